@@ -0,0 +1,310 @@
+/*
+ * encode_benchmark.c
+ *
+ * Measures the encoding and decoding throughput of information objects per TypeID
+ * and the throughput of the CS 104 APDU parser
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "iec60870_common.h"
+#include "cs101_information_objects.h"
+#include "cs101_asdu_template.h"
+#include "cs104_apdu_parser.h"
+#include "hal_time.h"
+
+static struct sCS101_AppLayerParameters appLayerParameters = {
+    /* .sizeOfTypeId =  */ 1,
+    /* .sizeOfVSQ = */ 1,
+    /* .sizeOfCOT = */ 2,
+    /* .originatorAddress = */ 0,
+    /* .sizeOfCA = */ 2,
+    /* .sizeOfIOA = */ 3,
+    /* .maxSizeOfASDU = */ 249
+};
+
+static InformationObject
+createInformationObject(TypeID typeId, struct sCP56Time2a* timestamp)
+{
+    switch (typeId) {
+
+    case M_SP_NA_1:
+        return (InformationObject) SinglePointInformation_create(NULL, 100, true, IEC60870_QUALITY_GOOD);
+
+    case M_DP_NA_1:
+        return (InformationObject) DoublePointInformation_create(NULL, 100, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_GOOD);
+
+    case M_ME_NA_1:
+        return (InformationObject) MeasuredValueNormalized_create(NULL, 100, 0.5f, IEC60870_QUALITY_GOOD);
+
+    case M_ME_NB_1:
+        return (InformationObject) MeasuredValueScaled_create(NULL, 100, 1234, IEC60870_QUALITY_GOOD);
+
+    case M_ME_NC_1:
+        return (InformationObject) MeasuredValueShort_create(NULL, 100, 12.5f, IEC60870_QUALITY_GOOD);
+
+    case M_IT_NA_1:
+        {
+            struct sBinaryCounterReading bcr;
+            BinaryCounterReading_setValue(&bcr, 123456);
+            BinaryCounterReading_setSequenceNumber(&bcr, 1);
+
+            return (InformationObject) IntegratedTotals_create(NULL, 100, &bcr);
+        }
+
+    case M_SP_TB_1:
+        return (InformationObject) SinglePointWithCP56Time2a_create(NULL, 100, true, IEC60870_QUALITY_GOOD, timestamp);
+
+    case M_ME_TF_1:
+        return (InformationObject) MeasuredValueShortWithCP56Time2a_create(NULL, 100, 12.5f, IEC60870_QUALITY_GOOD, timestamp);
+
+    default:
+        return NULL;
+    }
+}
+
+static void
+runBenchmark(TypeID typeId, int numberOfAsdus, InformationObject decodeBuffer)
+{
+    struct sCP56Time2a timestamp;
+    CP56Time2a_createFromMsTimestamp(&timestamp, Hal_getTimeInMs());
+
+    InformationObject io = createInformationObject(typeId, &timestamp);
+
+    if (io == NULL)
+        return;
+
+    sCS101_StaticASDU staticAsdu;
+
+    long objectsEncoded = 0;
+    int objectsPerAsdu = 0;
+    int asduSize = 0;
+
+    nsSinceEpoch start = Hal_getMonotonicTimeInNs();
+
+    int i;
+
+    for (i = 0; i < numberOfAsdus; i++) {
+        CS101_ASDU asdu = CS101_ASDU_initializeStatic(&staticAsdu, &appLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+        while (CS101_ASDU_addInformationObject(asdu, io))
+            objectsEncoded++;
+
+        objectsPerAsdu = CS101_ASDU_getNumberOfElements(asdu);
+        asduSize = CS101_ASDU_getPayloadSize(asdu);
+    }
+
+    nsSinceEpoch duration = Hal_getMonotonicTimeInNs() - start;
+
+    if (duration == 0)
+        duration = 1;
+
+    /* decode the elements of the last encoded ASDU */
+    CS101_ASDU asdu = (CS101_ASDU) &staticAsdu;
+
+    long objectsDecoded = 0;
+    int checksum = 0;
+
+    start = Hal_getMonotonicTimeInNs();
+
+    for (i = 0; i < numberOfAsdus; i++) {
+        int j;
+
+        for (j = 0; j < objectsPerAsdu; j++) {
+            InformationObject element = CS101_ASDU_getElementEx(asdu, decodeBuffer, j);
+
+            if (element) {
+                checksum += InformationObject_getObjectAddress(element);
+                objectsDecoded++;
+            }
+        }
+    }
+
+    nsSinceEpoch decodeDuration = Hal_getMonotonicTimeInNs() - start;
+
+    if (decodeDuration == 0)
+        decodeDuration = 1;
+
+    printf("%-18s %6i %6i %12.1f %12.2f %12.1f %12.2f\n", TypeID_toString(typeId), objectsPerAsdu, asduSize,
+            (double) duration / (double) objectsEncoded,
+            ((double) objectsEncoded * 1000.0) / (double) duration,
+            (double) decodeDuration / (double) objectsDecoded,
+            ((double) objectsDecoded * 1000.0) / (double) decodeDuration);
+
+    if (checksum == 0)
+        printf("  decoding failed!\n");
+
+    InformationObject_destroy(io);
+}
+
+/* compare building a M_ME_NC_1 ASDU from scratch with updating a pre-encoded template */
+static void
+runTemplateBenchmark(int numberOfAsdus)
+{
+    sCS101_StaticASDU staticAsdu;
+
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&staticAsdu, &appLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    struct sMeasuredValueShort* ios[30];
+    int i;
+
+    for (i = 0; i < 30; i++) {
+        ios[i] = MeasuredValueShort_create(NULL, 1000 + i, 0.0f, IEC60870_QUALITY_GOOD);
+        CS101_ASDU_addInformationObject(asdu, (InformationObject) ios[i]);
+    }
+
+    CS101_ASDUTemplate asduTemplate = CS101_ASDUTemplate_create(asdu);
+
+    nsSinceEpoch start = Hal_getMonotonicTimeInNs();
+
+    for (i = 0; i < numberOfAsdus; i++) {
+        asdu = CS101_ASDU_initializeStatic(&staticAsdu, &appLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+        int j;
+
+        for (j = 0; j < 30; j++) {
+            MeasuredValueShort_setValue(ios[j], (float) (i + j));
+            CS101_ASDU_addInformationObject(asdu, (InformationObject) ios[j]);
+        }
+    }
+
+    nsSinceEpoch rebuildDuration = Hal_getMonotonicTimeInNs() - start;
+
+    start = Hal_getMonotonicTimeInNs();
+
+    for (i = 0; i < numberOfAsdus; i++) {
+        int j;
+
+        for (j = 0; j < 30; j++)
+            CS101_ASDUTemplate_setShortValue(asduTemplate, j, (float) (i + j), IEC60870_QUALITY_GOOD);
+    }
+
+    nsSinceEpoch templateDuration = Hal_getMonotonicTimeInNs() - start;
+
+    printf("\ncyclic M_ME_NC_1 update (30 IOs per ASDU): rebuild %.1f ns/IO, template %.1f ns/IO\n",
+            (double) rebuildDuration / (30.0 * numberOfAsdus), (double) templateDuration / (30.0 * numberOfAsdus));
+
+    CS101_ASDUTemplate_destroy(asduTemplate);
+
+    for (i = 0; i < 30; i++)
+        MeasuredValueShort_destroy(ios[i]);
+}
+
+/* parse a stream of I, S, and U format APDUs delivered in chunks of the given size */
+static void
+runParserBenchmark(int numberOfRuns, int chunkSize)
+{
+    static uint8_t stream[64 * 1024];
+    int streamSize = 0;
+    int numberOfApdus = 0;
+
+    while (streamSize + 2 * 257 < (int) sizeof(stream)) {
+        int asduSize = 10 + (numberOfApdus % 200);
+        int i;
+
+        /* I format APDU */
+        stream[streamSize++] = 0x68;
+        stream[streamSize++] = (uint8_t) (4 + asduSize);
+        stream[streamSize++] = (uint8_t) ((numberOfApdus % 128) * 2);
+        stream[streamSize++] = 0;
+        stream[streamSize++] = 0;
+        stream[streamSize++] = 0;
+
+        for (i = 0; i < asduSize; i++)
+            stream[streamSize++] = (uint8_t) i;
+
+        /* S format APDU */
+        stream[streamSize++] = 0x68;
+        stream[streamSize++] = 4;
+        stream[streamSize++] = 0x01;
+        stream[streamSize++] = 0;
+        stream[streamSize++] = (uint8_t) ((numberOfApdus % 128) * 2);
+        stream[streamSize++] = 0;
+
+        numberOfApdus += 2;
+    }
+
+    sCS104_APDUParser parser;
+    CS104_APDUParser_initialize(&parser);
+
+    int completeApdus = 0;
+    int run;
+
+    nsSinceEpoch start = Hal_getMonotonicTimeInNs();
+
+    for (run = 0; run < numberOfRuns; run++) {
+        int chunkStart;
+
+        for (chunkStart = 0; chunkStart < streamSize; chunkStart += chunkSize) {
+            int size = streamSize - chunkStart;
+            int pos = 0;
+
+            if (size > chunkSize)
+                size = chunkSize;
+
+            while (pos < size) {
+                sCS104_APDU apdu;
+                int bytesConsumed;
+
+                CS104_APDUParserResult result = CS104_APDUParser_parse(&parser, stream + chunkStart + pos, size - pos, &bytesConsumed, &apdu);
+
+                pos += bytesConsumed;
+
+                if (result == CS104_APDU_PARSER_APDU_COMPLETE)
+                    completeApdus++;
+                else if (result == CS104_APDU_PARSER_ERROR) {
+                    printf("  parser error!\n");
+                    return;
+                }
+            }
+        }
+    }
+
+    nsSinceEpoch duration = Hal_getMonotonicTimeInNs() - start;
+
+    if (completeApdus != numberOfApdus * numberOfRuns)
+        printf("  unexpected number of APDUs!\n");
+
+    printf("APDU parser (chunk size %5i): %8.1f MB/s, %6.1f ns/APDU\n", chunkSize,
+            ((double) streamSize * numberOfRuns * 1000.0) / (double) duration,
+            (double) duration / (double) completeApdus);
+}
+
+int
+main(int argc, char** argv)
+{
+    int numberOfAsdus = 200000;
+
+    if (argc > 1)
+        numberOfAsdus = atoi(argv[1]);
+
+    printf("encoding %i ASDUs per type (COT: %i, CA: %i, IOA: %i bytes)\n\n", numberOfAsdus,
+            appLayerParameters.sizeOfCOT, appLayerParameters.sizeOfCA, appLayerParameters.sizeOfIOA);
+
+    InformationObject decodeBuffer = (InformationObject) malloc(InformationObject_getMaxSizeInMemory());
+
+    printf("%-18s %6s %6s %12s %12s %12s %12s\n", "type", "IOs", "bytes", "enc ns/IO", "enc MIOs/s", "dec ns/IO", "dec MIOs/s");
+
+    runBenchmark(M_SP_NA_1, numberOfAsdus, decodeBuffer);
+    runBenchmark(M_DP_NA_1, numberOfAsdus, decodeBuffer);
+    runBenchmark(M_ME_NA_1, numberOfAsdus, decodeBuffer);
+    runBenchmark(M_ME_NB_1, numberOfAsdus, decodeBuffer);
+    runBenchmark(M_ME_NC_1, numberOfAsdus, decodeBuffer);
+    runBenchmark(M_IT_NA_1, numberOfAsdus, decodeBuffer);
+    runBenchmark(M_SP_TB_1, numberOfAsdus, decodeBuffer);
+    runBenchmark(M_ME_TF_1, numberOfAsdus, decodeBuffer);
+
+    runTemplateBenchmark(numberOfAsdus);
+
+    printf("\n");
+
+    runParserBenchmark(numberOfAsdus / 1000 + 1, 1460);
+    runParserBenchmark(numberOfAsdus / 1000 + 1, 7);
+
+    free(decodeBuffer);
+
+    return 0;
+}
@@ -0,0 +1,252 @@
+/*
+ * process_image_benchmark.c
+ *
+ * Measures lookup and update throughput of the process image, the cost of
+ * change detection for complete scan cycles, and the time to encode all
+ * points into ASDUs (e.g. for a station interrogation). The update rate is also
+ * measured while another thread reads all points (like a running interrogation).
+ */
+
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdio.h>
+
+#include "iec60870_common.h"
+#include "cs101_information_objects.h"
+#include "cs101_process_image.h"
+#include "cs101_change_detector.h"
+#include "hal_time.h"
+#include "hal_thread.h"
+
+static struct sCS101_AppLayerParameters appLayerParameters = {
+    /* .sizeOfTypeId =  */ 1,
+    /* .sizeOfVSQ = */ 1,
+    /* .sizeOfCOT = */ 2,
+    /* .originatorAddress = */ 0,
+    /* .sizeOfCA = */ 2,
+    /* .sizeOfIOA = */ 3,
+    /* .maxSizeOfASDU = */ 249
+};
+
+static int eventAsdus = 0;
+
+static void
+eventHandler(void* parameter, CS101_ASDU asdu)
+{
+    eventAsdus++;
+}
+
+static volatile bool readerRunning = false;
+static volatile int readerCycles = 0;
+
+/* reads all points continuously (consistent read of each point) */
+static void*
+readerThread(void* parameter)
+{
+    CS101_ProcessImage processImage = (CS101_ProcessImage) parameter;
+
+    sCS101_StaticASDU staticAsdu;
+
+    while (readerRunning) {
+        int i;
+
+        for (i = 0; i < CS101_ProcessImage_getNumberOfPoints(processImage); i++) {
+            CS101_ASDU asdu = CS101_ASDU_initializeStatic(&staticAsdu, &appLayerParameters, false, CS101_COT_INTERROGATED_BY_STATION,
+                    0, CS101_ProcessImage_getCA(processImage, i), false, false);
+
+            CS101_ProcessImage_addToASDU(processImage, i, asdu);
+        }
+
+        readerCycles++;
+    }
+
+    return NULL;
+}
+
+static void
+printResult(const char* name, nsSinceEpoch duration, int operations)
+{
+    printf("%-32s %10.1f ns/op %10.2f Mop/s\n", name, (double) duration / operations,
+            ((double) operations * 1000.0) / (double) duration);
+}
+
+int
+main(int argc, char** argv)
+{
+    int numberOfPoints = 50000;
+    int numberOfRounds = 100;
+
+    if (argc > 1)
+        numberOfPoints = atoi(argv[1]);
+
+    if (argc > 2)
+        numberOfRounds = atoi(argv[2]);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(numberOfPoints);
+
+    if (processImage == NULL) {
+        printf("Failed to create process image\n");
+        return 1;
+    }
+
+    int i;
+
+    int numberOfSinglePoints = numberOfPoints / 4;
+
+    /* 1/4 single points, 3/4 short floating point values */
+    for (i = 0; i < numberOfPoints; i++) {
+        TypeID typeId = (i < numberOfSinglePoints) ? M_SP_NA_1 : M_ME_NC_1;
+
+        CS101_ProcessImage_addPoint(processImage, 1 + (i / 10000), 1000 + i, typeId);
+    }
+
+    printf("process image with %i points, %i rounds\n\n", numberOfPoints, numberOfRounds);
+
+    int operations = numberOfPoints * numberOfRounds;
+    int round;
+    int found = 0;
+
+    nsSinceEpoch start = Hal_getMonotonicTimeInNs();
+
+    for (round = 0; round < numberOfRounds; round++) {
+        for (i = 0; i < numberOfPoints; i++) {
+            if (CS101_ProcessImage_lookup(processImage, 1 + (i / 10000), 1000 + i) != -1)
+                found++;
+        }
+    }
+
+    printResult("lookup (CA, IOA)", Hal_getMonotonicTimeInNs() - start, operations);
+
+    if (found != operations)
+        printf("  lookup failed!\n");
+
+    uint64_t timestamp = Hal_getTimeInMs();
+
+    start = Hal_getMonotonicTimeInNs();
+
+    for (round = 0; round < numberOfRounds; round++) {
+        for (i = 0; i < numberOfPoints; i++) {
+            if (i < numberOfSinglePoints)
+                CS101_ProcessImage_updateSinglePoint(processImage, i, (round & 1) == 1, IEC60870_QUALITY_GOOD, timestamp);
+            else
+                CS101_ProcessImage_updateShortValue(processImage, i, (float) (round + i), IEC60870_QUALITY_GOOD, timestamp);
+        }
+    }
+
+    printResult("update (with timestamp)", Hal_getMonotonicTimeInNs() - start, operations);
+
+    start = Hal_getMonotonicTimeInNs();
+
+    for (round = 0; round < numberOfRounds; round++) {
+        for (i = 0; i < numberOfPoints; i++) {
+            if (i < numberOfSinglePoints)
+                CS101_ProcessImage_updateSinglePoint(processImage, i, (round & 1) == 1, IEC60870_QUALITY_GOOD, 0);
+            else
+                CS101_ProcessImage_updateShortValue(processImage, i, (float) (round + i), IEC60870_QUALITY_GOOD, 0);
+        }
+    }
+
+    printResult("update (current time)", Hal_getMonotonicTimeInNs() - start, operations);
+
+    /* updates while another thread reads all points */
+    readerRunning = true;
+
+    Thread reader = Thread_create(readerThread, processImage, false);
+    Thread_start(reader);
+
+    start = Hal_getMonotonicTimeInNs();
+
+    for (round = 0; round < numberOfRounds; round++) {
+        for (i = 0; i < numberOfPoints; i++) {
+            if (i < numberOfSinglePoints)
+                CS101_ProcessImage_updateSinglePoint(processImage, i, (round & 1) == 1, IEC60870_QUALITY_GOOD, timestamp);
+            else
+                CS101_ProcessImage_updateShortValue(processImage, i, (float) (round + i), IEC60870_QUALITY_GOOD, timestamp);
+        }
+    }
+
+    printResult("update (concurrent reader)", Hal_getMonotonicTimeInNs() - start, operations);
+
+    readerRunning = false;
+    Thread_destroy(reader);
+
+    printf("  %i read cycles of all points\n", readerCycles);
+
+    /* scan cycles of all measured values with change detection (1 % of the values exceed the deadband) */
+    CS101_ChangeDetector detector = CS101_ChangeDetector_create(processImage, &appLayerParameters);
+
+    CS101_ChangeDetector_setEventHandler(detector, eventHandler, NULL);
+
+    int numberOfMeasuredValues = numberOfPoints - numberOfSinglePoints;
+
+    int* indices = (int*) malloc(numberOfMeasuredValues * sizeof(int));
+    float* values = (float*) malloc(numberOfMeasuredValues * sizeof(float));
+
+    for (i = 0; i < numberOfMeasuredValues; i++) {
+        indices[i] = numberOfSinglePoints + i;
+        values[i] = 0.f;
+
+        CS101_ChangeDetector_setDeadband(detector, indices[i], CS101_DEADBAND_ABSOLUTE, 1.f);
+    }
+
+    int events = 0;
+
+    start = Hal_getMonotonicTimeInNs();
+
+    for (round = 0; round < numberOfRounds; round++) {
+        for (i = 0; i < numberOfMeasuredValues; i++) {
+            if ((i % 100) == (round % 100))
+                values[i] += 2.f;
+            else
+                values[i] += 0.001f;
+        }
+
+        events += CS101_ChangeDetector_updateFloatValues(detector, indices, values, NULL, numberOfMeasuredValues, 0);
+    }
+
+    printResult("scan cycle with change detection", Hal_getMonotonicTimeInNs() - start, numberOfMeasuredValues * numberOfRounds);
+
+    printf("  %i events in %i ASDUs\n", events, eventAsdus);
+
+    CS101_ChangeDetector_destroy(detector);
+
+    free(indices);
+    free(values);
+
+    /* encode all points into ASDUs (new ASDU when the ASDU is full, or type or CA change) */
+    sCS101_StaticASDU staticAsdu;
+    int numberOfAsdus = 0;
+
+    start = Hal_getMonotonicTimeInNs();
+
+    for (round = 0; round < numberOfRounds; round++) {
+        CS101_ASDU asdu = NULL;
+
+        for (i = 0; i < numberOfPoints; i++) {
+            if (asdu && ((CS101_ASDU_getTypeID(asdu) != CS101_ProcessImage_getTypeID(processImage, i)) ||
+                    (CS101_ASDU_getCA(asdu) != CS101_ProcessImage_getCA(processImage, i)) ||
+                    (CS101_ProcessImage_addToASDU(processImage, i, asdu) == false)))
+            {
+                numberOfAsdus++;
+                asdu = NULL;
+            }
+
+            if (asdu == NULL) {
+                asdu = CS101_ASDU_initializeStatic(&staticAsdu, &appLayerParameters, false, CS101_COT_INTERROGATED_BY_STATION,
+                        0, CS101_ProcessImage_getCA(processImage, i), false, false);
+
+                CS101_ProcessImage_addToASDU(processImage, i, asdu);
+            }
+        }
+
+        numberOfAsdus++;
+    }
+
+    printResult("encode all points into ASDUs", Hal_getMonotonicTimeInNs() - start, operations);
+
+    printf("\n%i ASDUs per station interrogation\n", numberOfAsdus / numberOfRounds);
+
+    CS101_ProcessImage_destroy(processImage);
+
+    return 0;
+}
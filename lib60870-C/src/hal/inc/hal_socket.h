@@ -107,6 +107,20 @@ Handleset_removeSocket(HandleSet self, const Socket sock);
 PAL_API int
 Handleset_waitReady(HandleSet self, unsigned int timeoutMs);
 
+/**
+ * \brief check if a socket was ready in the last call of Handleset_waitReady
+ *
+ * The result is cached by Handleset_waitReady, so the function doesn't call the
+ * operating system.
+ *
+ * \param self the HandleSet instance
+ * \param sock the socket to check
+ *
+ * \return true when data is pending on the socket (or the socket has an error), false otherwise
+ */
+PAL_API bool
+Handleset_isReady(HandleSet self, const Socket sock);
+
 /**
  * \brief destroy the HandleSet instance
  *
@@ -369,6 +383,21 @@ Socket_getPeerAddress(Socket self);
 PAL_API char*
 Socket_getPeerAddressStatic(Socket self, char* peerAddressString);
 
+/**
+ * \brief Get the socket descriptor of the operating system
+ *
+ * The descriptor can be used to wait for the socket with the event mechanism of the application
+ * (e.g. poll or epoll). It must not be used to read, write, or close the socket.
+ *
+ * Implementation of this function is OPTIONAL (required for the threadless CS 104 client).
+ *
+ * \param self the client or connection socket instance
+ *
+ * \return the socket descriptor, or -1 when the socket is not open
+ */
+PAL_API int
+Socket_getFileDescriptor(Socket self);
+
 /**
  * \brief destroy a socket (close the socket if a connection is established)
  *
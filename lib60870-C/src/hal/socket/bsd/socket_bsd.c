@@ -65,6 +65,7 @@ struct sHandleSet
     bool pollfdIsUpdated;
     struct pollfd* fds;
     int nfds;
+    int lastReadyIndex; /* position of the last socket checked with Handleset_isReady */
 };
 
 HandleSet
@@ -78,6 +79,7 @@ Handleset_new(void)
         self->pollfdIsUpdated = false;
         self->fds = NULL;
         self->nfds = 0;
+        self->lastReadyIndex = 0;
     }
 
     return self;
@@ -133,27 +135,30 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
 
         self->fds = GLOBAL_CALLOC(self->nfds, sizeof(struct pollfd));
 
-        int i;
+        int i = 0;
 
-        for (i = 0; i < self->nfds; i++)
+        LinkedList sockElem = LinkedList_getNext(self->sockets);
+
+        while (sockElem && (i < self->nfds))
         {
-            LinkedList sockElem = LinkedList_get(self->sockets, i);
+            Socket sock = (Socket)LinkedList_getData(sockElem);
 
-            if (sockElem)
+            if (sock)
             {
-                Socket sock = (Socket)LinkedList_getData(sockElem);
-
-                if (sock)
-                {
-                    self->fds[i].fd = sock->fd;
-                    self->fds[i].events = POLL_IN;
-                }
+                self->fds[i].fd = sock->fd;
+                self->fds[i].events = POLL_IN;
             }
+
+            i++;
+
+            sockElem = LinkedList_getNext(sockElem);
         }
 
         self->pollfdIsUpdated = true;
     }
 
+    self->lastReadyIndex = 0;
+
     if (self->fds && self->nfds > 0)
     {
         int result = poll(self->fds, self->nfds, timeoutMs);
@@ -173,6 +178,30 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
     }
 }
 
+bool
+Handleset_isReady(HandleSet self, const Socket sock)
+{
+    if ((self == NULL) || (sock == NULL) || (self->fds == NULL) || (self->pollfdIsUpdated == false))
+        return false;
+
+    int i;
+
+    /* sockets are usually checked in the order they were added -> start after the last match */
+    for (i = 0; i < self->nfds; i++)
+    {
+        int idx = (self->lastReadyIndex + i) % self->nfds;
+
+        if (self->fds[idx].fd == sock->fd)
+        {
+            self->lastReadyIndex = idx + 1;
+
+            return ((self->fds[idx].revents & (POLLIN | POLLERR | POLLHUP | POLLNVAL)) != 0);
+        }
+    }
+
+    return false;
+}
+
 void
 Handleset_destroy(HandleSet self)
 {
@@ -690,6 +719,12 @@ Socket_write(Socket self, uint8_t* buf, int size)
         return retVal;
 }
 
+int
+Socket_getFileDescriptor(Socket self)
+{
+    return self->fd;
+}
+
 void
 Socket_destroy(Socket self)
 {
@@ -51,6 +51,7 @@ struct sServerSocket
 struct sHandleSet
 {
     fd_set handles;
+    fd_set readyHandles; /* result of the last Handleset_waitReady call */
     SOCKET maxHandle;
 };
 
@@ -68,6 +69,7 @@ Handleset_new(void)
     if (result != NULL)
     {
         FD_ZERO(&result->handles);
+        FD_ZERO(&result->readyHandles);
         result->maxHandle = INVALID_SOCKET;
     }
 
@@ -78,6 +80,7 @@ void
 Handleset_reset(HandleSet self)
 {
     FD_ZERO(&self->handles);
+    FD_ZERO(&self->readyHandles);
     self->maxHandle = INVALID_SOCKET;
 }
 
@@ -120,6 +123,11 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
         memcpy((void*)&handles, &(self->handles), sizeof(fd_set));
 
         result = select(0, &handles, NULL, NULL, &timeout);
+
+        if (result > 0)
+            memcpy((void*)&(self->readyHandles), &handles, sizeof(fd_set));
+        else
+            FD_ZERO(&(self->readyHandles));
     }
     else
     {
@@ -129,6 +137,15 @@ Handleset_waitReady(HandleSet self, unsigned int timeoutMs)
     return result;
 }
 
+bool
+Handleset_isReady(HandleSet self, const Socket sock)
+{
+    if ((self == NULL) || (sock == NULL))
+        return false;
+
+    return (FD_ISSET(sock->fd, &(self->readyHandles)) != 0);
+}
+
 void
 Handleset_destroy(HandleSet self)
 {
@@ -690,6 +707,15 @@ Socket_write(Socket self, uint8_t* buf, int size)
     return bytes_sent;
 }
 
+int
+Socket_getFileDescriptor(Socket self)
+{
+    if (self->fd == INVALID_SOCKET)
+        return -1;
+
+    return (int) self->fd;
+}
+
 void
 Socket_destroy(Socket self)
 {
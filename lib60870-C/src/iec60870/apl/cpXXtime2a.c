@@ -38,16 +38,22 @@
  *  CP16Time2a type
  **********************************/
 
+void
+CP16Time2a_decode(CP16Time2a self, const uint8_t* msg, int startIndex)
+{
+    int i;
+
+    for (i = 0; i < 2; i++)
+        self->encodedValue[i] = msg[startIndex + i];
+}
+
 bool
 CP16Time2a_getFromBuffer (CP16Time2a self, const uint8_t* msg, int msgSize, int startIndex)
 {
     if (msgSize < startIndex + 2)
         return false;
 
-    int i;
-
-    for (i = 0; i < 2; i++)
-        self->encodedValue[i] = msg[startIndex + i];
+    CP16Time2a_decode(self, msg, startIndex);
 
     return true;
 }
@@ -160,16 +166,22 @@ setSubstituted(uint8_t* encodedValue, bool value)
  *  CP24Time2a type
  **********************************/
 
+void
+CP24Time2a_decode(CP24Time2a self, const uint8_t* msg, int startIndex)
+{
+    int i;
+
+    for (i = 0; i < 3; i++)
+        self->encodedValue[i] = msg[startIndex + i];
+}
+
 bool
 CP24Time2a_getFromBuffer (CP24Time2a self, const uint8_t* msg, int msgSize, int startIndex)
 {
     if (msgSize < startIndex + 3)
         return false;
 
-    int i;
-
-    for (i = 0; i < 3; i++)
-        self->encodedValue[i] = msg[startIndex + i];
+    CP24Time2a_decode(self, msg, startIndex);
 
     return true;
 }
@@ -533,16 +545,22 @@ CP56Time2a_toMsTimestamp(const CP56Time2a self)
     return msTimestamp;
 }
 
+void
+CP56Time2a_decode(CP56Time2a self, const uint8_t* msg, int startIndex)
+{
+    int i;
+
+    for (i = 0; i < 7; i++)
+        self->encodedValue[i] = msg[startIndex + i];
+}
+
 /* private */ bool
 CP56Time2a_getFromBuffer(CP56Time2a self, const uint8_t* msg, int msgSize, int startIndex)
 {
     if (msgSize < startIndex + 7)
         return false;
 
-    int i;
-
-    for (i = 0; i < 7; i++)
-        self->encodedValue[i] = msg[startIndex + i];
+    CP56Time2a_decode(self, msg, startIndex);
 
     return true;
 }
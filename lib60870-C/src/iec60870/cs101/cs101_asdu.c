@@ -30,59 +30,6 @@
 #include "lib60870_internal.h"
 #include "cs101_asdu_internal.h"
 
-typedef struct sASDUFrame* ASDUFrame;
-
-struct sASDUFrame {
-    FrameVFT virtualFunctionTable;
-    CS101_ASDU asdu;
-};
-
-static void
-asduFrame_destroy(Frame self)
-{
-    UNUSED_PARAMETER(self);
-}
-
-static void
-asduFrame_setNextByte(Frame self, uint8_t byte)
-{
-    ASDUFrame frame = (ASDUFrame) self;
-
-    frame->asdu->payload[frame->asdu->payloadSize++] = byte;
-}
-
-static void
-asduFrame_appendBytes(Frame self, const uint8_t* bytes, int numberOfBytes)
-{
-    ASDUFrame frame = (ASDUFrame) self;
-
-    uint8_t* target = frame->asdu->payload + frame->asdu->payloadSize;
-
-    int i;
-    for (i = 0; i < numberOfBytes; i++)
-        target[i] = bytes[i];
-
-    frame->asdu->payloadSize += numberOfBytes;
-}
-
-static int
-asduFrame_getSpaceLeft(Frame self)
-{
-    ASDUFrame frame = (ASDUFrame) self;
-
-    return (frame->asdu->parameters->maxSizeOfASDU - frame->asdu->payloadSize - frame->asdu->asduHeaderLength);
-}
-
-struct sFrameVFT asduFrameVFT = {
-        asduFrame_destroy,
-        NULL,
-        asduFrame_setNextByte,
-        asduFrame_appendBytes,
-        NULL,
-        NULL,
-        asduFrame_getSpaceLeft
-};
-
 // parameters 应用层参数，包含ASDU的结构定义，如ASDU最大长度、序列号支持等
 // isSequence 信息对象是否按顺序排列（true：顺序，false：非顺序）
 // cot 	传输原因（COT），指示数据的来源或目的，如 CS101_COT_SPONTANEOUS（自发上报）、CS101_COT_INTERROGATED_BY_STATION（总召）
@@ -129,7 +76,7 @@ CS101_ASDU
 CS101_ASDU_initializeStatic(CS101_StaticASDU self, CS101_AppLayerParameters parameters, bool isSequence, CS101_CauseOfTransmission cot, int oa, int ca,
         bool isTest, bool isNegative)
 {
-    int asduHeaderLength = 2 + parameters->sizeOfCOT + parameters->sizeOfCA;
+    int asduHeaderLength = 2 + CS101_SIZE_OF_COT(parameters) + CS101_SIZE_OF_CA(parameters);
 
     self->encodedData[0] = (uint8_t) 0;
 
@@ -148,7 +95,7 @@ CS101_ASDU_initializeStatic(CS101_StaticASDU self, CS101_AppLayerParameters para
 
     int caIndex;
 
-    if (parameters->sizeOfCOT > 1) {
+    if (CS101_SIZE_OF_COT(parameters) > 1) {
         self->encodedData[3] = (uint8_t) oa;
         caIndex = 4;
     }
@@ -157,7 +104,7 @@ CS101_ASDU_initializeStatic(CS101_StaticASDU self, CS101_AppLayerParameters para
 
     self->encodedData[caIndex] = ca % 0x100;
 
-    if (parameters->sizeOfCA > 1)
+    if (CS101_SIZE_OF_CA(parameters) > 1)
         self->encodedData[caIndex + 1] = ca / 0x100;
 
     self->asdu = self->encodedData;
@@ -165,6 +112,7 @@ CS101_ASDU_initializeStatic(CS101_StaticASDU self, CS101_AppLayerParameters para
     self->payload = self->encodedData + asduHeaderLength;
     self->payloadSize = 0;
     self->parameters = parameters;
+    self->isValidated = false;
 
     return (CS101_ASDU) self;
 }
@@ -181,10 +129,23 @@ CS101_ASDU_encode(CS101_ASDU self, Frame frame)
     Frame_appendBytes(frame, self->asdu, self->asduHeaderLength + self->payloadSize);
 }
 
+bool
+CS101_ASDU_encodeToSpan(CS101_ASDU self, FrameSpan span)
+{
+    int asduSize = self->asduHeaderLength + self->payloadSize;
+
+    if (FrameSpan_getSpaceLeft(span) < asduSize)
+        return false;
+
+    FrameSpan_appendBytes(span, self->asdu, asduSize);
+
+    return true;
+}
+
 CS101_ASDU
 CS101_ASDU_createFromBufferEx(CS101_ASDU asdu, CS101_AppLayerParameters parameters, uint8_t* msg, int msgLength)
 {
-    int asduHeaderLength = 2 + parameters->sizeOfCOT + parameters->sizeOfCA;
+    int asduHeaderLength = 2 + CS101_SIZE_OF_COT(parameters) + CS101_SIZE_OF_CA(parameters);
 
     if (msgLength < asduHeaderLength)
         return NULL;
@@ -203,6 +164,8 @@ CS101_ASDU_createFromBufferEx(CS101_ASDU asdu, CS101_AppLayerParameters paramete
 
         self->payload = msg + asduHeaderLength;
         self->payloadSize = msgLength - asduHeaderLength;
+
+        CS101_ASDU_validate(self);
     }
 
     return self;
@@ -235,6 +198,7 @@ CS101_ASDU_addPayload(CS101_ASDU self, uint8_t* buffer, int size)
     if (self->payloadSize + self->asduHeaderLength + size <= 256) {
         memcpy(self->payload + self->payloadSize, buffer, size);
         self->payloadSize += size;
+        self->isValidated = false;
         return true;
     }
     else
@@ -248,10 +212,10 @@ getFirstIOA(CS101_ASDU self)
 
     int ioa = self->asdu[startIndex];
 
-    if (self->parameters->sizeOfIOA > 1)
+    if (CS101_SIZE_OF_IOA(self->parameters) > 1)
         ioa += (self->asdu [startIndex + 1] * 0x100);
 
-    if (self->parameters->sizeOfIOA > 2)
+    if (CS101_SIZE_OF_IOA(self->parameters) > 2)
         ioa += (self->asdu [startIndex + 2] * 0x10000);
 
     return ioa;
@@ -260,10 +224,10 @@ getFirstIOA(CS101_ASDU self)
 bool
 CS101_ASDU_addInformationObject(CS101_ASDU self, InformationObject io)
 {
-    struct sASDUFrame asduFrame = {
-            &asduFrameVFT,
-            self
-    };
+    struct sFrameSpan span;
+
+    FrameSpan_initialize(&span, self->payload, self->payloadSize,
+            self->parameters->maxSizeOfASDU - self->asduHeaderLength);
 
     bool encoded = false;
 
@@ -272,7 +236,7 @@ CS101_ASDU_addInformationObject(CS101_ASDU self, InformationObject io)
     if (numberOfElements == 0) {
         self->asdu[0] = (uint8_t) InformationObject_getType(io);
 
-        encoded = InformationObject_encode(io, (Frame) &asduFrame, self->parameters, false);
+        encoded = InformationObject_encodeToSpan(io, &span, self->parameters, false);
     }
     else if (numberOfElements < 0x7f) {
 
@@ -284,18 +248,21 @@ CS101_ASDU_addInformationObject(CS101_ASDU self, InformationObject io)
 
                 /* check that new information object has correct IOA */
                 if (InformationObject_getObjectAddress(io) == (getFirstIOA(self) + CS101_ASDU_getNumberOfElements(self)))
-                    encoded = InformationObject_encode(io, (Frame) &asduFrame, self->parameters, true);
+                    encoded = InformationObject_encodeToSpan(io, &span, self->parameters, true);
                 else
                     encoded = false;
             }
             else {
-                encoded = InformationObject_encode(io, (Frame) &asduFrame, self->parameters, false);;
+                encoded = InformationObject_encodeToSpan(io, &span, self->parameters, false);
             }
         }
     }
 
-    if (encoded)
+    if (encoded) {
+        self->payloadSize = span.pos;
         self->asdu[1]++; /* increase number of elements in VSQ */
+        self->isValidated = false;
+    }
 
     return encoded;
 }
@@ -305,6 +272,7 @@ CS101_ASDU_removeAllElements(CS101_ASDU self)
 {
     self->asdu[1] = (self->asdu[1] & 0x80);
     self->payloadSize = 0;
+    self->isValidated = false;
 }
 
 bool
@@ -346,7 +314,7 @@ CS101_ASDU_setNegative(CS101_ASDU self, bool value)
 int
 CS101_ASDU_getOA(CS101_ASDU self)
 {
-    if (self->parameters->sizeOfCOT < 2)
+    if (CS101_SIZE_OF_COT(self->parameters) < 2)
         return -1;
     else
         return (int) self->asdu[3];
@@ -370,11 +338,11 @@ CS101_ASDU_setCOT(CS101_ASDU self, CS101_CauseOfTransmission value)
 int
 CS101_ASDU_getCA(CS101_ASDU self)
 {
-    int caIndex = 2 + self->parameters->sizeOfCOT;
+    int caIndex = 2 + CS101_SIZE_OF_COT(self->parameters);
 
     int ca = self->asdu[caIndex];
 
-    if (self->parameters->sizeOfCA > 1)
+    if (CS101_SIZE_OF_CA(self->parameters) > 1)
         ca += (self->asdu[caIndex + 1] * 0x100);
 
     return ca;
@@ -383,7 +351,7 @@ CS101_ASDU_getCA(CS101_ASDU self)
 void
 CS101_ASDU_setCA(CS101_ASDU self, int ca)
 {
-    int caIndex = 2 + self->parameters->sizeOfCOT;
+    int caIndex = 2 + CS101_SIZE_OF_COT(self->parameters);
 
     int setCa = ca;
 
@@ -391,17 +359,17 @@ CS101_ASDU_setCA(CS101_ASDU self, int ca)
     if (ca < 0)
         setCa = 0;
     else {
-        if (self->parameters->sizeOfCA == 1) {
+        if (CS101_SIZE_OF_CA(self->parameters) == 1) {
             if (ca > 255)
                 setCa = 255;
         }
-        else if (self->parameters->sizeOfCA > 1) {
+        else if (CS101_SIZE_OF_CA(self->parameters) > 1) {
             if (ca > 65535)
                 setCa = 65535;
         }
     }
 
-    if (self->parameters->sizeOfCA == 1) {
+    if (CS101_SIZE_OF_CA(self->parameters) == 1) {
         self->asdu[caIndex] = (uint8_t) setCa;
     }
     else {
@@ -420,6 +388,7 @@ void
 CS101_ASDU_setTypeID(CS101_ASDU self, IEC60870_5_TypeID typeId)
 {
     self->asdu[0] = (uint8_t) typeId;
+    self->isValidated = false;
 }
 
 bool
@@ -438,6 +407,8 @@ CS101_ASDU_setSequence(CS101_ASDU self, bool isSequence)
         self->asdu[1] |= 0x80;
     else
         self->asdu[1] &= 0x7f;
+
+    self->isValidated = false;
 }
 
 int
@@ -451,6 +422,82 @@ CS101_ASDU_setNumberOfElements(CS101_ASDU self, int numberOfElements)
 {
     self->asdu[1] &= 0x80;
     self->asdu[1] |= ((uint8_t) numberOfElements) & 0x7f;
+    self->isValidated = false;
+}
+
+/* size of the information element (without IOA) per type ID, -1 for unsupported or variable size */
+static const int8_t informationElementSizes[128] = {
+    -1,                                 /* 0 - not used */
+    1, 4, 1, 4, 2, 5, 5, 8,             /* 1 - 8: M_SP_NA_1 - M_BO_TA_1 */
+    3, 6, 3, 6, 5, 8, 5, 8,             /* 9 - 16: M_ME_NA_1 - M_IT_TA_1 */
+    6, 7, 7, 5, 2,                      /* 17 - 21: M_EP_TA_1 - M_ME_ND_1 */
+    -1, -1, -1, -1, -1, -1, -1, -1,     /* 22 - 29 reserved */
+    8, 8, 9, 12, 10, 10, 12, 12,        /* 30 - 37: M_SP_TB_1 - M_IT_TB_1 */
+    10, 11, 11,                         /* 38 - 40: M_EP_TD_1 - M_EP_TF_1 */
+    -1, -1, -1, -1,                     /* 41 - 44 reserved */
+    1, 1, 1, 3, 3, 5, 4,                /* 45 - 51: C_SC_NA_1 - C_BO_NA_1 */
+    -1, -1, -1, -1, -1, -1,             /* 52 - 57 reserved */
+    8, 8, 8, 10, 10, 12, 11,            /* 58 - 64: C_SC_TA_1 - C_BO_TA_1 */
+    -1, -1, -1, -1, -1,                 /* 65 - 69 reserved */
+    1,                                  /* 70: M_EI_NA_1 */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 71 - 79 reserved */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 80 - 89 reserved */
+    -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, /* 90 - 99 reserved */
+    1, 1, 0, 7, 2, 1, 2, 9,             /* 100 - 107: C_IC_NA_1 - C_TS_TA_1 */
+    -1, -1,                             /* 108 - 109 reserved */
+    3, 3, 5, 1,                         /* 110 - 113: P_ME_NA_1 - P_AC_NA_1 */
+    -1, -1, -1, -1, -1, -1,             /* 114 - 119 reserved */
+    6, 7, 4, 5, 4, -1, 13, 16           /* 120 - 127: F_FR_NA_1 - F_SC_NB_1 (F_SG_NA_1 has variable size) */
+};
+
+int
+CS101_getInformationElementSize(TypeID typeId)
+{
+    if (((int) typeId > 0) && ((int) typeId < 128))
+        return informationElementSizes[typeId];
+    else
+        return -1;
+}
+
+/* types where the information objects can be encoded as sequence (SQ=1) */
+static bool
+isSequenceSupported(TypeID typeId)
+{
+    return ((typeId < C_SC_NA_1) || (typeId == F_DR_TA_1));
+}
+
+bool
+CS101_ASDU_validate(CS101_ASDU self)
+{
+    TypeID typeId = CS101_ASDU_getTypeID(self);
+    int elementSize = CS101_getInformationElementSize(typeId);
+    int numberOfElements = CS101_ASDU_getNumberOfElements(self);
+    int expectedSize;
+
+    self->isValidated = false;
+
+    if ((elementSize < 0) || (numberOfElements == 0))
+        return false;
+
+    if (CS101_ASDU_isSequence(self) && isSequenceSupported(typeId))
+        expectedSize = CS101_SIZE_OF_IOA(self->parameters) + (numberOfElements * elementSize);
+    else
+        expectedSize = numberOfElements * (CS101_SIZE_OF_IOA(self->parameters) + elementSize);
+
+    if (self->payloadSize != expectedSize) {
+        DEBUG_PRINT("invalid ASDU - payload size %i does not match (expected: %i)\n", self->payloadSize, expectedSize);
+        return false;
+    }
+
+    self->isValidated = true;
+
+    return true;
+}
+
+bool
+CS101_ASDU_isValidated(CS101_ASDU self)
+{
+    return self->isValidated;
 }
 
 InformationObject
@@ -459,6 +506,298 @@ CS101_ASDU_getElement(CS101_ASDU self, int index)
     return CS101_ASDU_getElementEx(self, NULL, index);
 }
 
+/* decode an element of a validated ASDU - payload size and index are already checked */
+static InformationObject
+getValidatedElement(CS101_ASDU self, InformationObject io, int index)
+{
+    InformationObject retVal = NULL;
+
+    TypeID typeId = CS101_ASDU_getTypeID(self);
+    int elementSize = informationElementSizes[typeId];
+    bool isSequence = (CS101_ASDU_isSequence(self) && isSequenceSupported(typeId));
+    int startIndex;
+
+    if (isSequence)
+        startIndex = CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize);
+    else
+        startIndex = index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize);
+
+    switch (typeId) {
+
+    case M_SP_NA_1:
+        retVal = (InformationObject) SinglePointInformation_decode((SinglePointInformation) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_SP_TA_1:
+        retVal = (InformationObject) SinglePointWithCP24Time2a_decode((SinglePointWithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_DP_NA_1:
+        retVal = (InformationObject) DoublePointInformation_decode((DoublePointInformation) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_DP_TA_1:
+        retVal = (InformationObject) DoublePointWithCP24Time2a_decode((DoublePointWithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ST_NA_1:
+        retVal = (InformationObject) StepPositionInformation_decode((StepPositionInformation) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ST_TA_1:
+        retVal = (InformationObject) StepPositionWithCP24Time2a_decode((StepPositionWithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_BO_NA_1:
+        retVal = (InformationObject) BitString32_decode((BitString32) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_BO_TA_1:
+        retVal = (InformationObject) Bitstring32WithCP24Time2a_decode((Bitstring32WithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_NA_1:
+        retVal = (InformationObject) MeasuredValueNormalized_decode((MeasuredValueNormalized) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_TA_1:
+        retVal = (InformationObject) MeasuredValueNormalizedWithCP24Time2a_decode((MeasuredValueNormalizedWithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_NB_1:
+        retVal = (InformationObject) MeasuredValueScaled_decode((MeasuredValueScaled) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_TB_1:
+        retVal = (InformationObject) MeasuredValueScaledWithCP24Time2a_decode((MeasuredValueScaledWithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_NC_1:
+        retVal = (InformationObject) MeasuredValueShort_decode((MeasuredValueShort) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_TC_1:
+        retVal = (InformationObject) MeasuredValueShortWithCP24Time2a_decode((MeasuredValueShortWithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_IT_NA_1:
+        retVal = (InformationObject) IntegratedTotals_decode((IntegratedTotals) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_IT_TA_1:
+        retVal = (InformationObject) IntegratedTotalsWithCP24Time2a_decode((IntegratedTotalsWithCP24Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_EP_TA_1:
+        retVal = (InformationObject) EventOfProtectionEquipment_decode((EventOfProtectionEquipment) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_EP_TB_1:
+        retVal = (InformationObject) PackedStartEventsOfProtectionEquipment_decode((PackedStartEventsOfProtectionEquipment) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_EP_TC_1:
+        retVal = (InformationObject) PackedOutputCircuitInfo_decode((PackedOutputCircuitInfo) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_PS_NA_1:
+        retVal = (InformationObject) PackedSinglePointWithSCD_decode((PackedSinglePointWithSCD) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_ND_1:
+        retVal = (InformationObject) MeasuredValueNormalizedWithoutQuality_decode((MeasuredValueNormalizedWithoutQuality) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_SP_TB_1:
+        retVal = (InformationObject) SinglePointWithCP56Time2a_decode((SinglePointWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_DP_TB_1:
+        retVal = (InformationObject) DoublePointWithCP56Time2a_decode((DoublePointWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ST_TB_1:
+        retVal = (InformationObject) StepPositionWithCP56Time2a_decode((StepPositionWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_BO_TB_1:
+        retVal = (InformationObject) Bitstring32WithCP56Time2a_decode((Bitstring32WithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_TD_1:
+        retVal = (InformationObject) MeasuredValueNormalizedWithCP56Time2a_decode((MeasuredValueNormalizedWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_TE_1:
+        retVal = (InformationObject) MeasuredValueScaledWithCP56Time2a_decode((MeasuredValueScaledWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_ME_TF_1:
+        retVal = (InformationObject) MeasuredValueShortWithCP56Time2a_decode((MeasuredValueShortWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_IT_TB_1:
+        retVal = (InformationObject) IntegratedTotalsWithCP56Time2a_decode((IntegratedTotalsWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_EP_TD_1:
+        retVal = (InformationObject) EventOfProtectionEquipmentWithCP56Time2a_decode((EventOfProtectionEquipmentWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_EP_TE_1:
+        retVal = (InformationObject) PackedStartEventsOfProtectionEquipmentWithCP56Time2a_decode((PackedStartEventsOfProtectionEquipmentWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case M_EP_TF_1:
+        retVal = (InformationObject) PackedOutputCircuitInfoWithCP56Time2a_decode((PackedOutputCircuitInfoWithCP56Time2a) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case F_DR_TA_1:
+        retVal = (InformationObject) FileDirectory_decode((FileDirectory) io, self->parameters, self->payload, startIndex, isSequence);
+        break;
+
+    case C_SC_NA_1:
+        retVal = (InformationObject) SingleCommand_decode((SingleCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_DC_NA_1:
+        retVal = (InformationObject) DoubleCommand_decode((DoubleCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_RC_NA_1:
+        retVal = (InformationObject) StepCommand_decode((StepCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_SE_NA_1:
+        retVal = (InformationObject) SetpointCommandNormalized_decode((SetpointCommandNormalized) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_SE_NB_1:
+        retVal = (InformationObject) SetpointCommandScaled_decode((SetpointCommandScaled) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_SE_NC_1:
+        retVal = (InformationObject) SetpointCommandShort_decode((SetpointCommandShort) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_BO_NA_1:
+        retVal = (InformationObject) Bitstring32Command_decode((Bitstring32Command) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_SC_TA_1:
+        retVal = (InformationObject) SingleCommandWithCP56Time2a_decode((SingleCommandWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_DC_TA_1:
+        retVal = (InformationObject) DoubleCommandWithCP56Time2a_decode((DoubleCommandWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_RC_TA_1:
+        retVal = (InformationObject) StepCommandWithCP56Time2a_decode((StepCommandWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_SE_TA_1:
+        retVal = (InformationObject) SetpointCommandNormalizedWithCP56Time2a_decode((SetpointCommandNormalizedWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_SE_TB_1:
+        retVal = (InformationObject) SetpointCommandScaledWithCP56Time2a_decode((SetpointCommandScaledWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_SE_TC_1:
+        retVal = (InformationObject) SetpointCommandShortWithCP56Time2a_decode((SetpointCommandShortWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_BO_TA_1:
+        retVal = (InformationObject) Bitstring32CommandWithCP56Time2a_decode((Bitstring32CommandWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case M_EI_NA_1:
+        retVal = (InformationObject) EndOfInitialization_decode((EndOfInitialization) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_IC_NA_1:
+        retVal = (InformationObject) InterrogationCommand_decode((InterrogationCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_CI_NA_1:
+        retVal = (InformationObject) CounterInterrogationCommand_decode((CounterInterrogationCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_RD_NA_1:
+        retVal = (InformationObject) ReadCommand_decode((ReadCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_CS_NA_1:
+        retVal = (InformationObject) ClockSynchronizationCommand_decode((ClockSynchronizationCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_TS_NA_1:
+        retVal = (InformationObject) TestCommand_decode((TestCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_RP_NA_1:
+        retVal = (InformationObject) ResetProcessCommand_decode((ResetProcessCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_CD_NA_1:
+        retVal = (InformationObject) DelayAcquisitionCommand_decode((DelayAcquisitionCommand) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case C_TS_TA_1:
+        retVal = (InformationObject) TestCommandWithCP56Time2a_decode((TestCommandWithCP56Time2a) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case P_ME_NA_1:
+        retVal = (InformationObject) ParameterNormalizedValue_decode((ParameterNormalizedValue) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case P_ME_NB_1:
+        retVal = (InformationObject) ParameterScaledValue_decode((ParameterScaledValue) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case P_ME_NC_1:
+        retVal = (InformationObject) ParameterFloatValue_decode((ParameterFloatValue) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case P_AC_NA_1:
+        retVal = (InformationObject) ParameterActivation_decode((ParameterActivation) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case F_FR_NA_1:
+        retVal = (InformationObject) FileReady_decode((FileReady) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case F_SR_NA_1:
+        retVal = (InformationObject) SectionReady_decode((SectionReady) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case F_SC_NA_1:
+        retVal = (InformationObject) FileCallOrSelect_decode((FileCallOrSelect) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case F_LS_NA_1:
+        retVal = (InformationObject) FileLastSegmentOrSection_decode((FileLastSegmentOrSection) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case F_AF_NA_1:
+        retVal = (InformationObject) FileACK_decode((FileACK) io, self->parameters, self->payload, startIndex);
+        break;
+
+    case F_SC_NB_1:
+        retVal = (InformationObject) QueryLog_decode((QueryLog) io, self->parameters, self->payload, startIndex);
+        break;
+
+    default:
+        break;
+    }
+
+    if (isSequence && retVal)
+        InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+
+    return retVal;
+}
+
 InformationObject
 CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 {
@@ -466,6 +805,17 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     int elementSize;
 
+    if (self->isValidated) {
+        /* payload size matches the number of elements -> only the index has to be checked */
+        if ((index < 0) || (index >= CS101_ASDU_getNumberOfElements(self)))
+            return NULL;
+
+        return getValidatedElement(self, io, index);
+    }
+
+    if (index < 0)
+        return NULL;
+
     switch (CS101_ASDU_getTypeID(self)) {
 
     case M_SP_NA_1: /* 1 */
@@ -474,13 +824,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) SinglePointInformation_getFromBuffer((SinglePointInformation) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) SinglePointInformation_getFromBuffer((SinglePointInformation) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -490,13 +841,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) SinglePointWithCP24Time2a_getFromBuffer((SinglePointWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) SinglePointWithCP24Time2a_getFromBuffer((SinglePointWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -506,13 +858,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) DoublePointInformation_getFromBuffer((DoublePointInformation) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) DoublePointInformation_getFromBuffer((DoublePointInformation) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
 
         break;
@@ -523,13 +876,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) DoublePointWithCP24Time2a_getFromBuffer((DoublePointWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) DoublePointWithCP24Time2a_getFromBuffer((DoublePointWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -539,13 +893,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) StepPositionInformation_getFromBuffer((StepPositionInformation) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) StepPositionInformation_getFromBuffer((StepPositionInformation) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -555,13 +910,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) StepPositionWithCP24Time2a_getFromBuffer((StepPositionWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) StepPositionWithCP24Time2a_getFromBuffer((StepPositionWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -571,13 +927,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) BitString32_getFromBuffer((BitString32) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) BitString32_getFromBuffer((BitString32) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -587,13 +944,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) Bitstring32WithCP24Time2a_getFromBuffer((Bitstring32WithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) Bitstring32WithCP24Time2a_getFromBuffer((Bitstring32WithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -603,13 +961,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueNormalized_getFromBuffer((MeasuredValueNormalized) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueNormalized_getFromBuffer((MeasuredValueNormalized) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -619,13 +978,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueNormalizedWithCP24Time2a_getFromBuffer((MeasuredValueNormalizedWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueNormalizedWithCP24Time2a_getFromBuffer((MeasuredValueNormalizedWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -635,13 +995,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueScaled_getFromBuffer((MeasuredValueScaled) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueScaled_getFromBuffer((MeasuredValueScaled) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -651,13 +1012,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueScaledWithCP24Time2a_getFromBuffer((MeasuredValueScaledWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueScaledWithCP24Time2a_getFromBuffer((MeasuredValueScaledWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -668,13 +1030,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueShort_getFromBuffer((MeasuredValueShort) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueShort_getFromBuffer((MeasuredValueShort) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
 
         break;
@@ -685,13 +1048,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueShortWithCP24Time2a_getFromBuffer((MeasuredValueShortWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueShortWithCP24Time2a_getFromBuffer((MeasuredValueShortWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -701,13 +1065,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) IntegratedTotals_getFromBuffer((IntegratedTotals) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) IntegratedTotals_getFromBuffer((IntegratedTotals) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -717,13 +1082,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) IntegratedTotalsWithCP24Time2a_getFromBuffer((IntegratedTotalsWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) IntegratedTotalsWithCP24Time2a_getFromBuffer((IntegratedTotalsWithCP24Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -733,13 +1099,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) EventOfProtectionEquipment_getFromBuffer((EventOfProtectionEquipment) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) EventOfProtectionEquipment_getFromBuffer((EventOfProtectionEquipment) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -749,13 +1116,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) PackedStartEventsOfProtectionEquipment_getFromBuffer((PackedStartEventsOfProtectionEquipment) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) PackedStartEventsOfProtectionEquipment_getFromBuffer((PackedStartEventsOfProtectionEquipment) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -765,13 +1133,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) PackedOutputCircuitInfo_getFromBuffer((PackedOutputCircuitInfo) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) PackedOutputCircuitInfo_getFromBuffer((PackedOutputCircuitInfo) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -781,13 +1150,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) PackedSinglePointWithSCD_getFromBuffer((PackedSinglePointWithSCD) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) PackedSinglePointWithSCD_getFromBuffer((PackedSinglePointWithSCD) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -797,13 +1167,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueNormalizedWithoutQuality_getFromBuffer((MeasuredValueNormalizedWithoutQuality) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueNormalizedWithoutQuality_getFromBuffer((MeasuredValueNormalizedWithoutQuality) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -813,13 +1184,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) SinglePointWithCP56Time2a_getFromBuffer((SinglePointWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) SinglePointWithCP56Time2a_getFromBuffer((SinglePointWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -829,13 +1201,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) DoublePointWithCP56Time2a_getFromBuffer((DoublePointWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) DoublePointWithCP56Time2a_getFromBuffer((DoublePointWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -845,13 +1218,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) StepPositionWithCP56Time2a_getFromBuffer((StepPositionWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) StepPositionWithCP56Time2a_getFromBuffer((StepPositionWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -861,13 +1235,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) Bitstring32WithCP56Time2a_getFromBuffer((Bitstring32WithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) Bitstring32WithCP56Time2a_getFromBuffer((Bitstring32WithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -877,13 +1252,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueNormalizedWithCP56Time2a_getFromBuffer((MeasuredValueNormalizedWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueNormalizedWithCP56Time2a_getFromBuffer((MeasuredValueNormalizedWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -893,13 +1269,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueScaledWithCP56Time2a_getFromBuffer((MeasuredValueScaledWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueScaledWithCP56Time2a_getFromBuffer((MeasuredValueScaledWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -909,13 +1286,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) MeasuredValueShortWithCP56Time2a_getFromBuffer((MeasuredValueShortWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) MeasuredValueShortWithCP56Time2a_getFromBuffer((MeasuredValueShortWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -925,13 +1303,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) IntegratedTotalsWithCP56Time2a_getFromBuffer((IntegratedTotalsWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) IntegratedTotalsWithCP56Time2a_getFromBuffer((IntegratedTotalsWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -941,13 +1320,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) EventOfProtectionEquipmentWithCP56Time2a_getFromBuffer((EventOfProtectionEquipmentWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) EventOfProtectionEquipmentWithCP56Time2a_getFromBuffer((EventOfProtectionEquipmentWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -957,13 +1337,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getFromBuffer((PackedStartEventsOfProtectionEquipmentWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getFromBuffer((PackedStartEventsOfProtectionEquipmentWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -973,13 +1354,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer((PackedOutputCircuitInfoWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer((PackedOutputCircuitInfoWithCP56Time2a) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -987,7 +1369,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SC_NA_1: /* 45 */
 
-        elementSize = self->parameters->sizeOfIOA + 1;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 1;
 
         retVal = (InformationObject) SingleCommand_getFromBuffer((SingleCommand) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -996,7 +1378,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_DC_NA_1: /* 46 */
 
-        elementSize = self->parameters->sizeOfIOA + 1;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 1;
 
         retVal = (InformationObject) DoubleCommand_getFromBuffer((DoubleCommand) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1004,7 +1386,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_RC_NA_1: /* 47 */
 
-        elementSize = self->parameters->sizeOfIOA + 1;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 1;
 
         retVal = (InformationObject) StepCommand_getFromBuffer((StepCommand) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1012,7 +1394,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SE_NA_1: /* 48 - Set-point command, normalized value */
 
-        elementSize = self->parameters->sizeOfIOA + 3;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 3;
 
         retVal = (InformationObject) SetpointCommandNormalized_getFromBuffer((SetpointCommandNormalized) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1021,7 +1403,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SE_NB_1: /* 49 - Set-point command, scaled value */
 
-        elementSize = self->parameters->sizeOfIOA + 3;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 3;
 
         retVal = (InformationObject) SetpointCommandScaled_getFromBuffer((SetpointCommandScaled) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1029,7 +1411,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SE_NC_1: /* 50 - Set-point command, short floating point number */
 
-        elementSize = self->parameters->sizeOfIOA + 5;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 5;
 
         retVal = (InformationObject) SetpointCommandShort_getFromBuffer((SetpointCommandShort) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1037,7 +1419,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_BO_NA_1: /* 51 - Bitstring command */
 
-        elementSize = self->parameters->sizeOfIOA + 4;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 4;
 
         retVal = (InformationObject) Bitstring32Command_getFromBuffer((Bitstring32Command) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1047,7 +1429,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SC_TA_1: /* 58 - Single command with CP56Time2a */
 
-        elementSize = self->parameters->sizeOfIOA + 8;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 8;
 
         retVal = (InformationObject) SingleCommandWithCP56Time2a_getFromBuffer((SingleCommandWithCP56Time2a) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1055,7 +1437,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_DC_TA_1: /* 59 - Double command with CP56Time2a */
 
-        elementSize = self->parameters->sizeOfIOA + 8;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 8;
 
         retVal = (InformationObject) DoubleCommandWithCP56Time2a_getFromBuffer((DoubleCommandWithCP56Time2a) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1063,7 +1445,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_RC_TA_1: /* 60 - Step command with CP56Time2a */
 
-        elementSize = self->parameters->sizeOfIOA + 8;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 8;
 
         retVal = (InformationObject) StepCommandWithCP56Time2a_getFromBuffer((StepCommandWithCP56Time2a) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1071,7 +1453,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SE_TA_1: /* 61 - Setpoint command, normalized value with CP56Time2a */
 
-        elementSize = self->parameters->sizeOfIOA + 10;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 10;
 
         retVal = (InformationObject) SetpointCommandNormalizedWithCP56Time2a_getFromBuffer((SetpointCommandNormalizedWithCP56Time2a) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1079,7 +1461,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SE_TB_1: /* 62 - Setpoint command, scaled value with CP56Time2a */
 
-        elementSize = self->parameters->sizeOfIOA + 10;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 10;
 
         retVal = (InformationObject) SetpointCommandScaledWithCP56Time2a_getFromBuffer((SetpointCommandScaledWithCP56Time2a) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1087,7 +1469,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_SE_TC_1: /* 63 - Setpoint command, short value with CP56Time2a */
 
-        elementSize = self->parameters->sizeOfIOA + 12;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 12;
 
         retVal = (InformationObject) SetpointCommandShortWithCP56Time2a_getFromBuffer((SetpointCommandShortWithCP56Time2a) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1095,7 +1477,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case C_BO_TA_1: /* 64 - Bitstring command with CP56Time2a */
 
-        elementSize = self->parameters->sizeOfIOA + 11;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 11;
 
         retVal = (InformationObject) Bitstring32CommandWithCP56Time2a_getFromBuffer((Bitstring32CommandWithCP56Time2a) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1157,7 +1539,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case P_ME_NA_1: /* 110 - Parameter of measured values, normalized value */
 
-        elementSize = self->parameters->sizeOfIOA + 3;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 3;
 
         retVal = (InformationObject) ParameterNormalizedValue_getFromBuffer((ParameterNormalizedValue) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1165,7 +1547,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case P_ME_NB_1: /* 111 - Parameter of measured values, scaled value */
 
-        elementSize = self->parameters->sizeOfIOA + 3;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 3;
 
         retVal = (InformationObject) ParameterScaledValue_getFromBuffer((ParameterScaledValue) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1173,7 +1555,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case P_ME_NC_1: /* 112 - Parameter of measured values, short floating point number */
 
-        elementSize = self->parameters->sizeOfIOA + 5;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 5;
 
         retVal = (InformationObject) ParameterFloatValue_getFromBuffer((ParameterFloatValue) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1181,7 +1563,7 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
     case P_AC_NA_1: /* 113 - Parameter for activation */
 
-        elementSize = self->parameters->sizeOfIOA + 1;
+        elementSize = CS101_SIZE_OF_IOA(self->parameters) + 1;
 
         retVal = (InformationObject) ParameterActivation_getFromBuffer((ParameterActivation) io, self->parameters, self->payload, self->payloadSize,  index * elementSize);
 
@@ -1229,13 +1611,14 @@ CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index)
 
         if (CS101_ASDU_isSequence(self)) {
             retVal  = (InformationObject) FileDirectory_getFromBuffer((FileDirectory) io, self->parameters,
-                    self->payload, self->payloadSize, self->parameters->sizeOfIOA + (index * elementSize), true);
+                    self->payload, self->payloadSize, CS101_SIZE_OF_IOA(self->parameters) + (index * elementSize), true);
 
-            InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
+            if (retVal)
+                InformationObject_setObjectAddress(retVal, InformationObject_ParseObjectAddress(self->parameters, self->payload, 0) + index);
         }
         else
             retVal  = (InformationObject) FileDirectory_getFromBuffer((FileDirectory) io, self->parameters,
-                    self->payload, self->payloadSize, index * (self->parameters->sizeOfIOA + elementSize), false);
+                    self->payload, self->payloadSize, index * (CS101_SIZE_OF_IOA(self->parameters) + elementSize), false);
 
         break;
 
@@ -0,0 +1,439 @@
+/*
+ *  cs101_asdu_template.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cs101_asdu_template.h"
+#include "cs101_asdu_internal.h"
+#include "lib_memory.h"
+#include "lib60870_internal.h"
+#include "platform_endian.h"
+
+struct sCS101_ASDUTemplate {
+    sCS101_StaticASDU asdu;
+    struct sCS101_AppLayerParameters parameters;
+
+    TypeID typeId;
+    int numberOfElements;
+
+    int firstElementOffset; /* offset of the first information element (after the IOA) in the payload */
+    int elementStride; /* distance between two information elements */
+
+    int qualityOffset; /* offset of the quality descriptor in the element or -1 */
+    int timestampOffset; /* offset of the time tag in the element or -1 */
+    int timestampSize; /* 3 for CP24Time2a, 7 for CP56Time2a */
+};
+
+/* offset of the quality descriptor in the information element, -1 when not present or type not supported */
+static int
+getQualityOffset(TypeID typeId)
+{
+    switch (typeId) {
+
+    case M_SP_NA_1:
+    case M_SP_TA_1:
+    case M_SP_TB_1:
+    case M_DP_NA_1:
+    case M_DP_TA_1:
+    case M_DP_TB_1:
+        return 0;
+
+    case M_ST_NA_1:
+    case M_ST_TA_1:
+    case M_ST_TB_1:
+        return 1;
+
+    case M_ME_NA_1:
+    case M_ME_TA_1:
+    case M_ME_TD_1:
+    case M_ME_NB_1:
+    case M_ME_TB_1:
+    case M_ME_TE_1:
+        return 2;
+
+    case M_BO_NA_1:
+    case M_BO_TA_1:
+    case M_BO_TB_1:
+    case M_ME_NC_1:
+    case M_ME_TC_1:
+    case M_ME_TF_1:
+        return 4;
+
+    default:
+        return -1;
+    }
+}
+
+static bool
+isSupportedType(TypeID typeId)
+{
+    if (getQualityOffset(typeId) != -1)
+        return true;
+
+    switch (typeId) {
+
+    case M_IT_NA_1:
+    case M_IT_TA_1:
+    case M_IT_TB_1:
+    case M_ME_ND_1:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static int
+getTimestampSize(TypeID typeId)
+{
+    switch (typeId) {
+
+    case M_SP_TA_1:
+    case M_DP_TA_1:
+    case M_ST_TA_1:
+    case M_BO_TA_1:
+    case M_ME_TA_1:
+    case M_ME_TB_1:
+    case M_ME_TC_1:
+    case M_IT_TA_1:
+        return 3;
+
+    case M_SP_TB_1:
+    case M_DP_TB_1:
+    case M_ST_TB_1:
+    case M_BO_TB_1:
+    case M_ME_TD_1:
+    case M_ME_TE_1:
+    case M_ME_TF_1:
+    case M_IT_TB_1:
+        return 7;
+
+    default:
+        return 0;
+    }
+}
+
+CS101_ASDUTemplate
+CS101_ASDUTemplate_create(CS101_ASDU asdu)
+{
+    TypeID typeId = CS101_ASDU_getTypeID(asdu);
+    int numberOfElements = CS101_ASDU_getNumberOfElements(asdu);
+
+    if ((numberOfElements == 0) || (isSupportedType(typeId) == false)) {
+        DEBUG_PRINT("ASDU template: type %i not supported or empty ASDU\n", typeId);
+        return NULL;
+    }
+
+    int sizeOfIOA = CS101_SIZE_OF_IOA(asdu->parameters);
+    int elementSize = CS101_getInformationElementSize(typeId);
+
+    /* the first information element always follows an IOA */
+    int firstElementOffset = sizeOfIOA;
+    int elementStride;
+
+    if (CS101_ASDU_isSequence(asdu))
+        elementStride = elementSize;
+    else
+        elementStride = sizeOfIOA + elementSize;
+
+    if (CS101_ASDU_validate(asdu) == false) {
+        DEBUG_PRINT("ASDU template: invalid payload size\n");
+        return NULL;
+    }
+
+    CS101_ASDUTemplate self = (CS101_ASDUTemplate) GLOBAL_MALLOC(sizeof(struct sCS101_ASDUTemplate));
+
+    if (self) {
+        self->parameters = *(asdu->parameters);
+
+        memcpy(self->asdu.encodedData, asdu->asdu, asdu->asduHeaderLength + asdu->payloadSize);
+
+        self->asdu.parameters = &(self->parameters);
+        self->asdu.asdu = self->asdu.encodedData;
+        self->asdu.asduHeaderLength = asdu->asduHeaderLength;
+        self->asdu.payload = self->asdu.encodedData + asdu->asduHeaderLength;
+        self->asdu.payloadSize = asdu->payloadSize;
+        self->asdu.isValidated = true;
+
+        self->typeId = typeId;
+        self->numberOfElements = numberOfElements;
+        self->firstElementOffset = firstElementOffset;
+        self->elementStride = elementStride;
+        self->qualityOffset = getQualityOffset(typeId);
+        self->timestampSize = getTimestampSize(typeId);
+
+        if (self->timestampSize > 0)
+            self->timestampOffset = elementSize - self->timestampSize;
+        else
+            self->timestampOffset = -1;
+    }
+
+    return self;
+}
+
+void
+CS101_ASDUTemplate_destroy(CS101_ASDUTemplate self)
+{
+    GLOBAL_FREEMEM(self);
+}
+
+CS101_ASDU
+CS101_ASDUTemplate_getASDU(CS101_ASDUTemplate self)
+{
+    return (CS101_ASDU) &(self->asdu);
+}
+
+TypeID
+CS101_ASDUTemplate_getTypeID(CS101_ASDUTemplate self)
+{
+    return self->typeId;
+}
+
+int
+CS101_ASDUTemplate_getNumberOfElements(CS101_ASDUTemplate self)
+{
+    return self->numberOfElements;
+}
+
+static uint8_t*
+getElement(CS101_ASDUTemplate self, int index)
+{
+    if ((index < 0) || (index >= self->numberOfElements))
+        return NULL;
+
+    return self->asdu.payload + self->firstElementOffset + (index * self->elementStride);
+}
+
+bool
+CS101_ASDUTemplate_setQuality(CS101_ASDUTemplate self, int index, QualityDescriptor quality)
+{
+    uint8_t* element = getElement(self, index);
+
+    if ((element == NULL) || (self->qualityOffset == -1))
+        return false;
+
+    if (self->qualityOffset == 0) {
+        /* SIQ/DIQ: value is stored in the lower bits */
+        element[0] = (uint8_t) ((element[0] & 0x03) | (quality & 0xf0));
+    }
+    else {
+        element[self->qualityOffset] = (uint8_t) quality;
+    }
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setTimestamp(CS101_ASDUTemplate self, int index, const CP56Time2a timestamp)
+{
+    uint8_t* element = getElement(self, index);
+
+    if ((element == NULL) || (self->timestampOffset == -1))
+        return false;
+
+    memcpy(element + self->timestampOffset, timestamp->encodedValue, self->timestampSize);
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setSinglePoint(CS101_ASDUTemplate self, int index, bool value, QualityDescriptor quality)
+{
+    if ((self->typeId != M_SP_NA_1) && (self->typeId != M_SP_TA_1) && (self->typeId != M_SP_TB_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    element[0] = (uint8_t) ((quality & 0xf0) | (value ? 1 : 0));
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setDoublePoint(CS101_ASDUTemplate self, int index, DoublePointValue value, QualityDescriptor quality)
+{
+    if ((self->typeId != M_DP_NA_1) && (self->typeId != M_DP_TA_1) && (self->typeId != M_DP_TB_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    element[0] = (uint8_t) ((quality & 0xf0) | (value & 0x03));
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setStepPosition(CS101_ASDUTemplate self, int index, int value, bool isTransient, QualityDescriptor quality)
+{
+    if ((self->typeId != M_ST_NA_1) && (self->typeId != M_ST_TA_1) && (self->typeId != M_ST_TB_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    if (value > 63)
+        value = 63;
+    else if (value < -64)
+        value = -64;
+
+    if (value < 0)
+        value = value + 128;
+
+    element[0] = (uint8_t) value;
+
+    if (isTransient)
+        element[0] |= 0x80;
+
+    element[1] = (uint8_t) quality;
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setBitstring32(CS101_ASDUTemplate self, int index, uint32_t value, QualityDescriptor quality)
+{
+    if ((self->typeId != M_BO_NA_1) && (self->typeId != M_BO_TA_1) && (self->typeId != M_BO_TB_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    element[0] = (uint8_t) (value % 0x100);
+    element[1] = (uint8_t) ((value / 0x100) % 0x100);
+    element[2] = (uint8_t) ((value / 0x10000) % 0x100);
+    element[3] = (uint8_t) (value / 0x1000000);
+    element[4] = (uint8_t) quality;
+
+    return true;
+}
+
+static void
+setScaledValue(uint8_t* encodedValue, int value)
+{
+    int valueToEncode;
+
+    if (value < 0)
+        valueToEncode = value + 65536;
+    else
+        valueToEncode = value;
+
+    encodedValue[0] = (uint8_t) (valueToEncode % 256);
+    encodedValue[1] = (uint8_t) (valueToEncode / 256);
+}
+
+bool
+CS101_ASDUTemplate_setNormalizedValue(CS101_ASDUTemplate self, int index, float value, QualityDescriptor quality)
+{
+    if ((self->typeId != M_ME_NA_1) && (self->typeId != M_ME_TA_1) && (self->typeId != M_ME_TD_1) && (self->typeId != M_ME_ND_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    if (value > 1.0f)
+        value = 1.0f;
+    else if (value < -1.0f)
+        value = -1.0f;
+
+    setScaledValue(element, (int) (value * 32767.f));
+
+    if (self->typeId != M_ME_ND_1)
+        element[2] = (uint8_t) quality;
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setScaledValue(CS101_ASDUTemplate self, int index, int value, QualityDescriptor quality)
+{
+    if ((self->typeId != M_ME_NB_1) && (self->typeId != M_ME_TB_1) && (self->typeId != M_ME_TE_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    setScaledValue(element, value);
+
+    element[2] = (uint8_t) quality;
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setShortValue(CS101_ASDUTemplate self, int index, float value, QualityDescriptor quality)
+{
+    if ((self->typeId != M_ME_NC_1) && (self->typeId != M_ME_TC_1) && (self->typeId != M_ME_TF_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    uint8_t* valueBytes = (uint8_t*) &value;
+
+#if (ORDER_LITTLE_ENDIAN == 1)
+    memcpy(element, valueBytes, 4);
+#else
+    element[0] = valueBytes[3];
+    element[1] = valueBytes[2];
+    element[2] = valueBytes[1];
+    element[3] = valueBytes[0];
+#endif
+
+    element[4] = (uint8_t) quality;
+
+    return true;
+}
+
+bool
+CS101_ASDUTemplate_setIntegratedTotals(CS101_ASDUTemplate self, int index, const BinaryCounterReading value)
+{
+    if ((self->typeId != M_IT_NA_1) && (self->typeId != M_IT_TA_1) && (self->typeId != M_IT_TB_1))
+        return false;
+
+    uint8_t* element = getElement(self, index);
+
+    if (element == NULL)
+        return false;
+
+    memcpy(element, value->encodedValue, 5);
+
+    return true;
+}
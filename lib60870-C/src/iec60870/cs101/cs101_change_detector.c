@@ -0,0 +1,475 @@
+/*
+ *  cs101_change_detector.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cs101_change_detector.h"
+#include "cs101_process_image_internal.h"
+#include "cs101_asdu_internal.h"
+#include "information_objects_internal.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_internal.h"
+
+/* maximum number of event ASDUs (different type ID or CA) that are filled at the same time */
+#define MAX_OPEN_ASDUS 8
+
+/* flags of a point */
+#define POINT_HAS_REFERENCE 0x01 /* a sample has been processed - reported value and quality are valid */
+
+typedef struct {
+    TypeID typeId;
+    int ca;
+    sCS101_StaticASDU asdu;
+} OpenASDU;
+
+struct sCS101_ChangeDetector {
+    CS101_ProcessImage processImage;
+    CS101_AppLayerParameters parameters;
+    int oa;
+
+    CS101_ChangeDetector_EventHandler eventHandler;
+    void* eventHandlerParameter;
+
+    /* point state (structure of arrays, indexed by point index) */
+    float* reportedValue;
+    float* deadband;
+    float* integral;
+    uint64_t* lastSampleTime;
+    uint8_t* reportedQuality;
+    uint8_t* deadbandType;
+    uint8_t* eventTypeId; /* 0 = use type of the point */
+    uint8_t* flags;
+
+    OpenASDU openAsdus[MAX_OPEN_ASDUS];
+    int numberOfOpenAsdus;
+};
+
+CS101_ChangeDetector
+CS101_ChangeDetector_create(CS101_ProcessImage processImage, CS101_AppLayerParameters parameters)
+{
+    CS101_ChangeDetector self = (CS101_ChangeDetector) GLOBAL_CALLOC(1, sizeof(struct sCS101_ChangeDetector));
+
+    if (self) {
+        int maxNumberOfPoints = CS101_ProcessImage_getMaxNumberOfPoints(processImage);
+
+        self->processImage = processImage;
+        self->parameters = parameters;
+        self->oa = 0;
+        self->eventHandler = NULL;
+        self->eventHandlerParameter = NULL;
+        self->numberOfOpenAsdus = 0;
+
+        self->reportedValue = (float*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(float));
+        self->deadband = (float*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(float));
+        self->integral = (float*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(float));
+        self->lastSampleTime = (uint64_t*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(uint64_t));
+        self->reportedQuality = (uint8_t*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(uint8_t));
+        self->deadbandType = (uint8_t*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(uint8_t));
+        self->eventTypeId = (uint8_t*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(uint8_t));
+        self->flags = (uint8_t*) GLOBAL_CALLOC(maxNumberOfPoints, sizeof(uint8_t));
+
+        if ((self->reportedValue == NULL) || (self->deadband == NULL) || (self->integral == NULL) ||
+                (self->lastSampleTime == NULL) || (self->reportedQuality == NULL) || (self->deadbandType == NULL) ||
+                (self->eventTypeId == NULL) || (self->flags == NULL))
+        {
+            CS101_ChangeDetector_destroy(self);
+            return NULL;
+        }
+    }
+
+    return self;
+}
+
+void
+CS101_ChangeDetector_destroy(CS101_ChangeDetector self)
+{
+    if (self) {
+        GLOBAL_FREEMEM(self->reportedValue);
+        GLOBAL_FREEMEM(self->deadband);
+        GLOBAL_FREEMEM(self->integral);
+        GLOBAL_FREEMEM(self->lastSampleTime);
+        GLOBAL_FREEMEM(self->reportedQuality);
+        GLOBAL_FREEMEM(self->deadbandType);
+        GLOBAL_FREEMEM(self->eventTypeId);
+        GLOBAL_FREEMEM(self->flags);
+
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+void
+CS101_ChangeDetector_setEventHandler(CS101_ChangeDetector self, CS101_ChangeDetector_EventHandler handler, void* parameter)
+{
+    self->eventHandler = handler;
+    self->eventHandlerParameter = parameter;
+}
+
+void
+CS101_ChangeDetector_setOriginatorAddress(CS101_ChangeDetector self, int oa)
+{
+    self->oa = oa;
+}
+
+static bool
+isValidIndex(CS101_ChangeDetector self, int index)
+{
+    return ((index >= 0) && (index < CS101_ProcessImage_getNumberOfPoints(self->processImage)));
+}
+
+bool
+CS101_ChangeDetector_setEventType(CS101_ChangeDetector self, int index, TypeID typeId)
+{
+    if (CS101_ProcessImage_isCompatibleType(self->processImage, index, typeId) == false)
+        return false;
+
+    self->eventTypeId[index] = (uint8_t) typeId;
+
+    return true;
+}
+
+bool
+CS101_ChangeDetector_setDeadband(CS101_ChangeDetector self, int index, CS101_DeadbandType type, float deadband)
+{
+    if (isValidIndex(self, index) == false)
+        return false;
+
+    self->deadbandType[index] = (uint8_t) type;
+    self->deadband[index] = deadband;
+    self->integral[index] = 0.f;
+
+    return true;
+}
+
+bool
+CS101_ChangeDetector_setPercentDeadband(CS101_ChangeDetector self, int index, float percent, float rangeMin, float rangeMax)
+{
+    return CS101_ChangeDetector_setDeadband(self, index, CS101_DEADBAND_ABSOLUTE, (rangeMax - rangeMin) * percent / 100.f);
+}
+
+static void
+flushOpenASDUs(CS101_ChangeDetector self)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfOpenAsdus; i++) {
+        if (self->eventHandler)
+            self->eventHandler(self->eventHandlerParameter, (CS101_ASDU) &(self->openAsdus[i].asdu));
+    }
+
+    self->numberOfOpenAsdus = 0;
+}
+
+static CS101_ASDU
+openNewASDU(CS101_ChangeDetector self, OpenASDU* openAsdu, TypeID typeId, int ca)
+{
+    openAsdu->typeId = typeId;
+    openAsdu->ca = ca;
+
+    return CS101_ASDU_initializeStatic(&(openAsdu->asdu), self->parameters, false, CS101_COT_SPONTANEOUS,
+            self->oa, ca, false, false);
+}
+
+/* add the current state of the point to the event ASDU with matching type ID and CA */
+static void
+addEvent(CS101_ChangeDetector self, int index)
+{
+    TypeID typeId = (TypeID) self->eventTypeId[index];
+
+    if (typeId == 0)
+        typeId = CS101_ProcessImage_getTypeID(self->processImage, index);
+
+    int ca = CS101_ProcessImage_getCA(self->processImage, index);
+
+    union uInformationObject ioBuffer;
+
+    InformationObject io = CS101_ProcessImage_getInformationObjectOfType(self->processImage, index, typeId, (InformationObject) &ioBuffer);
+
+    if (io == NULL)
+        return;
+
+    int i;
+
+    for (i = 0; i < self->numberOfOpenAsdus; i++) {
+        OpenASDU* openAsdu = &(self->openAsdus[i]);
+
+        if ((openAsdu->typeId == typeId) && (openAsdu->ca == ca)) {
+
+            CS101_ASDU asdu = (CS101_ASDU) &(openAsdu->asdu);
+
+            if (CS101_ASDU_addInformationObject(asdu, io))
+                return;
+
+            /* ASDU is full -> send and reuse */
+            if (self->eventHandler)
+                self->eventHandler(self->eventHandlerParameter, asdu);
+
+            asdu = openNewASDU(self, openAsdu, typeId, ca);
+
+            CS101_ASDU_addInformationObject(asdu, io);
+
+            return;
+        }
+    }
+
+    if (self->numberOfOpenAsdus == MAX_OPEN_ASDUS)
+        flushOpenASDUs(self);
+
+    CS101_ASDU asdu = openNewASDU(self, &(self->openAsdus[self->numberOfOpenAsdus]), typeId, ca);
+
+    self->numberOfOpenAsdus++;
+
+    CS101_ASDU_addInformationObject(asdu, io);
+}
+
+static float
+absValue(float value)
+{
+    return (value < 0.f) ? -value : value;
+}
+
+/* check if the new sample of a measured value has to be reported and update the reference values */
+static bool
+checkMeasuredValue(CS101_ChangeDetector self, int index, float value, uint8_t quality, uint64_t timestamp)
+{
+    bool report;
+
+    if ((self->flags[index] & POINT_HAS_REFERENCE) == 0) {
+        /* first sample is the reference value */
+        self->flags[index] |= POINT_HAS_REFERENCE;
+        report = false;
+    }
+    else if (quality != self->reportedQuality[index]) {
+        report = true;
+    }
+    else {
+        float deviation = value - self->reportedValue[index];
+
+        switch (self->deadbandType[index]) {
+
+        case CS101_DEADBAND_ABSOLUTE:
+            report = (absValue(deviation) > self->deadband[index]);
+            break;
+
+        case CS101_DEADBAND_INTEGRATED:
+            if (timestamp > self->lastSampleTime[index])
+                self->integral[index] += deviation * ((float) (timestamp - self->lastSampleTime[index]) / 1000.f);
+
+            report = (absValue(self->integral[index]) > self->deadband[index]);
+            break;
+
+        default:
+            report = (deviation != 0.f);
+            break;
+        }
+
+        if (report == false) {
+            self->lastSampleTime[index] = timestamp;
+            return false;
+        }
+    }
+
+    self->reportedValue[index] = value;
+    self->reportedQuality[index] = quality;
+    self->integral[index] = 0.f;
+    self->lastSampleTime[index] = timestamp;
+
+    return report;
+}
+
+/* check if the new sample of a status point has to be reported and update the reference values */
+static bool
+checkStatus(CS101_ChangeDetector self, int index, int value, uint8_t quality)
+{
+    bool report;
+
+    if ((self->flags[index] & POINT_HAS_REFERENCE) == 0) {
+        self->flags[index] |= POINT_HAS_REFERENCE;
+        report = false;
+    }
+    else {
+        report = ((value != (int) self->reportedValue[index]) || (quality != self->reportedQuality[index]));
+    }
+
+    self->reportedValue[index] = (float) value;
+    self->reportedQuality[index] = quality;
+
+    return report;
+}
+
+static uint64_t
+getSampleTime(uint64_t timestamp)
+{
+    /* get the time only once per scan cycle */
+    if (timestamp == 0)
+        return Hal_getTimeInMs();
+    else
+        return timestamp;
+}
+
+int
+CS101_ChangeDetector_updateFloatValues(CS101_ChangeDetector self, const int* indices, const float* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp)
+{
+    int events = 0;
+    int i;
+
+    timestamp = getSampleTime(timestamp);
+
+    for (i = 0; i < count; i++) {
+        int index = indices[i];
+        uint8_t quality = qualities ? (uint8_t) qualities[i] : IEC60870_QUALITY_GOOD;
+
+        if (CS101_ProcessImage_updateFloatValue(self->processImage, index, values[i], quality, timestamp) == false)
+            continue;
+
+        if (checkMeasuredValue(self, index, values[i], quality, timestamp)) {
+            addEvent(self, index);
+            events++;
+        }
+    }
+
+    flushOpenASDUs(self);
+
+    return events;
+}
+
+int
+CS101_ChangeDetector_updateScaledValues(CS101_ChangeDetector self, const int* indices, const int* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp)
+{
+    int events = 0;
+    int i;
+
+    timestamp = getSampleTime(timestamp);
+
+    for (i = 0; i < count; i++) {
+        int index = indices[i];
+        uint8_t quality = qualities ? (uint8_t) qualities[i] : IEC60870_QUALITY_GOOD;
+
+        if (CS101_ProcessImage_updateScaledValue(self->processImage, index, values[i], quality, timestamp) == false)
+            continue;
+
+        if (checkMeasuredValue(self, index, (float) values[i], quality, timestamp)) {
+            addEvent(self, index);
+            events++;
+        }
+    }
+
+    flushOpenASDUs(self);
+
+    return events;
+}
+
+int
+CS101_ChangeDetector_updateSinglePoints(CS101_ChangeDetector self, const int* indices, const bool* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp)
+{
+    int events = 0;
+    int i;
+
+    timestamp = getSampleTime(timestamp);
+
+    for (i = 0; i < count; i++) {
+        int index = indices[i];
+        uint8_t quality = qualities ? (uint8_t) qualities[i] : IEC60870_QUALITY_GOOD;
+
+        if (CS101_ProcessImage_updateSinglePoint(self->processImage, index, values[i], quality, timestamp) == false)
+            continue;
+
+        if (checkStatus(self, index, values[i] ? 1 : 0, quality)) {
+            addEvent(self, index);
+            events++;
+        }
+    }
+
+    flushOpenASDUs(self);
+
+    return events;
+}
+
+int
+CS101_ChangeDetector_updateDoublePoints(CS101_ChangeDetector self, const int* indices, const DoublePointValue* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp)
+{
+    int events = 0;
+    int i;
+
+    timestamp = getSampleTime(timestamp);
+
+    for (i = 0; i < count; i++) {
+        int index = indices[i];
+        uint8_t quality = qualities ? (uint8_t) qualities[i] : IEC60870_QUALITY_GOOD;
+
+        if (CS101_ProcessImage_updateDoublePoint(self->processImage, index, values[i], quality, timestamp) == false)
+            continue;
+
+        if (checkStatus(self, index, (int) values[i], quality)) {
+            addEvent(self, index);
+            events++;
+        }
+    }
+
+    flushOpenASDUs(self);
+
+    return events;
+}
+
+/* called by the process image for each point with changed quality */
+static void
+qualityChangedHandler(void* parameter, int index)
+{
+    CS101_ChangeDetector self = (CS101_ChangeDetector) parameter;
+
+    self->reportedQuality[index] = (uint8_t) CS101_ProcessImage_getQuality(self->processImage, index);
+
+    addEvent(self, index);
+}
+
+int
+CS101_ChangeDetector_setQualityFlags(CS101_ChangeDetector self, int ca, int firstIoa, int lastIoa, QualityDescriptor flags,
+        bool set, uint64_t timestamp)
+{
+    int events = CS101_ProcessImage_modifyQualityFlags(self->processImage, ca, firstIoa, lastIoa, -1, (uint8_t) flags, set,
+            getSampleTime(timestamp), qualityChangedHandler, self);
+
+    flushOpenASDUs(self);
+
+    return events;
+}
+
+int
+CS101_ChangeDetector_setQualityFlagsOfGroup(CS101_ChangeDetector self, int ca, int group, QualityDescriptor flags,
+        bool set, uint64_t timestamp)
+{
+    if ((group < 0) || (group > CS101_PROCESS_IMAGE_MAX_GROUP))
+        return 0;
+
+    int events = CS101_ProcessImage_modifyQualityFlags(self->processImage, ca, 0, 0xffffff, group, (uint8_t) flags, set,
+            getSampleTime(timestamp), qualityChangedHandler, self);
+
+    flushOpenASDUs(self);
+
+    return events;
+}
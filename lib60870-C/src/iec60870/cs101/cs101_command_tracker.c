@@ -0,0 +1,479 @@
+/*
+ *  cs101_command_tracker.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cs101_command_tracker.h"
+#include "cs101_asdu_internal.h"
+#include "information_objects_internal.h"
+#include "timer_wheel.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* number of slots of the timer wheel - one revolution is ~25 s with the tick interval of the tracker */
+#define TIMER_WHEEL_SLOTS 512
+
+#define NO_COMMAND -1
+
+typedef struct {
+    struct sTimerWheelEntry timer; /* has to be the first element */
+
+    uint64_t key;
+    bool waitForTermination;
+
+    CS101_CommandHandler handler;
+    void* parameter;
+
+    int nextFree;
+} TrackedCommand;
+
+/* completed command (the handler is called after the lock is released) */
+typedef struct {
+    uint64_t key;
+    CS101_CommandHandler handler;
+    void* parameter;
+} CompletedCommand;
+
+struct sCS101_CommandTracker {
+    TrackedCommand* commands;
+    int maxCommands;
+    int numberOfCommands;
+    int firstFree;
+
+    /* open addressing hash table (linear probing) with the indices of the commands */
+    int32_t* table;
+    uint32_t tableMask;
+
+    TimerWheel timerWheel;
+
+    /* expired or canceled commands (one entry for each command) - owned by the thread that holds the dispatch lock */
+    CompletedCommand* expired;
+    int numberOfExpired;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore lock;
+    Semaphore dispatchLock; /* serializes checkTimeouts and cancelAll while the handlers are called */
+#endif
+};
+
+static uint64_t
+createKey(TypeID typeId, int ca, int ioa)
+{
+    return ((uint64_t) (typeId & 0xff) << 40) | ((uint64_t) (ca & 0xffff) << 24) | (uint64_t) (ioa & 0xffffff);
+}
+
+static void
+callHandler(CompletedCommand* command, CS101_CommandEvent event, CS101_ASDU asdu)
+{
+    if (command->handler) {
+        command->handler(command->parameter, (TypeID) ((command->key >> 40) & 0xff), (int) ((command->key >> 24) & 0xffff),
+                (int) (command->key & 0xffffff), event, asdu);
+    }
+}
+
+static uint32_t
+getSlot(CS101_CommandTracker self, uint64_t key)
+{
+    return (uint32_t) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & self->tableMask;
+}
+
+static int
+lookup(CS101_CommandTracker self, uint64_t key)
+{
+    uint32_t slot = getSlot(self, key);
+
+    while (self->table[slot] != NO_COMMAND) {
+        if (self->commands[self->table[slot]].key == key)
+            return (int) slot;
+
+        slot = (slot + 1) & self->tableMask;
+    }
+
+    return -1;
+}
+
+static void
+removeFromTable(CS101_CommandTracker self, uint32_t slot)
+{
+    uint32_t next = (slot + 1) & self->tableMask;
+
+    /* move the following entries of the probe sequence back (no tombstones required) */
+    while (self->table[next] != NO_COMMAND) {
+        uint32_t home = getSlot(self, self->commands[self->table[next]].key);
+
+        if (((next - home) & self->tableMask) >= ((next - slot) & self->tableMask)) {
+            self->table[slot] = self->table[next];
+            slot = next;
+        }
+
+        next = (next + 1) & self->tableMask;
+    }
+
+    self->table[slot] = NO_COMMAND;
+}
+
+static void
+releaseCommand(CS101_CommandTracker self, uint32_t slot)
+{
+    int index = self->table[slot];
+    TrackedCommand* command = &(self->commands[index]);
+
+    TimerWheel_cancel(self->timerWheel, &(command->timer));
+
+    removeFromTable(self, slot);
+
+    command->handler = NULL;
+    command->nextFree = self->firstFree;
+    self->firstFree = index;
+
+    self->numberOfCommands--;
+}
+
+CS101_CommandTracker
+CS101_CommandTracker_create(int maxCommands)
+{
+    CS101_CommandTracker self = (CS101_CommandTracker) GLOBAL_CALLOC(1, sizeof(struct sCS101_CommandTracker));
+
+    if (self) {
+        uint32_t tableSize = 16;
+        int i;
+
+        if (maxCommands < 1)
+            maxCommands = 1;
+
+        while (tableSize < (uint32_t) (maxCommands * 2))
+            tableSize <<= 1;
+
+        self->maxCommands = maxCommands;
+        self->tableMask = tableSize - 1;
+
+        self->commands = (TrackedCommand*) GLOBAL_CALLOC(maxCommands, sizeof(TrackedCommand));
+        self->expired = (CompletedCommand*) GLOBAL_CALLOC(maxCommands, sizeof(CompletedCommand));
+        self->table = (int32_t*) GLOBAL_MALLOC(tableSize * sizeof(int32_t));
+        self->timerWheel = TimerWheel_create(TIMER_WHEEL_SLOTS, CS101_COMMAND_TRACKER_TICK_INTERVAL, Hal_getMonotonicTimeInMs());
+
+        if ((self->commands == NULL) || (self->expired == NULL) || (self->table == NULL) || (self->timerWheel == NULL)) {
+            CS101_CommandTracker_destroy(self);
+            return NULL;
+        }
+
+        for (i = 0; i < (int) tableSize; i++)
+            self->table[i] = NO_COMMAND;
+
+        for (i = 0; i < maxCommands; i++) {
+            TimerWheelEntry_initialize(&(self->commands[i].timer));
+            self->commands[i].nextFree = i + 1;
+        }
+
+        self->commands[maxCommands - 1].nextFree = NO_COMMAND;
+        self->firstFree = 0;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Semaphore_create(1);
+        self->dispatchLock = Semaphore_create(1);
+#endif
+    }
+
+    return self;
+}
+
+void
+CS101_CommandTracker_destroy(CS101_CommandTracker self)
+{
+    if (self) {
+        if (self->timerWheel)
+            TimerWheel_destroy(self->timerWheel);
+
+        GLOBAL_FREEMEM(self->table);
+        GLOBAL_FREEMEM(self->expired);
+        GLOBAL_FREEMEM(self->commands);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        if (self->lock)
+            Semaphore_destroy(self->lock);
+
+        if (self->dispatchLock)
+            Semaphore_destroy(self->dispatchLock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+bool
+CS101_CommandTracker_add(CS101_CommandTracker self, TypeID typeId, int ca, int ioa, bool waitForTermination,
+        int timeoutInMs, CS101_CommandHandler handler, void* parameter)
+{
+    bool added = false;
+    uint64_t key = createKey(typeId, ca, ioa);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    if ((self->firstFree != NO_COMMAND) && (lookup(self, key) == -1)) {
+        int index = self->firstFree;
+        TrackedCommand* command = &(self->commands[index]);
+        uint32_t slot = getSlot(self, key);
+
+        self->firstFree = command->nextFree;
+
+        command->key = key;
+        command->waitForTermination = waitForTermination;
+        command->handler = handler;
+        command->parameter = parameter;
+
+        while (self->table[slot] != NO_COMMAND)
+            slot = (slot + 1) & self->tableMask;
+
+        self->table[slot] = index;
+
+        if (timeoutInMs > 0)
+            TimerWheel_schedule(self->timerWheel, &(command->timer), Hal_getMonotonicTimeInMs() + (uint64_t) timeoutInMs);
+
+        self->numberOfCommands++;
+
+        added = true;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return added;
+}
+
+bool
+CS101_CommandTracker_remove(CS101_CommandTracker self, TypeID typeId, int ca, int ioa)
+{
+    bool removed = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    int slot = lookup(self, createKey(typeId, ca, ioa));
+
+    if (slot != -1) {
+        releaseCommand(self, (uint32_t) slot);
+        removed = true;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return removed;
+}
+
+bool
+CS101_CommandTracker_handleASDU(CS101_CommandTracker self, CS101_ASDU asdu)
+{
+    CS101_CommandEvent event;
+    bool isFinal = true;
+    int ioa = 0;
+
+    switch (CS101_ASDU_getCOT(asdu))
+    {
+    case CS101_COT_ACTIVATION_CON:
+    case CS101_COT_DEACTIVATION_CON:
+        event = CS101_ASDU_isNegative(asdu) ? CS101_COMMAND_EVENT_NEGATIVE : CS101_COMMAND_EVENT_CONFIRMED;
+        break;
+
+    case CS101_COT_ACTIVATION_TERMINATION:
+        event = CS101_COMMAND_EVENT_TERMINATED;
+        break;
+
+    case CS101_COT_UNKNOWN_TYPE_ID:
+    case CS101_COT_UNKNOWN_COT:
+    case CS101_COT_UNKNOWN_CA:
+    case CS101_COT_UNKNOWN_IOA:
+        event = CS101_COMMAND_EVENT_REJECTED;
+        break;
+
+    default:
+        return false;
+    }
+
+    /* the IOA of the first information object (commands are always single object ASDUs) */
+    if (asdu->payloadSize >= CS101_SIZE_OF_IOA(asdu->parameters))
+        ioa = InformationObject_ParseObjectAddress(asdu->parameters, asdu->payload, 0);
+
+    CompletedCommand completed;
+    bool matched = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    int slot = lookup(self, createKey(CS101_ASDU_getTypeID(asdu), CS101_ASDU_getCA(asdu), ioa));
+
+    if (slot != -1) {
+        TrackedCommand* command = &(self->commands[self->table[slot]]);
+
+        completed.key = command->key;
+        completed.handler = command->handler;
+        completed.parameter = command->parameter;
+
+        if ((event == CS101_COMMAND_EVENT_CONFIRMED) && command->waitForTermination)
+            isFinal = false;
+
+        if (isFinal)
+            releaseCommand(self, (uint32_t) slot);
+
+        matched = true;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    if (matched)
+        callHandler(&completed, event, asdu);
+
+    return matched;
+}
+
+static void
+handleExpiredCommand(void* parameter, TimerWheelEntry entry, uint64_t currentTime)
+{
+    CS101_CommandTracker self = (CS101_CommandTracker) parameter;
+    TrackedCommand* command = (TrackedCommand*) entry;
+
+    (void) currentTime;
+
+    CompletedCommand* expired = &(self->expired[self->numberOfExpired++]);
+
+    expired->key = command->key;
+    expired->handler = command->handler;
+    expired->parameter = command->parameter;
+}
+
+int
+CS101_CommandTracker_checkTimeouts(CS101_CommandTracker self)
+{
+    int numberOfExpired;
+    int i;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->dispatchLock);
+    Semaphore_wait(self->lock);
+#endif
+
+    self->numberOfExpired = 0;
+
+    TimerWheel_advance(self->timerWheel, Hal_getMonotonicTimeInMs(), handleExpiredCommand, self);
+
+    for (i = 0; i < self->numberOfExpired; i++) {
+        int slot = lookup(self, self->expired[i].key);
+
+        if (slot != -1)
+            releaseCommand(self, (uint32_t) slot);
+    }
+
+    numberOfExpired = self->numberOfExpired;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    /* the handlers are called without lock - the expired commands are protected by the dispatch lock */
+    for (i = 0; i < numberOfExpired; i++)
+        callHandler(&(self->expired[i]), CS101_COMMAND_EVENT_TIMEOUT, NULL);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->dispatchLock);
+#endif
+
+    return numberOfExpired;
+}
+
+void
+CS101_CommandTracker_cancelAll(CS101_CommandTracker self)
+{
+    int numberOfCanceled = 0;
+    int i;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->dispatchLock);
+    Semaphore_wait(self->lock);
+#endif
+
+    if (self->numberOfCommands > 0) {
+        for (i = 0; i <= (int) self->tableMask; i++) {
+            if (self->table[i] != NO_COMMAND) {
+                TrackedCommand* command = &(self->commands[self->table[i]]);
+
+                /* each command has one entry in the array of expired commands */
+                self->expired[numberOfCanceled].key = command->key;
+                self->expired[numberOfCanceled].handler = command->handler;
+                self->expired[numberOfCanceled].parameter = command->parameter;
+                numberOfCanceled++;
+
+                TimerWheel_cancel(self->timerWheel, &(command->timer));
+                command->handler = NULL;
+                self->table[i] = NO_COMMAND;
+            }
+        }
+
+        for (i = 0; i < self->maxCommands; i++)
+            self->commands[i].nextFree = i + 1;
+
+        self->commands[self->maxCommands - 1].nextFree = NO_COMMAND;
+        self->firstFree = 0;
+        self->numberOfCommands = 0;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    for (i = 0; i < numberOfCanceled; i++)
+        callHandler(&(self->expired[i]), CS101_COMMAND_EVENT_CANCELED, NULL);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->dispatchLock);
+#endif
+}
+
+int
+CS101_CommandTracker_getNumberOfCommands(CS101_CommandTracker self)
+{
+    int numberOfCommands;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    numberOfCommands = self->numberOfCommands;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return numberOfCommands;
+}
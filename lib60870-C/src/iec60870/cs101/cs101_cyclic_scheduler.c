@@ -0,0 +1,567 @@
+/*
+ *  cs101_cyclic_scheduler.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cs101_cyclic_scheduler.h"
+#include "cs101_asdu_template.h"
+#include "cs101_process_image.h"
+#include "cs101_process_image_internal.h"
+#include "timer_wheel.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* number of slots of the timer wheel - one revolution is ~10 s with the default tick interval */
+#define TIMER_WHEEL_SLOTS 1024
+
+typedef struct {
+    struct sTimerWheelEntry timer; /* has to be the first element */
+
+    int groupId;
+    bool isUsed;
+
+    int cycleTime;
+    uint64_t dueTime;
+
+    int* pointIndices;
+    int numberOfPoints;
+
+    CS101_ASDUTemplate* templates;
+    int numberOfTemplates;
+
+    uint32_t overruns;
+} CyclicGroup;
+
+struct sCS101_CyclicScheduler {
+    CS101_ProcessImage processImage;
+    CS101_AppLayerParameters parameters;
+    int oa;
+
+    CyclicGroup* groups;
+    int maxNumberOfGroups;
+
+    TimerWheel timerWheel;
+
+    CS101_CyclicScheduler_ASDUHandler asduHandler;
+    void* asduHandlerParameter;
+
+    CS101_CyclicScheduler_OverrunHandler overrunHandler;
+    void* overrunHandlerParameter;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore lock;
+#endif
+
+#if (CONFIG_USE_THREADS == 1)
+    Thread thread;
+    bool isRunning;
+#endif
+};
+
+CS101_CyclicScheduler
+CS101_CyclicScheduler_create(CS101_ProcessImage processImage, CS101_AppLayerParameters parameters, int maxNumberOfGroups)
+{
+    CS101_CyclicScheduler self = (CS101_CyclicScheduler) GLOBAL_CALLOC(1, sizeof(struct sCS101_CyclicScheduler));
+
+    if (self) {
+        self->processImage = processImage;
+        self->parameters = parameters;
+        self->maxNumberOfGroups = maxNumberOfGroups;
+
+        self->groups = (CyclicGroup*) GLOBAL_CALLOC(maxNumberOfGroups, sizeof(CyclicGroup));
+        self->timerWheel = TimerWheel_create(TIMER_WHEEL_SLOTS, CS101_CYCLIC_SCHEDULER_TICK_INTERVAL, Hal_getMonotonicTimeInMs());
+
+        if ((self->groups == NULL) || (self->timerWheel == NULL)) {
+            CS101_CyclicScheduler_destroy(self);
+            return NULL;
+        }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Semaphore_create(1);
+#endif
+    }
+
+    return self;
+}
+
+static void
+releaseGroup(CyclicGroup* group)
+{
+    int i;
+
+    for (i = 0; i < group->numberOfTemplates; i++)
+        CS101_ASDUTemplate_destroy(group->templates[i]);
+
+    GLOBAL_FREEMEM(group->templates);
+    GLOBAL_FREEMEM(group->pointIndices);
+
+    group->templates = NULL;
+    group->numberOfTemplates = 0;
+    group->pointIndices = NULL;
+    group->numberOfPoints = 0;
+    group->isUsed = false;
+}
+
+void
+CS101_CyclicScheduler_destroy(CS101_CyclicScheduler self)
+{
+    if (self) {
+#if (CONFIG_USE_THREADS == 1)
+        CS101_CyclicScheduler_stop(self);
+#endif
+
+        if (self->groups) {
+            int i;
+
+            for (i = 0; i < self->maxNumberOfGroups; i++) {
+                if (self->groups[i].isUsed)
+                    releaseGroup(&(self->groups[i]));
+            }
+
+            GLOBAL_FREEMEM(self->groups);
+        }
+
+        TimerWheel_destroy(self->timerWheel);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        if (self->lock)
+            Semaphore_destroy(self->lock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+void
+CS101_CyclicScheduler_setASDUHandler(CS101_CyclicScheduler self, CS101_CyclicScheduler_ASDUHandler handler, void* parameter)
+{
+    self->asduHandler = handler;
+    self->asduHandlerParameter = parameter;
+}
+
+void
+CS101_CyclicScheduler_setOverrunHandler(CS101_CyclicScheduler self, CS101_CyclicScheduler_OverrunHandler handler, void* parameter)
+{
+    self->overrunHandler = handler;
+    self->overrunHandlerParameter = parameter;
+}
+
+void
+CS101_CyclicScheduler_setOriginatorAddress(CS101_CyclicScheduler self, int oa)
+{
+    self->oa = oa;
+}
+
+/* prepare the ASDU templates of a group - returns false when a point cannot be added */
+static bool
+createTemplates(CS101_CyclicScheduler self, CyclicGroup* group, CS101_CauseOfTransmission cot)
+{
+    /* a group can require one ASDU per point in the worst case */
+    group->templates = (CS101_ASDUTemplate*) GLOBAL_CALLOC(group->numberOfPoints, sizeof(CS101_ASDUTemplate));
+
+    if (group->templates == NULL)
+        return false;
+
+    sCS101_StaticASDU _asdu;
+    CS101_ASDU asdu = NULL;
+
+    int i;
+
+    for (i = 0; i <= group->numberOfPoints; i++) {
+
+        int index = (i < group->numberOfPoints) ? group->pointIndices[i] : -1;
+
+        if (asdu && ((index == -1) ||
+                (CS101_ASDU_getTypeID(asdu) != CS101_ProcessImage_getTypeID(self->processImage, index)) ||
+                (CS101_ASDU_getCA(asdu) != CS101_ProcessImage_getCA(self->processImage, index)) ||
+                (CS101_ProcessImage_addToASDU(self->processImage, index, asdu) == false)))
+        {
+            group->templates[group->numberOfTemplates] = CS101_ASDUTemplate_create(asdu);
+
+            if (group->templates[group->numberOfTemplates] == NULL)
+                return false;
+
+            group->numberOfTemplates++;
+
+            asdu = NULL;
+        }
+
+        if ((asdu == NULL) && (index != -1)) {
+            asdu = CS101_ASDU_initializeStatic(&_asdu, self->parameters, false, cot, self->oa,
+                    CS101_ProcessImage_getCA(self->processImage, index), false, false);
+
+            if (CS101_ProcessImage_addToASDU(self->processImage, index, asdu) == false)
+                return false;
+        }
+    }
+
+    return true;
+}
+
+/* golden ratio based offset within the cycle - distributes the groups evenly */
+static uint64_t
+getPhaseOffset(int groupId, int cycleTime)
+{
+    double fraction = (double) groupId * 0.6180339887498949;
+
+    fraction = fraction - (double) ((uint64_t) fraction);
+
+    return (uint64_t) (fraction * (double) cycleTime);
+}
+
+int
+CS101_CyclicScheduler_addGroup(CS101_CyclicScheduler self, const int* pointIndices, int numberOfPoints,
+        CS101_CauseOfTransmission cot, int cycleTime)
+{
+    if ((numberOfPoints < 1) || (cycleTime < CS101_CYCLIC_SCHEDULER_TICK_INTERVAL))
+        return -1;
+
+    if ((cot != CS101_COT_PERIODIC) && (cot != CS101_COT_BACKGROUND_SCAN))
+        return -1;
+
+    int i;
+
+    for (i = 0; i < numberOfPoints; i++) {
+        if ((pointIndices[i] < 0) || (pointIndices[i] >= CS101_ProcessImage_getNumberOfPoints(self->processImage)))
+            return -1;
+    }
+
+    int groupId = -1;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    for (i = 0; i < self->maxNumberOfGroups; i++) {
+        if (self->groups[i].isUsed == false) {
+            groupId = i;
+            break;
+        }
+    }
+
+    if (groupId != -1) {
+        CyclicGroup* group = &(self->groups[groupId]);
+
+        memset(group, 0, sizeof(CyclicGroup));
+
+        TimerWheelEntry_initialize(&(group->timer));
+
+        group->groupId = groupId;
+        group->cycleTime = cycleTime;
+        group->numberOfPoints = numberOfPoints;
+        group->pointIndices = (int*) GLOBAL_MALLOC(numberOfPoints * sizeof(int));
+
+        if (group->pointIndices)
+            memcpy(group->pointIndices, pointIndices, numberOfPoints * sizeof(int));
+
+        if ((group->pointIndices == NULL) || (createTemplates(self, group, cot) == false)) {
+            DEBUG_PRINT("Cyclic scheduler: failed to create group\n");
+            releaseGroup(group);
+            groupId = -1;
+        }
+        else {
+            group->isUsed = true;
+            group->dueTime = Hal_getMonotonicTimeInMs() + getPhaseOffset(groupId, cycleTime);
+
+            TimerWheel_schedule(self->timerWheel, &(group->timer), group->dueTime);
+        }
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return groupId;
+}
+
+bool
+CS101_CyclicScheduler_removeGroup(CS101_CyclicScheduler self, int groupId)
+{
+    bool removed = false;
+
+    if ((groupId < 0) || (groupId >= self->maxNumberOfGroups))
+        return false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    CyclicGroup* group = &(self->groups[groupId]);
+
+    if (group->isUsed) {
+        TimerWheel_cancel(self->timerWheel, &(group->timer));
+        releaseGroup(group);
+        removed = true;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return removed;
+}
+
+uint32_t
+CS101_CyclicScheduler_getOverrunCount(CS101_CyclicScheduler self, int groupId)
+{
+    if ((groupId < 0) || (groupId >= self->maxNumberOfGroups))
+        return 0;
+
+    return self->groups[groupId].overruns;
+}
+
+static bool
+hasTimestamp(TypeID typeId)
+{
+    switch (typeId) {
+    case M_SP_TB_1:
+    case M_DP_TB_1:
+    case M_ST_TB_1:
+    case M_BO_TB_1:
+    case M_ME_TD_1:
+    case M_ME_TE_1:
+    case M_ME_TF_1:
+    case M_IT_TB_1:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* copy the current state of a point from the process image into the template */
+static void
+updateElement(CS101_ProcessImage processImage, int index, CS101_ASDUTemplate asduTemplate, int element)
+{
+    TypeID typeId = CS101_ProcessImage_getTypeID(processImage, index);
+    QualityDescriptor quality = CS101_ProcessImage_getQuality(processImage, index);
+
+    struct sBinaryCounterReading bcr;
+    bool isTransient;
+
+    switch (typeId) {
+
+    case M_SP_NA_1:
+    case M_SP_TB_1:
+        CS101_ASDUTemplate_setSinglePoint(asduTemplate, element, CS101_ProcessImage_getSinglePointValue(processImage, index), quality);
+        break;
+
+    case M_DP_NA_1:
+    case M_DP_TB_1:
+        CS101_ASDUTemplate_setDoublePoint(asduTemplate, element, CS101_ProcessImage_getDoublePointValue(processImage, index), quality);
+        break;
+
+    case M_ST_NA_1:
+    case M_ST_TB_1:
+        {
+            int value = CS101_ProcessImage_getStepPositionValue(processImage, index, &isTransient);
+            CS101_ASDUTemplate_setStepPosition(asduTemplate, element, value, isTransient, quality);
+        }
+        break;
+
+    case M_BO_NA_1:
+    case M_BO_TB_1:
+        CS101_ASDUTemplate_setBitstring32(asduTemplate, element, CS101_ProcessImage_getBitstring32Value(processImage, index), quality);
+        break;
+
+    case M_ME_NA_1:
+    case M_ME_TD_1:
+    case M_ME_ND_1:
+        CS101_ASDUTemplate_setNormalizedValue(asduTemplate, element, CS101_ProcessImage_getFloatValue(processImage, index), quality);
+        break;
+
+    case M_ME_NB_1:
+    case M_ME_TE_1:
+        CS101_ASDUTemplate_setScaledValue(asduTemplate, element, CS101_ProcessImage_getScaledValue(processImage, index), quality);
+        break;
+
+    case M_ME_NC_1:
+    case M_ME_TF_1:
+        CS101_ASDUTemplate_setShortValue(asduTemplate, element, CS101_ProcessImage_getFloatValue(processImage, index), quality);
+        break;
+
+    case M_IT_NA_1:
+    case M_IT_TB_1:
+        CS101_ProcessImage_getIntegratedTotals(processImage, index, &bcr);
+        CS101_ASDUTemplate_setIntegratedTotals(asduTemplate, element, &bcr);
+        break;
+
+    default:
+        break;
+    }
+
+    if (hasTimestamp(typeId)) {
+        struct sCP56Time2a timestamp;
+
+        CP56Time2a_createFromMsTimestamp(&timestamp, CS101_ProcessImage_getTimestamp(processImage, index));
+        CS101_ASDUTemplate_setTimestamp(asduTemplate, element, &timestamp);
+    }
+}
+
+static void
+sendGroup(CS101_CyclicScheduler self, CyclicGroup* group)
+{
+    int point = 0;
+    int i;
+
+    for (i = 0; i < group->numberOfTemplates; i++) {
+        CS101_ASDUTemplate asduTemplate = group->templates[i];
+
+        int numberOfElements = CS101_ASDUTemplate_getNumberOfElements(asduTemplate);
+        int element;
+
+        for (element = 0; element < numberOfElements; element++) {
+            int index = group->pointIndices[point++];
+            uint32_t sequence;
+
+            /* repeat when the point has been updated concurrently (value, quality, and time tag have to match) */
+            do {
+                sequence = CS101_ProcessImage_beginRead(self->processImage, index);
+
+                updateElement(self->processImage, index, asduTemplate, element);
+            } while (CS101_ProcessImage_retryRead(self->processImage, index, sequence));
+        }
+
+        if (self->asduHandler)
+            self->asduHandler(self->asduHandlerParameter, group->groupId, CS101_ASDUTemplate_getASDU(asduTemplate));
+    }
+}
+
+static void
+handleExpiredGroup(void* parameter, TimerWheelEntry entry, uint64_t currentTime)
+{
+    CS101_CyclicScheduler self = (CS101_CyclicScheduler) parameter;
+    CyclicGroup* group = (CyclicGroup*) entry;
+
+    sendGroup(self, group);
+
+    group->dueTime += group->cycleTime;
+
+    /* skip the cycles that have been missed */
+    if (group->dueTime <= currentTime) {
+        uint64_t missedCycles = ((currentTime - group->dueTime) / group->cycleTime) + 1;
+
+        group->dueTime += missedCycles * group->cycleTime;
+        group->overruns += (uint32_t) missedCycles;
+
+        DEBUG_PRINT("Cyclic scheduler: group %i missed %i cycles\n", group->groupId, (int) missedCycles);
+
+        if (self->overrunHandler)
+            self->overrunHandler(self->overrunHandlerParameter, group->groupId, (int) missedCycles);
+    }
+
+    TimerWheel_schedule(self->timerWheel, &(group->timer), group->dueTime);
+}
+
+void
+CS101_CyclicScheduler_tick(CS101_CyclicScheduler self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    TimerWheel_advance(self->timerWheel, Hal_getMonotonicTimeInMs(), handleExpiredGroup, self);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+}
+
+#if (CONFIG_USE_THREADS == 1)
+
+static bool
+isRunning(CS101_CyclicScheduler self)
+{
+    bool running;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    running = self->isRunning;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return running;
+}
+
+static void*
+schedulerThread(void* parameter)
+{
+    CS101_CyclicScheduler self = (CS101_CyclicScheduler) parameter;
+
+    while (isRunning(self)) {
+        CS101_CyclicScheduler_tick(self);
+
+        Thread_sleep(CS101_CYCLIC_SCHEDULER_TICK_INTERVAL);
+    }
+
+    return NULL;
+}
+
+#endif /* (CONFIG_USE_THREADS == 1) */
+
+void
+CS101_CyclicScheduler_start(CS101_CyclicScheduler self)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->thread == NULL) {
+        self->isRunning = true;
+
+        self->thread = Thread_create(schedulerThread, (void*) self, false);
+
+        if (self->thread)
+            Thread_start(self->thread);
+        else
+            self->isRunning = false;
+    }
+#endif
+}
+
+void
+CS101_CyclicScheduler_stop(CS101_CyclicScheduler self)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->thread) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_wait(self->lock);
+#endif
+
+        self->isRunning = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_post(self->lock);
+#endif
+
+        Thread_destroy(self->thread);
+
+        self->thread = NULL;
+    }
+#endif
+}
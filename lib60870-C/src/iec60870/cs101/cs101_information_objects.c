@@ -32,7 +32,7 @@
 #include "frame.h"
 #include "platform_endian.h"
 
-typedef bool (*EncodeFunction)(InformationObject self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence);
+typedef bool (*EncodeFunction)(InformationObject self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence);
 typedef void (*DestroyFunction)(InformationObject self);
 
 struct sInformationObjectVFT {
@@ -138,10 +138,36 @@ struct sInformationObject {
     InformationObjectVFT virtualFunctionTable;
 };
 
+bool
+InformationObject_encodeToSpan(InformationObject self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
+{
+    return self->virtualFunctionTable->encode(self, span, parameters, isSequence);
+}
+
 bool
 InformationObject_encode(InformationObject self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    return self->virtualFunctionTable->encode(self, frame, parameters, isSequence);
+    /* compatibility path for arbitrary frame implementations - encode into a
+     * temporary span and append the result to the frame */
+    uint8_t buffer[256];
+    struct sFrameSpan span;
+
+    int spaceLeft = Frame_getSpaceLeft(frame);
+
+    if (spaceLeft > (int) sizeof(buffer))
+        spaceLeft = (int) sizeof(buffer);
+
+    if (spaceLeft < 0)
+        spaceLeft = 0;
+
+    FrameSpan_initialize(&span, buffer, 0, spaceLeft);
+
+    if (self->virtualFunctionTable->encode(self, &span, parameters, isSequence)) {
+        Frame_appendBytes(frame, buffer, span.pos);
+        return true;
+    }
+    else
+        return false;
 }
 
 void
@@ -169,16 +195,16 @@ InformationObject_getType(InformationObject self)
 }
 
 static void
-InformationObject_encodeBase(InformationObject self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+InformationObject_encodeBase(InformationObject self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
     if (!isSequence) {
-        Frame_setNextByte(frame, (uint8_t)(self->objectAddress & 0xff));
+        FrameSpan_setNextByte(span, (uint8_t)(self->objectAddress & 0xff));
 
-        if (parameters->sizeOfIOA > 1)
-            Frame_setNextByte(frame, (uint8_t)((self->objectAddress / 0x100) & 0xff));
+        if (CS101_SIZE_OF_IOA(parameters) > 1)
+            FrameSpan_setNextByte(span, (uint8_t)((self->objectAddress / 0x100) & 0xff));
 
-        if (parameters->sizeOfIOA > 2)
-            Frame_setNextByte(frame, (uint8_t)((self->objectAddress / 0x10000) & 0xff));
+        if (CS101_SIZE_OF_IOA(parameters) > 2)
+            FrameSpan_setNextByte(span, (uint8_t)((self->objectAddress / 0x10000) & 0xff));
     }
 }
 
@@ -188,10 +214,10 @@ InformationObject_ParseObjectAddress(CS101_AppLayerParameters parameters, const
     /* parse information object address */
     int ioa = msg [startIndex];
 
-    if (parameters->sizeOfIOA > 1)
+    if (CS101_SIZE_OF_IOA(parameters) > 1)
         ioa += (msg [startIndex + 1] * 0x100);
 
-    if (parameters->sizeOfIOA > 2)
+    if (CS101_SIZE_OF_IOA(parameters) > 2)
         ioa += (msg [startIndex + 2] * 0x10000);
 
     return ioa;
@@ -216,21 +242,21 @@ InformationObject_getMaxSizeInMemory()
  **********************************************/
 
 static bool
-SinglePointInformation_encode(SinglePointInformation self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SinglePointInformation_encode(SinglePointInformation self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t val = (uint8_t) (self->quality & 0xf0);
 
     if (self->value)
         val++;
 
-    Frame_setNextByte(frame, val);
+    FrameSpan_setNextByte(span, val);
 
     return true;
 }
@@ -272,20 +298,9 @@ SinglePointInformation_destroy(SinglePointInformation self)
 }
 
 SinglePointInformation
-SinglePointInformation_getFromBuffer(SinglePointInformation self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+SinglePointInformation_decode(SinglePointInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 1;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SinglePointInformation) GLOBAL_MALLOC(sizeof(struct sSinglePointInformation));
 
@@ -295,7 +310,7 @@ SinglePointInformation_getFromBuffer(SinglePointInformation self, CS101_AppLayer
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse SIQ (single point information with quality) */
@@ -309,6 +324,24 @@ SinglePointInformation_getFromBuffer(SinglePointInformation self, CS101_AppLayer
     return self;
 }
 
+SinglePointInformation
+SinglePointInformation_getFromBuffer(SinglePointInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 1;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SinglePointInformation_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 bool
 SinglePointInformation_getValue(SinglePointInformation self)
 {
@@ -327,18 +360,18 @@ SinglePointInformation_getQuality(SinglePointInformation self)
  **********************************************/
 
 static bool
-StepPositionInformation_encode(StepPositionInformation self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+StepPositionInformation_encode(StepPositionInformation self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 2 : (parameters->sizeOfIOA + 2);
+    int size = isSequence ? 2 : (CS101_SIZE_OF_IOA(parameters) + 2);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->vti);
+    FrameSpan_setNextByte(span, self->vti);
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     return true;
 }
@@ -423,20 +456,9 @@ StepPositionInformation_getQuality(StepPositionInformation self)
 
 
 StepPositionInformation
-StepPositionInformation_getFromBuffer(StepPositionInformation self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+StepPositionInformation_decode(StepPositionInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 2;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (StepPositionInformation) GLOBAL_MALLOC(sizeof(struct sStepPositionInformation));
 
@@ -446,7 +468,7 @@ StepPositionInformation_getFromBuffer(StepPositionInformation self, CS101_AppLay
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse VTI (value with transient state indication) */
@@ -458,27 +480,45 @@ StepPositionInformation_getFromBuffer(StepPositionInformation self, CS101_AppLay
     return self;
 }
 
+StepPositionInformation
+StepPositionInformation_getFromBuffer(StepPositionInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 2;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return StepPositionInformation_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 
 /**********************************************
  * StepPositionWithCP56Time2a
  **********************************************/
 
 static bool
-StepPositionWithCP56Time2a_encode(StepPositionWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+StepPositionWithCP56Time2a_encode(StepPositionWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 9 : (parameters->sizeOfIOA + 9);
+    int size = isSequence ? 9 : (CS101_SIZE_OF_IOA(parameters) + 9);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->vti);
+    FrameSpan_setNextByte(span, self->vti);
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -541,20 +581,9 @@ StepPositionWithCP56Time2a_getTimestamp(StepPositionWithCP56Time2a self)
 }
 
 StepPositionWithCP56Time2a
-StepPositionWithCP56Time2a_getFromBuffer(StepPositionWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+StepPositionWithCP56Time2a_decode(StepPositionWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 9;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (StepPositionWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sStepPositionWithCP56Time2a));
 
@@ -564,7 +593,7 @@ StepPositionWithCP56Time2a_getFromBuffer(StepPositionWithCP56Time2a self, CS101_
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse VTI (value with transient state indication) */
@@ -573,32 +602,50 @@ StepPositionWithCP56Time2a_getFromBuffer(StepPositionWithCP56Time2a self, CS101_
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+StepPositionWithCP56Time2a
+StepPositionWithCP56Time2a_getFromBuffer(StepPositionWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 9;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return StepPositionWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /**********************************************
  * StepPositionWithCP24Time2a
  **********************************************/
 
 static bool
-StepPositionWithCP24Time2a_encode(StepPositionWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+StepPositionWithCP24Time2a_encode(StepPositionWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 5 : (parameters->sizeOfIOA + 5);
+    int size = isSequence ? 5 : (CS101_SIZE_OF_IOA(parameters) + 5);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->vti);
+    FrameSpan_setNextByte(span, self->vti);
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -662,20 +709,9 @@ StepPositionWithCP24Time2a_getTimestamp(StepPositionWithCP24Time2a self)
 }
 
 StepPositionWithCP24Time2a
-StepPositionWithCP24Time2a_getFromBuffer(StepPositionWithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+StepPositionWithCP24Time2a_decode(StepPositionWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 5;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (StepPositionWithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sStepPositionWithCP24Time2a));
 
@@ -685,7 +721,7 @@ StepPositionWithCP24Time2a_getFromBuffer(StepPositionWithCP24Time2a self, CS101_
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse VTI (value with transient state indication) */
@@ -694,31 +730,49 @@ StepPositionWithCP24Time2a_getFromBuffer(StepPositionWithCP24Time2a self, CS101_
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+StepPositionWithCP24Time2a
+StepPositionWithCP24Time2a_getFromBuffer(StepPositionWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 5;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return StepPositionWithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /**********************************************
  * DoublePointInformation
  **********************************************/
 
 static bool
-DoublePointInformation_encode(DoublePointInformation self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+DoublePointInformation_encode(DoublePointInformation self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t val = (uint8_t) (self->quality & 0xf0);
 
     val += (int) self->value;
 
-    Frame_setNextByte(frame, val);
+    FrameSpan_setNextByte(span, val);
 
     return true;
 }
@@ -772,20 +826,9 @@ DoublePointInformation_getQuality(DoublePointInformation self)
 }
 
 DoublePointInformation
-DoublePointInformation_getFromBuffer(DoublePointInformation self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+DoublePointInformation_decode(DoublePointInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 1;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (DoublePointInformation) GLOBAL_MALLOC(sizeof(struct sDoublePointInformation));
 
@@ -795,7 +838,7 @@ DoublePointInformation_getFromBuffer(DoublePointInformation self, CS101_AppLayer
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse DIQ (double point information with quality) */
@@ -809,29 +852,47 @@ DoublePointInformation_getFromBuffer(DoublePointInformation self, CS101_AppLayer
     return self;
 }
 
+DoublePointInformation
+DoublePointInformation_getFromBuffer(DoublePointInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 1;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return DoublePointInformation_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 
 /*******************************************
  * DoublePointWithCP24Time2a
  *******************************************/
 
 static bool
-DoublePointWithCP24Time2a_encode(DoublePointWithCP24Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+DoublePointWithCP24Time2a_encode(DoublePointWithCP24Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 4 : (parameters->sizeOfIOA + 4);
+    int size = isSequence ? 4 : (CS101_SIZE_OF_IOA(parameters) + 4);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t val = (uint8_t) (self->quality & 0xf0);
 
     val += (int) self->value;
 
-    Frame_setNextByte(frame, val);
+    FrameSpan_setNextByte(span, val);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -881,20 +942,9 @@ DoublePointWithCP24Time2a_getTimestamp(DoublePointWithCP24Time2a self)
 }
 
 DoublePointWithCP24Time2a
-DoublePointWithCP24Time2a_getFromBuffer(DoublePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+DoublePointWithCP24Time2a_decode(DoublePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 4;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (DoublePointWithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sDoublePointWithCP24Time2a));
 
@@ -904,7 +954,7 @@ DoublePointWithCP24Time2a_getFromBuffer(DoublePointWithCP24Time2a self, CS101_Ap
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse DIQ (double point information with quality) */
@@ -915,34 +965,52 @@ DoublePointWithCP24Time2a_getFromBuffer(DoublePointWithCP24Time2a self, CS101_Ap
         self->quality = (QualityDescriptor) (diq & 0xf0);
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+DoublePointWithCP24Time2a
+DoublePointWithCP24Time2a_getFromBuffer(DoublePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 4;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return DoublePointWithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * DoublePointWithCP56Time2a
  *******************************************/
 
 static bool
-DoublePointWithCP56Time2a_encode(DoublePointWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+DoublePointWithCP56Time2a_encode(DoublePointWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t val = (uint8_t) (self->quality & 0xf0);
 
     val += (int) self->value;
 
-    Frame_setNextByte(frame, val);
+    FrameSpan_setNextByte(span, val);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -991,20 +1059,9 @@ DoublePointWithCP56Time2a_getTimestamp(DoublePointWithCP56Time2a self)
 }
 
 DoublePointWithCP56Time2a
-DoublePointWithCP56Time2a_getFromBuffer(DoublePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+DoublePointWithCP56Time2a_decode(DoublePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 8;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (DoublePointWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sDoublePointWithCP56Time2a));
 
@@ -1014,7 +1071,7 @@ DoublePointWithCP56Time2a_getFromBuffer(DoublePointWithCP56Time2a self, CS101_Ap
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse DIQ (double point information with quality) */
@@ -1025,35 +1082,53 @@ DoublePointWithCP56Time2a_getFromBuffer(DoublePointWithCP56Time2a self, CS101_Ap
         self->quality = (QualityDescriptor) (diq & 0xf0);
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+DoublePointWithCP56Time2a
+DoublePointWithCP56Time2a_getFromBuffer(DoublePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 8;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return DoublePointWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * SinglePointWithCP24Time2a
  *******************************************/
 
 static bool
-SinglePointWithCP24Time2a_encode(SinglePointWithCP24Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SinglePointWithCP24Time2a_encode(SinglePointWithCP24Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 4 : (parameters->sizeOfIOA + 4);
+    int size = isSequence ? 4 : (CS101_SIZE_OF_IOA(parameters) + 4);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t val = (uint8_t) (self->quality & 0xf0);
 
     if (self->value)
         val++;
 
-    Frame_setNextByte(frame, val);
+    FrameSpan_setNextByte(span, val);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -1102,20 +1177,9 @@ SinglePointWithCP24Time2a_getTimestamp(SinglePointWithCP24Time2a self)
 }
 
 SinglePointWithCP24Time2a
-SinglePointWithCP24Time2a_getFromBuffer(SinglePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+SinglePointWithCP24Time2a_decode(SinglePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 4;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SinglePointWithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sSinglePointWithCP24Time2a));
 
@@ -1125,7 +1189,7 @@ SinglePointWithCP24Time2a_getFromBuffer(SinglePointWithCP24Time2a self, CS101_Ap
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse SIQ (single point information with qualitiy) */
@@ -1136,35 +1200,53 @@ SinglePointWithCP24Time2a_getFromBuffer(SinglePointWithCP24Time2a self, CS101_Ap
         self->quality = (QualityDescriptor) (siq & 0xf0);
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+SinglePointWithCP24Time2a
+SinglePointWithCP24Time2a_getFromBuffer(SinglePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 4;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SinglePointWithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * SinglePointWithCP56Time2a
  *******************************************/
 
 static bool
-SinglePointWithCP56Time2a_encode(SinglePointWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SinglePointWithCP56Time2a_encode(SinglePointWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t val = (uint8_t) (self->quality & 0xf0);
 
     if (self->value)
         val++;
 
-    Frame_setNextByte(frame, val);
+    FrameSpan_setNextByte(span, val);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -1213,20 +1295,9 @@ SinglePointWithCP56Time2a_getTimestamp(SinglePointWithCP56Time2a self)
 }
 
 SinglePointWithCP56Time2a
-SinglePointWithCP56Time2a_getFromBuffer(SinglePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+SinglePointWithCP56Time2a_decode(SinglePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 8;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SinglePointWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sSinglePointWithCP56Time2a));
 
@@ -1236,7 +1307,7 @@ SinglePointWithCP56Time2a_getFromBuffer(SinglePointWithCP56Time2a self, CS101_Ap
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* parse SIQ (single point information with qualitiy) */
@@ -1247,34 +1318,52 @@ SinglePointWithCP56Time2a_getFromBuffer(SinglePointWithCP56Time2a self, CS101_Ap
         self->quality = (QualityDescriptor) (siq & 0xf0);
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
-/**********************************************
- * BitString32
- **********************************************/
-
-static bool
-BitString32_encode(BitString32 self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
-{
-    int size = isSequence ? 5 : (parameters->sizeOfIOA + 5);
-
-    if (Frame_getSpaceLeft(frame) < size)
+SinglePointWithCP56Time2a
+SinglePointWithCP56Time2a_getFromBuffer(SinglePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 8;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SinglePointWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
+/**********************************************
+ * BitString32
+ **********************************************/
+
+static bool
+BitString32_encode(BitString32 self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
+{
+    int size = isSequence ? 5 : (CS101_SIZE_OF_IOA(parameters) + 5);
+
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint32_t value = self->value;
 
-    Frame_setNextByte(frame, (uint8_t) (value % 0x100));
-    Frame_setNextByte(frame, (uint8_t) ((value / 0x100) % 0x100));
-    Frame_setNextByte(frame, (uint8_t) ((value / 0x10000) % 0x100));
-    Frame_setNextByte(frame, (uint8_t) (value / 0x1000000));
+    FrameSpan_setNextByte(span, (uint8_t) (value % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) ((value / 0x100) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) ((value / 0x10000) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) (value / 0x1000000));
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     return true;
 }
@@ -1333,20 +1422,9 @@ BitString32_getQuality(BitString32 self)
 }
 
 BitString32
-BitString32_getFromBuffer(BitString32 self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+BitString32_decode(BitString32 self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 5;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (BitString32) GLOBAL_MALLOC(sizeof(struct sBitString32));
 
@@ -1356,7 +1434,7 @@ BitString32_getFromBuffer(BitString32 self, CS101_AppLayerParameters parameters,
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         uint32_t value;
@@ -1374,31 +1452,49 @@ BitString32_getFromBuffer(BitString32 self, CS101_AppLayerParameters parameters,
     return self;
 }
 
+BitString32
+BitString32_getFromBuffer(BitString32 self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 5;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return BitString32_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /**********************************************
  * Bitstring32WithCP24Time2a
  **********************************************/
 
 static bool
-Bitstring32WithCP24Time2a_encode(Bitstring32WithCP24Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+Bitstring32WithCP24Time2a_encode(Bitstring32WithCP24Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint32_t  value = self->value;
 
-    Frame_setNextByte(frame, (uint8_t) (value % 0x100));
-    Frame_setNextByte(frame, (uint8_t) ((value / 0x100) % 0x100));
-    Frame_setNextByte(frame, (uint8_t) ((value / 0x10000) % 0x100));
-    Frame_setNextByte(frame, (uint8_t) (value / 0x1000000));
+    FrameSpan_setNextByte(span, (uint8_t) (value % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) ((value / 0x100) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) ((value / 0x10000) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) (value / 0x1000000));
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -1452,20 +1548,9 @@ Bitstring32WithCP24Time2a_getTimestamp(Bitstring32WithCP24Time2a self)
 }
 
 Bitstring32WithCP24Time2a
-Bitstring32WithCP24Time2a_getFromBuffer(Bitstring32WithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+Bitstring32WithCP24Time2a_decode(Bitstring32WithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 8;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (Bitstring32WithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sBitstring32WithCP24Time2a));
 
@@ -1475,7 +1560,7 @@ Bitstring32WithCP24Time2a_getFromBuffer(Bitstring32WithCP24Time2a self, CS101_Ap
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         uint32_t value;
@@ -1490,37 +1575,55 @@ Bitstring32WithCP24Time2a_getFromBuffer(Bitstring32WithCP24Time2a self, CS101_Ap
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+Bitstring32WithCP24Time2a
+Bitstring32WithCP24Time2a_getFromBuffer(Bitstring32WithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 8;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return Bitstring32WithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /**********************************************
  * Bitstring32WithCP56Time2a
  **********************************************/
 
 static bool
-Bitstring32WithCP56Time2a_encode(Bitstring32WithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+Bitstring32WithCP56Time2a_encode(Bitstring32WithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 12 : (parameters->sizeOfIOA + 12);
+    int size = isSequence ? 12 : (CS101_SIZE_OF_IOA(parameters) + 12);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint32_t  value = self->value;
 
-    Frame_setNextByte(frame, (uint8_t) (value % 0x100));
-    Frame_setNextByte(frame, (uint8_t) ((value / 0x100) % 0x100));
-    Frame_setNextByte(frame, (uint8_t) ((value / 0x10000) % 0x100));
-    Frame_setNextByte(frame, (uint8_t) (value / 0x1000000));
+    FrameSpan_setNextByte(span, (uint8_t) (value % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) ((value / 0x100) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) ((value / 0x10000) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t) (value / 0x1000000));
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -1574,20 +1677,9 @@ Bitstring32WithCP56Time2a_getTimestamp(Bitstring32WithCP56Time2a self)
 }
 
 Bitstring32WithCP56Time2a
-Bitstring32WithCP56Time2a_getFromBuffer(Bitstring32WithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+Bitstring32WithCP56Time2a_decode(Bitstring32WithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 12;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (Bitstring32WithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sBitstring32WithCP56Time2a));
 
@@ -1597,7 +1689,7 @@ Bitstring32WithCP56Time2a_getFromBuffer(Bitstring32WithCP56Time2a self, CS101_Ap
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         uint32_t value;
@@ -1612,12 +1704,30 @@ Bitstring32WithCP56Time2a_getFromBuffer(Bitstring32WithCP56Time2a self, CS101_Ap
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+Bitstring32WithCP56Time2a
+Bitstring32WithCP56Time2a_getFromBuffer(Bitstring32WithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 12;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return Bitstring32WithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /**********************************************
  * MeasuredValueNormalized
  **********************************************/
@@ -1651,19 +1761,19 @@ setScaledValue(uint8_t* encodedValue, int value)
 }
 
 static bool
-MeasuredValueNormalized_encode(MeasuredValueNormalized self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueNormalized_encode(MeasuredValueNormalized self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 3 : (parameters->sizeOfIOA + 3);
+    int size = isSequence ? 3 : (CS101_SIZE_OF_IOA(parameters) + 3);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->encodedValue[0]);
-    Frame_setNextByte(frame, self->encodedValue[1]);
+    FrameSpan_setNextByte(span, self->encodedValue[0]);
+    FrameSpan_setNextByte(span, self->encodedValue[1]);
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     return true;
 }
@@ -1733,20 +1843,9 @@ MeasuredValueNormalized_getQuality(MeasuredValueNormalized self)
 }
 
 MeasuredValueNormalized
-MeasuredValueNormalized_getFromBuffer(MeasuredValueNormalized self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueNormalized_decode(MeasuredValueNormalized self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 3;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueNormalized) GLOBAL_MALLOC(sizeof(struct sMeasuredValueNormalized));
 
@@ -1756,7 +1855,7 @@ MeasuredValueNormalized_getFromBuffer(MeasuredValueNormalized self, CS101_AppLay
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         self->encodedValue[0] = msg [startIndex++];
@@ -1769,6 +1868,24 @@ MeasuredValueNormalized_getFromBuffer(MeasuredValueNormalized self, CS101_AppLay
     return self;
 }
 
+MeasuredValueNormalized
+MeasuredValueNormalized_getFromBuffer(MeasuredValueNormalized self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 3;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueNormalized_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /**********************************************
  * ParameterNormalizedValue
  **********************************************/
@@ -1810,6 +1927,20 @@ ParameterNormalizedValue_getQPM(ParameterNormalizedValue self)
     return self->quality;
 }
 
+ParameterNormalizedValue
+ParameterNormalizedValue_decode(ParameterNormalizedValue self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
+{
+    MeasuredValueNormalized pvn =
+            MeasuredValueNormalized_decode(self, parameters, msg, startIndex, false);
+
+    if (pvn) {
+        pvn->type = P_ME_NA_1;
+    }
+
+    return (ParameterNormalizedValue) pvn;
+}
+
 ParameterNormalizedValue
 ParameterNormalizedValue_getFromBuffer(ParameterNormalizedValue self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex)
@@ -1830,17 +1961,17 @@ ParameterNormalizedValue_getFromBuffer(ParameterNormalizedValue self, CS101_AppL
  *************************************************************/
 
 static bool
-MeasuredValueNormalizedWithoutQuality_encode(MeasuredValueNormalizedWithoutQuality self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueNormalizedWithoutQuality_encode(MeasuredValueNormalizedWithoutQuality self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 2 : (parameters->sizeOfIOA + 2);
+    int size = isSequence ? 2 : (CS101_SIZE_OF_IOA(parameters) + 2);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->encodedValue[0]);
-    Frame_setNextByte(frame, self->encodedValue[1]);
+    FrameSpan_setNextByte(span, self->encodedValue[0]);
+    FrameSpan_setNextByte(span, self->encodedValue[1]);
 
     return true;
 }
@@ -1902,20 +2033,9 @@ MeasuredValueNormalizedWithoutQuality_setValue(MeasuredValueNormalizedWithoutQua
 }
 
 MeasuredValueNormalizedWithoutQuality
-MeasuredValueNormalizedWithoutQuality_getFromBuffer(MeasuredValueNormalizedWithoutQuality self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueNormalizedWithoutQuality_decode(MeasuredValueNormalizedWithoutQuality self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 2;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (MeasuredValueNormalizedWithoutQuality) GLOBAL_MALLOC(sizeof(struct sMeasuredValueNormalizedWithoutQuality));
 
@@ -1925,7 +2045,7 @@ MeasuredValueNormalizedWithoutQuality_getFromBuffer(MeasuredValueNormalizedWitho
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         self->encodedValue[0] = msg [startIndex++];
@@ -1935,22 +2055,40 @@ MeasuredValueNormalizedWithoutQuality_getFromBuffer(MeasuredValueNormalizedWitho
     return self;
 }
 
+MeasuredValueNormalizedWithoutQuality
+MeasuredValueNormalizedWithoutQuality_getFromBuffer(MeasuredValueNormalizedWithoutQuality self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 2;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueNormalizedWithoutQuality_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * MeasuredValueNormalizedWithCP24Time2a : MeasuredValueNormalized
  ***********************************************************************/
 
 static bool
-MeasuredValueNormalizedWithCP24Time2a_encode(MeasuredValueNormalizedWithCP24Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueNormalizedWithCP24Time2a_encode(MeasuredValueNormalizedWithCP24Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 6 : (parameters->sizeOfIOA + 6);
+    int size = isSequence ? 6 : (CS101_SIZE_OF_IOA(parameters) + 6);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, frame, parameters, isSequence);
+    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, span, parameters, isSequence);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -2011,20 +2149,9 @@ MeasuredValueNormalizedWithCP24Time2a_setTimestamp(MeasuredValueNormalizedWithCP
 }
 
 MeasuredValueNormalizedWithCP24Time2a
-MeasuredValueNormalizedWithCP24Time2a_getFromBuffer(MeasuredValueNormalizedWithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueNormalizedWithCP24Time2a_decode(MeasuredValueNormalizedWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 6;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueNormalizedWithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sMeasuredValueNormalizedWithCP24Time2a));
 
@@ -2034,7 +2161,7 @@ MeasuredValueNormalizedWithCP24Time2a_getFromBuffer(MeasuredValueNormalizedWithC
         if (!isSequence) {
              InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-             startIndex += parameters->sizeOfIOA; /* skip IOA */
+             startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
          }
 
         self->encodedValue[0] = msg [startIndex++];
@@ -2044,28 +2171,46 @@ MeasuredValueNormalizedWithCP24Time2a_getFromBuffer(MeasuredValueNormalizedWithC
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+MeasuredValueNormalizedWithCP24Time2a
+MeasuredValueNormalizedWithCP24Time2a_getFromBuffer(MeasuredValueNormalizedWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 6;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueNormalizedWithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * MeasuredValueNormalizedWithCP56Time2a : MeasuredValueNormalized
  ***********************************************************************/
 
 static bool
-MeasuredValueNormalizedWithCP56Time2a_encode(MeasuredValueNormalizedWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueNormalizedWithCP56Time2a_encode(MeasuredValueNormalizedWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 10 : (parameters->sizeOfIOA + 10);
+    int size = isSequence ? 10 : (CS101_SIZE_OF_IOA(parameters) + 10);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, frame, parameters, isSequence);
+    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, span, parameters, isSequence);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -2126,20 +2271,9 @@ MeasuredValueNormalizedWithCP56Time2a_setTimestamp(MeasuredValueNormalizedWithCP
 }
 
 MeasuredValueNormalizedWithCP56Time2a
-MeasuredValueNormalizedWithCP56Time2a_getFromBuffer(MeasuredValueNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueNormalizedWithCP56Time2a_decode(MeasuredValueNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 10;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueNormalizedWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sMeasuredValueNormalizedWithCP56Time2a));
 
@@ -2149,7 +2283,7 @@ MeasuredValueNormalizedWithCP56Time2a_getFromBuffer(MeasuredValueNormalizedWithC
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         self->encodedValue[0] = msg [startIndex++];
@@ -2159,20 +2293,38 @@ MeasuredValueNormalizedWithCP56Time2a_getFromBuffer(MeasuredValueNormalizedWithC
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+MeasuredValueNormalizedWithCP56Time2a
+MeasuredValueNormalizedWithCP56Time2a_getFromBuffer(MeasuredValueNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 10;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueNormalizedWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * MeasuredValueScaled
  *******************************************/
 
 static bool
-MeasuredValueScaled_encode(MeasuredValueScaled self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueScaled_encode(MeasuredValueScaled self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    return MeasuredValueNormalized_encode((MeasuredValueNormalized) self, frame, parameters, isSequence);
+    return MeasuredValueNormalized_encode((MeasuredValueNormalized) self, span, parameters, isSequence);
 }
 
 struct sInformationObjectVFT measuredValueScaledVFT = {
@@ -2237,20 +2389,9 @@ MeasuredValueScaled_setQuality(MeasuredValueScaled self, QualityDescriptor quali
 }
 
 MeasuredValueScaled
-MeasuredValueScaled_getFromBuffer(MeasuredValueScaled self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueScaled_decode(MeasuredValueScaled self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 3;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueScaled) GLOBAL_MALLOC(sizeof(struct sMeasuredValueScaled));
 
@@ -2260,7 +2401,7 @@ MeasuredValueScaled_getFromBuffer(MeasuredValueScaled self, CS101_AppLayerParame
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         self->encodedValue[0] = msg [startIndex++];
@@ -2273,6 +2414,24 @@ MeasuredValueScaled_getFromBuffer(MeasuredValueScaled self, CS101_AppLayerParame
     return self;
 }
 
+MeasuredValueScaled
+MeasuredValueScaled_getFromBuffer(MeasuredValueScaled self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 3;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueScaled_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /******************************************************
  * ParameterScaledValue : MeasuredValueScaled
  *****************************************************/
@@ -2314,6 +2473,20 @@ ParameterScaledValue_getQPM(ParameterScaledValue self)
     return self->quality;
 }
 
+ParameterScaledValue
+ParameterScaledValue_decode(ParameterScaledValue self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
+{
+    MeasuredValueScaled psv =
+            MeasuredValueScaled_decode(self, parameters, msg, startIndex, false);
+
+    if (psv) {
+        psv->type = P_ME_NB_1;
+    }
+
+    return (ParameterScaledValue) psv;
+}
+
 ParameterScaledValue
 ParameterScaledValue_getFromBuffer(ParameterScaledValue self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex)
@@ -2333,16 +2506,16 @@ ParameterScaledValue_getFromBuffer(ParameterScaledValue self, CS101_AppLayerPara
  *******************************************/
 
 static bool
-MeasuredValueScaledWithCP24Time2a_encode(MeasuredValueScaledWithCP24Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueScaledWithCP24Time2a_encode(MeasuredValueScaledWithCP24Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 6 : (parameters->sizeOfIOA + 6);
+    int size = isSequence ? 6 : (CS101_SIZE_OF_IOA(parameters) + 6);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, frame, parameters, isSequence);
+    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -2401,20 +2574,9 @@ MeasuredValueScaledWithCP24Time2a_setTimestamp(MeasuredValueScaledWithCP24Time2a
 }
 
 MeasuredValueScaledWithCP24Time2a
-MeasuredValueScaledWithCP24Time2a_getFromBuffer(MeasuredValueScaledWithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueScaledWithCP24Time2a_decode(MeasuredValueScaledWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 6;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueScaledWithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sMeasuredValueScaledWithCP24Time2a));
 
@@ -2424,7 +2586,7 @@ MeasuredValueScaledWithCP24Time2a_getFromBuffer(MeasuredValueScaledWithCP24Time2
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         self->encodedValue[0] = msg [startIndex++];
@@ -2434,28 +2596,46 @@ MeasuredValueScaledWithCP24Time2a_getFromBuffer(MeasuredValueScaledWithCP24Time2
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+MeasuredValueScaledWithCP24Time2a
+MeasuredValueScaledWithCP24Time2a_getFromBuffer(MeasuredValueScaledWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 6;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueScaledWithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * MeasuredValueScaledWithCP56Time2a
  *******************************************/
 
 static bool
-MeasuredValueScaledWithCP56Time2a_encode(MeasuredValueScaledWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueScaledWithCP56Time2a_encode(MeasuredValueScaledWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 10 : (parameters->sizeOfIOA + 10);
+    int size = isSequence ? 10 : (CS101_SIZE_OF_IOA(parameters) + 10);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, frame, parameters, isSequence);
+    MeasuredValueNormalized_encode((MeasuredValueNormalized) self, span, parameters, isSequence);
 
     /* timestamp */
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -2514,20 +2694,9 @@ MeasuredValueScaledWithCP56Time2a_setTimestamp(MeasuredValueScaledWithCP56Time2a
 }
 
 MeasuredValueScaledWithCP56Time2a
-MeasuredValueScaledWithCP56Time2a_getFromBuffer(MeasuredValueScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueScaledWithCP56Time2a_decode(MeasuredValueScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 10;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueScaledWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sMeasuredValueScaledWithCP56Time2a));
 
@@ -2537,7 +2706,7 @@ MeasuredValueScaledWithCP56Time2a_getFromBuffer(MeasuredValueScaledWithCP56Time2
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* scaled value */
@@ -2548,38 +2717,56 @@ MeasuredValueScaledWithCP56Time2a_getFromBuffer(MeasuredValueScaledWithCP56Time2
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+MeasuredValueScaledWithCP56Time2a
+MeasuredValueScaledWithCP56Time2a_getFromBuffer(MeasuredValueScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 10;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueScaledWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * MeasuredValueShort
  *******************************************/
 
 static bool
-MeasuredValueShort_encode(MeasuredValueShort self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueShort_encode(MeasuredValueShort self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 5 : (parameters->sizeOfIOA + 5);
+    int size = isSequence ? 5 : (CS101_SIZE_OF_IOA(parameters) + 5);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t* valueBytes = (uint8_t*) &(self->value);
 
 #if (ORDER_LITTLE_ENDIAN == 1)
-    Frame_appendBytes(frame, valueBytes, 4);
+    FrameSpan_appendBytes(span, valueBytes, 4);
 #else
-    Frame_setNextByte(frame, valueBytes[3]);
-    Frame_setNextByte(frame, valueBytes[2]);
-    Frame_setNextByte(frame, valueBytes[1]);
-    Frame_setNextByte(frame, valueBytes[0]);
+    FrameSpan_setNextByte(span, valueBytes[3]);
+    FrameSpan_setNextByte(span, valueBytes[2]);
+    FrameSpan_setNextByte(span, valueBytes[1]);
+    FrameSpan_setNextByte(span, valueBytes[0]);
 #endif
 
-    Frame_setNextByte(frame, (uint8_t) self->quality);
+    FrameSpan_setNextByte(span, (uint8_t) self->quality);
 
     return true;
 }
@@ -2638,20 +2825,9 @@ MeasuredValueShort_getQuality(MeasuredValueShort self)
 }
 
 MeasuredValueShort
-MeasuredValueShort_getFromBuffer(MeasuredValueShort self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueShort_decode(MeasuredValueShort self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 5;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueShort) GLOBAL_MALLOC(sizeof(struct sMeasuredValueShort));
 
@@ -2661,7 +2837,7 @@ MeasuredValueShort_getFromBuffer(MeasuredValueShort self, CS101_AppLayerParamete
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         uint8_t* valueBytes = (uint8_t*) &(self->value);
@@ -2685,6 +2861,24 @@ MeasuredValueShort_getFromBuffer(MeasuredValueShort self, CS101_AppLayerParamete
     return self;
 }
 
+MeasuredValueShort
+MeasuredValueShort_getFromBuffer(MeasuredValueShort self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 5;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueShort_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /******************************************************
  * ParameterFloatValue : MeasuredValueShort
  *****************************************************/
@@ -2726,6 +2920,20 @@ ParameterFloatValue_getQPM(ParameterFloatValue self)
     return self->quality;
 }
 
+ParameterFloatValue
+ParameterFloatValue_decode(ParameterFloatValue self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
+{
+    ParameterFloatValue psv =
+            MeasuredValueShort_decode(self, parameters, msg, startIndex, false);
+
+    if (psv) {
+        psv->type = P_ME_NC_1;
+    }
+
+    return (ParameterFloatValue) psv;
+}
+
 ParameterFloatValue
 ParameterFloatValue_getFromBuffer(ParameterFloatValue self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex)
@@ -2745,16 +2953,16 @@ ParameterFloatValue_getFromBuffer(ParameterFloatValue self, CS101_AppLayerParame
  *******************************************/
 
 static bool
-MeasuredValueShortWithCP24Time2a_encode(MeasuredValueShortWithCP24Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueShortWithCP24Time2a_encode(MeasuredValueShortWithCP24Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    MeasuredValueShort_encode((MeasuredValueShort) self, frame, parameters, isSequence);
+    MeasuredValueShort_encode((MeasuredValueShort) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -2813,20 +3021,9 @@ MeasuredValueShortWithCP24Time2a_setTimestamp(MeasuredValueShortWithCP24Time2a s
 }
 
 MeasuredValueShortWithCP24Time2a
-MeasuredValueShortWithCP24Time2a_getFromBuffer(MeasuredValueShortWithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueShortWithCP24Time2a_decode(MeasuredValueShortWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 8;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueShortWithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sMeasuredValueShortWithCP24Time2a));
 
@@ -2836,7 +3033,7 @@ MeasuredValueShortWithCP24Time2a_getFromBuffer(MeasuredValueShortWithCP24Time2a
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         uint8_t* valueBytes = (uint8_t*) &(self->value);
@@ -2857,27 +3054,45 @@ MeasuredValueShortWithCP24Time2a_getFromBuffer(MeasuredValueShortWithCP24Time2a
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+MeasuredValueShortWithCP24Time2a
+MeasuredValueShortWithCP24Time2a_getFromBuffer(MeasuredValueShortWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 8;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return MeasuredValueShortWithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * MeasuredValueFloatWithCP56Time2a
  *******************************************/
 
 static bool
-MeasuredValueShortWithCP56Time2a_encode(MeasuredValueShortWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+MeasuredValueShortWithCP56Time2a_encode(MeasuredValueShortWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 12 : (parameters->sizeOfIOA + 12);
+    int size = isSequence ? 12 : (CS101_SIZE_OF_IOA(parameters) + 12);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    MeasuredValueShort_encode((MeasuredValueShort) self, frame, parameters, isSequence);
+    MeasuredValueShort_encode((MeasuredValueShort) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -2936,20 +3151,9 @@ MeasuredValueShortWithCP56Time2a_setTimestamp(MeasuredValueShortWithCP56Time2a s
 }
 
 MeasuredValueShortWithCP56Time2a
-MeasuredValueShortWithCP56Time2a_getFromBuffer(MeasuredValueShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+MeasuredValueShortWithCP56Time2a_decode(MeasuredValueShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 12;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (MeasuredValueShortWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sMeasuredValueShortWithCP56Time2a));
 
@@ -2959,7 +3163,7 @@ MeasuredValueShortWithCP56Time2a_getFromBuffer(MeasuredValueShortWithCP56Time2a
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         uint8_t* valueBytes = (uint8_t*) &(self->value);
@@ -2980,10 +3184,28 @@ MeasuredValueShortWithCP56Time2a_getFromBuffer(MeasuredValueShortWithCP56Time2a
         self->quality = (QualityDescriptor) msg [startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
+    }
+
+    return self;
+}
+
+MeasuredValueShortWithCP56Time2a
+MeasuredValueShortWithCP56Time2a_getFromBuffer(MeasuredValueShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 12;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
     }
 
-    return self;
+    return MeasuredValueShortWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
 }
 
 /*******************************************
@@ -2991,16 +3213,16 @@ MeasuredValueShortWithCP56Time2a_getFromBuffer(MeasuredValueShortWithCP56Time2a
  *******************************************/
 
 static bool
-IntegratedTotals_encode(IntegratedTotals self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+IntegratedTotals_encode(IntegratedTotals self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 5 : (parameters->sizeOfIOA + 5);
+    int size = isSequence ? 5 : (CS101_SIZE_OF_IOA(parameters) + 5);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->totals.encodedValue, 5);
+    FrameSpan_appendBytes(span, self->totals.encodedValue, 5);
 
     return true;
 }
@@ -3055,20 +3277,9 @@ IntegratedTotals_setBCR(IntegratedTotals self, BinaryCounterReading value)
 }
 
 IntegratedTotals
-IntegratedTotals_getFromBuffer(IntegratedTotals self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+IntegratedTotals_decode(IntegratedTotals self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 5;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (IntegratedTotals) GLOBAL_MALLOC(sizeof(struct sIntegratedTotals));
 
@@ -3078,7 +3289,7 @@ IntegratedTotals_getFromBuffer(IntegratedTotals self, CS101_AppLayerParameters p
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* BCR */
@@ -3091,21 +3302,39 @@ IntegratedTotals_getFromBuffer(IntegratedTotals self, CS101_AppLayerParameters p
     return self;
 }
 
+IntegratedTotals
+IntegratedTotals_getFromBuffer(IntegratedTotals self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 5;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return IntegratedTotals_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * IntegratedTotalsWithCP24Time2a : IntegratedTotals
  ***********************************************************************/
 
 static bool
-IntegratedTotalsWithCP24Time2a_encode(IntegratedTotalsWithCP24Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+IntegratedTotalsWithCP24Time2a_encode(IntegratedTotalsWithCP24Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    IntegratedTotals_encode((IntegratedTotals) self, frame, parameters, isSequence);
+    IntegratedTotals_encode((IntegratedTotals) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -3163,20 +3392,9 @@ IntegratedTotalsWithCP24Time2a_setTimestamp(IntegratedTotalsWithCP24Time2a self,
 }
 
 IntegratedTotalsWithCP24Time2a
-IntegratedTotalsWithCP24Time2a_getFromBuffer(IntegratedTotalsWithCP24Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+IntegratedTotalsWithCP24Time2a_decode(IntegratedTotalsWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 8;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (IntegratedTotalsWithCP24Time2a) GLOBAL_MALLOC(sizeof(struct sIntegratedTotalsWithCP24Time2a));
 
@@ -3186,7 +3404,7 @@ IntegratedTotalsWithCP24Time2a_getFromBuffer(IntegratedTotalsWithCP24Time2a self
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* BCR */
@@ -3196,28 +3414,46 @@ IntegratedTotalsWithCP24Time2a_getFromBuffer(IntegratedTotalsWithCP24Time2a self
             self->totals.encodedValue[i] = msg [startIndex++];
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+IntegratedTotalsWithCP24Time2a
+IntegratedTotalsWithCP24Time2a_getFromBuffer(IntegratedTotalsWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 8;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return IntegratedTotalsWithCP24Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * IntegratedTotalsWithCP56Time2a : IntegratedTotals
  ***********************************************************************/
 
 
 static bool
-IntegratedTotalsWithCP56Time2a_encode(IntegratedTotalsWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+IntegratedTotalsWithCP56Time2a_encode(IntegratedTotalsWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 12 : (parameters->sizeOfIOA + 12);
+    int size = isSequence ? 12 : (CS101_SIZE_OF_IOA(parameters) + 12);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    IntegratedTotals_encode((IntegratedTotals) self, frame, parameters, isSequence);
+    IntegratedTotals_encode((IntegratedTotals) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -3275,20 +3511,9 @@ IntegratedTotalsWithCP56Time2a_setTimestamp(IntegratedTotalsWithCP56Time2a self,
 }
 
 IntegratedTotalsWithCP56Time2a
-IntegratedTotalsWithCP56Time2a_getFromBuffer(IntegratedTotalsWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+IntegratedTotalsWithCP56Time2a_decode(IntegratedTotalsWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 12;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (IntegratedTotalsWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sIntegratedTotalsWithCP56Time2a));
 
@@ -3298,7 +3523,7 @@ IntegratedTotalsWithCP56Time2a_getFromBuffer(IntegratedTotalsWithCP56Time2a self
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* BCR */
@@ -3308,31 +3533,49 @@ IntegratedTotalsWithCP56Time2a_getFromBuffer(IntegratedTotalsWithCP56Time2a self
             self->totals.encodedValue[i] = msg [startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+IntegratedTotalsWithCP56Time2a
+IntegratedTotalsWithCP56Time2a_getFromBuffer(IntegratedTotalsWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 12;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return IntegratedTotalsWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * EventOfProtectionEquipment : InformationObject
  ***********************************************************************/
 
 static bool
-EventOfProtectionEquipment_encode(EventOfProtectionEquipment self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+EventOfProtectionEquipment_encode(EventOfProtectionEquipment self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 6 : (parameters->sizeOfIOA + 6);
+    int size = isSequence ? 6 : (CS101_SIZE_OF_IOA(parameters) + 6);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, (uint8_t) self->event);
+    FrameSpan_setNextByte(span, (uint8_t) self->event);
 
-    Frame_appendBytes(frame, self->elapsedTime.encodedValue, 2);
+    FrameSpan_appendBytes(span, self->elapsedTime.encodedValue, 2);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -3375,20 +3618,9 @@ EventOfProtectionEquipment_create(EventOfProtectionEquipment self, int ioa,
 }
 
 EventOfProtectionEquipment
-EventOfProtectionEquipment_getFromBuffer(EventOfProtectionEquipment self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+EventOfProtectionEquipment_decode(EventOfProtectionEquipment self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 6;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (EventOfProtectionEquipment) GLOBAL_MALLOC(sizeof(struct sEventOfProtectionEquipment));
 
@@ -3398,23 +3630,41 @@ EventOfProtectionEquipment_getFromBuffer(EventOfProtectionEquipment self, CS101_
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* event */
         self->event = msg[startIndex++];
 
         /* elapsed time */
-        CP16Time2a_getFromBuffer(&(self->elapsedTime), msg, msgSize, startIndex);
+        CP16Time2a_decode(&(self->elapsedTime), msg, startIndex);
         startIndex += 2;
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+EventOfProtectionEquipment
+EventOfProtectionEquipment_getFromBuffer(EventOfProtectionEquipment self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 6;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return EventOfProtectionEquipment_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 SingleEvent
 EventOfProtectionEquipment_getEvent(EventOfProtectionEquipment self)
 {
@@ -3438,20 +3688,20 @@ EventOfProtectionEquipment_getTimestamp(EventOfProtectionEquipment self)
  ***********************************************************************/
 
 static bool
-EventOfProtectionEquipmentWithCP56Time2a_encode(EventOfProtectionEquipmentWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+EventOfProtectionEquipmentWithCP56Time2a_encode(EventOfProtectionEquipmentWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 10 : (parameters->sizeOfIOA + 10);
+    int size = isSequence ? 10 : (CS101_SIZE_OF_IOA(parameters) + 10);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, (uint8_t) self->event);
+    FrameSpan_setNextByte(span, (uint8_t) self->event);
 
-    Frame_appendBytes(frame, self->elapsedTime.encodedValue, 2);
+    FrameSpan_appendBytes(span, self->elapsedTime.encodedValue, 2);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -3512,20 +3762,9 @@ EventOfProtectionEquipmentWithCP56Time2a_getTimestamp(EventOfProtectionEquipment
 }
 
 EventOfProtectionEquipmentWithCP56Time2a
-EventOfProtectionEquipmentWithCP56Time2a_getFromBuffer(EventOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+EventOfProtectionEquipmentWithCP56Time2a_decode(EventOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 10;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (EventOfProtectionEquipmentWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sEventOfProtectionEquipmentWithCP56Time2a));
 
@@ -3535,44 +3774,62 @@ EventOfProtectionEquipmentWithCP56Time2a_getFromBuffer(EventOfProtectionEquipmen
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* event */
         self->event = msg[startIndex++];
 
         /* elapsed time */
-        CP16Time2a_getFromBuffer(&(self->elapsedTime), msg, msgSize, startIndex);
+        CP16Time2a_decode(&(self->elapsedTime), msg, startIndex);
         startIndex += 2;
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+EventOfProtectionEquipmentWithCP56Time2a
+EventOfProtectionEquipmentWithCP56Time2a_getFromBuffer(EventOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 10;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return EventOfProtectionEquipmentWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * PackedStartEventsOfProtectionEquipment : InformationObject
  ***********************************************************************/
 
 static bool
-PackedStartEventsOfProtectionEquipment_encode(PackedStartEventsOfProtectionEquipment self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+PackedStartEventsOfProtectionEquipment_encode(PackedStartEventsOfProtectionEquipment self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 7 : (parameters->sizeOfIOA + 7);
+    int size = isSequence ? 7 : (CS101_SIZE_OF_IOA(parameters) + 7);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, (uint8_t) self->event);
+    FrameSpan_setNextByte(span, (uint8_t) self->event);
 
-    Frame_setNextByte(frame, (uint8_t) self->qdp);
+    FrameSpan_setNextByte(span, (uint8_t) self->qdp);
 
-    Frame_appendBytes(frame, self->elapsedTime.encodedValue, 2);
+    FrameSpan_appendBytes(span, self->elapsedTime.encodedValue, 2);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -3640,20 +3897,9 @@ PackedStartEventsOfProtectionEquipment_getTimestamp(PackedStartEventsOfProtectio
 }
 
 PackedStartEventsOfProtectionEquipment
-PackedStartEventsOfProtectionEquipment_getFromBuffer(PackedStartEventsOfProtectionEquipment self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+PackedStartEventsOfProtectionEquipment_decode(PackedStartEventsOfProtectionEquipment self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 7;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (PackedStartEventsOfProtectionEquipment) GLOBAL_MALLOC(sizeof(struct sPackedStartEventsOfProtectionEquipment));
 
@@ -3663,7 +3909,7 @@ PackedStartEventsOfProtectionEquipment_getFromBuffer(PackedStartEventsOfProtecti
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* event */
@@ -3673,37 +3919,55 @@ PackedStartEventsOfProtectionEquipment_getFromBuffer(PackedStartEventsOfProtecti
         self->qdp = msg[startIndex++];
 
         /* elapsed time */
-        CP16Time2a_getFromBuffer(&(self->elapsedTime), msg, msgSize, startIndex);
+        CP16Time2a_decode(&(self->elapsedTime), msg, startIndex);
         startIndex += 2;
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+PackedStartEventsOfProtectionEquipment
+PackedStartEventsOfProtectionEquipment_getFromBuffer(PackedStartEventsOfProtectionEquipment self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 7;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return PackedStartEventsOfProtectionEquipment_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***************************************************************************
  * PackedStartEventsOfProtectionEquipmentWithCP56Time2a : InformationObject
  ***************************************************************************/
 
 static bool
-PackedStartEventsOfProtectionEquipmentWithCP56Time2a_encode(PackedStartEventsOfProtectionEquipmentWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+PackedStartEventsOfProtectionEquipmentWithCP56Time2a_encode(PackedStartEventsOfProtectionEquipmentWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 11 : (parameters->sizeOfIOA + 11);
+    int size = isSequence ? 11 : (CS101_SIZE_OF_IOA(parameters) + 11);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, (uint8_t) self->event);
+    FrameSpan_setNextByte(span, (uint8_t) self->event);
 
-    Frame_setNextByte(frame, (uint8_t) self->qdp);
+    FrameSpan_setNextByte(span, (uint8_t) self->qdp);
 
-    Frame_appendBytes(frame, self->elapsedTime.encodedValue, 2);
+    FrameSpan_appendBytes(span, self->elapsedTime.encodedValue, 2);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -3771,20 +4035,9 @@ PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getTimestamp(PackedStartEve
 }
 
 PackedStartEventsOfProtectionEquipmentWithCP56Time2a
-PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getFromBuffer(PackedStartEventsOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+PackedStartEventsOfProtectionEquipmentWithCP56Time2a_decode(PackedStartEventsOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 11;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (PackedStartEventsOfProtectionEquipmentWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sPackedStartEventsOfProtectionEquipmentWithCP56Time2a));
 
@@ -3794,7 +4047,7 @@ PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getFromBuffer(PackedStartEv
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* event */
@@ -3804,37 +4057,55 @@ PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getFromBuffer(PackedStartEv
         self->qdp = msg[startIndex++];
 
         /* elapsed time */
-        CP16Time2a_getFromBuffer(&(self->elapsedTime), msg, msgSize, startIndex);
+        CP16Time2a_decode(&(self->elapsedTime), msg, startIndex);
         startIndex += 2;
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+PackedStartEventsOfProtectionEquipmentWithCP56Time2a
+PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getFromBuffer(PackedStartEventsOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 11;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return PackedStartEventsOfProtectionEquipmentWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * PacketOutputCircuitInfo : InformationObject
  ***********************************************************************/
 
 static bool
-PacketOutputCircuitInfo_encode(PackedOutputCircuitInfo self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+PacketOutputCircuitInfo_encode(PackedOutputCircuitInfo self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 7 : (parameters->sizeOfIOA + 7);
+    int size = isSequence ? 7 : (CS101_SIZE_OF_IOA(parameters) + 7);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, (uint8_t) self->oci);
+    FrameSpan_setNextByte(span, (uint8_t) self->oci);
 
-    Frame_setNextByte(frame, (uint8_t) self->qdp);
+    FrameSpan_setNextByte(span, (uint8_t) self->qdp);
 
-    Frame_appendBytes(frame, self->operatingTime.encodedValue, 2);
+    FrameSpan_appendBytes(span, self->operatingTime.encodedValue, 2);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 3);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 3);
 
     return true;
 }
@@ -3902,20 +4173,9 @@ PackedOutputCircuitInfo_getTimestamp(PackedOutputCircuitInfo self)
 }
 
 PackedOutputCircuitInfo
-PackedOutputCircuitInfo_getFromBuffer(PackedOutputCircuitInfo self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+PackedOutputCircuitInfo_decode(PackedOutputCircuitInfo self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 7;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (PackedOutputCircuitInfo) GLOBAL_MALLOC(sizeof(struct sPackedOutputCircuitInfo));
 
@@ -3925,7 +4185,7 @@ PackedOutputCircuitInfo_getFromBuffer(PackedOutputCircuitInfo self, CS101_AppLay
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* OCI - output circuit information */
@@ -3935,37 +4195,55 @@ PackedOutputCircuitInfo_getFromBuffer(PackedOutputCircuitInfo self, CS101_AppLay
         self->qdp = msg[startIndex++];
 
         /* operating time */
-        CP16Time2a_getFromBuffer(&(self->operatingTime), msg, msgSize, startIndex);
+        CP16Time2a_decode(&(self->operatingTime), msg, startIndex);
         startIndex += 2;
 
         /* timestamp */
-        CP24Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP24Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+PackedOutputCircuitInfo
+PackedOutputCircuitInfo_getFromBuffer(PackedOutputCircuitInfo self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 7;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return PackedOutputCircuitInfo_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /***********************************************************************
  * PackedOutputCircuitInfoWithCP56Time2a : InformationObject
  ***********************************************************************/
 
 static bool
-PackedOutputCircuitInfoWithCP56Time2a_encode(PackedOutputCircuitInfoWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+PackedOutputCircuitInfoWithCP56Time2a_encode(PackedOutputCircuitInfoWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 11 : (parameters->sizeOfIOA + 11);
+    int size = isSequence ? 11 : (CS101_SIZE_OF_IOA(parameters) + 11);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, (uint8_t) self->oci);
+    FrameSpan_setNextByte(span, (uint8_t) self->oci);
 
-    Frame_setNextByte(frame, (uint8_t) self->qdp);
+    FrameSpan_setNextByte(span, (uint8_t) self->qdp);
 
-    Frame_appendBytes(frame, self->operatingTime.encodedValue, 2);
+    FrameSpan_appendBytes(span, self->operatingTime.encodedValue, 2);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -4033,20 +4311,9 @@ PackedOutputCircuitInfoWithCP56Time2a_getTimestamp(PackedOutputCircuitInfoWithCP
 }
 
 PackedOutputCircuitInfoWithCP56Time2a
-PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer(PackedOutputCircuitInfoWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+PackedOutputCircuitInfoWithCP56Time2a_decode(PackedOutputCircuitInfoWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 11;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (PackedOutputCircuitInfoWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sPackedOutputCircuitInfoWithCP56Time2a));
 
@@ -4056,7 +4323,7 @@ PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer(PackedOutputCircuitInfoWithC
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* OCI - output circuit information */
@@ -4066,14 +4333,32 @@ PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer(PackedOutputCircuitInfoWithC
         self->qdp = msg[startIndex++];
 
         /* operating time */
-        CP16Time2a_getFromBuffer(&(self->operatingTime), msg, msgSize, startIndex);
+        CP16Time2a_decode(&(self->operatingTime), msg, startIndex);
         startIndex += 2;
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
+    }
+
+    return self;
+}
+
+PackedOutputCircuitInfoWithCP56Time2a
+PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer(PackedOutputCircuitInfoWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 11;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
     }
 
-    return self;
+    return PackedOutputCircuitInfoWithCP56Time2a_decode(self, parameters, msg, startIndex, isSequence);
 }
 
 
@@ -4082,18 +4367,18 @@ PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer(PackedOutputCircuitInfoWithC
  ***********************************************************************/
 
 static bool
-PackedSinglePointWithSCD_encode(PackedSinglePointWithSCD self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+PackedSinglePointWithSCD_encode(PackedSinglePointWithSCD self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 5 : (parameters->sizeOfIOA + 5);
+    int size = isSequence ? 5 : (CS101_SIZE_OF_IOA(parameters) + 5);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->scd.encodedValue, 4);
+    FrameSpan_appendBytes(span, self->scd.encodedValue, 4);
 
-    Frame_setNextByte(frame, (uint8_t) self->qds);
+    FrameSpan_setNextByte(span, (uint8_t) self->qds);
 
     return true;
 }
@@ -4147,20 +4432,9 @@ PackedSinglePointWithSCD_getSCD(PackedSinglePointWithSCD self)
 }
 
 PackedSinglePointWithSCD
-PackedSinglePointWithSCD_getFromBuffer(PackedSinglePointWithSCD self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+PackedSinglePointWithSCD_decode(PackedSinglePointWithSCD self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + 5;
-
-    if (!isSequence)
-        minSize += parameters->sizeOfIOA;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (PackedSinglePointWithSCD) GLOBAL_MALLOC(sizeof(struct sPackedSinglePointWithSCD));
 
@@ -4170,7 +4444,7 @@ PackedSinglePointWithSCD_getFromBuffer(PackedSinglePointWithSCD self, CS101_AppL
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         /* SCD */
@@ -4186,21 +4460,39 @@ PackedSinglePointWithSCD_getFromBuffer(PackedSinglePointWithSCD self, CS101_AppL
     return self;
 }
 
+PackedSinglePointWithSCD
+PackedSinglePointWithSCD_getFromBuffer(PackedSinglePointWithSCD self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + 5;
+
+    if (!isSequence)
+        minSize += CS101_SIZE_OF_IOA(parameters);
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return PackedSinglePointWithSCD_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*******************************************
  * SingleCommand
  *******************************************/
 
 static bool
-SingleCommand_encode(SingleCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SingleCommand_encode(SingleCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->sco);
+    FrameSpan_setNextByte(span, self->sco);
 
     return true;
 }
@@ -4265,17 +4557,9 @@ SingleCommand_isSelect(SingleCommand self)
 }
 
 SingleCommand
-SingleCommand_getFromBuffer(SingleCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SingleCommand_decode(SingleCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SingleCommand) GLOBAL_MALLOC(sizeof(struct sSingleCommand));
 
@@ -4284,7 +4568,7 @@ SingleCommand_getFromBuffer(SingleCommand self, CS101_AppLayerParameters paramet
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* SCO */
         self->sco = msg[startIndex];
@@ -4293,22 +4577,37 @@ SingleCommand_getFromBuffer(SingleCommand self, CS101_AppLayerParameters paramet
     return self;
 }
 
+SingleCommand
+SingleCommand_getFromBuffer(SingleCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SingleCommand_decode(self, parameters, msg, startIndex);
+}
+
 
 /***********************************************************************
  * SingleCommandWithCP56Time2a : SingleCommand
  ***********************************************************************/
 
 static bool
-SingleCommandWithCP56Time2a_encode(SingleCommandWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SingleCommandWithCP56Time2a_encode(SingleCommandWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    SingleCommand_encode((SingleCommand) self, frame, parameters, isSequence);
+    SingleCommand_encode((SingleCommand) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -4363,17 +4662,9 @@ SingleCommandWithCP56Time2a_getTimestamp(SingleCommandWithCP56Time2a self)
 }
 
 SingleCommandWithCP56Time2a
-SingleCommandWithCP56Time2a_getFromBuffer(SingleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SingleCommandWithCP56Time2a_decode(SingleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 8;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SingleCommandWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sSingleCommandWithCP56Time2a));
 
@@ -4382,33 +4673,48 @@ SingleCommandWithCP56Time2a_getFromBuffer(SingleCommandWithCP56Time2a self, CS10
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* SCO */
         self->sco = msg[startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+SingleCommandWithCP56Time2a
+SingleCommandWithCP56Time2a_getFromBuffer(SingleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 8;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SingleCommandWithCP56Time2a_decode(self, parameters, msg, startIndex);
+}
+
 /*******************************************
  * DoubleCommand : InformationObject
  *******************************************/
 
 static bool
-DoubleCommand_encode(DoubleCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+DoubleCommand_encode(DoubleCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->dcq);
+    FrameSpan_setNextByte(span, self->dcq);
 
     return true;
 }
@@ -4473,17 +4779,9 @@ DoubleCommand_isSelect(DoubleCommand self)
 }
 
 DoubleCommand
-DoubleCommand_getFromBuffer(DoubleCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+DoubleCommand_decode(DoubleCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (DoubleCommand) GLOBAL_MALLOC(sizeof(struct sDoubleCommand));
 
@@ -4492,7 +4790,7 @@ DoubleCommand_getFromBuffer(DoubleCommand self, CS101_AppLayerParameters paramet
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* SCO */
         self->dcq = msg[startIndex];
@@ -4501,21 +4799,36 @@ DoubleCommand_getFromBuffer(DoubleCommand self, CS101_AppLayerParameters paramet
     return self;
 }
 
+DoubleCommand
+DoubleCommand_getFromBuffer(DoubleCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return DoubleCommand_decode(self, parameters, msg, startIndex);
+}
+
 /**********************************************
  * DoubleCommandWithCP56Time2a : DoubleCommand
  **********************************************/
 
 static bool
-DoubleCommandWithCP56Time2a_encode(DoubleCommandWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+DoubleCommandWithCP56Time2a_encode(DoubleCommandWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    DoubleCommand_encode((DoubleCommand) self, frame, parameters, isSequence);
+    DoubleCommand_encode((DoubleCommand) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -4582,17 +4895,9 @@ DoubleCommandWithCP56Time2a_isSelect(DoubleCommandWithCP56Time2a self)
 }
 
 DoubleCommandWithCP56Time2a
-DoubleCommandWithCP56Time2a_getFromBuffer(DoubleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+DoubleCommandWithCP56Time2a_decode(DoubleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 8;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (DoubleCommandWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sDoubleCommandWithCP56Time2a));
 
@@ -4601,18 +4906,33 @@ DoubleCommandWithCP56Time2a_getFromBuffer(DoubleCommandWithCP56Time2a self, CS10
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* DCQ */
         self->dcq = msg[startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+DoubleCommandWithCP56Time2a
+DoubleCommandWithCP56Time2a_getFromBuffer(DoubleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 8;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return DoubleCommandWithCP56Time2a_decode(self, parameters, msg, startIndex);
+}
+
 CP56Time2a
 DoubleCommandWithCP56Time2a_getTimestamp(DoubleCommandWithCP56Time2a self)
 {
@@ -4624,16 +4944,16 @@ DoubleCommandWithCP56Time2a_getTimestamp(DoubleCommandWithCP56Time2a self)
  *******************************************/
 
 static bool
-StepCommand_encode(StepCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+StepCommand_encode(StepCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->dcq);
+    FrameSpan_setNextByte(span, self->dcq);
 
     return true;
 }
@@ -4699,17 +5019,9 @@ StepCommand_isSelect(StepCommand self)
 }
 
 StepCommand
-StepCommand_getFromBuffer(StepCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+StepCommand_decode(StepCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (StepCommand) GLOBAL_MALLOC(sizeof(struct sStepCommand));
 
@@ -4718,7 +5030,7 @@ StepCommand_getFromBuffer(StepCommand self, CS101_AppLayerParameters parameters,
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* SCO */
         self->dcq = msg[startIndex];
@@ -4727,21 +5039,36 @@ StepCommand_getFromBuffer(StepCommand self, CS101_AppLayerParameters parameters,
     return self;
 }
 
+StepCommand
+StepCommand_getFromBuffer(StepCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return StepCommand_decode(self, parameters, msg, startIndex);
+}
+
 /*************************************************
  * StepCommandWithCP56Time2a : InformationObject
  *************************************************/
 
 static bool
-StepCommandWithCP56Time2a_encode(StepCommandWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+StepCommandWithCP56Time2a_encode(StepCommandWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 8 : (parameters->sizeOfIOA + 8);
+    int size = isSequence ? 8 : (CS101_SIZE_OF_IOA(parameters) + 8);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    StepCommand_encode((StepCommand) self, frame, parameters, isSequence);
+    StepCommand_encode((StepCommand) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -4808,17 +5135,9 @@ StepCommandWithCP56Time2a_isSelect(StepCommandWithCP56Time2a self)
 }
 
 StepCommandWithCP56Time2a
-StepCommandWithCP56Time2a_getFromBuffer(StepCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+StepCommandWithCP56Time2a_decode(StepCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 8;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (StepCommandWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sStepCommandWithCP56Time2a));
 
@@ -4827,18 +5146,33 @@ StepCommandWithCP56Time2a_getFromBuffer(StepCommandWithCP56Time2a self, CS101_Ap
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* SCO */
         self->dcq = msg[startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+StepCommandWithCP56Time2a
+StepCommandWithCP56Time2a_getFromBuffer(StepCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 8;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return StepCommandWithCP56Time2a_decode(self, parameters, msg, startIndex);
+}
+
 CP56Time2a
 StepCommandWithCP56Time2a_getTimestamp(StepCommandWithCP56Time2a self)
 {
@@ -4850,17 +5184,17 @@ StepCommandWithCP56Time2a_getTimestamp(StepCommandWithCP56Time2a self)
  ************************************************/
 
 static bool
-SetpointCommandNormalized_encode(SetpointCommandNormalized self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SetpointCommandNormalized_encode(SetpointCommandNormalized self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 3 : (parameters->sizeOfIOA + 3);
+    int size = isSequence ? 3 : (CS101_SIZE_OF_IOA(parameters) + 3);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->encodedValue, 2);
-    Frame_setNextByte(frame, self->qos);
+    FrameSpan_appendBytes(span, self->encodedValue, 2);
+    FrameSpan_setNextByte(span, self->qos);
 
     return true;
 }
@@ -4929,17 +5263,9 @@ SetpointCommandNormalized_isSelect(SetpointCommandNormalized self)
 }
 
 SetpointCommandNormalized
-SetpointCommandNormalized_getFromBuffer(SetpointCommandNormalized self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SetpointCommandNormalized_decode(SetpointCommandNormalized self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 3;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SetpointCommandNormalized) GLOBAL_MALLOC(sizeof(struct sSetpointCommandNormalized));
 
@@ -4948,7 +5274,7 @@ SetpointCommandNormalized_getFromBuffer(SetpointCommandNormalized self, CS101_Ap
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->encodedValue[0] = msg[startIndex++];
         self->encodedValue[1] = msg[startIndex++];
@@ -4960,21 +5286,36 @@ SetpointCommandNormalized_getFromBuffer(SetpointCommandNormalized self, CS101_Ap
     return self;
 }
 
+SetpointCommandNormalized
+SetpointCommandNormalized_getFromBuffer(SetpointCommandNormalized self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 3;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SetpointCommandNormalized_decode(self, parameters, msg, startIndex);
+}
+
 /**********************************************************************
  * SetpointCommandNormalizedWithCP56Time2a : SetpointCommandNormalized
  **********************************************************************/
 
 static bool
-SetpointCommandNormalizedWithCP56Time2a_encode(SetpointCommandNormalizedWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SetpointCommandNormalizedWithCP56Time2a_encode(SetpointCommandNormalizedWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 10 : (parameters->sizeOfIOA + 10);
+    int size = isSequence ? 10 : (CS101_SIZE_OF_IOA(parameters) + 10);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    SetpointCommandNormalized_encode((SetpointCommandNormalized) self, frame, parameters, isSequence);
+    SetpointCommandNormalized_encode((SetpointCommandNormalized) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -5043,17 +5384,9 @@ SetpointCommandNormalizedWithCP56Time2a_isSelect(SetpointCommandNormalizedWithCP
 }
 
 SetpointCommandNormalizedWithCP56Time2a
-SetpointCommandNormalizedWithCP56Time2a_getFromBuffer(SetpointCommandNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SetpointCommandNormalizedWithCP56Time2a_decode(SetpointCommandNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 10;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (SetpointCommandNormalizedWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sSetpointCommandNormalizedWithCP56Time2a));
 
@@ -5062,7 +5395,7 @@ SetpointCommandNormalizedWithCP56Time2a_getFromBuffer(SetpointCommandNormalizedW
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->encodedValue[0] = msg[startIndex++];
         self->encodedValue[1] = msg[startIndex++];
@@ -5071,12 +5404,27 @@ SetpointCommandNormalizedWithCP56Time2a_getFromBuffer(SetpointCommandNormalizedW
         self->qos = msg[startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+SetpointCommandNormalizedWithCP56Time2a
+SetpointCommandNormalizedWithCP56Time2a_getFromBuffer(SetpointCommandNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 10;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SetpointCommandNormalizedWithCP56Time2a_decode(self, parameters, msg, startIndex);
+}
+
 CP56Time2a
 SetpointCommandNormalizedWithCP56Time2a_getTimestamp(SetpointCommandNormalizedWithCP56Time2a self)
 {
@@ -5088,17 +5436,17 @@ SetpointCommandNormalizedWithCP56Time2a_getTimestamp(SetpointCommandNormalizedWi
  ************************************************/
 
 static bool
-SetpointCommandScaled_encode(SetpointCommandScaled self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SetpointCommandScaled_encode(SetpointCommandScaled self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 3 : (parameters->sizeOfIOA + 3);
+    int size = isSequence ? 3 : (CS101_SIZE_OF_IOA(parameters) + 3);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->encodedValue, 2);
-    Frame_setNextByte(frame, self->qos);
+    FrameSpan_appendBytes(span, self->encodedValue, 2);
+    FrameSpan_setNextByte(span, self->qos);
 
     return true;
 }
@@ -5163,17 +5511,9 @@ SetpointCommandScaled_isSelect(SetpointCommandScaled self)
 }
 
 SetpointCommandScaled
-SetpointCommandScaled_getFromBuffer(SetpointCommandScaled self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SetpointCommandScaled_decode(SetpointCommandScaled self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 3;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SetpointCommandScaled) GLOBAL_MALLOC(sizeof(struct sSetpointCommandScaled));
 
@@ -5182,7 +5522,7 @@ SetpointCommandScaled_getFromBuffer(SetpointCommandScaled self, CS101_AppLayerPa
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->encodedValue[0] = msg[startIndex++];
         self->encodedValue[1] = msg[startIndex++];
@@ -5194,21 +5534,36 @@ SetpointCommandScaled_getFromBuffer(SetpointCommandScaled self, CS101_AppLayerPa
     return self;
 }
 
+SetpointCommandScaled
+SetpointCommandScaled_getFromBuffer(SetpointCommandScaled self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 3;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SetpointCommandScaled_decode(self, parameters, msg, startIndex);
+}
+
 /**********************************************************************
  * SetpointCommandScaledWithCP56Time2a : SetpointCommandScaled
  **********************************************************************/
 
 static bool
-SetpointCommandScaledWithCP56Time2a_encode(SetpointCommandScaledWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SetpointCommandScaledWithCP56Time2a_encode(SetpointCommandScaledWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 10 : (parameters->sizeOfIOA + 10);
+    int size = isSequence ? 10 : (CS101_SIZE_OF_IOA(parameters) + 10);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    SetpointCommandScaled_encode((SetpointCommandScaled) self, frame, parameters, isSequence);
+    SetpointCommandScaled_encode((SetpointCommandScaled) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -5275,17 +5630,9 @@ SetpointCommandScaledWithCP56Time2a_isSelect(SetpointCommandScaledWithCP56Time2a
 }
 
 SetpointCommandScaledWithCP56Time2a
-SetpointCommandScaledWithCP56Time2a_getFromBuffer(SetpointCommandScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SetpointCommandScaledWithCP56Time2a_decode(SetpointCommandScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 10;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (SetpointCommandScaledWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sSetpointCommandScaledWithCP56Time2a));
 
@@ -5294,19 +5641,34 @@ SetpointCommandScaledWithCP56Time2a_getFromBuffer(SetpointCommandScaledWithCP56T
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->encodedValue[0] = msg[startIndex++];
         self->encodedValue[1] = msg[startIndex++];
 
-        /* QOS - qualifier of setpoint command */
-        self->qos = msg[startIndex++];
+        /* QOS - qualifier of setpoint command */
+        self->qos = msg[startIndex++];
+
+        /* timestamp */
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
+    }
+
+    return self;
+}
+
+SetpointCommandScaledWithCP56Time2a
+SetpointCommandScaledWithCP56Time2a_getFromBuffer(SetpointCommandScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 10;
 
-        /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
     }
 
-    return self;
+    return SetpointCommandScaledWithCP56Time2a_decode(self, parameters, msg, startIndex);
 }
 
 CP56Time2a
@@ -5320,27 +5682,27 @@ SetpointCommandScaledWithCP56Time2a_getTimestamp(SetpointCommandScaledWithCP56Ti
  ************************************************/
 
 static bool
-SetpointCommandShort_encode(SetpointCommandShort self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SetpointCommandShort_encode(SetpointCommandShort self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 5 : (parameters->sizeOfIOA + 5);
+    int size = isSequence ? 5 : (CS101_SIZE_OF_IOA(parameters) + 5);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t* valueBytes = (uint8_t*) &(self->value);
 
 #if (ORDER_LITTLE_ENDIAN == 1)
-    Frame_appendBytes(frame, valueBytes, 4);
+    FrameSpan_appendBytes(span, valueBytes, 4);
 #else
-    Frame_setNextByte(frame, valueBytes[3]);
-    Frame_setNextByte(frame, valueBytes[2]);
-    Frame_setNextByte(frame, valueBytes[1]);
-    Frame_setNextByte(frame, valueBytes[0]);
+    FrameSpan_setNextByte(span, valueBytes[3]);
+    FrameSpan_setNextByte(span, valueBytes[2]);
+    FrameSpan_setNextByte(span, valueBytes[1]);
+    FrameSpan_setNextByte(span, valueBytes[0]);
 #endif
 
-    Frame_setNextByte(frame, self->qos);
+    FrameSpan_setNextByte(span, self->qos);
 
     return true;
 }
@@ -5405,17 +5767,9 @@ SetpointCommandShort_isSelect(SetpointCommandShort self)
 }
 
 SetpointCommandShort
-SetpointCommandShort_getFromBuffer(SetpointCommandShort self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SetpointCommandShort_decode(SetpointCommandShort self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 5;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (SetpointCommandShort) GLOBAL_MALLOC(sizeof(struct sSetpointCommandShort));
 
@@ -5424,7 +5778,7 @@ SetpointCommandShort_getFromBuffer(SetpointCommandShort self, CS101_AppLayerPara
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         uint8_t* valueBytes = (uint8_t*) &(self->value);
 
@@ -5447,21 +5801,36 @@ SetpointCommandShort_getFromBuffer(SetpointCommandShort self, CS101_AppLayerPara
     return self;
 }
 
+SetpointCommandShort
+SetpointCommandShort_getFromBuffer(SetpointCommandShort self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 5;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SetpointCommandShort_decode(self, parameters, msg, startIndex);
+}
+
 /**********************************************************************
  * SetpointCommandShortWithCP56Time2a : SetpointCommandShort
  **********************************************************************/
 
 static bool
-SetpointCommandShortWithCP56Time2a_encode(SetpointCommandShortWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SetpointCommandShortWithCP56Time2a_encode(SetpointCommandShortWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 12 : (parameters->sizeOfIOA + 12);
+    int size = isSequence ? 12 : (CS101_SIZE_OF_IOA(parameters) + 12);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    SetpointCommandShort_encode((SetpointCommandShort) self, frame, parameters, isSequence);
+    SetpointCommandShort_encode((SetpointCommandShort) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -5528,17 +5897,9 @@ SetpointCommandShortWithCP56Time2a_isSelect(SetpointCommandShortWithCP56Time2a s
 }
 
 SetpointCommandShortWithCP56Time2a
-SetpointCommandShortWithCP56Time2a_getFromBuffer(SetpointCommandShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SetpointCommandShortWithCP56Time2a_decode(SetpointCommandShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 12;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (SetpointCommandShortWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sSetpointCommandShortWithCP56Time2a));
 
@@ -5547,7 +5908,7 @@ SetpointCommandShortWithCP56Time2a_getFromBuffer(SetpointCommandShortWithCP56Tim
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         uint8_t* valueBytes = (uint8_t*) &(self->value);
 
@@ -5567,12 +5928,27 @@ SetpointCommandShortWithCP56Time2a_getFromBuffer(SetpointCommandShortWithCP56Tim
         self->qos = msg[startIndex++];
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+SetpointCommandShortWithCP56Time2a
+SetpointCommandShortWithCP56Time2a_getFromBuffer(SetpointCommandShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 12;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return SetpointCommandShortWithCP56Time2a_decode(self, parameters, msg, startIndex);
+}
+
 CP56Time2a
 SetpointCommandShortWithCP56Time2a_getTimestamp(SetpointCommandShortWithCP56Time2a self)
 {
@@ -5584,24 +5960,24 @@ SetpointCommandShortWithCP56Time2a_getTimestamp(SetpointCommandShortWithCP56Time
  ************************************************/
 
 static bool
-Bitstring32Command_encode(Bitstring32Command self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+Bitstring32Command_encode(Bitstring32Command self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 5 : (parameters->sizeOfIOA + 5);
+    int size = isSequence ? 5 : (CS101_SIZE_OF_IOA(parameters) + 5);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     uint8_t* valueBytes = (uint8_t*) &(self->value);
 
 #if (ORDER_LITTLE_ENDIAN == 1)
-    Frame_appendBytes(frame, valueBytes, 4);
+    FrameSpan_appendBytes(span, valueBytes, 4);
 #else
-    Frame_setNextByte(frame, valueBytes[3]);
-    Frame_setNextByte(frame, valueBytes[2]);
-    Frame_setNextByte(frame, valueBytes[1]);
-    Frame_setNextByte(frame, valueBytes[0]);
+    FrameSpan_setNextByte(span, valueBytes[3]);
+    FrameSpan_setNextByte(span, valueBytes[2]);
+    FrameSpan_setNextByte(span, valueBytes[1]);
+    FrameSpan_setNextByte(span, valueBytes[0]);
 #endif
 
     return true;
@@ -5649,17 +6025,9 @@ Bitstring32Command_getValue(Bitstring32Command self)
 }
 
 Bitstring32Command
-Bitstring32Command_getFromBuffer(Bitstring32Command self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+Bitstring32Command_decode(Bitstring32Command self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 4;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (Bitstring32Command) GLOBAL_MALLOC(sizeof(struct sBitstring32Command));
 
@@ -5668,7 +6036,7 @@ Bitstring32Command_getFromBuffer(Bitstring32Command self, CS101_AppLayerParamete
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         uint8_t* valueBytes = (uint8_t*) &(self->value);
 
@@ -5688,21 +6056,36 @@ Bitstring32Command_getFromBuffer(Bitstring32Command self, CS101_AppLayerParamete
     return self;
 }
 
+Bitstring32Command
+Bitstring32Command_getFromBuffer(Bitstring32Command self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 4;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return Bitstring32Command_decode(self, parameters, msg, startIndex);
+}
+
 /*******************************************************
  * Bitstring32CommandWithCP56Time2a: Bitstring32Command
  *******************************************************/
 
 static bool
-Bitstring32CommandWithCP56Time2a_encode(Bitstring32CommandWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+Bitstring32CommandWithCP56Time2a_encode(Bitstring32CommandWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 12 : (parameters->sizeOfIOA + 12);
+    int size = isSequence ? 12 : (CS101_SIZE_OF_IOA(parameters) + 12);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    Bitstring32Command_encode((Bitstring32Command) self, frame, parameters, isSequence);
+    Bitstring32Command_encode((Bitstring32Command) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -5757,17 +6140,9 @@ Bitstring32CommandWithCP56Time2a_getTimestamp(Bitstring32CommandWithCP56Time2a s
 }
 
 Bitstring32CommandWithCP56Time2a
-Bitstring32CommandWithCP56Time2a_getFromBuffer(Bitstring32CommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+Bitstring32CommandWithCP56Time2a_decode(Bitstring32CommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 11;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (Bitstring32CommandWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sBitstring32CommandWithCP56Time2a));
 
@@ -5776,7 +6151,7 @@ Bitstring32CommandWithCP56Time2a_getFromBuffer(Bitstring32CommandWithCP56Time2a
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         uint8_t* valueBytes = (uint8_t*) &(self->value);
 
@@ -5793,25 +6168,40 @@ Bitstring32CommandWithCP56Time2a_getFromBuffer(Bitstring32CommandWithCP56Time2a
 #endif
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+Bitstring32CommandWithCP56Time2a
+Bitstring32CommandWithCP56Time2a_getFromBuffer(Bitstring32CommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 11;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return Bitstring32CommandWithCP56Time2a_decode(self, parameters, msg, startIndex);
+}
+
 /*************************************************
  * ReadCommand : InformationObject
  ************************************************/
 
 static bool
-ReadCommand_encode(ReadCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+ReadCommand_encode(ReadCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 0 : (parameters->sizeOfIOA + 0);
+    int size = isSequence ? 0 : (CS101_SIZE_OF_IOA(parameters) + 0);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
     return true;
 }
@@ -5851,17 +6241,9 @@ ReadCommand_destroy(ReadCommand self)
 
 
 ReadCommand
-ReadCommand_getFromBuffer(ReadCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+ReadCommand_decode(ReadCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 0;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (ReadCommand) GLOBAL_MALLOC(sizeof(struct sReadCommand));
 
@@ -5874,21 +6256,36 @@ ReadCommand_getFromBuffer(ReadCommand self, CS101_AppLayerParameters parameters,
     return self;
 }
 
+ReadCommand
+ReadCommand_getFromBuffer(ReadCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 0;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return ReadCommand_decode(self, parameters, msg, startIndex);
+}
+
 /***************************************************
  * ClockSynchronizationCommand : InformationObject
  **************************************************/
 
 static bool
-ClockSynchronizationCommand_encode(ClockSynchronizationCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+ClockSynchronizationCommand_encode(ClockSynchronizationCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 7 : (parameters->sizeOfIOA + 7);
+    int size = isSequence ? 7 : (CS101_SIZE_OF_IOA(parameters) + 7);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -5934,17 +6331,9 @@ ClockSynchronizationCommand_getTime(ClockSynchronizationCommand self)
 }
 
 ClockSynchronizationCommand
-ClockSynchronizationCommand_getFromBuffer(ClockSynchronizationCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+ClockSynchronizationCommand_decode(ClockSynchronizationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 7;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (ClockSynchronizationCommand) GLOBAL_MALLOC(sizeof(struct sClockSynchronizationCommand));
 
@@ -5953,30 +6342,45 @@ ClockSynchronizationCommand_getFromBuffer(ClockSynchronizationCommand self, CS10
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+ClockSynchronizationCommand
+ClockSynchronizationCommand_getFromBuffer(ClockSynchronizationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 7;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return ClockSynchronizationCommand_decode(self, parameters, msg, startIndex);
+}
+
 /*************************************************
  * InterrogationCommand : InformationObject
  ************************************************/
 
 static bool
-InterrogationCommand_encode(InterrogationCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+InterrogationCommand_encode(InterrogationCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->qoi);
+    FrameSpan_setNextByte(span, self->qoi);
 
     return true;
 }
@@ -6023,17 +6427,9 @@ InterrogationCommand_getQOI(InterrogationCommand self)
 }
 
 InterrogationCommand
-InterrogationCommand_getFromBuffer(InterrogationCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+InterrogationCommand_decode(InterrogationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
 		self = (InterrogationCommand) GLOBAL_MALLOC(sizeof(struct sInterrogationCommand));
 
@@ -6042,7 +6438,7 @@ InterrogationCommand_getFromBuffer(InterrogationCommand self, CS101_AppLayerPara
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* QUI */
         self->qoi = msg[startIndex];
@@ -6051,21 +6447,36 @@ InterrogationCommand_getFromBuffer(InterrogationCommand self, CS101_AppLayerPara
     return self;
 }
 
+InterrogationCommand
+InterrogationCommand_getFromBuffer(InterrogationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return InterrogationCommand_decode(self, parameters, msg, startIndex);
+}
+
 /**************************************************
  * CounterInterrogationCommand : InformationObject
  **************************************************/
 
 static bool
-CounterInterrogationCommand_encode(CounterInterrogationCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+CounterInterrogationCommand_encode(CounterInterrogationCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->qcc);
+    FrameSpan_setNextByte(span, self->qcc);
 
     return true;
 }
@@ -6112,17 +6523,9 @@ CounterInterrogationCommand_getQCC(CounterInterrogationCommand self)
 }
 
 CounterInterrogationCommand
-CounterInterrogationCommand_getFromBuffer(CounterInterrogationCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+CounterInterrogationCommand_decode(CounterInterrogationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (CounterInterrogationCommand) GLOBAL_MALLOC(sizeof(struct sCounterInterrogationCommand));
 
@@ -6131,7 +6534,7 @@ CounterInterrogationCommand_getFromBuffer(CounterInterrogationCommand self, CS10
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* QCC */
         self->qcc = msg[startIndex];
@@ -6140,22 +6543,37 @@ CounterInterrogationCommand_getFromBuffer(CounterInterrogationCommand self, CS10
     return self;
 }
 
+CounterInterrogationCommand
+CounterInterrogationCommand_getFromBuffer(CounterInterrogationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return CounterInterrogationCommand_decode(self, parameters, msg, startIndex);
+}
+
 /*************************************************
  * TestCommand : InformationObject
  ************************************************/
 
 static bool
-TestCommand_encode(TestCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+TestCommand_encode(TestCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 2 : (parameters->sizeOfIOA + 2);
+    int size = isSequence ? 2 : (CS101_SIZE_OF_IOA(parameters) + 2);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->byte1);
-    Frame_setNextByte(frame, self->byte2);
+    FrameSpan_setNextByte(span, self->byte1);
+    FrameSpan_setNextByte(span, self->byte2);
 
     return true;
 }
@@ -6206,17 +6624,9 @@ TestCommand_isValid(TestCommand self)
 }
 
 TestCommand
-TestCommand_getFromBuffer(TestCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+TestCommand_decode(TestCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + 2;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (TestCommand) GLOBAL_MALLOC(sizeof(struct sTestCommand));
 
@@ -6225,7 +6635,7 @@ TestCommand_getFromBuffer(TestCommand self, CS101_AppLayerParameters parameters,
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* test bytes */
         self->byte1 = msg[startIndex++];
@@ -6235,24 +6645,39 @@ TestCommand_getFromBuffer(TestCommand self, CS101_AppLayerParameters parameters,
     return self;
 }
 
+TestCommand
+TestCommand_getFromBuffer(TestCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + 2;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return TestCommand_decode(self, parameters, msg, startIndex);
+}
+
 /*************************************************
  * TestCommandWithCP56Time2a : InformationObject
  ************************************************/
 
 static bool
-TestCommandWithCP56Time2a_encode(TestCommandWithCP56Time2a self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+TestCommandWithCP56Time2a_encode(TestCommandWithCP56Time2a self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 2 : (parameters->sizeOfIOA + 9);
+    int size = isSequence ? 2 : (CS101_SIZE_OF_IOA(parameters) + 9);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->tsc % 0x100);
-    Frame_setNextByte(frame, self->tsc / 0x100);
+    FrameSpan_setNextByte(span, self->tsc % 0x100);
+    FrameSpan_setNextByte(span, self->tsc / 0x100);
 
-    Frame_appendBytes(frame, self->timestamp.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->timestamp.encodedValue, 7);
 
     return true;
 }
@@ -6306,17 +6731,9 @@ TestCommandWithCP56Time2a_getTimestamp(TestCommandWithCP56Time2a self)
 }
 
 TestCommandWithCP56Time2a
-TestCommandWithCP56Time2a_getFromBuffer(TestCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+TestCommandWithCP56Time2a_decode(TestCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + 9;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (TestCommandWithCP56Time2a) GLOBAL_MALLOC(sizeof(struct sTestCommandWithCP56Time2a));
 
@@ -6325,34 +6742,49 @@ TestCommandWithCP56Time2a_getFromBuffer(TestCommandWithCP56Time2a self, CS101_Ap
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* test counter */
         self->tsc = msg[startIndex++];
         self->tsc += (msg[startIndex++] * 0x100);
 
         /* timestamp */
-        CP56Time2a_getFromBuffer(&(self->timestamp), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->timestamp), msg, startIndex);
     }
 
     return self;
 }
 
+TestCommandWithCP56Time2a
+TestCommandWithCP56Time2a_getFromBuffer(TestCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + 9;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return TestCommandWithCP56Time2a_decode(self, parameters, msg, startIndex);
+}
+
 /*************************************************
  * ResetProcessCommand : InformationObject
  ************************************************/
 
 static bool
-ResetProcessCommand_encode(ResetProcessCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+ResetProcessCommand_encode(ResetProcessCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->qrp);
+    FrameSpan_setNextByte(span, self->qrp);
 
     return true;
 }
@@ -6399,17 +6831,9 @@ ResetProcessCommand_getQRP(ResetProcessCommand self)
 }
 
 ResetProcessCommand
-ResetProcessCommand_getFromBuffer(ResetProcessCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
-{
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
+ResetProcessCommand_decode(ResetProcessCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
+{
     if (self == NULL)
         self = (ResetProcessCommand) GLOBAL_MALLOC(sizeof(struct sResetProcessCommand));
 
@@ -6418,7 +6842,7 @@ ResetProcessCommand_getFromBuffer(ResetProcessCommand self, CS101_AppLayerParame
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* QUI */
         self->qrp = msg[startIndex];
@@ -6427,21 +6851,36 @@ ResetProcessCommand_getFromBuffer(ResetProcessCommand self, CS101_AppLayerParame
     return self;
 }
 
+ResetProcessCommand
+ResetProcessCommand_getFromBuffer(ResetProcessCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return ResetProcessCommand_decode(self, parameters, msg, startIndex);
+}
+
 /*************************************************
  * DelayAcquisitionCommand : InformationObject
  ************************************************/
 
 static bool
-DelayAcquisitionCommand_encode(DelayAcquisitionCommand self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+DelayAcquisitionCommand_encode(DelayAcquisitionCommand self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 2 : (parameters->sizeOfIOA + 2);
+    int size = isSequence ? 2 : (CS101_SIZE_OF_IOA(parameters) + 2);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_appendBytes(frame, self->delay.encodedValue, 2);
+    FrameSpan_appendBytes(span, self->delay.encodedValue, 2);
 
     return true;
 }
@@ -6488,17 +6927,9 @@ DelayAcquisitionCommand_getDelay(DelayAcquisitionCommand self)
 }
 
 DelayAcquisitionCommand
-DelayAcquisitionCommand_getFromBuffer(DelayAcquisitionCommand self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+DelayAcquisitionCommand_decode(DelayAcquisitionCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 2;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (DelayAcquisitionCommand) GLOBAL_MALLOC(sizeof(struct sDelayAcquisitionCommand));
 
@@ -6507,30 +6938,45 @@ DelayAcquisitionCommand_getFromBuffer(DelayAcquisitionCommand self, CS101_AppLay
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* delay */
-        CP16Time2a_getFromBuffer(&(self->delay), msg, msgSize, startIndex);
+        CP16Time2a_decode(&(self->delay), msg, startIndex);
     }
 
     return self;
 }
 
+DelayAcquisitionCommand
+DelayAcquisitionCommand_getFromBuffer(DelayAcquisitionCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 2;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return DelayAcquisitionCommand_decode(self, parameters, msg, startIndex);
+}
+
 /*******************************************
  * ParameterActivation : InformationObject
  *******************************************/
 
 static bool
-ParameterActivation_encode(ParameterActivation self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+ParameterActivation_encode(ParameterActivation self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->qpa);
+    FrameSpan_setNextByte(span, self->qpa);
 
     return true;
 }
@@ -6576,17 +7022,9 @@ ParameterActivation_getQuality(ParameterActivation self)
 }
 
 ParameterActivation
-ParameterActivation_getFromBuffer(ParameterActivation self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+ParameterActivation_decode(ParameterActivation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
         self = (ParameterActivation) GLOBAL_MALLOC(sizeof(struct sParameterActivation));
 
@@ -6595,7 +7033,7 @@ ParameterActivation_getFromBuffer(ParameterActivation self, CS101_AppLayerParame
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* QPA */
         self->qpa = (QualifierOfParameterActivation) msg [startIndex++];
@@ -6604,21 +7042,36 @@ ParameterActivation_getFromBuffer(ParameterActivation self, CS101_AppLayerParame
     return self;
 }
 
+ParameterActivation
+ParameterActivation_getFromBuffer(ParameterActivation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return ParameterActivation_decode(self, parameters, msg, startIndex);
+}
+
 /*******************************************
  * EndOfInitialization : InformationObject
  *******************************************/
 
 static bool
-EndOfInitialization_encode(EndOfInitialization self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+EndOfInitialization_encode(EndOfInitialization self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte(frame, self->coi);
+    FrameSpan_setNextByte(span, self->coi);
 
     return true;
 }
@@ -6665,17 +7118,9 @@ EndOfInitialization_getCOI(EndOfInitialization self)
 }
 
 EndOfInitialization
-EndOfInitialization_getFromBuffer(EndOfInitialization self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+EndOfInitialization_decode(EndOfInitialization self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 1;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
        self = (EndOfInitialization) GLOBAL_MALLOC(sizeof(struct sEndOfInitialization));
 
@@ -6684,37 +7129,52 @@ EndOfInitialization_getFromBuffer(EndOfInitialization self, CS101_AppLayerParame
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         /* COI */
         self->coi = msg[startIndex];
     }
 
     return self;
-};
+}
+
+EndOfInitialization
+EndOfInitialization_getFromBuffer(EndOfInitialization self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 1;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return EndOfInitialization_decode(self, parameters, msg, startIndex);
+}
 
 /*******************************************
  * FileReady : InformationObject
  *******************************************/
 
 static bool
-FileReady_encode(FileReady self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+FileReady_encode(FileReady self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_setNextByte (frame, (uint8_t)(self->lengthOfFile % 0x100));
-    Frame_setNextByte (frame, (uint8_t)((self->lengthOfFile / 0x100) % 0x100));
-    Frame_setNextByte (frame, (uint8_t)((self->lengthOfFile / 0x10000) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)(self->lengthOfFile % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)((self->lengthOfFile / 0x100) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)((self->lengthOfFile / 0x10000) % 0x100));
 
-    Frame_setNextByte (frame, self->frq);
+    FrameSpan_setNextByte(span, self->frq);
 
     return true;
 }
@@ -6790,17 +7250,9 @@ FileReady_destroy(FileReady self)
 }
 
 FileReady
-FileReady_getFromBuffer(FileReady self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+FileReady_decode(FileReady self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 6;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
        self = (FileReady) GLOBAL_MALLOC(sizeof(struct sFileReady));
 
@@ -6809,7 +7261,7 @@ FileReady_getFromBuffer(FileReady self, CS101_AppLayerParameters parameters,
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->nof = msg[startIndex++];
         self->nof += (msg[startIndex++] * 0x100);
@@ -6823,32 +7275,47 @@ FileReady_getFromBuffer(FileReady self, CS101_AppLayerParameters parameters,
     }
 
     return self;
-};
+}
+
+FileReady
+FileReady_getFromBuffer(FileReady self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 6;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return FileReady_decode(self, parameters, msg, startIndex);
+}
 
 /*******************************************
  * SectionReady : InformationObject
  *******************************************/
 
 static bool
-SectionReady_encode(SectionReady self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+SectionReady_encode(SectionReady self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_setNextByte (frame, self->nameOfSection);
+    FrameSpan_setNextByte(span, self->nameOfSection);
 
-    Frame_setNextByte (frame, (uint8_t)(self->lengthOfSection % 0x100));
-    Frame_setNextByte (frame, (uint8_t)((self->lengthOfSection / 0x100) % 0x100));
-    Frame_setNextByte (frame, (uint8_t)((self->lengthOfSection / 0x10000) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)(self->lengthOfSection % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)((self->lengthOfSection / 0x100) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)((self->lengthOfSection / 0x10000) % 0x100));
 
-    Frame_setNextByte (frame, self->srq);
+    FrameSpan_setNextByte(span, self->srq);
 
     return true;
 }
@@ -6931,17 +7398,9 @@ SectionReady_destroy(SectionReady self)
 }
 
 SectionReady
-SectionReady_getFromBuffer(SectionReady self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+SectionReady_decode(SectionReady self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 7;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    };
-
     if (self == NULL)
        self = (SectionReady) GLOBAL_MALLOC(sizeof(struct sSectionReady));
 
@@ -6950,7 +7409,7 @@ SectionReady_getFromBuffer(SectionReady self, CS101_AppLayerParameters parameter
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->nof = msg[startIndex++];
         self->nof += (msg[startIndex++] * 0x100);
@@ -6965,28 +7424,43 @@ SectionReady_getFromBuffer(SectionReady self, CS101_AppLayerParameters parameter
     }
 
     return self;
-};
+}
+
+SectionReady
+SectionReady_getFromBuffer(SectionReady self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 7;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    };
+
+    return SectionReady_decode(self, parameters, msg, startIndex);
+}
 
 /*******************************************
  * FileCallOrSelect : InformationObject
  *******************************************/
 
 static bool
-FileCallOrSelect_encode(FileCallOrSelect self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+FileCallOrSelect_encode(FileCallOrSelect self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 1 : (parameters->sizeOfIOA + 1);
+    int size = isSequence ? 1 : (CS101_SIZE_OF_IOA(parameters) + 1);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_setNextByte (frame, self->nameOfSection);
+    FrameSpan_setNextByte(span, self->nameOfSection);
 
-    Frame_setNextByte (frame, self->scq);
+    FrameSpan_setNextByte(span, self->scq);
 
     return true;
 }
@@ -7047,17 +7521,9 @@ FileCallOrSelect_destroy(FileCallOrSelect self)
 }
 
 FileCallOrSelect
-FileCallOrSelect_getFromBuffer(FileCallOrSelect self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+FileCallOrSelect_decode(FileCallOrSelect self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 4;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
        self = (FileCallOrSelect) GLOBAL_MALLOC(sizeof(struct sFileCallOrSelect));
 
@@ -7066,7 +7532,7 @@ FileCallOrSelect_getFromBuffer(FileCallOrSelect self, CS101_AppLayerParameters p
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->nof = msg[startIndex++];
         self->nof += (msg[startIndex++] * 0x100);
@@ -7077,25 +7543,40 @@ FileCallOrSelect_getFromBuffer(FileCallOrSelect self, CS101_AppLayerParameters p
     }
 
     return self;
-};
+}
+
+FileCallOrSelect
+FileCallOrSelect_getFromBuffer(FileCallOrSelect self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 4;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return FileCallOrSelect_decode(self, parameters, msg, startIndex);
+}
 
 /*************************************************
  * FileLastSegmentOrSection : InformationObject
  *************************************************/
 
 static bool
-FileLastSegmentOrSection_encode(FileLastSegmentOrSection self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+FileLastSegmentOrSection_encode(FileLastSegmentOrSection self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_setNextByte (frame, self->nameOfSection);
+    FrameSpan_setNextByte(span, self->nameOfSection);
 
-    Frame_setNextByte (frame, self->lsq);
+    FrameSpan_setNextByte(span, self->lsq);
 
-    Frame_setNextByte (frame, self->chs);
+    FrameSpan_setNextByte(span, self->chs);
 
     return true;
 }
@@ -7162,17 +7643,9 @@ FileLastSegmentOrSection_destroy(FileLastSegmentOrSection self)
 }
 
 FileLastSegmentOrSection
-FileLastSegmentOrSection_getFromBuffer(FileLastSegmentOrSection self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+FileLastSegmentOrSection_decode(FileLastSegmentOrSection self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 5;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
        self = (FileLastSegmentOrSection) GLOBAL_MALLOC(sizeof(struct sFileLastSegmentOrSection));
 
@@ -7181,7 +7654,7 @@ FileLastSegmentOrSection_getFromBuffer(FileLastSegmentOrSection self, CS101_AppL
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->nof = msg[startIndex++];
         self->nof += (msg[startIndex++] * 0x100);
@@ -7194,23 +7667,38 @@ FileLastSegmentOrSection_getFromBuffer(FileLastSegmentOrSection self, CS101_AppL
     }
 
     return self;
-};
+}
+
+FileLastSegmentOrSection
+FileLastSegmentOrSection_getFromBuffer(FileLastSegmentOrSection self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 5;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return FileLastSegmentOrSection_decode(self, parameters, msg, startIndex);
+}
 
 /*************************************************
  * FileACK : InformationObject
  *************************************************/
 
 static bool
-FileACK_encode(FileACK self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+FileACK_encode(FileACK self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_setNextByte (frame, self->nameOfSection);
+    FrameSpan_setNextByte(span, self->nameOfSection);
 
-    Frame_setNextByte (frame, self->afq);
+    FrameSpan_setNextByte(span, self->afq);
 
     return true;
 }
@@ -7271,17 +7759,9 @@ FileACK_destroy(FileACK self)
 }
 
 FileACK
-FileACK_getFromBuffer(FileACK self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+FileACK_decode(FileACK self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 4;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
        self = (FileACK) GLOBAL_MALLOC(sizeof(struct sFileACK));
 
@@ -7290,7 +7770,7 @@ FileACK_getFromBuffer(FileACK self, CS101_AppLayerParameters parameters,
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->nof = msg[startIndex++];
         self->nof += (msg[startIndex++] * 0x100);
@@ -7301,28 +7781,43 @@ FileACK_getFromBuffer(FileACK self, CS101_AppLayerParameters parameters,
     }
 
     return self;
-};
+}
+
+FileACK
+FileACK_getFromBuffer(FileACK self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 4;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return FileACK_decode(self, parameters, msg, startIndex);
+}
 
 /*************************************************
  * FileSegment : InformationObject
  *************************************************/
 
 static bool
-FileSegment_encode(FileSegment self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+FileSegment_encode(FileSegment self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
     if (self->los > FileSegment_GetMaxDataSize(parameters))
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_setNextByte (frame, self->nameOfSection);
+    FrameSpan_setNextByte(span, self->nameOfSection);
 
-    Frame_setNextByte (frame, self->los);
+    FrameSpan_setNextByte(span, self->los);
 
-    Frame_appendBytes (frame, self->data, self->los);
+    FrameSpan_appendBytes(span, self->data, self->los);
 
     return true;
 }
@@ -7387,8 +7882,8 @@ int
 FileSegment_GetMaxDataSize(CS101_AppLayerParameters parameters)
 {
     int maxSize = parameters->maxSizeOfASDU -
-        parameters->sizeOfTypeId - parameters->sizeOfVSQ - parameters->sizeOfCA - parameters->sizeOfCOT
-        - parameters->sizeOfIOA - 4;
+        parameters->sizeOfTypeId - parameters->sizeOfVSQ - CS101_SIZE_OF_CA(parameters) - CS101_SIZE_OF_COT(parameters)
+        - CS101_SIZE_OF_IOA(parameters) - 4;
 
     return maxSize;
 }
@@ -7404,16 +7899,16 @@ FileSegment_getFromBuffer(FileSegment self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex)
 {
     /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 4;
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 4;
 
     if (minSize > msgSize) {
         DEBUG_PRINT("invalid ASDU - size too small\n");
         return NULL;
     }
 
-    uint8_t los = msg[startIndex + 3 + parameters->sizeOfIOA];
+    uint8_t los = msg[startIndex + 3 + CS101_SIZE_OF_IOA(parameters)];
 
-    if ((msgSize - startIndex) < (parameters->sizeOfIOA) + 4 + los)
+    if ((msgSize - startIndex) < (CS101_SIZE_OF_IOA(parameters)) + 4 + los)
         return NULL;
 
     if (self == NULL)
@@ -7424,7 +7919,7 @@ FileSegment_getFromBuffer(FileSegment self, CS101_AppLayerParameters parameters,
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->nof = msg[startIndex++];
         self->nof += (msg[startIndex++] * 0x100);
@@ -7444,25 +7939,25 @@ FileSegment_getFromBuffer(FileSegment self, CS101_AppLayerParameters parameters,
  *************************************************/
 
 static bool
-FileDirectory_encode(FileDirectory self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+FileDirectory_encode(FileDirectory self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 13 : (parameters->sizeOfIOA + 13);
+    int size = isSequence ? 13 : (CS101_SIZE_OF_IOA(parameters) + 13);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_setNextByte (frame, (uint8_t)(self->lengthOfFile % 0x100));
-    Frame_setNextByte (frame, (uint8_t)((self->lengthOfFile / 0x100) % 0x100));
-    Frame_setNextByte (frame, (uint8_t)((self->lengthOfFile / 0x10000) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)(self->lengthOfFile % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)((self->lengthOfFile / 0x100) % 0x100));
+    FrameSpan_setNextByte(span, (uint8_t)((self->lengthOfFile / 0x10000) % 0x100));
 
-    Frame_setNextByte (frame, self->sof);
+    FrameSpan_setNextByte(span, self->sof);
 
-    Frame_appendBytes(frame, self->creationTime.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->creationTime.encodedValue, 7);
 
     return true;
 }
@@ -7554,17 +8049,9 @@ FileDirectory_destroy(FileDirectory self)
 }
 
 FileDirectory
-FileDirectory_getFromBuffer(FileDirectory self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+FileDirectory_decode(FileDirectory self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 13;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
        self = (FileDirectory) GLOBAL_MALLOC(sizeof(struct sFileDirectory));
 
@@ -7575,7 +8062,7 @@ FileDirectory_getFromBuffer(FileDirectory self, CS101_AppLayerParameters paramet
         if (!isSequence) {
             InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-            startIndex += parameters->sizeOfIOA; /* skip IOA */
+            startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
         }
 
         self->nof = msg[startIndex++];
@@ -7588,31 +8075,46 @@ FileDirectory_getFromBuffer(FileDirectory self, CS101_AppLayerParameters paramet
 
         self->sof = msg[startIndex++];
 
-        CP56Time2a_getFromBuffer(&(self->creationTime), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->creationTime), msg, startIndex);
     }
 
     return self;
 }
 
+FileDirectory
+FileDirectory_getFromBuffer(FileDirectory self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex, bool isSequence)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 13;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return FileDirectory_decode(self, parameters, msg, startIndex, isSequence);
+}
+
 /*************************************************
  * QueryLog: InformationObject
  *************************************************/
 
 static bool
-QueryLog_encode(QueryLog self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence)
+QueryLog_encode(QueryLog self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence)
 {
-    int size = isSequence ? 16 : (parameters->sizeOfIOA + 16);
+    int size = isSequence ? 16 : (CS101_SIZE_OF_IOA(parameters) + 16);
 
-    if (Frame_getSpaceLeft(frame) < size)
+    if (FrameSpan_getSpaceLeft(span) < size)
         return false;
 
-    InformationObject_encodeBase((InformationObject) self, frame, parameters, isSequence);
+    InformationObject_encodeBase((InformationObject) self, span, parameters, isSequence);
 
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof % 256));
-    Frame_setNextByte (frame, (uint8_t)((int) self->nof / 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof % 256));
+    FrameSpan_setNextByte(span, (uint8_t)((int) self->nof / 256));
 
-    Frame_appendBytes(frame, self->rangeStartTime.encodedValue, 7);
-    Frame_appendBytes(frame, self->rangeStopTime.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->rangeStartTime.encodedValue, 7);
+    FrameSpan_appendBytes(span, self->rangeStopTime.encodedValue, 7);
 
     return true;
 }
@@ -7672,17 +8174,9 @@ QueryLog_destroy(QueryLog self)
 }
 
 QueryLog
-QueryLog_getFromBuffer(QueryLog self, CS101_AppLayerParameters parameters,
-        uint8_t* msg, int msgSize, int startIndex)
+QueryLog_decode(QueryLog self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex)
 {
-    /* check message size */
-    int minSize = startIndex + parameters->sizeOfIOA + 16;
-
-    if (minSize > msgSize) {
-        DEBUG_PRINT("invalid ASDU - size too small\n");
-        return NULL;
-    }
-
     if (self == NULL)
        self = (QueryLog) GLOBAL_MALLOC(sizeof(struct sQueryLog));
 
@@ -7692,16 +8186,31 @@ QueryLog_getFromBuffer(QueryLog self, CS101_AppLayerParameters parameters,
 
         InformationObject_getFromBuffer((InformationObject) self, parameters, msg, startIndex);
 
-        startIndex += parameters->sizeOfIOA; /* skip IOA */
+        startIndex += CS101_SIZE_OF_IOA(parameters); /* skip IOA */
 
         self->nof = msg[startIndex++];
         self->nof += (msg[startIndex++] * 0x100);
 
-        CP56Time2a_getFromBuffer(&(self->rangeStartTime), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->rangeStartTime), msg, startIndex);
         startIndex += 7;
 
-        CP56Time2a_getFromBuffer(&(self->rangeStopTime), msg, msgSize, startIndex);
+        CP56Time2a_decode(&(self->rangeStopTime), msg, startIndex);
     }
 
     return self;
 }
+
+QueryLog
+QueryLog_getFromBuffer(QueryLog self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int msgSize, int startIndex)
+{
+    /* check message size */
+    int minSize = startIndex + CS101_SIZE_OF_IOA(parameters) + 16;
+
+    if (minSize > msgSize) {
+        DEBUG_PRINT("invalid ASDU - size too small\n");
+        return NULL;
+    }
+
+    return QueryLog_decode(self, parameters, msg, startIndex);
+}
@@ -26,6 +26,7 @@
 #include <stdio.h>
 #include <string.h>
 #include "buffer_frame.h"
+#include "hal_time.h"
 #include "lib_memory.h"
 #include "apl_types_internal.h"
 #include "lib60870_config.h"
@@ -35,6 +36,7 @@
 #include "cs101_master.h"
 #include "cs101_queue.h"
 #include "cs101_asdu_internal.h"
+#include "cs101_mirror_internal.h"
 
 
 struct sCS101_Master
@@ -56,6 +58,9 @@ struct sCS101_Master
     CS101_ASDUReceivedHandler asduReceivedHandler;
     void* asduReceivedHandlerParameter;
 
+    CS101_Mirror mirror;
+    CS101_CommandTracker commandTracker;
+
     struct sCS101_Queue userDataQueue;
 
 #if (CONFIG_USE_THREADS == 1)
@@ -105,9 +110,15 @@ IBalancedApplicationLayer_HandleReceivedData (void* parameter, uint8_t* msg, boo
 
     CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(&_asdu, &(self->alParameters), msg + userDataStart, userDataLength);
 
+    if (self->mirror)
+        CS101_Mirror_handleASDUFromSource(self->mirror, asdu, self);
+
     if (self->asduReceivedHandler)
         self->asduReceivedHandler(self->asduReceivedHandlerParameter, 0, asdu);
 
+    if (asdu && self->commandTracker)
+        CS101_CommandTracker_handleASDU(self->commandTracker, asdu);
+
     return true;
 }
 
@@ -143,8 +154,14 @@ IPrimaryApplicationLayer_UserData(void* parameter, int slaveAddress, uint8_t* ms
 
     CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(&_asdu, &(self->alParameters), msg + start, length);
 
+    if (self->mirror)
+        CS101_Mirror_handleASDUFromSource(self->mirror, asdu, self);
+
     if (self->asduReceivedHandler)
         self->asduReceivedHandler(self->asduReceivedHandlerParameter, slaveAddress, asdu);
+
+    if (asdu && self->commandTracker)
+        CS101_CommandTracker_handleASDU(self->commandTracker, asdu);
 }
 
 static void
@@ -211,6 +228,8 @@ CS101_Master_createEx(SerialPort serialPort, const LinkLayerParameters llParamet
         }
 
         self->asduReceivedHandler = NULL;
+        self->mirror = NULL;
+        self->commandTracker = NULL;
 
 #if (CONFIG_USE_THREADS == 1)
         self->isRunning = false;
@@ -237,6 +256,12 @@ CS101_Master_run(CS101_Master self)
     else {
         LinkLayerBalanced_run(self->balancedLinkLayer);
     }
+
+    if (self->mirror)
+        CS101_Mirror_checkStations(self->mirror, Hal_getTimeInMs());
+
+    if (self->commandTracker)
+        CS101_CommandTracker_checkTimeouts(self->commandTracker);
 }
 
 #if (CONFIG_USE_THREADS == 1)
@@ -502,6 +527,18 @@ CS101_Master_setASDUReceivedHandler(CS101_Master self, CS101_ASDUReceivedHandler
     self->asduReceivedHandlerParameter = parameter;
 }
 
+void
+CS101_Master_setMirror(CS101_Master self, CS101_Mirror mirror)
+{
+    self->mirror = mirror;
+}
+
+void
+CS101_Master_setCommandTracker(CS101_Master self, CS101_CommandTracker tracker)
+{
+    self->commandTracker = tracker;
+}
+
 void
 CS101_Master_setLinkLayerStateChanged(CS101_Master self, IEC60870_LinkLayerStateChangedHandler handler, void* parameter)
 {
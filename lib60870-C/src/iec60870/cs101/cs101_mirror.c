@@ -0,0 +1,447 @@
+/*
+ *  cs101_mirror.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cs101_mirror_internal.h"
+#include "cs101_process_image_internal.h"
+#include "information_objects_internal.h"
+#include "seqlock.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_internal.h"
+
+/* maximum number of information objects of an ASDU (7 bit number of elements) */
+#define MAX_ELEMENTS_PER_ASDU 127
+
+typedef struct {
+    uint64_t lastUpdateTime;
+    int ca;
+    bool isStale;
+    const void* source; /* connection of the last update (NULL when updated by the application) */
+} MirrorStation;
+
+struct sCS101_Mirror {
+    CS101_ProcessImage processImage;
+
+    /* protects the point index (points are added when received) and the station table */
+    SeqLock tableLock;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    /* serializes the writers (a mirror can be shared by several connections) - the sequence lock supports only one writer */
+    Semaphore updateLock;
+#endif
+
+    MirrorStation* stations;
+    int maxNumberOfStations;
+    int numberOfStations;
+
+    int staleTimeout; /* in ms (0 = no timeout) */
+
+    CS101_MirrorChangeHandler changeHandler;
+    void* changeHandlerParameter;
+
+    CS101_MirrorStationHandler stationHandler;
+    void* stationHandlerParameter;
+};
+
+CS101_Mirror
+CS101_Mirror_create(int maxNumberOfPoints, int maxNumberOfStations)
+{
+    if (maxNumberOfStations < 1)
+        return NULL;
+
+    CS101_Mirror self = (CS101_Mirror) GLOBAL_CALLOC(1, sizeof(struct sCS101_Mirror));
+
+    if (self) {
+        self->processImage = CS101_ProcessImage_create(maxNumberOfPoints);
+        self->stations = (MirrorStation*) GLOBAL_CALLOC(maxNumberOfStations, sizeof(MirrorStation));
+        self->maxNumberOfStations = maxNumberOfStations;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->updateLock = Semaphore_create(1);
+#endif
+
+        if ((self->processImage == NULL) || (self->stations == NULL)) {
+            CS101_Mirror_destroy(self);
+            return NULL;
+        }
+    }
+
+    return self;
+}
+
+void
+CS101_Mirror_destroy(CS101_Mirror self)
+{
+    if (self) {
+        if (self->processImage)
+            CS101_ProcessImage_destroy(self->processImage);
+
+        GLOBAL_FREEMEM(self->stations);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        if (self->updateLock)
+            Semaphore_destroy(self->updateLock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+CS101_ProcessImage
+CS101_Mirror_getProcessImage(CS101_Mirror self)
+{
+    return self->processImage;
+}
+
+int
+CS101_Mirror_lookup(CS101_Mirror self, int ca, int ioa)
+{
+    int index;
+    uint32_t sequence;
+
+    do {
+        sequence = SeqLock_readBegin(&(self->tableLock));
+
+        index = CS101_ProcessImage_lookup(self->processImage, ca, ioa);
+    } while (SeqLock_readRetry(&(self->tableLock), sequence));
+
+    return index;
+}
+
+void
+CS101_Mirror_setChangeHandler(CS101_Mirror self, CS101_MirrorChangeHandler handler, void* parameter)
+{
+    self->changeHandler = handler;
+    self->changeHandlerParameter = parameter;
+}
+
+void
+CS101_Mirror_setStationHandler(CS101_Mirror self, CS101_MirrorStationHandler handler, void* parameter)
+{
+    self->stationHandler = handler;
+    self->stationHandlerParameter = parameter;
+}
+
+void
+CS101_Mirror_setStaleTimeout(CS101_Mirror self, int timeoutInMs)
+{
+    self->staleTimeout = timeoutInMs;
+}
+
+static bool
+isMirroredType(TypeID typeId)
+{
+    switch (typeId) {
+
+    case M_SP_NA_1:
+    case M_SP_TB_1:
+    case M_DP_NA_1:
+    case M_DP_TB_1:
+    case M_ST_NA_1:
+    case M_ST_TB_1:
+    case M_BO_NA_1:
+    case M_BO_TB_1:
+    case M_ME_NA_1:
+    case M_ME_TD_1:
+    case M_ME_ND_1:
+    case M_ME_NB_1:
+    case M_ME_TE_1:
+    case M_ME_NC_1:
+    case M_ME_TF_1:
+    case M_IT_NA_1:
+    case M_IT_TB_1:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+static void
+lockUpdate(CS101_Mirror self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->updateLock);
+#endif
+}
+
+static void
+unlockUpdate(CS101_Mirror self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->updateLock);
+#endif
+}
+
+/* has to be called with the update lock */
+static int
+addPoint(CS101_Mirror self, int ca, int ioa, TypeID typeId)
+{
+    SeqLock_writeBegin(&(self->tableLock));
+
+    int index = CS101_ProcessImage_addPoint(self->processImage, ca, ioa, typeId);
+
+    SeqLock_writeEnd(&(self->tableLock));
+
+    return index;
+}
+
+static MirrorStation*
+getStation(CS101_Mirror self, int ca)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfStations; i++) {
+        if (self->stations[i].ca == ca)
+            return &(self->stations[i]);
+    }
+
+    return NULL;
+}
+
+/* record an update of the station - returns true when the station was stale before */
+static bool
+updateStation(CS101_Mirror self, int ca, uint64_t time, const void* source)
+{
+    bool wasStale = false;
+
+    SeqLock_writeBegin(&(self->tableLock));
+
+    MirrorStation* station = getStation(self, ca);
+
+    if ((station == NULL) && (self->numberOfStations < self->maxNumberOfStations)) {
+        station = &(self->stations[self->numberOfStations]);
+
+        station->ca = ca;
+        station->isStale = true;
+
+        self->numberOfStations++;
+    }
+
+    if (station) {
+        wasStale = station->isStale;
+
+        station->lastUpdateTime = time;
+        station->isStale = false;
+        station->source = source;
+    }
+
+    SeqLock_writeEnd(&(self->tableLock));
+
+    return wasStale;
+}
+
+bool
+CS101_Mirror_handleASDUFromSource(CS101_Mirror self, CS101_ASDU asdu, const void* source)
+{
+    if (asdu == NULL)
+        return false;
+
+    TypeID typeId = CS101_ASDU_getTypeID(asdu);
+
+    if (isMirroredType(typeId) == false)
+        return false;
+
+    if (CS101_ASDU_isNegative(asdu) || CS101_ASDU_isTest(asdu))
+        return false;
+
+    int ca = CS101_ASDU_getCA(asdu);
+
+    uint64_t receptionTime = Hal_getTimeInMs();
+
+    int numberOfElements = CS101_ASDU_getNumberOfElements(asdu);
+
+    /* indices of the changed points of this ASDU */
+    int changedPoints[MAX_ELEMENTS_PER_ASDU];
+    int numberOfChangedPoints = 0;
+
+    union uInformationObject ioBuffer;
+
+    int i;
+
+    lockUpdate(self);
+
+    for (i = 0; i < numberOfElements; i++) {
+        InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) &ioBuffer, i);
+
+        if (io == NULL)
+            break;
+
+        int ioa = InformationObject_getObjectAddress(io);
+
+        /* the point index is only modified with the update lock -> no sequence lock required */
+        int index = CS101_ProcessImage_lookup(self->processImage, ca, ioa);
+
+        bool changed = true;
+
+        if (index == -1) {
+            index = addPoint(self, ca, ioa, typeId);
+
+            if (index == -1) {
+                DEBUG_PRINT("Mirror: cannot add point (CA: %i, IOA: %i)\n", ca, ioa);
+                continue;
+            }
+
+            CS101_ProcessImage_updateFromInformationObject(self->processImage, index, typeId, io, receptionTime, NULL);
+        }
+        else if (CS101_ProcessImage_updateFromInformationObject(self->processImage, index, typeId, io, receptionTime, &changed) == false) {
+            DEBUG_PRINT("Mirror: type %i doesn't match point (CA: %i, IOA: %i)\n", typeId, ca, ioa);
+            continue;
+        }
+
+        if (changed && (numberOfChangedPoints < MAX_ELEMENTS_PER_ASDU))
+            changedPoints[numberOfChangedPoints++] = index;
+    }
+
+    bool wasStale = updateStation(self, ca, receptionTime, source);
+
+    unlockUpdate(self);
+
+    /* the handlers are called without lock */
+    if (wasStale && self->stationHandler)
+        self->stationHandler(self->stationHandlerParameter, self, ca, false);
+
+    if ((numberOfChangedPoints > 0) && self->changeHandler)
+        self->changeHandler(self->changeHandlerParameter, self, changedPoints, numberOfChangedPoints);
+
+    return true;
+}
+
+bool
+CS101_Mirror_handleASDU(CS101_Mirror self, CS101_ASDU asdu)
+{
+    return CS101_Mirror_handleASDUFromSource(self, asdu, NULL);
+}
+
+/* mark the station with the given table index as stale - returns true when the state has changed */
+static bool
+setStationStale(CS101_Mirror self, int stationIndex, uint64_t currentTime, bool checkTimeout, const void* source)
+{
+    bool changed = false;
+
+    lockUpdate(self);
+
+    SeqLock_writeBegin(&(self->tableLock));
+
+    MirrorStation* station = &(self->stations[stationIndex]);
+
+    if ((station->isStale == false) && ((source == NULL) || (station->source == source))) {
+        if ((checkTimeout == false) || (currentTime >= station->lastUpdateTime + (uint64_t) self->staleTimeout)) {
+            station->isStale = true;
+            changed = true;
+        }
+    }
+
+    SeqLock_writeEnd(&(self->tableLock));
+
+    unlockUpdate(self);
+
+    return changed;
+}
+
+static int
+getNumberOfStations(CS101_Mirror self)
+{
+    lockUpdate(self);
+
+    int numberOfStations = self->numberOfStations;
+
+    unlockUpdate(self);
+
+    return numberOfStations;
+}
+
+void
+CS101_Mirror_checkStations(CS101_Mirror self, uint64_t currentTime)
+{
+    if (self->staleTimeout <= 0)
+        return;
+
+    int numberOfStations = getNumberOfStations(self);
+    int i;
+
+    for (i = 0; i < numberOfStations; i++) {
+        if (setStationStale(self, i, currentTime, true, NULL)) {
+            if (self->stationHandler)
+                self->stationHandler(self->stationHandlerParameter, self, self->stations[i].ca, true);
+        }
+    }
+}
+
+void
+CS101_Mirror_setStationsOfSourceStale(CS101_Mirror self, const void* source)
+{
+    int numberOfStations = getNumberOfStations(self);
+    int i;
+
+    for (i = 0; i < numberOfStations; i++) {
+        if (setStationStale(self, i, 0, false, source)) {
+            if (self->stationHandler)
+                self->stationHandler(self->stationHandlerParameter, self, self->stations[i].ca, true);
+        }
+    }
+}
+
+void
+CS101_Mirror_setStationsStale(CS101_Mirror self)
+{
+    CS101_Mirror_setStationsOfSourceStale(self, NULL);
+}
+
+bool
+CS101_Mirror_isStationStale(CS101_Mirror self, int ca)
+{
+    bool isStale;
+    uint32_t sequence;
+
+    do {
+        sequence = SeqLock_readBegin(&(self->tableLock));
+
+        MirrorStation* station = getStation(self, ca);
+
+        isStale = (station == NULL) || station->isStale;
+    } while (SeqLock_readRetry(&(self->tableLock), sequence));
+
+    return isStale;
+}
+
+uint64_t
+CS101_Mirror_getLastUpdateTime(CS101_Mirror self, int ca)
+{
+    uint64_t lastUpdateTime;
+    uint32_t sequence;
+
+    do {
+        sequence = SeqLock_readBegin(&(self->tableLock));
+
+        MirrorStation* station = getStation(self, ca);
+
+        lastUpdateTime = station ? station->lastUpdateTime : 0;
+    } while (SeqLock_readRetry(&(self->tableLock), sequence));
+
+    return lastUpdateTime;
+}
@@ -0,0 +1,1714 @@
+/*
+ *  cs101_process_image.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cs101_process_image.h"
+#include "cs101_process_image_internal.h"
+#include "information_objects_internal.h"
+#include "seqlock.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_internal.h"
+
+typedef enum {
+    VALUE_KIND_NONE = 0,
+    VALUE_KIND_SINGLE_POINT,
+    VALUE_KIND_DOUBLE_POINT,
+    VALUE_KIND_STEP_POSITION,
+    VALUE_KIND_BITSTRING32,
+    VALUE_KIND_NORMALIZED,
+    VALUE_KIND_SCALED,
+    VALUE_KIND_SHORT,
+    VALUE_KIND_INTEGRATED_TOTALS
+} ValueKind;
+
+/*
+ * Frozen state of integrated totals. The two buffers are written alternately by a freeze; the
+ * active buffer is switched after the inactive buffer has been written.
+ */
+typedef struct {
+    int32_t frozenValue[2];
+    uint64_t frozenTimestamp[2];
+    uint8_t frozenFlags[2]; /* sequence number and flags (last byte of the binary counter reading) */
+    uint8_t activeBuffer;
+    int32_t resetValue; /* running value at the last reset */
+} CounterState;
+
+/* raw value of a point - interpretation depends on the value kind */
+typedef union {
+    int32_t intValue;
+    uint32_t bits;
+    float floatValue;
+} PointValue;
+
+struct sCS101_ProcessImage {
+    int maxNumberOfPoints;
+    int numberOfPoints;
+
+    /* point configuration */
+    uint16_t* ca;
+    int32_t* ioa;
+    uint8_t* typeId;
+    uint8_t* valueKind;
+
+    /* point state */
+    PointValue* value;
+    uint8_t* quality; /* quality descriptor, or the last byte of the binary counter reading (sequence number and flags) */
+    uint64_t* timestamp;
+
+    /* hash index (CA, IOA) -> point index with linear probing. Empty slots are -1 */
+    int32_t* hashTable;
+    uint32_t hashMask;
+
+    /* interrogation group membership - one bitmap per group (0 = station, 1 ... 16 = groups) */
+    uint32_t* groupBits;
+    int groupBitsWords; /* number of 32 bit words per group bitmap */
+
+    /* bitmap of the CAs used by the points */
+    uint32_t* caBits;
+
+    /* state of integrated totals indexed by point index (allocated with the first integrated totals) */
+    CounterState* counters;
+
+    /* one sequence lock per block of points - protects the point state, the counter state, and the history */
+    SeqLock* blockSequence;
+
+    /*
+     * history of the changes of the point state - ring buffer of historyDepth entries per point. The arrays
+     * are parts of one memory block and are indexed by (point index * historyDepth + entry)
+     */
+    int historyDepth;
+    uint8_t* historyMemory;
+    uint64_t* historyTimestamp;
+    uint32_t* historyValue;
+    uint32_t* historyCount; /* number of changes recorded per point - the newest entry is (count - 1) % historyDepth */
+    uint8_t* historyQuality;
+};
+
+#define NUMBER_OF_CA_BITS_WORDS (0x10000 / 32)
+
+/* bitmaps of the counter groups follow the interrogation groups (0 = all integrated totals, 1 ... 4 = groups) */
+#define COUNTER_GROUP_BITMAP(group) (CS101_PROCESS_IMAGE_MAX_GROUP + 1 + (group))
+
+#define NUMBER_OF_GROUP_BITMAPS (CS101_PROCESS_IMAGE_MAX_GROUP + CS101_PROCESS_IMAGE_MAX_COUNTER_GROUP + 2)
+
+static ValueKind
+getValueKind(TypeID typeId)
+{
+    switch (typeId) {
+
+    case M_SP_NA_1:
+    case M_SP_TB_1:
+        return VALUE_KIND_SINGLE_POINT;
+
+    case M_DP_NA_1:
+    case M_DP_TB_1:
+        return VALUE_KIND_DOUBLE_POINT;
+
+    case M_ST_NA_1:
+    case M_ST_TB_1:
+        return VALUE_KIND_STEP_POSITION;
+
+    case M_BO_NA_1:
+    case M_BO_TB_1:
+        return VALUE_KIND_BITSTRING32;
+
+    case M_ME_NA_1:
+    case M_ME_TD_1:
+    case M_ME_ND_1:
+        return VALUE_KIND_NORMALIZED;
+
+    case M_ME_NB_1:
+    case M_ME_TE_1:
+        return VALUE_KIND_SCALED;
+
+    case M_ME_NC_1:
+    case M_ME_TF_1:
+        return VALUE_KIND_SHORT;
+
+    case M_IT_NA_1:
+    case M_IT_TB_1:
+        return VALUE_KIND_INTEGRATED_TOTALS;
+
+    default:
+        return VALUE_KIND_NONE;
+    }
+}
+
+static uint32_t
+getHash(CS101_ProcessImage self, int ca, int ioa)
+{
+    uint64_t key = ((uint64_t) ca << 24) | (uint64_t) (ioa & 0xffffff);
+
+    return (uint32_t) ((key * 0x9E3779B97F4A7C15ULL) >> 32) & self->hashMask;
+}
+
+static uint32_t*
+getGroupBitmap(CS101_ProcessImage self, int group)
+{
+    return self->groupBits + (group * self->groupBitsWords);
+}
+
+static SeqLock*
+getBlockLock(CS101_ProcessImage self, int index)
+{
+    return &(self->blockSequence[index / CS101_PROCESS_IMAGE_BLOCK_SIZE]);
+}
+
+/* counter value relative to the last reset (wraps around like the counter) */
+static int32_t
+getCounterValue(CS101_ProcessImage self, int index, int32_t runningValue)
+{
+    return (int32_t) ((uint32_t) runningValue - (uint32_t) self->counters[index].resetValue);
+}
+
+/*
+ * read the state of a point - consistent also when the point is updated concurrently. The value of
+ * integrated totals is relative to the last reset (read in the same section as the running value).
+ */
+static void
+readState(CS101_ProcessImage self, int index, PointValue* value, uint8_t* quality, uint64_t* timestamp)
+{
+    SeqLock* lock = getBlockLock(self, index);
+    uint32_t sequence;
+
+    do {
+        sequence = SeqLock_readBegin(lock);
+
+        *value = self->value[index];
+        *quality = self->quality[index];
+        *timestamp = self->timestamp[index];
+
+        if (self->valueKind[index] == VALUE_KIND_INTEGRATED_TOTALS)
+            value->intValue = getCounterValue(self, index, value->intValue);
+    } while (SeqLock_readRetry(lock, sequence));
+}
+
+CS101_ProcessImage
+CS101_ProcessImage_create(int maxNumberOfPoints)
+{
+    if (maxNumberOfPoints < 1)
+        return NULL;
+
+    CS101_ProcessImage self = (CS101_ProcessImage) GLOBAL_CALLOC(1, sizeof(struct sCS101_ProcessImage));
+
+    if (self) {
+        /* hash table has at least twice the number of entries to keep the probe sequences short */
+        uint32_t hashTableSize = 2;
+
+        while (hashTableSize < (uint32_t) maxNumberOfPoints * 2)
+            hashTableSize *= 2;
+
+        self->maxNumberOfPoints = maxNumberOfPoints;
+        self->numberOfPoints = 0;
+        self->hashMask = hashTableSize - 1;
+
+        self->ca = (uint16_t*) GLOBAL_MALLOC(maxNumberOfPoints * sizeof(uint16_t));
+        self->ioa = (int32_t*) GLOBAL_MALLOC(maxNumberOfPoints * sizeof(int32_t));
+        self->typeId = (uint8_t*) GLOBAL_MALLOC(maxNumberOfPoints * sizeof(uint8_t));
+        self->valueKind = (uint8_t*) GLOBAL_MALLOC(maxNumberOfPoints * sizeof(uint8_t));
+        self->value = (PointValue*) GLOBAL_MALLOC(maxNumberOfPoints * sizeof(PointValue));
+        self->quality = (uint8_t*) GLOBAL_MALLOC(maxNumberOfPoints * sizeof(uint8_t));
+        self->timestamp = (uint64_t*) GLOBAL_MALLOC(maxNumberOfPoints * sizeof(uint64_t));
+        self->hashTable = (int32_t*) GLOBAL_MALLOC(hashTableSize * sizeof(int32_t));
+
+        self->groupBitsWords = (maxNumberOfPoints + 31) / 32;
+        self->groupBits = (uint32_t*) GLOBAL_CALLOC(NUMBER_OF_GROUP_BITMAPS * self->groupBitsWords, sizeof(uint32_t));
+        self->caBits = (uint32_t*) GLOBAL_CALLOC(NUMBER_OF_CA_BITS_WORDS, sizeof(uint32_t));
+
+        int numberOfBlocks = (maxNumberOfPoints + CS101_PROCESS_IMAGE_BLOCK_SIZE - 1) / CS101_PROCESS_IMAGE_BLOCK_SIZE;
+
+        self->blockSequence = (SeqLock*) GLOBAL_CALLOC(numberOfBlocks, sizeof(SeqLock));
+
+        if ((self->ca == NULL) || (self->ioa == NULL) || (self->typeId == NULL) || (self->valueKind == NULL) ||
+                (self->value == NULL) || (self->quality == NULL) || (self->timestamp == NULL) || (self->hashTable == NULL) ||
+                (self->groupBits == NULL) || (self->caBits == NULL) || (self->blockSequence == NULL))
+        {
+            CS101_ProcessImage_destroy(self);
+            return NULL;
+        }
+
+        memset(self->hashTable, 0xff, hashTableSize * sizeof(int32_t));
+    }
+
+    return self;
+}
+
+void
+CS101_ProcessImage_destroy(CS101_ProcessImage self)
+{
+    if (self) {
+        GLOBAL_FREEMEM(self->ca);
+        GLOBAL_FREEMEM(self->ioa);
+        GLOBAL_FREEMEM(self->typeId);
+        GLOBAL_FREEMEM(self->valueKind);
+        GLOBAL_FREEMEM(self->value);
+        GLOBAL_FREEMEM(self->quality);
+        GLOBAL_FREEMEM(self->timestamp);
+        GLOBAL_FREEMEM(self->hashTable);
+        GLOBAL_FREEMEM(self->groupBits);
+        GLOBAL_FREEMEM(self->caBits);
+        GLOBAL_FREEMEM(self->counters);
+        GLOBAL_FREEMEM((void*) self->blockSequence);
+        GLOBAL_FREEMEM(self->historyMemory);
+
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+int
+CS101_ProcessImage_lookup(CS101_ProcessImage self, int ca, int ioa)
+{
+    uint32_t slot = getHash(self, ca, ioa);
+
+    while (self->hashTable[slot] != -1) {
+        int index = self->hashTable[slot];
+
+        if ((self->ioa[index] == ioa) && (self->ca[index] == ca))
+            return index;
+
+        slot = (slot + 1) & self->hashMask;
+    }
+
+    return -1;
+}
+
+int
+CS101_ProcessImage_addPoint(CS101_ProcessImage self, int ca, int ioa, TypeID typeId)
+{
+    ValueKind valueKind = getValueKind(typeId);
+
+    if (valueKind == VALUE_KIND_NONE) {
+        DEBUG_PRINT("Process image: type %i not supported\n", typeId);
+        return -1;
+    }
+
+    if (self->numberOfPoints >= self->maxNumberOfPoints) {
+        DEBUG_PRINT("Process image: maximum number of points reached\n");
+        return -1;
+    }
+
+    if ((ca < 0) || (ca > 0xffff) || (ioa < 0) || (ioa > 0xffffff))
+        return -1;
+
+    uint32_t slot = getHash(self, ca, ioa);
+
+    while (self->hashTable[slot] != -1) {
+        int otherIndex = self->hashTable[slot];
+
+        if ((self->ioa[otherIndex] == ioa) && (self->ca[otherIndex] == ca)) {
+            DEBUG_PRINT("Process image: point (CA: %i, IOA: %i) already exists\n", ca, ioa);
+            return -1;
+        }
+
+        slot = (slot + 1) & self->hashMask;
+    }
+
+    if ((valueKind == VALUE_KIND_INTEGRATED_TOTALS) && (self->counters == NULL)) {
+        self->counters = (CounterState*) GLOBAL_CALLOC(self->maxNumberOfPoints, sizeof(CounterState));
+
+        if (self->counters == NULL)
+            return -1;
+    }
+
+    int index = self->numberOfPoints;
+
+    self->ca[index] = (uint16_t) ca;
+    self->ioa[index] = ioa;
+    self->typeId[index] = (uint8_t) typeId;
+    self->valueKind[index] = (uint8_t) valueKind;
+    self->value[index].bits = 0;
+    self->timestamp[index] = 0;
+
+    if (valueKind == VALUE_KIND_INTEGRATED_TOTALS) {
+        self->quality[index] = 0x80; /* IV flag of the binary counter reading */
+
+        memset(&(self->counters[index]), 0, sizeof(CounterState));
+        self->counters[index].frozenFlags[0] = 0x80;
+        self->counters[index].frozenFlags[1] = 0x80;
+
+        getGroupBitmap(self, COUNTER_GROUP_BITMAP(0))[index / 32] |= (1U << (index % 32));
+    }
+    else {
+        self->quality[index] = IEC60870_QUALITY_INVALID;
+
+        /* member of station interrogation (integrated totals are reported by counter interrogation only) */
+        getGroupBitmap(self, 0)[index / 32] |= (1U << (index % 32));
+    }
+
+    self->caBits[ca / 32] |= (1U << (ca % 32));
+
+    self->hashTable[slot] = index;
+
+    self->numberOfPoints++;
+
+    return index;
+}
+
+int
+CS101_ProcessImage_getNumberOfPoints(CS101_ProcessImage self)
+{
+    return self->numberOfPoints;
+}
+
+int
+CS101_ProcessImage_getCA(CS101_ProcessImage self, int index)
+{
+    return self->ca[index];
+}
+
+int
+CS101_ProcessImage_getIOA(CS101_ProcessImage self, int index)
+{
+    return self->ioa[index];
+}
+
+TypeID
+CS101_ProcessImage_getTypeID(CS101_ProcessImage self, int index)
+{
+    return (TypeID) self->typeId[index];
+}
+
+QualityDescriptor
+CS101_ProcessImage_getQuality(CS101_ProcessImage self, int index)
+{
+    if (self->valueKind[index] == VALUE_KIND_INTEGRATED_TOTALS) {
+        if (self->quality[index] & 0x80)
+            return IEC60870_QUALITY_INVALID;
+        else
+            return IEC60870_QUALITY_GOOD;
+    }
+
+    return (QualityDescriptor) self->quality[index];
+}
+
+uint64_t
+CS101_ProcessImage_getTimestamp(CS101_ProcessImage self, int index)
+{
+    PointValue value;
+    uint8_t quality;
+    uint64_t timestamp;
+
+    /* 64 bit value - has to be read consistently also on 32 bit platforms */
+    readState(self, index, &value, &quality, &timestamp);
+
+    return timestamp;
+}
+
+static bool
+isValidGroupMember(CS101_ProcessImage self, int index, int group)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return false;
+
+    return ((group >= 0) && (group <= CS101_PROCESS_IMAGE_MAX_GROUP));
+}
+
+bool
+CS101_ProcessImage_addToGroup(CS101_ProcessImage self, int index, int group)
+{
+    if (isValidGroupMember(self, index, group) == false)
+        return false;
+
+    getGroupBitmap(self, group)[index / 32] |= (1U << (index % 32));
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_removeFromGroup(CS101_ProcessImage self, int index, int group)
+{
+    if (isValidGroupMember(self, index, group) == false)
+        return false;
+
+    getGroupBitmap(self, group)[index / 32] &= ~(1U << (index % 32));
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_isInGroup(CS101_ProcessImage self, int index, int group)
+{
+    if (isValidGroupMember(self, index, group) == false)
+        return false;
+
+    return ((getGroupBitmap(self, group)[index / 32] & (1U << (index % 32))) != 0);
+}
+
+static bool
+isValidCounterGroupMember(CS101_ProcessImage self, int index, int group)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return false;
+
+    if (self->valueKind[index] != VALUE_KIND_INTEGRATED_TOTALS)
+        return false;
+
+    return ((group >= 1) && (group <= CS101_PROCESS_IMAGE_MAX_COUNTER_GROUP));
+}
+
+bool
+CS101_ProcessImage_addToCounterGroup(CS101_ProcessImage self, int index, int group)
+{
+    if (isValidCounterGroupMember(self, index, group) == false)
+        return false;
+
+    getGroupBitmap(self, COUNTER_GROUP_BITMAP(group))[index / 32] |= (1U << (index % 32));
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_removeFromCounterGroup(CS101_ProcessImage self, int index, int group)
+{
+    if (isValidCounterGroupMember(self, index, group) == false)
+        return false;
+
+    getGroupBitmap(self, COUNTER_GROUP_BITMAP(group))[index / 32] &= ~(1U << (index % 32));
+
+    return true;
+}
+
+/* find the next member of the group (and CA) with an index >= startIndex - returns -1 if there is none */
+static int
+getNextGroupMember(CS101_ProcessImage self, int group, int ca, int startIndex)
+{
+    uint32_t* bitmap = getGroupBitmap(self, group);
+
+    int index = startIndex;
+
+    while (index < self->numberOfPoints) {
+        uint32_t word = bitmap[index / 32] >> (index % 32);
+
+        if (word == 0) {
+            /* skip to next word */
+            index = (index | 31) + 1;
+            continue;
+        }
+
+        while ((word & 1) == 0) {
+            word = word >> 1;
+            index++;
+        }
+
+        if (index >= self->numberOfPoints)
+            break;
+
+        if ((ca == -1) || (self->ca[index] == ca))
+            return index;
+
+        index++;
+    }
+
+    return -1;
+}
+
+int
+CS101_ProcessImage_freezeCounters(CS101_ProcessImage self, int ca, int group, bool reset, uint64_t timestamp)
+{
+    if ((group < 0) || (group > CS101_PROCESS_IMAGE_MAX_COUNTER_GROUP))
+        return 0;
+
+    if (timestamp == 0)
+        timestamp = Hal_getTimeInMs();
+
+    int frozenCounters = 0;
+
+    int index = getNextGroupMember(self, COUNTER_GROUP_BITMAP(group), ca, 0);
+
+    while (index != -1) {
+        CounterState* counter = &(self->counters[index]);
+        SeqLock* lock = getBlockLock(self, index);
+
+        SeqLock_writeBegin(lock);
+
+        int32_t runningValue = self->value[index].intValue;
+        uint8_t runningFlags = self->quality[index];
+
+        int activeBuffer = counter->activeBuffer;
+        int inactiveBuffer = activeBuffer ^ 1;
+
+        uint8_t sequenceNumber = (uint8_t) ((counter->frozenFlags[activeBuffer] + 1) & 0x1f);
+
+        counter->frozenValue[inactiveBuffer] = getCounterValue(self, index, runningValue);
+        counter->frozenTimestamp[inactiveBuffer] = timestamp;
+        counter->frozenFlags[inactiveBuffer] = (uint8_t) ((runningFlags & 0xe0) | sequenceNumber);
+
+        counter->activeBuffer = (uint8_t) inactiveBuffer;
+
+        if (reset)
+            counter->resetValue = runningValue;
+
+        SeqLock_writeEnd(lock);
+
+        frozenCounters++;
+
+        index = getNextGroupMember(self, COUNTER_GROUP_BITMAP(group), ca, index + 1);
+    }
+
+    return frozenCounters;
+}
+
+int
+CS101_ProcessImage_resetCounters(CS101_ProcessImage self, int ca, int group)
+{
+    if ((group < 0) || (group > CS101_PROCESS_IMAGE_MAX_COUNTER_GROUP))
+        return 0;
+
+    int resetCounters = 0;
+
+    int index = getNextGroupMember(self, COUNTER_GROUP_BITMAP(group), ca, 0);
+
+    while (index != -1) {
+        SeqLock* lock = getBlockLock(self, index);
+
+        SeqLock_writeBegin(lock);
+
+        self->counters[index].resetValue = self->value[index].intValue;
+
+        SeqLock_writeEnd(lock);
+
+        resetCounters++;
+
+        index = getNextGroupMember(self, COUNTER_GROUP_BITMAP(group), ca, index + 1);
+    }
+
+    return resetCounters;
+}
+
+static bool
+isValidUpdate(CS101_ProcessImage self, int index, ValueKind valueKind)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return false;
+
+    return (self->valueKind[index] == (uint8_t) valueKind);
+}
+
+/* has to be called with the block lock */
+static void
+recordHistory(CS101_ProcessImage self, int index, uint32_t bits, uint8_t quality, uint64_t timestamp)
+{
+    uint32_t count = self->historyCount[index];
+
+    size_t entry = (size_t) index * self->historyDepth + (count % self->historyDepth);
+
+    self->historyTimestamp[entry] = timestamp;
+    self->historyValue[entry] = bits;
+    self->historyQuality[entry] = quality;
+
+    self->historyCount[index] = count + 1;
+}
+
+static void
+setState(CS101_ProcessImage self, int index, uint32_t bits, uint8_t quality, uint64_t timestamp)
+{
+    if (timestamp == 0)
+        timestamp = Hal_getTimeInMs();
+
+    SeqLock* lock = getBlockLock(self, index);
+
+    SeqLock_writeBegin(lock);
+
+    if (self->historyCount && ((self->value[index].bits != bits) || (self->quality[index] != quality)))
+        recordHistory(self, index, bits, quality, timestamp);
+
+    self->value[index].bits = bits;
+    self->quality[index] = quality;
+    self->timestamp[index] = timestamp;
+
+    SeqLock_writeEnd(lock);
+}
+
+bool
+CS101_ProcessImage_updateSinglePoint(CS101_ProcessImage self, int index, bool value, QualityDescriptor quality, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_SINGLE_POINT) == false)
+        return false;
+
+    setState(self, index, value ? 1 : 0, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateDoublePoint(CS101_ProcessImage self, int index, DoublePointValue value, QualityDescriptor quality, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_DOUBLE_POINT) == false)
+        return false;
+
+    setState(self, index, (uint32_t) value & 0x03, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateStepPosition(CS101_ProcessImage self, int index, int value, bool isTransient, QualityDescriptor quality, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_STEP_POSITION) == false)
+        return false;
+
+    PointValue pointValue;
+
+    /* keep the step position and the transient flag in one value */
+    pointValue.intValue = (isTransient ? 0x100 : 0) | (value & 0xff);
+
+    setState(self, index, pointValue.bits, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateBitstring32(CS101_ProcessImage self, int index, uint32_t value, QualityDescriptor quality, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_BITSTRING32) == false)
+        return false;
+
+    setState(self, index, value, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateNormalizedValue(CS101_ProcessImage self, int index, float value, QualityDescriptor quality, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_NORMALIZED) == false)
+        return false;
+
+    PointValue pointValue;
+    pointValue.floatValue = value;
+
+    setState(self, index, pointValue.bits, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateScaledValue(CS101_ProcessImage self, int index, int value, QualityDescriptor quality, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_SCALED) == false)
+        return false;
+
+    PointValue pointValue;
+    pointValue.intValue = value;
+
+    setState(self, index, pointValue.bits, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateShortValue(CS101_ProcessImage self, int index, float value, QualityDescriptor quality, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_SHORT) == false)
+        return false;
+
+    PointValue pointValue;
+    pointValue.floatValue = value;
+
+    setState(self, index, pointValue.bits, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateFloatValue(CS101_ProcessImage self, int index, float value, QualityDescriptor quality, uint64_t timestamp)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return false;
+
+    if ((self->valueKind[index] != VALUE_KIND_SHORT) && (self->valueKind[index] != VALUE_KIND_NORMALIZED))
+        return false;
+
+    PointValue pointValue;
+    pointValue.floatValue = value;
+
+    setState(self, index, pointValue.bits, (uint8_t) quality, timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateIntegratedTotals(CS101_ProcessImage self, int index, const BinaryCounterReading value, uint64_t timestamp)
+{
+    if (isValidUpdate(self, index, VALUE_KIND_INTEGRATED_TOTALS) == false)
+        return false;
+
+    PointValue pointValue;
+    pointValue.intValue = BinaryCounterReading_getValue(value);
+
+    setState(self, index, pointValue.bits, value->encodedValue[4], timestamp);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateQuality(CS101_ProcessImage self, int index, QualityDescriptor quality, uint64_t timestamp)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return false;
+
+    if (timestamp == 0)
+        timestamp = Hal_getTimeInMs();
+
+    SeqLock* lock = getBlockLock(self, index);
+
+    SeqLock_writeBegin(lock);
+
+    uint8_t oldQuality = self->quality[index];
+
+    if (self->valueKind[index] == VALUE_KIND_INTEGRATED_TOTALS) {
+        if (quality & IEC60870_QUALITY_INVALID)
+            self->quality[index] |= 0x80;
+        else
+            self->quality[index] &= 0x7f;
+    }
+    else
+        self->quality[index] = (uint8_t) quality;
+
+    if (self->historyCount && (self->quality[index] != oldQuality))
+        recordHistory(self, index, self->value[index].bits, self->quality[index], timestamp);
+
+    self->timestamp[index] = timestamp;
+
+    SeqLock_writeEnd(lock);
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_updateFromInformationObject(CS101_ProcessImage self, int index, TypeID typeId, InformationObject io,
+        uint64_t timestamp, bool* changed)
+{
+    ValueKind valueKind = getValueKind(typeId);
+
+    if ((valueKind == VALUE_KIND_NONE) || (isValidUpdate(self, index, valueKind) == false))
+        return false;
+
+    PointValue value;
+    uint8_t quality;
+    BinaryCounterReading bcr;
+
+    switch (valueKind) {
+
+    case VALUE_KIND_SINGLE_POINT:
+        value.bits = SinglePointInformation_getValue((SinglePointInformation) io) ? 1 : 0;
+        quality = (uint8_t) SinglePointInformation_getQuality((SinglePointInformation) io);
+        break;
+
+    case VALUE_KIND_DOUBLE_POINT:
+        value.bits = (uint32_t) DoublePointInformation_getValue((DoublePointInformation) io) & 0x03;
+        quality = (uint8_t) DoublePointInformation_getQuality((DoublePointInformation) io);
+        break;
+
+    case VALUE_KIND_STEP_POSITION:
+        value.intValue = (StepPositionInformation_isTransient((StepPositionInformation) io) ? 0x100 : 0) |
+                (StepPositionInformation_getValue((StepPositionInformation) io) & 0xff);
+        quality = (uint8_t) StepPositionInformation_getQuality((StepPositionInformation) io);
+        break;
+
+    case VALUE_KIND_BITSTRING32:
+        value.bits = BitString32_getValue((BitString32) io);
+        quality = (uint8_t) BitString32_getQuality((BitString32) io);
+        break;
+
+    case VALUE_KIND_NORMALIZED:
+        if (typeId == M_ME_ND_1) {
+            value.floatValue = MeasuredValueNormalizedWithoutQuality_getValue((MeasuredValueNormalizedWithoutQuality) io);
+            quality = IEC60870_QUALITY_GOOD;
+        }
+        else {
+            value.floatValue = MeasuredValueNormalized_getValue((MeasuredValueNormalized) io);
+            quality = (uint8_t) MeasuredValueNormalized_getQuality((MeasuredValueNormalized) io);
+        }
+        break;
+
+    case VALUE_KIND_SCALED:
+        value.intValue = MeasuredValueScaled_getValue((MeasuredValueScaled) io);
+        quality = (uint8_t) MeasuredValueScaled_getQuality((MeasuredValueScaled) io);
+        break;
+
+    case VALUE_KIND_SHORT:
+        value.floatValue = MeasuredValueShort_getValue((MeasuredValueShort) io);
+        quality = (uint8_t) MeasuredValueShort_getQuality((MeasuredValueShort) io);
+        break;
+
+    case VALUE_KIND_INTEGRATED_TOTALS:
+        bcr = IntegratedTotals_getBCR((IntegratedTotals) io);
+        value.intValue = BinaryCounterReading_getValue(bcr);
+        quality = bcr->encodedValue[4];
+        break;
+
+    default:
+        return false;
+    }
+
+    CP56Time2a time = NULL;
+
+    switch (typeId) {
+
+    case M_SP_TB_1:
+        time = SinglePointWithCP56Time2a_getTimestamp((SinglePointWithCP56Time2a) io);
+        break;
+
+    case M_DP_TB_1:
+        time = DoublePointWithCP56Time2a_getTimestamp((DoublePointWithCP56Time2a) io);
+        break;
+
+    case M_ST_TB_1:
+        time = StepPositionWithCP56Time2a_getTimestamp((StepPositionWithCP56Time2a) io);
+        break;
+
+    case M_BO_TB_1:
+        time = Bitstring32WithCP56Time2a_getTimestamp((Bitstring32WithCP56Time2a) io);
+        break;
+
+    case M_ME_TD_1:
+        time = MeasuredValueNormalizedWithCP56Time2a_getTimestamp((MeasuredValueNormalizedWithCP56Time2a) io);
+        break;
+
+    case M_ME_TE_1:
+        time = MeasuredValueScaledWithCP56Time2a_getTimestamp((MeasuredValueScaledWithCP56Time2a) io);
+        break;
+
+    case M_ME_TF_1:
+        time = MeasuredValueShortWithCP56Time2a_getTimestamp((MeasuredValueShortWithCP56Time2a) io);
+        break;
+
+    case M_IT_TB_1:
+        time = IntegratedTotalsWithCP56Time2a_getTimestamp((IntegratedTotalsWithCP56Time2a) io);
+        break;
+
+    default:
+        break;
+    }
+
+    if (time)
+        timestamp = CP56Time2a_toMsTimestamp(time);
+
+    /* only the updating thread modifies the state - no lock required to compare */
+    if (changed)
+        *changed = ((self->value[index].bits != value.bits) || (self->quality[index] != quality));
+
+    setState(self, index, value.bits, quality, timestamp);
+
+    return true;
+}
+
+/* bitmap of the points of a block that are selected by CA, IOA range, and group */
+static uint64_t
+getSelectedPoints(CS101_ProcessImage self, int block, int ca, int firstIoa, int lastIoa, int group)
+{
+    int firstIndex = block * CS101_PROCESS_IMAGE_BLOCK_SIZE;
+    int numberOfPoints = self->numberOfPoints - firstIndex;
+
+    if (numberOfPoints > CS101_PROCESS_IMAGE_BLOCK_SIZE)
+        numberOfPoints = CS101_PROCESS_IMAGE_BLOCK_SIZE;
+
+    uint64_t selected = 0;
+    int i;
+
+    /* without branches - can be vectorized by the compiler */
+    for (i = 0; i < numberOfPoints; i++) {
+        int index = firstIndex + i;
+
+        uint64_t isSelected = (uint64_t) (((ca == -1) || (self->ca[index] == ca)) &
+                (self->ioa[index] >= firstIoa) & (self->ioa[index] <= lastIoa));
+
+        selected |= (isSelected << i);
+    }
+
+    if (group != -1) {
+        /* a block covers two words of the group bitmap */
+        uint32_t* bitmap = getGroupBitmap(self, group);
+        int word = firstIndex / 32;
+
+        uint64_t members = bitmap[word];
+
+        if (word + 1 < self->groupBitsWords)
+            members |= ((uint64_t) bitmap[word + 1] << 32);
+
+        selected &= members;
+    }
+
+    return selected;
+}
+
+int
+CS101_ProcessImage_modifyQualityFlags(CS101_ProcessImage self, int ca, int firstIoa, int lastIoa, int group, uint8_t flags,
+        bool set, uint64_t timestamp, CS101_ProcessImage_QualityChangedHandler handler, void* parameter)
+{
+    if ((group < -1) || (group > CS101_PROCESS_IMAGE_MAX_GROUP))
+        return 0;
+
+    if (timestamp == 0)
+        timestamp = Hal_getTimeInMs();
+
+    /* the invalid flag of the binary counter reading has the same position as the invalid flag of the quality descriptor */
+    uint8_t counterFlags = flags & IEC60870_QUALITY_INVALID;
+
+    int numberOfBlocks = (self->numberOfPoints + CS101_PROCESS_IMAGE_BLOCK_SIZE - 1) / CS101_PROCESS_IMAGE_BLOCK_SIZE;
+    int changedPoints = 0;
+    int block;
+
+    for (block = 0; block < numberOfBlocks; block++) {
+        uint64_t selected = getSelectedPoints(self, block, ca, firstIoa, lastIoa, group);
+
+        if (selected == 0)
+            continue;
+
+        int firstIndex = block * CS101_PROCESS_IMAGE_BLOCK_SIZE;
+        uint64_t changed = 0;
+        int i;
+
+        SeqLock* lock = &(self->blockSequence[block]);
+
+        SeqLock_writeBegin(lock);
+
+        for (i = 0; i < CS101_PROCESS_IMAGE_BLOCK_SIZE; i++) {
+            if ((selected & ((uint64_t) 1 << i)) == 0)
+                continue;
+
+            int index = firstIndex + i;
+
+            uint8_t mask = (self->valueKind[index] == VALUE_KIND_INTEGRATED_TOTALS) ? counterFlags : flags;
+            uint8_t oldQuality = self->quality[index];
+            uint8_t newQuality = set ? (oldQuality | mask) : (oldQuality & ~mask);
+
+            if (newQuality != oldQuality) {
+                self->quality[index] = newQuality;
+                self->timestamp[index] = timestamp;
+
+                if (self->historyCount)
+                    recordHistory(self, index, self->value[index].bits, newQuality, timestamp);
+
+                changed |= ((uint64_t) 1 << i);
+            }
+        }
+
+        SeqLock_writeEnd(lock);
+
+        for (i = 0; i < CS101_PROCESS_IMAGE_BLOCK_SIZE; i++) {
+            if (changed & ((uint64_t) 1 << i)) {
+                changedPoints++;
+
+                if (handler)
+                    handler(parameter, firstIndex + i);
+            }
+        }
+    }
+
+    return changedPoints;
+}
+
+int
+CS101_ProcessImage_setQualityFlags(CS101_ProcessImage self, int ca, int firstIoa, int lastIoa, QualityDescriptor flags,
+        bool set, uint64_t timestamp)
+{
+    return CS101_ProcessImage_modifyQualityFlags(self, ca, firstIoa, lastIoa, -1, (uint8_t) flags, set, timestamp, NULL, NULL);
+}
+
+int
+CS101_ProcessImage_setQualityFlagsOfGroup(CS101_ProcessImage self, int ca, int group, QualityDescriptor flags,
+        bool set, uint64_t timestamp)
+{
+    if ((group < 0) || (group > CS101_PROCESS_IMAGE_MAX_GROUP))
+        return 0;
+
+    return CS101_ProcessImage_modifyQualityFlags(self, ca, 0, 0xffffff, group, (uint8_t) flags, set, timestamp, NULL, NULL);
+}
+
+bool
+CS101_ProcessImage_getSinglePointValue(CS101_ProcessImage self, int index)
+{
+    return (self->value[index].bits != 0);
+}
+
+DoublePointValue
+CS101_ProcessImage_getDoublePointValue(CS101_ProcessImage self, int index)
+{
+    return (DoublePointValue) self->value[index].bits;
+}
+
+static int
+getStepPosition(PointValue value, bool* isTransient)
+{
+    if (isTransient)
+        *isTransient = ((value.intValue & 0x100) != 0);
+
+    /* sign extension of the 8 bit value */
+    return (int) (int8_t) (value.intValue & 0xff);
+}
+
+int
+CS101_ProcessImage_getStepPositionValue(CS101_ProcessImage self, int index, bool* isTransient)
+{
+    return getStepPosition(self->value[index], isTransient);
+}
+
+uint32_t
+CS101_ProcessImage_getBitstring32Value(CS101_ProcessImage self, int index)
+{
+    return self->value[index].bits;
+}
+
+float
+CS101_ProcessImage_getFloatValue(CS101_ProcessImage self, int index)
+{
+    return self->value[index].floatValue;
+}
+
+int
+CS101_ProcessImage_getScaledValue(CS101_ProcessImage self, int index)
+{
+    return self->value[index].intValue;
+}
+
+bool
+CS101_ProcessImage_getIntegratedTotals(CS101_ProcessImage self, int index, BinaryCounterReading value)
+{
+    if (self->valueKind[index] != VALUE_KIND_INTEGRATED_TOTALS)
+        return false;
+
+    PointValue counterValue;
+    uint8_t flags;
+    uint64_t timestamp;
+
+    readState(self, index, &counterValue, &flags, &timestamp);
+
+    BinaryCounterReading_setValue(value, counterValue.intValue);
+    value->encodedValue[4] = flags;
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_getFrozenIntegratedTotals(CS101_ProcessImage self, int index, BinaryCounterReading value, uint64_t* timestamp)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return false;
+
+    if (self->valueKind[index] != VALUE_KIND_INTEGRATED_TOTALS)
+        return false;
+
+    CounterState* counter = &(self->counters[index]);
+    SeqLock* lock = getBlockLock(self, index);
+
+    int32_t frozenValue;
+    uint8_t frozenFlags;
+    uint64_t frozenTimestamp;
+    uint32_t sequence;
+
+    /* the active buffer is not written by a freeze - only repeated when two freezes happen during the read */
+    do {
+        sequence = SeqLock_readBegin(lock);
+
+        int activeBuffer = counter->activeBuffer;
+
+        frozenValue = counter->frozenValue[activeBuffer];
+        frozenFlags = counter->frozenFlags[activeBuffer];
+        frozenTimestamp = counter->frozenTimestamp[activeBuffer];
+    } while (SeqLock_readRetry(lock, sequence));
+
+    BinaryCounterReading_setValue(value, frozenValue);
+    value->encodedValue[4] = frozenFlags;
+
+    if (timestamp)
+        *timestamp = frozenTimestamp;
+
+    return true;
+}
+
+int
+CS101_ProcessImage_getMaxNumberOfPoints(CS101_ProcessImage self)
+{
+    return self->maxNumberOfPoints;
+}
+
+bool
+CS101_ProcessImage_isCompatibleType(CS101_ProcessImage self, int index, TypeID typeId)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return false;
+
+    return (self->valueKind[index] == (uint8_t) getValueKind(typeId));
+}
+
+InformationObject
+CS101_ProcessImage_getInformationObject(CS101_ProcessImage self, int index, InformationObject io)
+{
+    if ((index < 0) || (index >= self->numberOfPoints))
+        return NULL;
+
+    return CS101_ProcessImage_getInformationObjectOfType(self, index, (TypeID) self->typeId[index], io);
+}
+
+/* create the information object from a copy of the point state (counter values are relative to the last reset) */
+static InformationObject
+createInformationObject(CS101_ProcessImage self, int index, TypeID typeId, PointValue value, uint8_t qualityByte,
+        uint64_t time, InformationObject io)
+{
+    int ioa = self->ioa[index];
+    QualityDescriptor quality = (QualityDescriptor) qualityByte;
+
+    struct sCP56Time2a timestamp;
+    struct sBinaryCounterReading bcr;
+    bool isTransient;
+    int stepPosition;
+
+    switch (typeId) {
+
+    case M_SP_NA_1:
+        return (InformationObject) SinglePointInformation_create((SinglePointInformation) io, ioa,
+                (value.bits != 0), quality);
+
+    case M_SP_TB_1:
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) SinglePointWithCP56Time2a_create((SinglePointWithCP56Time2a) io, ioa,
+                (value.bits != 0), quality, &timestamp);
+
+    case M_DP_NA_1:
+        return (InformationObject) DoublePointInformation_create((DoublePointInformation) io, ioa,
+                (DoublePointValue) value.bits, quality);
+
+    case M_DP_TB_1:
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) DoublePointWithCP56Time2a_create((DoublePointWithCP56Time2a) io, ioa,
+                (DoublePointValue) value.bits, quality, &timestamp);
+
+    case M_ST_NA_1:
+        stepPosition = getStepPosition(value, &isTransient);
+        return (InformationObject) StepPositionInformation_create((StepPositionInformation) io, ioa,
+                stepPosition, isTransient, quality);
+
+    case M_ST_TB_1:
+        stepPosition = getStepPosition(value, &isTransient);
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) StepPositionWithCP56Time2a_create((StepPositionWithCP56Time2a) io, ioa,
+                stepPosition, isTransient, quality, &timestamp);
+
+    case M_BO_NA_1:
+        return (InformationObject) BitString32_createEx((BitString32) io, ioa,
+                value.bits, quality);
+
+    case M_BO_TB_1:
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) Bitstring32WithCP56Time2a_createEx((Bitstring32WithCP56Time2a) io, ioa,
+                value.bits, quality, &timestamp);
+
+    case M_ME_NA_1:
+        return (InformationObject) MeasuredValueNormalized_create((MeasuredValueNormalized) io, ioa,
+                value.floatValue, quality);
+
+    case M_ME_TD_1:
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) MeasuredValueNormalizedWithCP56Time2a_create((MeasuredValueNormalizedWithCP56Time2a) io, ioa,
+                value.floatValue, quality, &timestamp);
+
+    case M_ME_ND_1:
+        return (InformationObject) MeasuredValueNormalizedWithoutQuality_create((MeasuredValueNormalizedWithoutQuality) io, ioa,
+                value.floatValue);
+
+    case M_ME_NB_1:
+        return (InformationObject) MeasuredValueScaled_create((MeasuredValueScaled) io, ioa,
+                value.intValue, quality);
+
+    case M_ME_TE_1:
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) MeasuredValueScaledWithCP56Time2a_create((MeasuredValueScaledWithCP56Time2a) io, ioa,
+                value.intValue, quality, &timestamp);
+
+    case M_ME_NC_1:
+        return (InformationObject) MeasuredValueShort_create((MeasuredValueShort) io, ioa,
+                value.floatValue, quality);
+
+    case M_ME_TF_1:
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) MeasuredValueShortWithCP56Time2a_create((MeasuredValueShortWithCP56Time2a) io, ioa,
+                value.floatValue, quality, &timestamp);
+
+    case M_IT_NA_1:
+        BinaryCounterReading_setValue(&bcr, value.intValue);
+        bcr.encodedValue[4] = qualityByte;
+        return (InformationObject) IntegratedTotals_create((IntegratedTotals) io, ioa, &bcr);
+
+    case M_IT_TB_1:
+        BinaryCounterReading_setValue(&bcr, value.intValue);
+        bcr.encodedValue[4] = qualityByte;
+        CP56Time2a_createFromMsTimestamp(&timestamp, time);
+        return (InformationObject) IntegratedTotalsWithCP56Time2a_create((IntegratedTotalsWithCP56Time2a) io, ioa,
+                &bcr, &timestamp);
+
+    default:
+        return NULL;
+    }
+}
+
+InformationObject
+CS101_ProcessImage_getInformationObjectOfType(CS101_ProcessImage self, int index, TypeID typeId, InformationObject io)
+{
+    if (CS101_ProcessImage_isCompatibleType(self, index, typeId) == false)
+        return NULL;
+
+    PointValue value;
+    uint8_t quality;
+    uint64_t timestamp;
+
+    readState(self, index, &value, &quality, &timestamp);
+
+    return createInformationObject(self, index, typeId, value, quality, timestamp, io);
+}
+
+bool
+CS101_ProcessImage_addToASDU(CS101_ProcessImage self, int index, CS101_ASDU asdu)
+{
+    union uInformationObject ioBuffer;
+
+    InformationObject io = CS101_ProcessImage_getInformationObject(self, index, (InformationObject) &ioBuffer);
+
+    if (io == NULL)
+        return false;
+
+    return CS101_ASDU_addInformationObject(asdu, io);
+}
+
+size_t
+CS101_ProcessImage_getHistoryMemorySize(int maxNumberOfPoints, int depth)
+{
+    size_t numberOfEntries = (size_t) maxNumberOfPoints * (size_t) depth;
+
+    return numberOfEntries * (sizeof(uint64_t) + sizeof(uint32_t) + sizeof(uint8_t)) +
+            (size_t) maxNumberOfPoints * sizeof(uint32_t);
+}
+
+bool
+CS101_ProcessImage_enableHistory(CS101_ProcessImage self, int depth)
+{
+    if ((depth < 1) || (depth > 0xffff) || self->historyMemory)
+        return false;
+
+    size_t numberOfEntries = (size_t) self->maxNumberOfPoints * (size_t) depth;
+
+    uint8_t* memory = (uint8_t*) GLOBAL_CALLOC(1, CS101_ProcessImage_getHistoryMemorySize(self->maxNumberOfPoints, depth));
+
+    if (memory == NULL)
+        return false;
+
+    self->historyMemory = memory;
+    self->historyDepth = depth;
+
+    /* arrays with larger elements first - every array starts at a suitably aligned address */
+    self->historyTimestamp = (uint64_t*) memory;
+    self->historyValue = (uint32_t*) (self->historyTimestamp + numberOfEntries);
+    self->historyCount = self->historyValue + numberOfEntries;
+    self->historyQuality = (uint8_t*) (self->historyCount + self->maxNumberOfPoints);
+
+    return true;
+}
+
+int
+CS101_ProcessImage_getHistoryLength(CS101_ProcessImage self, int index)
+{
+    if ((self->historyCount == NULL) || (index < 0) || (index >= self->numberOfPoints))
+        return 0;
+
+    uint32_t count = self->historyCount[index];
+
+    if (count > (uint32_t) self->historyDepth)
+        return self->historyDepth;
+    else
+        return (int) count;
+}
+
+/* type with time tag that is used for history entries */
+static TypeID
+getTimeTaggedType(TypeID typeId)
+{
+    switch (typeId) {
+
+    case M_SP_NA_1:
+        return M_SP_TB_1;
+
+    case M_DP_NA_1:
+        return M_DP_TB_1;
+
+    case M_ST_NA_1:
+        return M_ST_TB_1;
+
+    case M_BO_NA_1:
+        return M_BO_TB_1;
+
+    case M_ME_NA_1:
+    case M_ME_ND_1:
+        return M_ME_TD_1;
+
+    case M_ME_NB_1:
+        return M_ME_TE_1;
+
+    case M_ME_NC_1:
+        return M_ME_TF_1;
+
+    case M_IT_NA_1:
+        return M_IT_TB_1;
+
+    default:
+        return typeId;
+    }
+}
+
+/* copy a history entry (identified by the number of the change) - returns false when the entry doesn't exist (anymore) */
+static bool
+readHistoryEntry(CS101_ProcessImage self, int index, uint32_t number, PointValue* value, uint8_t* quality, uint64_t* timestamp)
+{
+    SeqLock* lock = getBlockLock(self, index);
+    uint32_t sequence;
+    bool exists;
+
+    do {
+        sequence = SeqLock_readBegin(lock);
+
+        uint32_t count = self->historyCount[index];
+
+        exists = ((number < count) && (count - number <= (uint32_t) self->historyDepth));
+
+        if (exists) {
+            size_t entry = (size_t) index * self->historyDepth + (number % self->historyDepth);
+
+            value->bits = self->historyValue[entry];
+            *quality = self->historyQuality[entry];
+            *timestamp = self->historyTimestamp[entry];
+
+            if (self->valueKind[index] == VALUE_KIND_INTEGRATED_TOTALS)
+                value->intValue = getCounterValue(self, index, value->intValue);
+        }
+    } while (SeqLock_readRetry(lock, sequence));
+
+    return exists;
+}
+
+InformationObject
+CS101_ProcessImage_getHistoryInformationObject(CS101_ProcessImage self, int index, int entry, InformationObject io)
+{
+    if ((self->historyCount == NULL) || (index < 0) || (index >= self->numberOfPoints) || (entry < 0))
+        return NULL;
+
+    uint32_t count = self->historyCount[index];
+
+    if ((uint32_t) entry >= count)
+        return NULL;
+
+    PointValue value;
+    uint8_t quality;
+    uint64_t timestamp;
+
+    if (readHistoryEntry(self, index, count - 1 - (uint32_t) entry, &value, &quality, &timestamp) == false)
+        return NULL;
+
+    return createInformationObject(self, index, getTimeTaggedType((TypeID) self->typeId[index]), value, quality, timestamp, io);
+}
+
+bool
+CS101_ProcessImage_hasCA(CS101_ProcessImage self, int ca)
+{
+    if ((ca < 0) || (ca > 0xffff))
+        return false;
+
+    return ((self->caBits[ca / 32] & (1U << (ca % 32))) != 0);
+}
+
+uint32_t
+CS101_ProcessImage_beginRead(CS101_ProcessImage self, int index)
+{
+    return SeqLock_readBegin(getBlockLock(self, index));
+}
+
+bool
+CS101_ProcessImage_retryRead(CS101_ProcessImage self, int index, uint32_t sequence)
+{
+    return SeqLock_readRetry(getBlockLock(self, index), sequence);
+}
+
+void
+CS101_InterrogationCursor_start(CS101_InterrogationCursor self, int group, int ca)
+{
+    self->group = group;
+    self->ca = ca;
+    self->nextIndex = 0;
+    self->snapshotBlock = -1;
+    self->historyEntries = 0;
+}
+
+void
+CS101_InterrogationCursor_stop(CS101_InterrogationCursor self)
+{
+    self->group = -1;
+}
+
+void
+CS101_InterrogationCursor_startCounterInterrogation(CS101_InterrogationCursor self, int group, int ca)
+{
+    self->group = COUNTER_GROUP_BITMAP(group);
+    self->ca = ca;
+    self->nextIndex = 0;
+    self->snapshotBlock = -1;
+    self->historyEntries = 0;
+}
+
+void
+CS101_InterrogationCursor_startHistoryReplay(CS101_InterrogationCursor self, int numberOfEntries, int ca)
+{
+    self->group = 0;
+    self->ca = ca;
+    self->nextIndex = 0;
+    self->snapshotBlock = -1;
+    self->historyEntries = numberOfEntries;
+    self->historyStarted = false;
+}
+
+bool
+CS101_InterrogationCursor_isRunning(CS101_InterrogationCursor self)
+{
+    return (self->group != -1);
+}
+
+static bool
+isCounterInterrogation(CS101_InterrogationCursor cursor)
+{
+    return (cursor->group >= COUNTER_GROUP_BITMAP(0));
+}
+
+/* add the frozen state of integrated totals to the ASDU */
+static bool
+addFrozenCounterToASDU(CS101_ProcessImage self, int index, CS101_ASDU asdu)
+{
+    union uInformationObject ioBuffer;
+    struct sBinaryCounterReading bcr;
+    uint64_t frozenTime;
+
+    CS101_ProcessImage_getFrozenIntegratedTotals(self, index, &bcr, &frozenTime);
+
+    InformationObject io;
+
+    if (self->typeId[index] == M_IT_TB_1) {
+        struct sCP56Time2a timestamp;
+
+        CP56Time2a_createFromMsTimestamp(&timestamp, frozenTime);
+
+        io = (InformationObject) IntegratedTotalsWithCP56Time2a_create((IntegratedTotalsWithCP56Time2a) &ioBuffer,
+                self->ioa[index], &bcr, &timestamp);
+    }
+    else
+        io = (InformationObject) IntegratedTotals_create((IntegratedTotals) &ioBuffer, self->ioa[index], &bcr);
+
+    return CS101_ASDU_addInformationObject(asdu, io);
+}
+
+/*
+ * copy the state of all points of a block - the copy is a consistent cut of the block. The values of
+ * integrated totals are stored relative to the reset value of the same cut.
+ */
+static void
+takeBlockSnapshot(CS101_ProcessImage self, CS101_InterrogationCursor cursor, int block)
+{
+    int firstIndex = block * CS101_PROCESS_IMAGE_BLOCK_SIZE;
+    int numberOfPoints = self->numberOfPoints - firstIndex;
+    int i;
+
+    if (numberOfPoints > CS101_PROCESS_IMAGE_BLOCK_SIZE)
+        numberOfPoints = CS101_PROCESS_IMAGE_BLOCK_SIZE;
+
+    SeqLock* lock = &(self->blockSequence[block]);
+    uint32_t sequence;
+
+    do {
+        sequence = SeqLock_readBegin(lock);
+
+        memcpy(cursor->snapshotValue, self->value + firstIndex, numberOfPoints * sizeof(PointValue));
+        memcpy(cursor->snapshotQuality, self->quality + firstIndex, numberOfPoints * sizeof(uint8_t));
+        memcpy(cursor->snapshotTimestamp, self->timestamp + firstIndex, numberOfPoints * sizeof(uint64_t));
+
+        if (self->counters) {
+            for (i = 0; i < numberOfPoints; i++) {
+                if (self->valueKind[firstIndex + i] == VALUE_KIND_INTEGRATED_TOTALS)
+                    cursor->snapshotValue[i] = (uint32_t) getCounterValue(self, firstIndex + i, (int32_t) cursor->snapshotValue[i]);
+            }
+        }
+    } while (SeqLock_readRetry(lock, sequence));
+
+    cursor->snapshotBlock = block;
+}
+
+static bool
+addPointToASDU(CS101_ProcessImage self, CS101_InterrogationCursor cursor, int index, CS101_ASDU asdu)
+{
+    if (isCounterInterrogation(cursor))
+        return addFrozenCounterToASDU(self, index, asdu);
+
+    int block = index / CS101_PROCESS_IMAGE_BLOCK_SIZE;
+
+    if (cursor->snapshotBlock != block)
+        takeBlockSnapshot(self, cursor, block);
+
+    int offset = index % CS101_PROCESS_IMAGE_BLOCK_SIZE;
+
+    PointValue value;
+    value.bits = cursor->snapshotValue[offset];
+
+    union uInformationObject ioBuffer;
+
+    InformationObject io = createInformationObject(self, index, (TypeID) self->typeId[index], value,
+            cursor->snapshotQuality[offset], cursor->snapshotTimestamp[offset], (InformationObject) &ioBuffer);
+
+    return CS101_ASDU_addInformationObject(asdu, io);
+}
+
+/* check if the point can follow the first point of a sequence (SQ = 1) ASDU */
+static bool
+isNextInSequence(CS101_ProcessImage self, int firstIndex, int index, int numberOfElements)
+{
+    return ((self->typeId[index] == self->typeId[firstIndex]) && (self->ca[index] == self->ca[firstIndex]) &&
+            (self->ioa[index] == self->ioa[firstIndex] + numberOfElements));
+}
+
+bool
+CS101_ProcessImage_getNextInterrogationASDU(CS101_ProcessImage self, CS101_InterrogationCursor cursor, CS101_ASDU asdu)
+{
+    if (CS101_InterrogationCursor_isRunning(cursor) == false)
+        return false;
+
+    int firstIndex = getNextGroupMember(self, cursor->group, cursor->ca, cursor->nextIndex);
+
+    if (firstIndex == -1) {
+        cursor->nextIndex = self->numberOfPoints;
+        return false;
+    }
+
+    int nextIndex = getNextGroupMember(self, cursor->group, cursor->ca, firstIndex + 1);
+
+    /* use a sequence of information elements when the points have consecutive IOAs */
+    bool isSequence = ((nextIndex != -1) && isNextInSequence(self, firstIndex, nextIndex, 1));
+
+    CS101_ASDU_setCA(asdu, self->ca[firstIndex]);
+    CS101_ASDU_setSequence(asdu, isSequence);
+
+    addPointToASDU(self, cursor, firstIndex, asdu);
+
+    int numberOfElements = 1;
+
+    while (nextIndex != -1) {
+
+        if (isSequence) {
+            if (isNextInSequence(self, firstIndex, nextIndex, numberOfElements) == false)
+                break;
+        }
+        else {
+            if ((self->typeId[nextIndex] != self->typeId[firstIndex]) || (self->ca[nextIndex] != self->ca[firstIndex]))
+                break;
+        }
+
+        if (addPointToASDU(self, cursor, nextIndex, asdu) == false)
+            break; /* ASDU is full */
+
+        numberOfElements++;
+
+        nextIndex = getNextGroupMember(self, cursor->group, cursor->ca, nextIndex + 1);
+    }
+
+    if (nextIndex == -1)
+        cursor->nextIndex = self->numberOfPoints;
+    else
+        cursor->nextIndex = nextIndex;
+
+    return true;
+}
+
+bool
+CS101_ProcessImage_getNextHistoryASDU(CS101_ProcessImage self, CS101_InterrogationCursor cursor, CS101_ASDU asdu)
+{
+    if ((CS101_InterrogationCursor_isRunning(cursor) == false) || (cursor->historyEntries < 1) || (self->historyCount == NULL))
+        return false;
+
+    int numberOfElements = 0;
+    int firstIndex = -1;
+
+    while (cursor->nextIndex < self->numberOfPoints) {
+        int index = cursor->nextIndex;
+
+        if ((cursor->ca != -1) && (self->ca[index] != cursor->ca)) {
+            cursor->nextIndex++;
+            continue;
+        }
+
+        uint32_t count = self->historyCount[index];
+
+        if (cursor->historyStarted == false) {
+            uint32_t numberOfEntries = (uint32_t) cursor->historyEntries;
+
+            if (numberOfEntries > count)
+                numberOfEntries = count;
+
+            cursor->historyNext = count - numberOfEntries;
+            cursor->historyStarted = true;
+        }
+
+        PointValue value;
+        uint8_t quality;
+        uint64_t timestamp;
+
+        /* skip entries that have been overwritten in the meantime */
+        if (count - cursor->historyNext > (uint32_t) self->historyDepth)
+            cursor->historyNext = count - self->historyDepth;
+
+        if ((cursor->historyNext >= count) ||
+                (readHistoryEntry(self, index, cursor->historyNext, &value, &quality, &timestamp) == false))
+        {
+            cursor->nextIndex++;
+            cursor->historyStarted = false;
+            continue;
+        }
+
+        TypeID typeId = getTimeTaggedType((TypeID) self->typeId[index]);
+
+        if (firstIndex == -1) {
+            firstIndex = index;
+            CS101_ASDU_setCA(asdu, self->ca[index]);
+        }
+        else if ((typeId != getTimeTaggedType((TypeID) self->typeId[firstIndex])) || (self->ca[index] != self->ca[firstIndex]))
+            break;
+
+        union uInformationObject ioBuffer;
+
+        InformationObject io = createInformationObject(self, index, typeId, value, quality, timestamp, (InformationObject) &ioBuffer);
+
+        if (CS101_ASDU_addInformationObject(asdu, io) == false)
+            break; /* ASDU is full */
+
+        numberOfElements++;
+        cursor->historyNext++;
+    }
+
+    return (numberOfElements > 0);
+}
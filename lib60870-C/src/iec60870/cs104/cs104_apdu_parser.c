@@ -0,0 +1,145 @@
+/*
+ *  cs104_apdu_parser.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <string.h>
+
+#include "cs104_apdu_parser.h"
+#include "lib60870_internal.h"
+
+#define START_BYTE 0x68
+
+/* minimum value of the length field (size of the control field) */
+#define MIN_APDU_LENGTH 4
+
+void
+CS104_APDUParser_initialize(CS104_APDUParser self)
+{
+    self->bufPos = 0;
+}
+
+bool
+CS104_APDUParser_hasPartialAPDU(CS104_APDUParser self)
+{
+    return (self->bufPos > 0);
+}
+
+static void
+decodeAPDU(CS104_APDU apdu, uint8_t* msg, int msgSize)
+{
+    apdu->apdu = msg;
+    apdu->apduSize = msgSize;
+    apdu->controlField = msg[2];
+    apdu->asdu = NULL;
+    apdu->asduSize = 0;
+
+    if ((msg[2] & 0x01) == 0) {
+        apdu->format = CS104_APDU_FORMAT_I;
+        apdu->sendSequenceNumber = ((msg[3] * 0x100) + (msg[2] & 0xfe)) / 2;
+        apdu->receiveSequenceNumber = ((msg[5] * 0x100) + (msg[4] & 0xfe)) / 2;
+        apdu->asdu = msg + 6;
+        apdu->asduSize = msgSize - 6;
+    }
+    else if ((msg[2] & 0x03) == 0x01) {
+        apdu->format = CS104_APDU_FORMAT_S;
+        apdu->sendSequenceNumber = 0;
+        apdu->receiveSequenceNumber = ((msg[5] * 0x100) + (msg[4] & 0xfe)) / 2;
+    }
+    else {
+        apdu->format = CS104_APDU_FORMAT_U;
+        apdu->sendSequenceNumber = 0;
+        apdu->receiveSequenceNumber = 0;
+    }
+}
+
+CS104_APDUParserResult
+CS104_APDUParser_parse(CS104_APDUParser self, uint8_t* data, int dataSize, int* bytesConsumed, CS104_APDU apdu)
+{
+    int pos = 0;
+
+    /* fast path - complete APDU is available in the provided data */
+    if ((self->bufPos == 0) && (dataSize >= 2 + MIN_APDU_LENGTH)) {
+
+        int apduSize = data[1] + 2;
+
+        if ((data[0] == START_BYTE) && (data[1] >= MIN_APDU_LENGTH) && (apduSize <= dataSize)) {
+            decodeAPDU(apdu, data, apduSize);
+
+            *bytesConsumed = apduSize;
+
+            return CS104_APDU_PARSER_APDU_COMPLETE;
+        }
+    }
+
+    /* slow path - collect the APDU in the internal buffer */
+    while (pos < dataSize) {
+
+        if (self->bufPos == 0) {
+            if (data[pos] != START_BYTE) {
+                DEBUG_PRINT("APDU parser: invalid start byte\n");
+                goto exit_with_error;
+            }
+
+            self->buffer[self->bufPos++] = data[pos++];
+        }
+        else if (self->bufPos == 1) {
+            if (data[pos] < MIN_APDU_LENGTH) {
+                DEBUG_PRINT("APDU parser: invalid length\n");
+                goto exit_with_error;
+            }
+
+            self->buffer[self->bufPos++] = data[pos++];
+        }
+        else {
+            int apduSize = self->buffer[1] + 2;
+            int missingBytes = apduSize - self->bufPos;
+
+            if (missingBytes > (dataSize - pos))
+                missingBytes = dataSize - pos;
+
+            memcpy(self->buffer + self->bufPos, data + pos, missingBytes);
+
+            self->bufPos += missingBytes;
+            pos += missingBytes;
+
+            if (self->bufPos == apduSize) {
+                decodeAPDU(apdu, self->buffer, apduSize);
+
+                self->bufPos = 0;
+                *bytesConsumed = pos;
+
+                return CS104_APDU_PARSER_APDU_COMPLETE;
+            }
+        }
+    }
+
+    *bytesConsumed = pos;
+
+    return CS104_APDU_PARSER_NEED_MORE_DATA;
+
+exit_with_error:
+
+    self->bufPos = 0;
+    *bytesConsumed = pos;
+
+    return CS104_APDU_PARSER_ERROR;
+}
@@ -0,0 +1,428 @@
+/*
+ *  cs104_client_engine.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+
+#include "cs104_client_engine.h"
+#include "cs104_connection_internal.h"
+#include "hal_thread.h"
+#include "hal_socket.h"
+#include "linked_list.h"
+#include "lib_memory.h"
+#include "lib60870_internal.h"
+
+/* maximum time to wait for received messages (timeouts are handled after the wait) */
+#define ENGINE_MAX_WAIT_TIME_MS 100
+
+/* time to wait while connections are connecting or no connection is established */
+#define ENGINE_CONNECT_WAIT_TIME_MS 10
+
+typedef struct {
+    CS104_ClientEngine engine;
+
+#if (CONFIG_USE_THREADS == 1)
+    Thread thread;
+#endif
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    /* protects the connection list - held while the event loop handles the connections */
+    Semaphore lock;
+#endif
+
+    LinkedList connections;
+    int numberOfConnections;
+
+    /* sockets of the established connections - only rebuilt when a connection is opened or closed */
+    HandleSet handleSet;
+    bool updateHandleSet;
+
+    /* connections that don't read because the decode queue is full (the handle set is rebuilt every time) */
+    int numberOfPausedConnections;
+} EventLoop;
+
+struct sCS104_ClientEngine {
+    int numberOfLoops;
+    EventLoop* loops;
+
+    bool running;
+};
+
+static void
+lockEventLoop(EventLoop* loop)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(loop->lock);
+#endif
+}
+
+static void
+unlockEventLoop(EventLoop* loop)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(loop->lock);
+#endif
+}
+
+/**
+ * \brief Start requested connects and collect the sockets of the established connections
+ *
+ * \return the time to wait for received messages
+ */
+static int
+prepareWait(EventLoop* loop, bool* hasSockets)
+{
+    int waitTime = ENGINE_MAX_WAIT_TIME_MS;
+    int numberOfSockets = 0;
+    int numberOfPausedConnections = 0;
+
+    if (loop->numberOfPausedConnections > 0)
+        loop->updateHandleSet = true;
+
+    if (loop->updateHandleSet)
+        Handleset_reset(loop->handleSet);
+
+    LinkedList element = LinkedList_getNext(loop->connections);
+
+    while (element) {
+        CS104_Connection connection = (CS104_Connection) LinkedList_getData(element);
+
+        if (CS104_Connection_takeConnectRequest(connection)) {
+            CS104_Connection_startConnectNonBlocking(connection);
+        }
+
+        if (CS104_Connection_isConnecting(connection)) {
+            waitTime = ENGINE_CONNECT_WAIT_TIME_MS;
+        }
+        else {
+            Socket socket = CS104_Connection_getSocket(connection);
+
+            if (socket) {
+                if (CS104_Connection_isReceivePaused(connection)) {
+                    numberOfPausedConnections++;
+                }
+                else {
+                    if (loop->updateHandleSet)
+                        Handleset_addSocket(loop->handleSet, socket);
+
+                    numberOfSockets++;
+                }
+            }
+        }
+
+        element = LinkedList_getNext(element);
+    }
+
+    /*
+     * the handle set copies the socket descriptors when it is used the first time. This has to be done here -
+     * a socket can be destroyed by CS104_ClientEngine_removeConnection while the event loop waits.
+     */
+    if (loop->updateHandleSet && (numberOfSockets > 0))
+        Handleset_waitReady(loop->handleSet, 0);
+
+    loop->updateHandleSet = false;
+    loop->numberOfPausedConnections = numberOfPausedConnections;
+
+    /* paused connections are checked for free slots of the decode queue with the short wait time */
+    if ((numberOfSockets == 0) || (numberOfPausedConnections > 0))
+        waitTime = ENGINE_CONNECT_WAIT_TIME_MS;
+
+    *hasSockets = (numberOfSockets > 0);
+
+    return waitTime;
+}
+
+/* \param readable true when at least one socket of the handle set is ready */
+static void
+handleConnections(EventLoop* loop, bool readable)
+{
+    LinkedList element = LinkedList_getNext(loop->connections);
+
+    while (element) {
+        CS104_Connection connection = (CS104_Connection) LinkedList_getData(element);
+
+        Socket oldSocket = CS104_Connection_getSocket(connection);
+
+        /* only read from the connections with pending data */
+        bool socketReady = readable && Handleset_isReady(loop->handleSet, oldSocket);
+
+        CS104_Connection_handleEvents(connection, socketReady);
+
+        if (CS104_Connection_getSocket(connection) != oldSocket)
+            loop->updateHandleSet = true;
+
+        element = LinkedList_getNext(element);
+    }
+}
+
+static bool
+containsConnection(EventLoop* loop, CS104_Connection connection)
+{
+    LinkedList element = LinkedList_getNext(loop->connections);
+
+    while (element) {
+        if (LinkedList_getData(element) == connection)
+            return true;
+
+        element = LinkedList_getNext(element);
+    }
+
+    return false;
+}
+
+/* close the connection and return it to the mode with connection thread */
+static void
+closeAndDetach(CS104_Connection connection)
+{
+    CS104_Connection_close(connection);
+
+    while (CS104_Connection_handleEvents(connection, false));
+
+    CS104_Connection_setEngine(connection, NULL);
+}
+
+#if (CONFIG_USE_THREADS == 1)
+static void*
+runEventLoop(void* parameter)
+{
+    EventLoop* loop = (EventLoop*) parameter;
+
+    while (loop->engine->running) {
+        bool hasSockets;
+
+        lockEventLoop(loop);
+
+        int waitTime = prepareWait(loop, &hasSockets);
+
+        unlockEventLoop(loop);
+
+        bool readable = false;
+
+        if (hasSockets)
+            readable = (Handleset_waitReady(loop->handleSet, waitTime) != 0);
+        else
+            Thread_sleep(waitTime);
+
+        lockEventLoop(loop);
+
+        handleConnections(loop, readable);
+
+        unlockEventLoop(loop);
+    }
+
+    return NULL;
+}
+#endif /* (CONFIG_USE_THREADS == 1) */
+
+CS104_ClientEngine
+CS104_ClientEngine_create(int numberOfThreads)
+{
+    if (numberOfThreads < 1)
+        return NULL;
+
+    CS104_ClientEngine self = (CS104_ClientEngine) GLOBAL_CALLOC(1, sizeof(struct sCS104_ClientEngine));
+
+    if (self) {
+        self->loops = (EventLoop*) GLOBAL_CALLOC(numberOfThreads, sizeof(EventLoop));
+
+        if (self->loops == NULL) {
+            GLOBAL_FREEMEM(self);
+            return NULL;
+        }
+
+        self->numberOfLoops = numberOfThreads;
+        self->running = false;
+
+        int i;
+
+        for (i = 0; i < numberOfThreads; i++) {
+            EventLoop* loop = &(self->loops[i]);
+
+            loop->engine = self;
+#if (CONFIG_USE_SEMAPHORES == 1)
+            loop->lock = Semaphore_create(1);
+#endif
+            loop->connections = LinkedList_create();
+            loop->numberOfConnections = 0;
+            loop->handleSet = Handleset_new();
+            loop->updateHandleSet = true;
+        }
+    }
+
+    return self;
+}
+
+void
+CS104_ClientEngine_start(CS104_ClientEngine self)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->running)
+        return;
+
+    self->running = true;
+
+    int i;
+
+    for (i = 0; i < self->numberOfLoops; i++) {
+        EventLoop* loop = &(self->loops[i]);
+
+        loop->thread = Thread_create(runEventLoop, (void*) loop, false);
+
+        if (loop->thread)
+            Thread_start(loop->thread);
+    }
+#endif /* (CONFIG_USE_THREADS == 1) */
+}
+
+void
+CS104_ClientEngine_stop(CS104_ClientEngine self)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->running == false)
+        return;
+
+    self->running = false;
+
+    int i;
+
+    for (i = 0; i < self->numberOfLoops; i++) {
+        EventLoop* loop = &(self->loops[i]);
+
+        if (loop->thread) {
+            Thread_destroy(loop->thread);
+            loop->thread = NULL;
+        }
+    }
+#endif /* (CONFIG_USE_THREADS == 1) */
+}
+
+bool
+CS104_ClientEngine_addConnection(CS104_ClientEngine self, CS104_Connection connection)
+{
+    int i;
+
+    EventLoop* selectedLoop = NULL;
+
+    for (i = 0; i < self->numberOfLoops; i++) {
+        EventLoop* loop = &(self->loops[i]);
+
+        lockEventLoop(loop);
+
+        bool found = containsConnection(loop, connection);
+
+        unlockEventLoop(loop);
+
+        if (found)
+            return false;
+
+        if ((selectedLoop == NULL) || (loop->numberOfConnections < selectedLoop->numberOfConnections))
+            selectedLoop = loop;
+    }
+
+    lockEventLoop(selectedLoop);
+
+    CS104_Connection_setEngine(connection, self);
+
+    LinkedList_add(selectedLoop->connections, connection);
+    selectedLoop->numberOfConnections++;
+
+    unlockEventLoop(selectedLoop);
+
+    return true;
+}
+
+void
+CS104_ClientEngine_removeConnection(CS104_ClientEngine self, CS104_Connection connection)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfLoops; i++) {
+        EventLoop* loop = &(self->loops[i]);
+
+        lockEventLoop(loop);
+
+        if (LinkedList_remove(loop->connections, connection)) {
+            loop->numberOfConnections--;
+
+            closeAndDetach(connection);
+
+            loop->updateHandleSet = true;
+
+            unlockEventLoop(loop);
+
+            return;
+        }
+
+        unlockEventLoop(loop);
+    }
+}
+
+int
+CS104_ClientEngine_getNumberOfConnections(CS104_ClientEngine self)
+{
+    int numberOfConnections = 0;
+    int i;
+
+    for (i = 0; i < self->numberOfLoops; i++) {
+        EventLoop* loop = &(self->loops[i]);
+
+        lockEventLoop(loop);
+
+        numberOfConnections += loop->numberOfConnections;
+
+        unlockEventLoop(loop);
+    }
+
+    return numberOfConnections;
+}
+
+void
+CS104_ClientEngine_destroy(CS104_ClientEngine self)
+{
+    CS104_ClientEngine_stop(self);
+
+    int i;
+
+    for (i = 0; i < self->numberOfLoops; i++) {
+        EventLoop* loop = &(self->loops[i]);
+
+        LinkedList element = LinkedList_getNext(loop->connections);
+
+        while (element) {
+            CS104_Connection connection = (CS104_Connection) LinkedList_getData(element);
+
+            closeAndDetach(connection);
+
+            element = LinkedList_getNext(element);
+        }
+
+        LinkedList_destroyStatic(loop->connections);
+        Handleset_destroy(loop->handleSet);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_destroy(loop->lock);
+#endif
+    }
+
+    GLOBAL_FREEMEM(self->loops);
+    GLOBAL_FREEMEM(self);
+}
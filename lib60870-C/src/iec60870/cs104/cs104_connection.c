@@ -25,6 +25,8 @@
 #endif
 
 #include "cs104_connection.h"
+#include "cs104_client_engine.h"
+#include "cs104_reconnect_manager.h"
 
 #include <limits.h>
 #include <stdlib.h>
@@ -32,6 +34,7 @@
 #include <stdio.h>
 
 #include "cs104_frame.h"
+#include "cs104_apdu_parser.h"
 #include "hal_thread.h"
 #include "hal_socket.h"
 #include "tls_socket.h"
@@ -42,6 +45,8 @@
 #include "information_objects_internal.h"
 #include "lib60870_internal.h"
 #include "cs101_asdu_internal.h"
+#include "cs101_mirror_internal.h"
+#include "cs104_connection_internal.h"
 
 struct sCS104_APCIParameters defaultAPCIParameters = {
 		/* .k = */ 12,
@@ -74,11 +79,44 @@ typedef enum {
     STATE_WAITING_FOR_STOPDT_CON = 4
 } CS104_ConState;
 
+/* state of the socket - used by the event loop of a client engine */
+typedef enum {
+    IO_STATE_IDLE = 0,
+    IO_STATE_CONNECTING = 1,
+    IO_STATE_CONNECTED = 2
+} CS104_IOState;
+
 typedef struct {
     uint64_t sentTime; /* required for T1 timeout */
     int seqNo;
+
+    /* handler of a queued ASDU - informed when the I frame is confirmed */
+    CS104_SendCompletionHandler handler;
+    void* parameter;
 } SentASDU;
 
+typedef struct {
+    Frame frame; /* NULL when the deadline elapsed */
+    uint64_t deadline; /* 0 = no deadline */
+    CS104_SendCompletionHandler handler;
+    void* parameter;
+} QueuedASDU;
+
+typedef struct {
+    CS104_SendCompletionHandler handler;
+    void* parameter;
+    CS104_SendEvent event;
+} SendCompletion;
+
+/* received ASDU waiting for a thread of the decode pool */
+typedef struct {
+    int size;
+    uint8_t asdu[IEC60870_5_104_MAX_ASDU_LENGTH];
+} DecodeSlot;
+
+/* smallest I message that is queued for the decode pool (APCI and at least one byte of ASDU) */
+#define MIN_I_MESSAGE_SIZE (IEC60870_5_104_APCI_LENGTH + 1)
+
 struct sCS104_Connection {
     char hostname[HOST_NAME_MAX + 1];
     int tcpPort;
@@ -90,20 +128,70 @@ struct sCS104_Connection {
     struct sCS101_AppLayerParameters alParameters;
 
     uint8_t recvBuffer[260];
-    int recvBufPos;
+    sCS104_APDUParser apduParser;
+
+    /* reference counted receive buffers - used instead of recvBuffer when a buffer is free */
+    CS104_ReceiveBufferPool receiveBufferPool;
+    uint8_t* receiveBuffer;
+
+    T104FramePool framePool; /* frames for the ASDUs sent by the application */
 
     int connectTimeoutInMs;
     uint8_t sMessage[6];
 
     SentASDU* sentASDUs; /* the k-buffer */
-    int maxSentASDUs;    /* maximum number of ASDU to be sent without confirmation - parameter k */
+    int maxSentASDUs;    /* size of the k-buffer - parameter k (or maximum k in adaptive mode) */
     int oldestSentASDU;  /* index of oldest entry in k-buffer */
     int newestSentASDU;  /* index of newest entry in k-buffer */
 
+    /* adaptive mode (see CS104_Connection_setAdaptiveWindow) */
+    bool adaptiveWindow;
+    int minK;
+    int maxK;
+    int minW;
+    int maxW;
+
+    int sendWindow;      /* maximum number of ASDUs sent without confirmation */
+    int ackThreshold;    /* number of received I messages confirmed by one S message */
+    bool sendWindowFull; /* the send window was full since the last confirmation */
+
+    /* round trip time measurement */
+    uint64_t uMessageSentTime; /* STARTDT ACT or TESTFR ACT waiting for confirmation (0 = none) */
+    uint64_t lastIMessageTime;
+    int interArrivalTime;      /* smoothed time between received I messages in 1/16 ms (0 = not measured) */
+
+    struct sCS104_WindowStatistics statistics;
+    uint64_t utilizationSum;
+
+    /* send queue - ASDUs waiting for space in the k-buffer */
+    QueuedASDU* sendQueue;
+    int sendQueueSize;
+    int firstQueuedASDU;
+    int numberOfQueuedASDUs;
+
+    /*
+     * events of queued ASDUs - the handlers are called after conStateLock is released. Each queued ASDU reserves
+     * two entries (sent and the final event) until its final event is handled.
+     */
+    SendCompletion* completions;
+    int maxCompletions;
+    int firstCompletion;
+    int numberOfCompletions;
+    int reservedCompletions;
+    bool dispatchingCompletions;
+
 #if (CONFIG_USE_THREADS == 1)
     Thread connectionHandlingThread;
 #endif
 
+    /* event loop driven mode (connection is handled by a client engine or by the application) */
+    CS104_ClientEngine engine;
+    CS104_IOState ioState;
+    uint64_t connectDeadline;
+    bool connectRequested;
+    bool threadless;
+    bool inTick;
+
     int receiveCount;
     int sendCount;
 
@@ -137,6 +225,36 @@ struct sCS104_Connection {
     CS101_ASDUReceivedHandler receivedHandler;
     void* receivedHandlerParameter;
 
+    /* batch delivery of the ASDUs received with one socket read */
+    CS101_ASDUBatchHandler batchHandler;
+    void* batchHandlerParameter;
+    int maxBatchSize;
+    struct sCS101_ASDU* batchASDUs;
+    CS101_ASDU* batch;
+    int batchSize;
+    uint8_t* batchRecvBuffer;
+    int batchRecvBufferSize;
+
+    /* decode pool - the received ASDUs are handled by the threads of the pool */
+    CS104_DecodePool decodePool;
+    int decodeWorker; /* home thread of the connection */
+    DecodeSlot* decodeQueue;
+    int decodeQueueSize;
+    int firstDecodeSlot;
+    int numberOfDecodeSlots; /* queued ASDUs, including the ASDUs handled by a pool thread */
+    bool decodeScheduled;    /* queued on a pool thread, or handled by a pool thread */
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore decodeLock;
+#endif
+
+    CS101_Mirror mirror;
+    CS101_CommandTracker commandTracker;
+
+    /* reconnect manager and the index of the connection in the manager */
+    CS104_ReconnectManager reconnectManager;
+    int reconnectEntry;
+
     CS104_ConnectionHandler connectionHandler;
     void* connectionHandlerParameter;
 
@@ -190,6 +308,8 @@ sendSMessage(CS104_Connection self)
 {
     uint8_t* msg = self->sMessage;
 
+    self->statistics.sentSMessages++;
+
     msg [4] = (uint8_t) ((self->receiveCount % 128) * 2);
     msg [5] = (uint8_t) (self->receiveCount / 128);
 
@@ -213,22 +333,107 @@ sendIMessage(CS104_Connection self, Frame frame)
     return sendCount;
 }
 
+static int
+getNumberOfSentASDUs(CS104_Connection self)
+{
+    if (self->oldestSentASDU == -1)
+        return 0;
+    else
+        return ((self->newestSentASDU - self->oldestSentASDU + self->maxSentASDUs) % self->maxSentASDUs) + 1;
+}
+
+static void
+sendIMessageAndUpdateSentASDUs(CS104_Connection self, Frame frame)
+{
+    int currentIndex = 0;
+
+    if (self->oldestSentASDU == -1)
+    {
+        self->oldestSentASDU = 0;
+        self->newestSentASDU = 0;
+
+    }
+    else
+    {
+        currentIndex = (self->newestSentASDU + 1) % self->maxSentASDUs;
+    }
+
+    self->sentASDUs [currentIndex].seqNo = sendIMessage (self, frame);
+    self->sentASDUs [currentIndex].sentTime = Hal_getMonotonicTimeInMs();
+    self->sentASDUs [currentIndex].handler = NULL;
+
+    self->newestSentASDU = currentIndex;
+
+    int outstanding = getNumberOfSentASDUs(self);
+
+    self->statistics.sentIMessages++;
+
+    if (outstanding > self->statistics.maxOutstanding)
+        self->statistics.maxOutstanding = outstanding;
+
+    self->utilizationSum += (outstanding * 100) / self->sendWindow;
+}
+
+static void
+pushCompletion(CS104_Connection self, CS104_SendCompletionHandler handler, void* parameter, CS104_SendEvent event)
+{
+    int index = (self->firstCompletion + self->numberOfCompletions) % self->maxCompletions;
+
+    self->completions[index].handler = handler;
+    self->completions[index].parameter = parameter;
+    self->completions[index].event = event;
+
+    self->numberOfCompletions++;
+}
+
+/* called when the I frame of an entry of the k-buffer is confirmed */
+static void
+confirmSentASDU(CS104_Connection self, int index)
+{
+    SentASDU* sentASDU = &(self->sentASDUs[index]);
+
+    if (sentASDU->handler) {
+        pushCompletion(self, sentASDU->handler, sentASDU->parameter, CS104_SEND_EVENT_CONFIRMED);
+        sentASDU->handler = NULL;
+    }
+}
+
 static CS104_Connection
 createConnection(const char* hostname, int tcpPort)
 {
     CS104_Connection self = (CS104_Connection) GLOBAL_CALLOC(1, sizeof(struct sCS104_Connection));
 
     if (self != NULL) {
+        self->framePool = T104FramePool_create(CONFIG_CS104_CONNECTION_FRAME_POOL_SIZE);
+
+        if (self->framePool == NULL) {
+            GLOBAL_FREEMEM(self);
+            return NULL;
+        }
+
         strncpy(self->hostname, hostname, HOST_NAME_MAX);
         self->tcpPort = tcpPort;
         self->parameters = defaultAPCIParameters;
         self->alParameters = defaultAppLayerParameters;
 
+        self->sendWindow = self->parameters.k;
+        self->ackThreshold = self->parameters.w;
+
         self->localIpAddress = NULL;
         self->localTcpPort = -1;
 
         self->receivedHandler = NULL;
         self->receivedHandlerParameter = NULL;
+        self->mirror = NULL;
+        self->commandTracker = NULL;
+
+        self->decodePool = NULL;
+
+        self->receiveBufferPool = NULL;
+        self->receiveBuffer = NULL;
+
+        self->reconnectManager = NULL;
+        self->reconnectEntry = -1;
 
         self->connectionHandler = NULL;
         self->connectionHandlerParameter = NULL;
@@ -244,6 +449,12 @@ createConnection(const char* hostname, int tcpPort)
         self->connectionHandlingThread = NULL;
 #endif
 
+        self->engine = NULL;
+        self->ioState = IO_STATE_IDLE;
+        self->connectRequested = false;
+        self->threadless = false;
+        self->inTick = false;
+
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
         self->tlsConfig = NULL;
         self->tlsSocket = NULL;
@@ -292,6 +503,17 @@ resetT3Timeout(CS104_Connection self)
     self->nextT3Timeout = Hal_getMonotonicTimeInMs() + (self->parameters.t3 * 1000);
 }
 
+static int
+clampValue(int value, int min, int max)
+{
+    if (value < min)
+        return min;
+    else if (value > max)
+        return max;
+    else
+        return value;
+}
+
 static void
 resetConnection(CS104_Connection self)
 {
@@ -300,7 +522,7 @@ resetConnection(CS104_Connection self)
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 
     self->connectTimeoutInMs = self->parameters.t0 * 1000;
-    self->recvBufPos = 0;
+    CS104_APDUParser_initialize(&(self->apduParser));
 
     self->running = false;
     self->failure = false;
@@ -316,11 +538,36 @@ resetConnection(CS104_Connection self)
     self->oldestSentASDU = -1;
     self->newestSentASDU = -1;
 
-    if (self->sentASDUs == NULL) {
-        self->maxSentASDUs = self->parameters.k;
+    int maxSentASDUs = self->adaptiveWindow ? self->maxK : self->parameters.k;
+
+    /* the k-buffer is allocated again when k has been changed */
+    if ((self->sentASDUs == NULL) || (self->maxSentASDUs != maxSentASDUs)) {
+        if (self->sentASDUs)
+            GLOBAL_FREEMEM(self->sentASDUs);
+
+        self->maxSentASDUs = maxSentASDUs;
         self->sentASDUs = (SentASDU*) GLOBAL_MALLOC(sizeof(SentASDU) * self->maxSentASDUs);
     }
 
+    if (self->adaptiveWindow) {
+        self->sendWindow = clampValue(self->parameters.k, self->minK, self->maxK);
+        self->ackThreshold = clampValue(self->parameters.w, self->minW, self->maxW);
+    }
+    else {
+        self->sendWindow = self->parameters.k;
+        self->ackThreshold = self->parameters.w;
+    }
+
+    self->sendWindowFull = false;
+    self->uMessageSentTime = 0;
+    self->lastIMessageTime = 0;
+    self->interArrivalTime = 0;
+
+    memset(&(self->statistics), 0, sizeof(struct sCS104_WindowStatistics));
+    self->statistics.smoothedRtt = -1;
+    self->statistics.minRtt = -1;
+    self->utilizationSum = 0;
+
     self->outstandingTestFCConMessages = 0;
     self->uMessageTimeout = 0;
 
@@ -333,6 +580,89 @@ resetConnection(CS104_Connection self)
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 }
 
+/**
+ * \brief Adapt the send window to the measured round trip time (adaptive mode)
+ */
+static void
+adaptSendWindow(CS104_Connection self)
+{
+    /* tolerance for the resolution of the time measurement */
+    int minRtt = self->statistics.minRtt + 10;
+
+    if (self->statistics.smoothedRtt > (4 * minRtt)) {
+        /* messages are queued by the link or the server */
+        if (self->sendWindow > self->minK)
+            self->sendWindow--;
+    }
+    else if (self->sendWindowFull && (self->statistics.smoothedRtt < (2 * minRtt))) {
+        if (self->sendWindow < self->maxK)
+            self->sendWindow++;
+    }
+}
+
+/**
+ * \brief Update the round trip time with the confirmation of a message
+ *
+ * \param sentTime time when the confirmed message was sent
+ * \param iMessage true for the confirmation of an I message
+ */
+static void
+updateRoundTripTime(CS104_Connection self, uint64_t sentTime, bool iMessage)
+{
+    uint64_t currentTime = Hal_getMonotonicTimeInMs();
+
+    int rtt = (currentTime > sentTime) ? (int) (currentTime - sentTime) : 0;
+
+    if (self->statistics.smoothedRtt == -1)
+        self->statistics.smoothedRtt = rtt;
+    else
+        self->statistics.smoothedRtt += (rtt - self->statistics.smoothedRtt) / 8;
+
+    if ((self->statistics.minRtt == -1) || (rtt < self->statistics.minRtt))
+        self->statistics.minRtt = rtt;
+
+    if (iMessage) {
+        if (self->adaptiveWindow)
+            adaptSendWindow(self);
+
+        self->sendWindowFull = false;
+    }
+}
+
+/**
+ * \brief Update the time between received I messages and the acknowledgement threshold (adaptive mode)
+ */
+static void
+updateAckThreshold(CS104_Connection self)
+{
+    uint64_t currentTime = Hal_getMonotonicTimeInMs();
+
+    if (self->lastIMessageTime != 0) {
+        int interval = (currentTime > self->lastIMessageTime) ? (int) (currentTime - self->lastIMessageTime) : 0;
+
+        /* idle times don't count as one long interval */
+        if (interval > 1000)
+            interval = 1000;
+
+        if (self->interArrivalTime == 0)
+            self->interArrivalTime = (interval * 16) + 1;
+        else
+            self->interArrivalTime += ((interval * 16) - self->interArrivalTime) / 8;
+
+        if (self->interArrivalTime < 1)
+            self->interArrivalTime = 1;
+    }
+
+    self->lastIMessageTime = currentTime;
+
+    if (self->adaptiveWindow && (self->statistics.minRtt != -1) && (self->interArrivalTime != 0)) {
+        /* I messages the server sends during one round trip - they are sent before the S message is received */
+        int inFlight = ((self->statistics.minRtt * 16) + self->interArrivalTime - 1) / self->interArrivalTime;
+
+        self->ackThreshold = clampValue(self->parameters.k - inFlight, self->minW, self->maxW);
+    }
+}
+
 static bool
 checkSequenceNumber(CS104_Connection self, int seqNo)
 {
@@ -384,9 +714,13 @@ checkSequenceNumber(CS104_Connection self, int seqNo)
                 if (seqNo == oldestValidSeqNo)
                     break;
 
+                confirmSentASDU(self, self->oldestSentASDU);
+
                 if (self->sentASDUs [self->oldestSentASDU].seqNo == seqNo) {
                     /* we arrived at the seq# that has been confirmed */
 
+                    updateRoundTripTime(self, self->sentASDUs [self->oldestSentASDU].sentTime, true);
+
                     if (self->oldestSentASDU == self->newestSentASDU)
                         self->oldestSentASDU = -1;
                     else
@@ -415,15 +749,147 @@ checkSequenceNumber(CS104_Connection self, int seqNo)
 static bool
 isSentBufferFull(CS104_Connection self)
 {
-    if (self->oldestSentASDU == -1)
-        return false;
+    return (getNumberOfSentASDUs(self) >= self->sendWindow);
+}
 
-    int newIndex = (self->newestSentASDU + 1) % self->maxSentASDUs;
+/* send queued ASDUs while the k-buffer has space - requires conStateLock */
+static void
+sendQueuedASDUs(CS104_Connection self)
+{
+    while ((self->numberOfQueuedASDUs > 0) && (self->conState == STATE_ACTIVE) && (isSentBufferFull(self) == false)) {
+        QueuedASDU* queuedASDU = &(self->sendQueue[self->firstQueuedASDU]);
 
-    if (newIndex == self->oldestSentASDU)
-        return true;
-    else
-        return false;
+        self->firstQueuedASDU = (self->firstQueuedASDU + 1) % self->sendQueueSize;
+        self->numberOfQueuedASDUs--;
+
+        /* skip ASDUs with elapsed deadline */
+        if (queuedASDU->frame) {
+            sendIMessageAndUpdateSentASDUs(self, queuedASDU->frame);
+
+            if (queuedASDU->handler) {
+                self->sentASDUs[self->newestSentASDU].handler = queuedASDU->handler;
+                self->sentASDUs[self->newestSentASDU].parameter = queuedASDU->parameter;
+
+                pushCompletion(self, queuedASDU->handler, queuedASDU->parameter, CS104_SEND_EVENT_SENT);
+            }
+
+            T104Frame_destroy(queuedASDU->frame);
+            queuedASDU->frame = NULL;
+        }
+    }
+
+    if ((self->numberOfQueuedASDUs > 0) && (self->conState == STATE_ACTIVE) && (self->sendWindowFull == false)) {
+        self->sendWindowFull = true;
+        self->statistics.windowFullEvents++;
+    }
+}
+
+/* remove queued ASDUs with elapsed deadline - requires conStateLock */
+static void
+removeExpiredASDUs(CS104_Connection self, uint64_t currentTime)
+{
+    int i;
+
+    for (i = 0; i < self->numberOfQueuedASDUs; i++) {
+        QueuedASDU* queuedASDU = &(self->sendQueue[(self->firstQueuedASDU + i) % self->sendQueueSize]);
+
+        if (queuedASDU->frame && (queuedASDU->deadline != 0) && (currentTime > queuedASDU->deadline)) {
+            DEBUG_PRINT("Deadline of queued ASDU elapsed\n");
+
+            if (queuedASDU->handler)
+                pushCompletion(self, queuedASDU->handler, queuedASDU->parameter, CS104_SEND_EVENT_TIMEOUT);
+
+            T104Frame_destroy(queuedASDU->frame);
+            queuedASDU->frame = NULL;
+        }
+    }
+
+    /* remove the expired ASDUs from the head of the queue */
+    while ((self->numberOfQueuedASDUs > 0) && (self->sendQueue[self->firstQueuedASDU].frame == NULL)) {
+        self->firstQueuedASDU = (self->firstQueuedASDU + 1) % self->sendQueueSize;
+        self->numberOfQueuedASDUs--;
+    }
+}
+
+/* the connection is closed - queued and unconfirmed ASDUs fail. Requires conStateLock */
+static void
+failPendingASDUs(CS104_Connection self)
+{
+    if (self->oldestSentASDU != -1) {
+        int index = self->oldestSentASDU;
+
+        while (true) {
+            SentASDU* sentASDU = &(self->sentASDUs[index]);
+
+            if (sentASDU->handler) {
+                pushCompletion(self, sentASDU->handler, sentASDU->parameter, CS104_SEND_EVENT_FAILED);
+                sentASDU->handler = NULL;
+            }
+
+            if (index == self->newestSentASDU)
+                break;
+
+            index = (index + 1) % self->maxSentASDUs;
+        }
+    }
+
+    while (self->numberOfQueuedASDUs > 0) {
+        QueuedASDU* queuedASDU = &(self->sendQueue[self->firstQueuedASDU]);
+
+        if (queuedASDU->frame) {
+            if (queuedASDU->handler)
+                pushCompletion(self, queuedASDU->handler, queuedASDU->parameter, CS104_SEND_EVENT_FAILED);
+
+            T104Frame_destroy(queuedASDU->frame);
+            queuedASDU->frame = NULL;
+        }
+
+        self->firstQueuedASDU = (self->firstQueuedASDU + 1) % self->sendQueueSize;
+        self->numberOfQueuedASDUs--;
+    }
+}
+
+/* call the handlers of the send events - must be called without holding conStateLock */
+static void
+dispatchCompletions(CS104_Connection self)
+{
+    if (self->completions == NULL)
+        return;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    /* only one thread calls the handlers - keeps the order of the events */
+    if (self->dispatchingCompletions == false) {
+        self->dispatchingCompletions = true;
+
+        while (self->numberOfCompletions > 0) {
+            SendCompletion completion = self->completions[self->firstCompletion];
+
+            self->firstCompletion = (self->firstCompletion + 1) % self->maxCompletions;
+            self->numberOfCompletions--;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Semaphore_post(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+            completion.handler(completion.parameter, self, completion.event);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+            if (completion.event != CS104_SEND_EVENT_SENT)
+                self->reservedCompletions -= 2;
+        }
+
+        self->dispatchingCompletions = false;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
 }
 
 void
@@ -435,10 +901,18 @@ CS104_Connection_close(CS104_Connection self)
 
     self->close = true;
 
+    /* a connection of a client engine is closed by the event loop */
+    self->connectRequested = false;
+
 #if (CONFIG_USE_SEMAPHORES == 1)
     Semaphore_post(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 
+    /* in threadless mode the connection is closed immediately (or at the end of the tick when called by a handler) */
+    if (self->threadless && (self->inTick == false)) {
+        while (CS104_Connection_handleEvents(self, false));
+    }
+
 #if (CONFIG_USE_THREADS == 1)
     if (self->connectionHandlingThread)
     {
@@ -451,11 +925,31 @@ CS104_Connection_close(CS104_Connection self)
 void
 CS104_Connection_destroy(CS104_Connection self)
 {
+    if (self->reconnectManager)
+        CS104_ReconnectManager_removeConnection(self->reconnectManager, self);
+
     CS104_Connection_close(self);
 
+    if (self->engine)
+        CS104_ClientEngine_removeConnection(self->engine, self);
+
     if (self->sentASDUs != NULL)
         GLOBAL_FREEMEM(self->sentASDUs);
 
+    if (self->sendQueue != NULL)
+        GLOBAL_FREEMEM(self->sendQueue);
+
+    if (self->completions != NULL)
+        GLOBAL_FREEMEM(self->completions);
+
+    CS104_Connection_setDecodePool(self, NULL, 0);
+
+    CS104_Connection_setReceiveBufferPool(self, NULL);
+
+    CS104_Connection_setASDUBatchHandler(self, NULL, NULL, 0);
+
+    T104FramePool_destroy(self->framePool);
+
 #if (CONFIG_USE_SEMAPHORES == 1)
     Semaphore_destroy(self->conStateLock);
 #endif
@@ -532,73 +1026,6 @@ readFromSocket(CS104_Connection self, uint8_t* buffer, int size)
 #endif
 }
 
-/**
- * \brief Read message part into receive buffer
- *
- * \return -1 in case of an error, 0 when no complete message can be read, > 0 when a complete message is in buffer
- */
-static int
-receiveMessage(CS104_Connection self)
-{
-    uint8_t* buffer = self->recvBuffer;
-    int bufPos = self->recvBufPos;
-
-    /* read start byte */
-    if (bufPos == 0) {
-        int readFirst = readFromSocket(self, buffer, 1);
-
-        if (readFirst < 1)
-            return readFirst;
-
-        if (buffer[0] != 0x68)
-            return -1; /* message error */
-
-        bufPos++;
-    }
-
-    /* read length byte */
-    if (bufPos == 1)  {
-
-        int readCnt = readFromSocket(self, buffer + 1, 1);
-
-        if (readCnt < 0) {
-            self->recvBufPos = 0;
-            return -1;
-        }
-        else if (readCnt == 0) {
-            self->recvBufPos = 1;
-            return 0;
-        }
-
-        bufPos++;
-    }
-
-    /* read remaining frame */
-    if (bufPos > 1) {
-        int length = buffer[1];
-
-        int remainingLength = length - bufPos + 2;
-
-        int readCnt = readFromSocket(self, buffer + bufPos, remainingLength);
-
-        if (readCnt == remainingLength) {
-            self->recvBufPos = 0;
-            return length + 2;
-        }
-        else if (readCnt == -1) {
-            self->recvBufPos = 0;
-            return -1;
-        }
-        else {
-            self->recvBufPos = bufPos + readCnt;
-            return 0;
-        }
-    }
-
-    self->recvBufPos = bufPos;
-    return 0;
-}
-
 static bool
 checkConfirmTimeout(CS104_Connection self, uint64_t currentTime)
 {
@@ -620,27 +1047,96 @@ confirmOutstandingMessages(CS104_Connection self)
     sendSMessage(self);
 }
 
+/**
+ * \brief Check if the received ASDUs are delivered in batches by the thread of the connection
+ */
 static bool
-checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
+isBatchDelivery(CS104_Connection self)
 {
-    bool retVal = true;
-
-    if ((buffer[2] & 1) == 0) /* I format frame */
-    {
-        if (self->timeoutT2Trigger == false) {
-            self->timeoutT2Trigger = true;
-            self->lastConfirmationTime = Hal_getMonotonicTimeInMs(); /* start timeout T2 */
-        }
-
-        if (msgSize < 7) {
-            DEBUG_PRINT("I msg too small!\n");
-            retVal =  false;
+    return (self->batchHandler != NULL) && (self->decodePool == NULL);
+}
+
+static void
+lockDecodeQueue(CS104_Connection self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->decodeLock);
+#endif
+}
+
+static void
+unlockDecodeQueue(CS104_Connection self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->decodeLock);
+#endif
+}
+
+static int
+getFreeDecodeSlots(CS104_Connection self)
+{
+    lockDecodeQueue(self);
+
+    int freeSlots = self->decodeQueueSize - self->numberOfDecodeSlots;
+
+    unlockDecodeQueue(self);
+
+    return freeSlots;
+}
+
+/**
+ * \brief Copy a received ASDU to the decode queue and queue the connection on a pool thread when required
+ *
+ * The caller has to ensure that a slot is free (see receiveAndHandleMessages).
+ */
+static void
+queueForDecoding(CS104_Connection self, uint8_t* asdu, int asduSize)
+{
+    bool schedule = false;
+
+    lockDecodeQueue(self);
+
+    DecodeSlot* slot = &(self->decodeQueue[(self->firstDecodeSlot + self->numberOfDecodeSlots) % self->decodeQueueSize]);
+
+    memcpy(slot->asdu, asdu, asduSize);
+    slot->size = asduSize;
+
+    self->numberOfDecodeSlots++;
+
+    if (self->decodeScheduled == false) {
+        self->decodeScheduled = true;
+        schedule = true;
+    }
+
+    unlockDecodeQueue(self);
+
+    if (schedule)
+        CS104_DecodePool_schedule(self->decodePool, self->decodeWorker, self);
+}
+
+static bool
+checkMessage(CS104_Connection self, CS104_APDU apdu)
+{
+    bool retVal = true;
+
+    uint8_t* buffer = apdu->apdu;
+
+    if (apdu->format == CS104_APDU_FORMAT_I)
+    {
+        if (self->timeoutT2Trigger == false) {
+            self->timeoutT2Trigger = true;
+            self->lastConfirmationTime = Hal_getMonotonicTimeInMs(); /* start timeout T2 */
+        }
+
+        if (apdu->asduSize < 1) {
+            DEBUG_PRINT("I msg too small!\n");
+            retVal =  false;
 
             goto exit_function;
         }
 
-        int frameSendSequenceNumber = ((buffer [3] * 0x100) + (buffer [2] & 0xfe)) / 2;
-        int frameRecvSequenceNumber = ((buffer [5] * 0x100) + (buffer [4] & 0xfe)) / 2;
+        int frameSendSequenceNumber = apdu->sendSequenceNumber;
+        int frameRecvSequenceNumber = apdu->receiveSequenceNumber;
 
         DEBUG_PRINT("Received I frame: N(S) = %i N(R) = %i\n", frameSendSequenceNumber, frameRecvSequenceNumber);
 
@@ -662,14 +1158,28 @@ checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
         self->receiveCount = (self->receiveCount + 1) % 32768;
         self->unconfirmedReceivedIMessages++;
 
+        self->statistics.receivedIMessages++;
+        updateAckThreshold(self);
+
         struct sCS101_ASDU _asdu;
 
-        CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(&_asdu, (CS101_AppLayerParameters)&(self->alParameters), buffer + 6, msgSize - 6);
+        /* in batch mode the ASDU view is stored until the batch is delivered */
+        CS101_ASDU asduBuffer = isBatchDelivery(self) ? &(self->batchASDUs[self->batchSize]) : &_asdu;
+
+        CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(asduBuffer, (CS101_AppLayerParameters)&(self->alParameters), apdu->asdu, apdu->asduSize);
 
         if (asdu)
         {
-            if (self->receivedHandler != NULL)
-                self->receivedHandler(self->receivedHandlerParameter, -1, asdu);
+            /* the valid ASDU is handled by a thread of the decode pool */
+            if (self->decodePool) {
+                queueForDecoding(self, apdu->asdu, apdu->asduSize);
+            }
+            else {
+                if (self->batchHandler)
+                    self->batch[self->batchSize++] = asdu;
+                else if (self->receivedHandler != NULL)
+                    self->receivedHandler(self->receivedHandlerParameter, -1, asdu);
+            }
         }
         else
         {
@@ -678,7 +1188,7 @@ checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
             goto exit_function;
         }
     }
-    else if ((buffer[2] & 0x03) == 0x03)  /* U format frame */
+    else if (apdu->format == CS104_APDU_FORMAT_U)
     {
         DEBUG_PRINT("Received U frame\n");
 
@@ -692,6 +1202,11 @@ checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
         else if (buffer[2] == 0x83) { /* TESTFR_CON */
             DEBUG_PRINT("Rcvd TESTFR_CON\n");
             self->outstandingTestFCConMessages = 0;
+
+            if (self->uMessageSentTime != 0) {
+                updateRoundTripTime(self, self->uMessageSentTime, false);
+                self->uMessageSentTime = 0;
+            }
         }
         else if (buffer[2] == 0x07) { /* STARTDT_ACT */
             DEBUG_PRINT("Send STARTDT_CON\n");
@@ -704,6 +1219,11 @@ checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
             DEBUG_PRINT("Received STARTDT_CON\n");
 
             self->conState = STATE_ACTIVE;
+
+            if (self->uMessageSentTime != 0) {
+                updateRoundTripTime(self, self->uMessageSentTime, false);
+                self->uMessageSentTime = 0;
+            }
         }
         else if (buffer[2] == 0x23) { /* STOPDT_CON */
             DEBUG_PRINT("Received STOPDT_CON\n");
@@ -714,7 +1234,7 @@ checkMessage(CS104_Connection self, uint8_t* buffer, int msgSize)
     }
     else if (buffer [2] == 0x01) /* S-message */
     {
-        int seqNo = (buffer[4] + buffer[5] * 0x100) / 2;
+        int seqNo = apdu->receiveSequenceNumber;
 
         DEBUG_PRINT("Rcvd S(%i) (own sendcounter = %i)\n", seqNo, self->sendCount);
 
@@ -759,6 +1279,7 @@ handleTimeouts(CS104_Connection self)
 
             writeToSocket(self, TESTFR_ACT_MSG, TESTFR_ACT_MSG_SIZE);
 
+            self->uMessageSentTime = currentTime;
             self->uMessageTimeout = currentTime + (self->parameters.t1 * 1000);
             self->outstandingTestFCConMessages++;
 
@@ -766,6 +1287,9 @@ handleTimeouts(CS104_Connection self)
         }
     }
 
+    if (self->numberOfQueuedASDUs > 0)
+        removeExpiredASDUs(self, currentTime);
+
     if (self->unconfirmedReceivedIMessages > 0)
     {
         if (checkConfirmTimeout(self, currentTime))
@@ -860,264 +1384,990 @@ isClose(CS104_Connection self)
     return isClose;
 }
 
-#if (CONFIG_USE_THREADS == 1)
-static void*
-handleConnection(void* parameter)
+static void
+confirmMessagesIfRequired(CS104_Connection self)
 {
-    CS104_Connection self = (CS104_Connection) parameter;
-
-    CS104_ConnectionEvent event = CS104_CONNECTION_OPENED;
-
-    resetConnection(self);
-
-    self->socket = TcpSocket_create();
-
-    if (self->socket) {
-        Socket_setConnectTimeout(self->socket, self->connectTimeoutInMs);
-
-        if (self->localIpAddress) {
-            Socket_bind(self->socket, self->localIpAddress, self->localTcpPort);
-        }
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
 
-        if (Socket_connect(self->socket, self->hostname, self->tcpPort)) {
+    if ((self->unconfirmedReceivedIMessages >= self->ackThreshold) || (self->conState == STATE_WAITING_FOR_STOPDT_CON)) {
+        confirmOutstandingMessages(self);
+    }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_wait(self->conStateLock);
+    Semaphore_post(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
+}
 
-#if (CONFIG_CS104_SUPPORT_TLS == 1)
-            if (self->tlsConfig != NULL) {
-                self->tlsSocket = TLSSocket_create(self->socket, self->tlsConfig, false);
+/**
+ * \brief Handle a received APDU
+ *
+ * \return false when the connection has to be closed
+ */
+static bool
+handleAPDU(CS104_Connection self, CS104_APDU apdu)
+{
+    bool retVal = true;
 
-                if (self->tlsSocket)
-                    self->running = true;
-                else
-                    self->failure = true;
-            }
-            else
-                self->running = true;
-#else
-            self->running = true;
-#endif
+    if (self->rawMessageHandler)
+        self->rawMessageHandler(self->rawMessageHandlerParameter, apdu->apdu, apdu->apduSize, false);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_post(self->conStateLock);
+    Semaphore_wait(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 
-            if (isRunning(self)) {
+    CS104_ConState oldState = self->conState;
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-                Semaphore_wait(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+    if (checkMessage(self, apdu) == false)
+        retVal = false;
+    else
+        sendQueuedASDUs(self);
 
-                self->conState = STATE_INACTIVE;
+    CS104_ConState newState = self->conState;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-                Semaphore_post(self->conStateLock);
+    Semaphore_post(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 
-                /* Call connection handler */
-                if (self->connectionHandler)
-                    self->connectionHandler(self->connectionHandlerParameter, self, CS104_CONNECTION_OPENED);
+    /* the mirror and command handlers are called without lock (they can send the next command) */
+    if (retVal && (self->mirror || self->commandTracker) && (self->batchHandler == NULL) && (self->decodePool == NULL) &&
+            (apdu->format == CS104_APDU_FORMAT_I)) {
+        struct sCS101_ASDU _asdu;
 
-                HandleSet handleSet = Handleset_new();
+        CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(&_asdu, (CS101_AppLayerParameters)&(self->alParameters), apdu->asdu, apdu->asduSize);
 
-                bool loopRunning = true;
+        if (asdu) {
+            if (self->mirror)
+                CS101_Mirror_handleASDUFromSource(self->mirror, asdu, self);
 
-                while (loopRunning) {
+            if (self->commandTracker)
+                CS101_CommandTracker_handleASDU(self->commandTracker, asdu);
+        }
+    }
 
-                    Handleset_reset(handleSet);
-                    Handleset_addSocket(handleSet, self->socket);
+    /* call connection handler when required */
+    if ((newState != oldState) && self->connectionHandler)
+    {
+        if (newState == STATE_ACTIVE)
+            self->connectionHandler(self->connectionHandlerParameter, self, CS104_CONNECTION_STARTDT_CON_RECEIVED);
+        else if (newState == STATE_INACTIVE)
+            self->connectionHandler(self->connectionHandlerParameter, self, CS104_CONNECTION_STOPDT_CON_RECEIVED);
+    }
 
-                    if (Handleset_waitReady(handleSet, 100)) {
-                        int bytesRec = receiveMessage(self);
+    /*
+     * in batch mode the S message is sent after the batch has been delivered, in adaptive mode after all APDUs
+     * of the socket read have been handled
+     */
+    if ((isBatchDelivery(self) == false) && (self->adaptiveWindow == false))
+        confirmMessagesIfRequired(self);
 
-                        if (bytesRec == -1) {
-                            loopRunning = false;
+    dispatchCompletions(self);
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-                            Semaphore_wait(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+    return retVal;
+}
 
-                            self->failure = true;
+/**
+ * \brief Call the batch handler (without lock) and confirm the received I messages when required
+ */
+static void
+deliverBatch(CS104_Connection self)
+{
+    if (self->batchSize > 0) {
+        int i;
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-                            Semaphore_post(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
-                        }
+        /* deliverBatch is called without lock -> the handlers of the mirror can send commands */
+        if (self->mirror) {
+            for (i = 0; i < self->batchSize; i++)
+                CS101_Mirror_handleASDUFromSource(self->mirror, self->batch[i], self);
+        }
 
-                        if (bytesRec > 0) {
+        self->batchHandler(self->batchHandlerParameter, -1, self->batch, self->batchSize);
 
-                            if (self->rawMessageHandler)
-                                self->rawMessageHandler(self->rawMessageHandlerParameter, self->recvBuffer, bytesRec, false);
+        if (self->commandTracker) {
+            for (i = 0; i < self->batchSize; i++)
+                CS101_CommandTracker_handleASDU(self->commandTracker, self->batch[i]);
+        }
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-                            Semaphore_wait(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+        self->batchSize = 0;
 
-                            CS104_ConState oldState = self->conState;
+        confirmMessagesIfRequired(self);
+    }
+}
 
-                            if (checkMessage(self, self->recvBuffer, bytesRec) == false)
-                            {
-                                /* close connection on error */
-                                loopRunning = false;
+/**
+ * \brief Read the available data from the socket and handle all complete APDUs
+ *
+ * \return false in case of a socket error or when the connection has to be closed
+ */
+static bool
+receiveAndHandleMessages(CS104_Connection self)
+{
+    bool retVal = true;
 
-                                self->failure = true;
-                            }
+    uint8_t* buffer = self->recvBuffer;
+    int bufferSize = sizeof(self->recvBuffer);
 
-                            CS104_ConState newState = self->conState;
+    /* in batch mode a larger buffer is used to receive more APDUs with one read */
+    if (self->batchRecvBuffer) {
+        buffer = self->batchRecvBuffer;
+        bufferSize = self->batchRecvBufferSize;
+    }
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-                            Semaphore_post(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+    if (self->receiveBufferPool) {
+        /* a new buffer is required when the application retains ASDUs of the previous read */
+        self->receiveBuffer = CS104_ReceiveBufferPool_renewBuffer(self->receiveBufferPool, self->receiveBuffer);
 
-                            /* call connection handler when required */
-                            if ((newState != oldState) && self->connectionHandler)
-                            {
-                                if (newState == STATE_ACTIVE)
-                                    self->connectionHandler(self->connectionHandlerParameter, self, CS104_CONNECTION_STARTDT_CON_RECEIVED);
-                                else if (newState == STATE_INACTIVE)
-                                    self->connectionHandler(self->connectionHandlerParameter, self, CS104_CONNECTION_STOPDT_CON_RECEIVED);
-                            }
-                        }
+        if (self->receiveBuffer) {
+            buffer = self->receiveBuffer;
+            bufferSize = CS104_ReceiveBufferPool_getBufferSize(self->receiveBufferPool);
+        }
+    }
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-                        Semaphore_wait(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+    if (self->decodePool) {
+        /*
+         * each received I message requires a slot of the decode queue. The number of I messages that can be
+         * completed with the read bytes (and an incomplete APDU of the previous read) is limited by the size of the
+         * smallest I message.
+         */
+        int maxBytes = getFreeDecodeSlots(self) * MIN_I_MESSAGE_SIZE;
 
-                        if ((self->unconfirmedReceivedIMessages >= self->parameters.w) || (self->conState == STATE_WAITING_FOR_STOPDT_CON)) {
-                            confirmOutstandingMessages(self);
-                        }
+        if (bufferSize > maxBytes)
+            bufferSize = maxBytes;
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-                        Semaphore_post(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
-                    }
+        /* the queue is full - the remaining data is read when the pool threads have handled queued ASDUs */
+        if (bufferSize == 0)
+            return true;
+    }
 
-                    if (handleTimeouts(self) == false)
-                        loopRunning = false;
+    int readBytes = readFromSocket(self, buffer, bufferSize);
 
-                    if (isClose(self))
-                        loopRunning = false;
-                }
+    if (readBytes < 0)
+        return false;
 
-                Handleset_destroy(handleSet);
+    int pos = 0;
 
-                /* register CLOSED event */
-                event = CS104_CONNECTION_CLOSED;
-            }
-        }
-        else {
-#if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_wait(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
-            self->failure = true;
+    while (pos < readBytes) {
+        sCS104_APDU apdu;
+        int bytesConsumed;
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-            Semaphore_post(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+        if (self->batchSize > 0) {
+            int remainingBytes = readBytes - pos;
 
-            /* register CLOSED event */
-            event = CS104_CONNECTION_FAILED;
+            /* an incomplete APDU is copied to the parser buffer that can be referenced by the first ASDU of the batch */
+            if ((self->batchSize == self->maxBatchSize) || (remainingBytes < 2) || (remainingBytes < buffer[pos + 1] + 2))
+                deliverBatch(self);
         }
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_wait(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+        CS104_APDUParserResult result = CS104_APDUParser_parse(&(self->apduParser), buffer + pos,
+                readBytes - pos, &bytesConsumed, &apdu);
 
-        /* Confirm all unconfirmed received I-messages before closing the connection */
-        if (self->unconfirmedReceivedIMessages > 0) {
-            confirmOutstandingMessages(self);
+        pos += bytesConsumed;
+
+        if (result == CS104_APDU_PARSER_ERROR) {
+            DEBUG_PRINT("Invalid APDU - close connection\n");
+            retVal = false;
+            break;
         }
 
-    #if (CONFIG_CS104_SUPPORT_TLS == 1)
-        if (self->tlsSocket)
-        {
-            TLSSocket_close(self->tlsSocket);
-            self->tlsSocket = NULL;
+        if (result == CS104_APDU_PARSER_APDU_COMPLETE) {
+            if (handleAPDU(self, &apdu) == false) {
+                retVal = false;
+                break;
+            }
         }
-    #endif
+    }
 
-        Socket_destroy(self->socket);
-        self->socket = NULL;
+    /* the ASDUs of the batch are only valid until the next read */
+    if (isBatchDelivery(self))
+        deliverBatch(self);
 
-        self->conState = STATE_IDLE;
+    /* one S message for the I messages received with one read */
+    if (self->adaptiveWindow)
+        confirmMessagesIfRequired(self);
 
-        self->running = false;
+    return retVal;
+}
 
+static void
+setFailure(CS104_Connection self)
+{
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_post(self->conStateLock);
+    Semaphore_wait(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
-    }
-    else
-    {
-        DEBUG_PRINT("Failed to create socket\n");
+
+    self->failure = true;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_wait(self->conStateLock);
+    Semaphore_post(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
+}
+
+/**
+ * \brief Create the socket and start to connect
+ *
+ * \param blocking when true, wait until the TCP connection is established or the connect timeout elapsed
+ *
+ * \return false when the connection failed
+ */
+static bool
+startConnect(CS104_Connection self, bool blocking)
+{
+    resetConnection(self);
 
-        self->running = false;
+    self->socket = TcpSocket_create();
 
-#if (CONFIG_USE_SEMAPHORES == 1)
-        Semaphore_post(self->conStateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+    if (self->socket == NULL) {
+        DEBUG_PRINT("Failed to create socket\n");
+        return false;
     }
 
-    /* Call connection handler */
-    if ((event == CS104_CONNECTION_CLOSED) || (event == CS104_CONNECTION_FAILED)) {
-        if (self->connectionHandler)
-            self->connectionHandler(self->connectionHandlerParameter, self, event);
+    Socket_setConnectTimeout(self->socket, self->connectTimeoutInMs);
+
+    if (self->localIpAddress) {
+        Socket_bind(self->socket, self->localIpAddress, self->localTcpPort);
     }
 
-    return NULL;
+    bool connectStarted;
+
+    if (blocking)
+        connectStarted = Socket_connect(self->socket, self->hostname, self->tcpPort);
+    else
+        connectStarted = Socket_connectAsync(self->socket, self->hostname, self->tcpPort);
+
+    if (connectStarted) {
+        self->connectDeadline = Hal_getMonotonicTimeInMs() + self->connectTimeoutInMs;
+        self->ioState = IO_STATE_CONNECTING;
+    }
+
+    return connectStarted;
 }
-#endif /* (CONFIG_USE_THREADS == 1) */
 
-void
-CS104_Connection_connectAsync(CS104_Connection self)
+/**
+ * \brief Start the TLS session (when configured) and the APCI layer after the TCP connection is established
+ *
+ * \return false when the connection failed
+ */
+static bool
+startSession(CS104_Connection self)
 {
 #if (CONFIG_USE_SEMAPHORES == 1)
     Semaphore_wait(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 
-    self->running = false;
-    self->failure = false;
-    self->close = false;
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+    if (self->tlsConfig != NULL) {
+        self->tlsSocket = TLSSocket_create(self->socket, self->tlsConfig, false);
+
+        if (self->tlsSocket)
+            self->running = true;
+        else
+            self->failure = true;
+    }
+    else
+        self->running = true;
+#else
+    self->running = true;
+#endif
+
+    if (self->running)
+        self->conState = STATE_INACTIVE;
+
+    bool running = self->running;
 
 #if (CONFIG_USE_SEMAPHORES == 1)
     Semaphore_post(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 
-#if (CONFIG_USE_THREADS == 1)
-    if (self->connectionHandlingThread) {
-        Thread_destroy(self->connectionHandlingThread);
-        self->connectionHandlingThread = NULL;
-    }
+    if (running) {
+        self->ioState = IO_STATE_CONNECTED;
 
-    self->connectionHandlingThread = Thread_create(handleConnection, (void*) self, false);
+        if (self->reconnectManager)
+            CS104_ReconnectManager_handleConnectionEvent(self->reconnectManager, self->reconnectEntry, self,
+                    CS104_CONNECTION_OPENED, false);
 
-    if (self->connectionHandlingThread)
-        Thread_start(self->connectionHandlingThread);
-#endif
+        /* Call connection handler */
+        if (self->connectionHandler)
+            self->connectionHandler(self->connectionHandlerParameter, self, CS104_CONNECTION_OPENED);
+    }
+
+    return running;
 }
 
-bool
-CS104_Connection_connect(CS104_Connection self)
+/**
+ * \brief Handle received messages, timeouts, and close requests of an established connection
+ *
+ * \param readable true when the socket has data to read
+ *
+ * \return false when the connection has to be closed
+ */
+static bool
+handleConnectionEvents(CS104_Connection self, bool readable)
 {
-    CS104_Connection_connectAsync(self);
+    bool retVal = true;
 
-    while ((isRunning(self) == false) && (isFailure(self) == false))
-        Thread_sleep(1);
+    if (readable) {
+        if (receiveAndHandleMessages(self) == false) {
+            retVal = false;
+            setFailure(self);
+        }
 
-    return isRunning(self);
-}
+        confirmMessagesIfRequired(self);
+    }
 
-void
-CS104_Connection_setASDUReceivedHandler(CS104_Connection self, CS101_ASDUReceivedHandler handler, void* parameter)
+    if (handleTimeouts(self) == false)
+        retVal = false;
+
+    dispatchCompletions(self);
+
+    if (self->commandTracker)
+        CS101_CommandTracker_checkTimeouts(self->commandTracker);
+
+    if (self->mirror)
+        CS101_Mirror_checkStations(self->mirror, Hal_getTimeInMs());
+
+    if (isClose(self))
+        retVal = false;
+
+    return retVal;
+}
+
+/**
+ * \brief Release the socket and report the end of the connection
+ *
+ * \param event CS104_CONNECTION_CLOSED or CS104_CONNECTION_FAILED
+ */
+static void
+finishConnection(CS104_Connection self, CS104_ConnectionEvent event)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    if (event == CS104_CONNECTION_FAILED)
+        self->failure = true;
+
+    bool closeRequested = self->close;
+
+    if (self->socket) {
+        /* Confirm all unconfirmed received I-messages before closing the connection */
+        if (self->unconfirmedReceivedIMessages > 0) {
+            confirmOutstandingMessages(self);
+        }
+
+#if (CONFIG_CS104_SUPPORT_TLS == 1)
+        if (self->tlsSocket)
+        {
+            TLSSocket_close(self->tlsSocket);
+            self->tlsSocket = NULL;
+        }
+#endif
+
+        Socket_destroy(self->socket);
+        self->socket = NULL;
+    }
+
+    failPendingASDUs(self);
+
+    self->conState = STATE_IDLE;
+    self->ioState = IO_STATE_IDLE;
+
+    self->running = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    dispatchCompletions(self);
+
+    if (self->commandTracker)
+        CS101_CommandTracker_cancelAll(self->commandTracker);
+
+    if (self->mirror)
+        CS101_Mirror_setStationsOfSourceStale(self->mirror, self);
+
+    if (self->reconnectManager)
+        CS104_ReconnectManager_handleConnectionEvent(self->reconnectManager, self->reconnectEntry, self, event, closeRequested);
+
+    /* Call connection handler */
+    if (self->connectionHandler)
+        self->connectionHandler(self->connectionHandlerParameter, self, event);
+}
+
+#if (CONFIG_USE_THREADS == 1)
+static void*
+handleConnection(void* parameter)
+{
+    CS104_Connection self = (CS104_Connection) parameter;
+
+    if (startConnect(self, true) && startSession(self)) {
+
+        HandleSet handleSet = Handleset_new();
+
+        bool loopRunning = true;
+
+        while (loopRunning) {
+
+            bool readable = false;
+
+            if (CS104_Connection_isReceivePaused(self)) {
+                /* wait for the decode pool - timeouts are still handled */
+                Thread_sleep(1);
+            }
+            else {
+                Handleset_reset(handleSet);
+                Handleset_addSocket(handleSet, self->socket);
+
+                readable = (Handleset_waitReady(handleSet, 100) != 0);
+            }
+
+            loopRunning = handleConnectionEvents(self, readable);
+        }
+
+        Handleset_destroy(handleSet);
+
+        finishConnection(self, CS104_CONNECTION_CLOSED);
+    }
+    else {
+        finishConnection(self, CS104_CONNECTION_FAILED);
+    }
+
+    return NULL;
+}
+#endif /* (CONFIG_USE_THREADS == 1) */
+
+void
+CS104_Connection_setEngine(CS104_Connection self, CS104_ClientEngine engine)
+{
+    self->engine = engine;
+}
+
+bool
+CS104_Connection_takeConnectRequest(CS104_Connection self)
+{
+    bool connectRequested = false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    if (self->ioState == IO_STATE_IDLE) {
+        connectRequested = self->connectRequested;
+        self->connectRequested = false;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    return connectRequested;
+}
+
+void
+CS104_Connection_startConnectNonBlocking(CS104_Connection self)
+{
+    if (startConnect(self, false) == false)
+        finishConnection(self, CS104_CONNECTION_FAILED);
+}
+
+void
+CS104_Connection_setReconnectManager(CS104_Connection self, CS104_ReconnectManager manager, int entry)
+{
+    self->reconnectManager = manager;
+    self->reconnectEntry = entry;
+}
+
+int
+CS104_Connection_getReconnectEntry(CS104_Connection self, CS104_ReconnectManager manager)
+{
+    if (self->reconnectManager == manager)
+        return self->reconnectEntry;
+    else
+        return -1;
+}
+
+Socket
+CS104_Connection_getSocket(CS104_Connection self)
+{
+    if (self->ioState == IO_STATE_CONNECTED)
+        return self->socket;
+    else
+        return NULL;
+}
+
+bool
+CS104_Connection_isConnecting(CS104_Connection self)
+{
+    return (self->ioState == IO_STATE_CONNECTING);
+}
+
+bool
+CS104_Connection_handleEvents(CS104_Connection self, bool readable)
+{
+    if (self->ioState == IO_STATE_CONNECTING) {
+        SocketState socketState = Socket_checkAsyncConnectState(self->socket);
+
+        if (socketState == SOCKET_STATE_CONNECTED) {
+            if (startSession(self) == false)
+                finishConnection(self, CS104_CONNECTION_FAILED);
+        }
+        else if ((socketState == SOCKET_STATE_FAILED) || isClose(self) ||
+                (Hal_getMonotonicTimeInMs() > self->connectDeadline))
+        {
+            finishConnection(self, CS104_CONNECTION_FAILED);
+        }
+    }
+    else if (self->ioState == IO_STATE_CONNECTED) {
+        if (handleConnectionEvents(self, readable) == false)
+            finishConnection(self, CS104_CONNECTION_CLOSED);
+    }
+
+    return (self->ioState != IO_STATE_IDLE);
+}
+
+bool
+CS104_Connection_connectThreadless(CS104_Connection self)
+{
+    if (self->engine || (self->ioState != IO_STATE_IDLE))
+        return false;
+
+    self->threadless = true;
+
+    CS104_Connection_startConnectNonBlocking(self);
+
+    return (self->ioState != IO_STATE_IDLE);
+}
+
+bool
+CS104_Connection_tick(CS104_Connection self)
+{
+    if (self->threadless == false)
+        return false;
+
+    self->inTick = true;
+
+    /* the socket is non-blocking - reading without available data returns immediately */
+    bool isOpen = CS104_Connection_handleEvents(self, true);
+
+    self->inTick = false;
+
+    return isOpen;
+}
+
+int
+CS104_Connection_getSocketFileDescriptor(CS104_Connection self)
+{
+    if ((self->ioState != IO_STATE_IDLE) && self->socket)
+        return Socket_getFileDescriptor(self->socket);
+    else
+        return -1;
+}
+
+static uint64_t
+minDeadline(uint64_t deadline, uint64_t timeout)
+{
+    return (timeout < deadline) ? timeout : deadline;
+}
+
+uint64_t
+CS104_Connection_getNextDeadline(CS104_Connection self)
+{
+    uint64_t deadline = UINT64_MAX;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    /* the timeouts are detected when the current time is after the timeout */
+    if (self->ioState == IO_STATE_CONNECTING) {
+        deadline = self->connectDeadline + 1;
+    }
+    else if (self->ioState == IO_STATE_CONNECTED) {
+        deadline = self->nextT3Timeout + 1;
+
+        if (self->unconfirmedReceivedIMessages > 0)
+            deadline = minDeadline(deadline, self->lastConfirmationTime + (self->parameters.t2 * 1000));
+
+        if (self->uMessageTimeout != 0)
+            deadline = minDeadline(deadline, self->uMessageTimeout + 1);
+
+        if (self->oldestSentASDU != -1)
+            deadline = minDeadline(deadline, self->sentASDUs[self->oldestSentASDU].sentTime + (self->parameters.t1 * 1000));
+
+        int i;
+
+        for (i = 0; i < self->numberOfQueuedASDUs; i++) {
+            QueuedASDU* queuedASDU = &(self->sendQueue[(self->firstQueuedASDU + i) % self->sendQueueSize]);
+
+            if (queuedASDU->frame && (queuedASDU->deadline != 0))
+                deadline = minDeadline(deadline, queuedASDU->deadline + 1);
+        }
+
+        /* the timeouts of the tracked commands are checked with the resolution of the tracker */
+        if (self->commandTracker && (CS101_CommandTracker_getNumberOfCommands(self->commandTracker) > 0))
+            deadline = minDeadline(deadline, Hal_getMonotonicTimeInMs() + CS101_COMMAND_TRACKER_TICK_INTERVAL);
+
+        /* stale stations of the mirror are checked once per second */
+        if (self->mirror)
+            deadline = minDeadline(deadline, Hal_getMonotonicTimeInMs() + 1000);
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    return deadline;
+}
+
+void
+CS104_Connection_connectAsync(CS104_Connection self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    self->running = false;
+    self->failure = false;
+    self->close = false;
+    self->threadless = false;
+
+    /* the event loop of the client engine starts the connection */
+    if (self->engine)
+        self->connectRequested = true;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    if (self->engine)
+        return;
+
+#if (CONFIG_USE_THREADS == 1)
+    if (self->connectionHandlingThread) {
+        Thread_destroy(self->connectionHandlingThread);
+        self->connectionHandlingThread = NULL;
+    }
+
+    self->connectionHandlingThread = Thread_create(handleConnection, (void*) self, false);
+
+    if (self->connectionHandlingThread)
+        Thread_start(self->connectionHandlingThread);
+#endif
+}
+
+bool
+CS104_Connection_connect(CS104_Connection self)
+{
+    CS104_Connection_connectAsync(self);
+
+    while ((isRunning(self) == false) && (isFailure(self) == false))
+        Thread_sleep(1);
+
+    return isRunning(self);
+}
+
+void
+CS104_Connection_setASDUReceivedHandler(CS104_Connection self, CS101_ASDUReceivedHandler handler, void* parameter)
+{
+    self->receivedHandler = handler;
+    self->receivedHandlerParameter = parameter;
+}
+
+bool
+CS104_Connection_setASDUBatchHandler(CS104_Connection self, CS101_ASDUBatchHandler handler, void* parameter, int maxBatchSize)
+{
+    if (isRunning(self))
+        return false;
+
+    GLOBAL_FREEMEM(self->batchASDUs);
+    GLOBAL_FREEMEM(self->batch);
+    GLOBAL_FREEMEM(self->batchRecvBuffer);
+
+    self->batchHandler = NULL;
+    self->batchHandlerParameter = NULL;
+    self->maxBatchSize = 0;
+    self->batchASDUs = NULL;
+    self->batch = NULL;
+    self->batchSize = 0;
+    self->batchRecvBuffer = NULL;
+    self->batchRecvBufferSize = 0;
+
+    if (handler) {
+        if (maxBatchSize < 1)
+            return false;
+
+        self->batchASDUs = (struct sCS101_ASDU*) GLOBAL_CALLOC(maxBatchSize, sizeof(struct sCS101_ASDU));
+        self->batch = (CS101_ASDU*) GLOBAL_CALLOC(maxBatchSize, sizeof(CS101_ASDU));
+
+        /* space for a full batch of APDUs with maximum size */
+        self->batchRecvBufferSize = maxBatchSize * CS104_APDU_PARSER_MAX_APDU_SIZE;
+        self->batchRecvBuffer = (uint8_t*) GLOBAL_MALLOC(self->batchRecvBufferSize);
+
+        if ((self->batchASDUs == NULL) || (self->batch == NULL) || (self->batchRecvBuffer == NULL)) {
+            CS104_Connection_setASDUBatchHandler(self, NULL, NULL, 0);
+            return false;
+        }
+
+        self->batchHandler = handler;
+        self->batchHandlerParameter = parameter;
+        self->maxBatchSize = maxBatchSize;
+    }
+
+    return true;
+}
+
+/**
+ * \brief Wait until the queued ASDUs have been handled by the decode pool
+ */
+static void
+waitForDecodeQueue(CS104_Connection self)
+{
+    while (true) {
+        lockDecodeQueue(self);
+
+        bool scheduled = self->decodeScheduled;
+
+        unlockDecodeQueue(self);
+
+        if (scheduled == false)
+            break;
+
+#if (CONFIG_USE_THREADS == 1)
+        Thread_sleep(1);
+#endif
+    }
+}
+
+bool
+CS104_Connection_setDecodePool(CS104_Connection self, CS104_DecodePool pool, int queueSize)
+{
+    if (isRunning(self))
+        return false;
+
+    if (self->decodePool) {
+        waitForDecodeQueue(self);
+
+        CS104_DecodePool_detach(self->decodePool);
+
+        GLOBAL_FREEMEM(self->decodeQueue);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_destroy(self->decodeLock);
+#endif
+
+        self->decodePool = NULL;
+        self->decodeQueue = NULL;
+        self->decodeQueueSize = 0;
+    }
+
+    if (pool) {
+        if (queueSize < 1)
+            return false;
+
+        int worker = CS104_DecodePool_attach(pool);
+
+        if (worker == -1)
+            return false;
+
+        self->decodeQueue = (DecodeSlot*) GLOBAL_MALLOC(queueSize * sizeof(DecodeSlot));
+
+        if (self->decodeQueue == NULL) {
+            CS104_DecodePool_detach(pool);
+            return false;
+        }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->decodeLock = Semaphore_create(1);
+#endif
+
+        self->decodeWorker = worker;
+        self->decodeQueueSize = queueSize;
+        self->firstDecodeSlot = 0;
+        self->numberOfDecodeSlots = 0;
+        self->decodeScheduled = false;
+        self->decodePool = pool;
+    }
+
+    return true;
+}
+
+int
+CS104_Connection_getNumberOfPendingASDUs(CS104_Connection self)
 {
-    self->receivedHandler = handler;
-    self->receivedHandlerParameter = parameter;
+    int pending = 0;
+
+    if (self->decodePool) {
+        lockDecodeQueue(self);
+
+        pending = self->numberOfDecodeSlots;
+
+        unlockDecodeQueue(self);
+    }
+
+    return pending;
+}
+
+bool
+CS104_Connection_isReceivePaused(CS104_Connection self)
+{
+    if (self->decodePool)
+        return (getFreeDecodeSlots(self) == 0);
+    else
+        return false;
+}
+
+bool
+CS104_Connection_handleDecodeQueue(CS104_Connection self, int maxASDUs)
+{
+    bool moreASDUs = false;
+    int handled = 0;
+
+    while (handled < maxASDUs) {
+        lockDecodeQueue(self);
+
+        int first = self->firstDecodeSlot;
+        int count = self->numberOfDecodeSlots;
+
+        unlockDecodeQueue(self);
+
+        if (count == 0)
+            break;
+
+        /* the ASDUs of a batch are the queued ASDUs (up to the maximum batch size) */
+        int maxCount = self->batchHandler ? self->maxBatchSize : 1;
+
+        if (count > maxCount)
+            count = maxCount;
+
+        int batchSize = 0;
+        int i;
+
+        for (i = 0; i < count; i++) {
+            DecodeSlot* slot = &(self->decodeQueue[(first + i) % self->decodeQueueSize]);
+
+            struct sCS101_ASDU _asdu;
+
+            CS101_ASDU asduBuffer = self->batchHandler ? &(self->batchASDUs[batchSize]) : &_asdu;
+
+            CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(asduBuffer, (CS101_AppLayerParameters)&(self->alParameters),
+                    slot->asdu, slot->size);
+
+            if (asdu) {
+                if (self->mirror)
+                    CS101_Mirror_handleASDUFromSource(self->mirror, asdu, self);
+
+                if (self->batchHandler) {
+                    self->batch[batchSize++] = asdu;
+                }
+                else {
+                    if (self->receivedHandler)
+                        self->receivedHandler(self->receivedHandlerParameter, -1, asdu);
+
+                    if (self->commandTracker)
+                        CS101_CommandTracker_handleASDU(self->commandTracker, asdu);
+                }
+            }
+        }
+
+        if (batchSize > 0) {
+            self->batchHandler(self->batchHandlerParameter, -1, self->batch, batchSize);
+
+            if (self->commandTracker) {
+                for (i = 0; i < batchSize; i++)
+                    CS101_CommandTracker_handleASDU(self->commandTracker, self->batch[i]);
+            }
+        }
+
+        /* release the slots - the connection can receive more ASDUs */
+        lockDecodeQueue(self);
+
+        self->firstDecodeSlot = (self->firstDecodeSlot + count) % self->decodeQueueSize;
+        self->numberOfDecodeSlots -= count;
+
+        unlockDecodeQueue(self);
+
+        handled += count;
+    }
+
+    lockDecodeQueue(self);
+
+    if (self->numberOfDecodeSlots > 0)
+        moreASDUs = true;
+    else
+        self->decodeScheduled = false;
+
+    unlockDecodeQueue(self);
+
+    return moreASDUs;
+}
+
+bool
+CS104_Connection_setAdaptiveWindow(CS104_Connection self, bool enable, int minK, int maxK, int minW, int maxW)
+{
+    if (isRunning(self))
+        return false;
+
+    if (enable) {
+        if ((minK < 1) || (maxK < minK) || (maxK > 32767) || (minW < 1) || (maxW < minW))
+            return false;
+
+        self->minK = minK;
+        self->maxK = maxK;
+        self->minW = minW;
+        self->maxW = maxW;
+    }
+
+    self->adaptiveWindow = enable;
+
+    return true;
+}
+
+void
+CS104_Connection_getWindowStatistics(CS104_Connection self, CS104_WindowStatistics statistics)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+
+    *statistics = self->statistics;
+
+    statistics->sendWindow = self->sendWindow;
+    statistics->ackThreshold = self->ackThreshold;
+
+    if (self->statistics.sentIMessages > 0)
+        statistics->windowUtilization = (int) (self->utilizationSum / self->statistics.sentIMessages);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
+}
+
+bool
+CS104_Connection_setReceiveBufferPool(CS104_Connection self, CS104_ReceiveBufferPool pool)
+{
+    if (isRunning(self))
+        return false;
+
+    if (self->receiveBuffer) {
+        CS104_ReceiveBufferPool_releaseMessage(self->receiveBufferPool, self->receiveBuffer);
+        self->receiveBuffer = NULL;
+    }
+
+    self->receiveBufferPool = pool;
+
+    return true;
+}
+
+void
+CS104_Connection_setMirror(CS104_Connection self, CS101_Mirror mirror)
+{
+    self->mirror = mirror;
+}
+
+void
+CS104_Connection_setCommandTracker(CS104_Connection self, CS101_CommandTracker tracker)
+{
+    self->commandTracker = tracker;
 }
 
 void
@@ -1135,33 +2385,33 @@ CS104_Connection_setRawMessageHandler(CS104_Connection self, IEC60870_RawMessage
 }
 
 static void
-encodeIdentificationField(CS104_Connection self, Frame frame, TypeID typeId,
+encodeIdentificationField(CS104_Connection self, FrameSpan span, TypeID typeId,
         int vsq, CS101_CauseOfTransmission cot, int ca)
 {
-    T104Frame_setNextByte(frame, typeId);
-    T104Frame_setNextByte(frame, (uint8_t) vsq);
+    FrameSpan_setNextByte(span, typeId);
+    FrameSpan_setNextByte(span, vsq);
 
     /* encode COT */
-    T104Frame_setNextByte(frame, (uint8_t) cot);
-    if (self->alParameters.sizeOfCOT == 2)
-        T104Frame_setNextByte(frame, (uint8_t) self->alParameters.originatorAddress);
+    FrameSpan_setNextByte(span, cot);
+    if (CS101_SIZE_OF_COT(&(self->alParameters)) == 2)
+        FrameSpan_setNextByte(span, self->alParameters.originatorAddress);
 
     /* encode CA */
-    T104Frame_setNextByte(frame, (uint8_t)(ca & 0xff));
-    if (self->alParameters.sizeOfCA == 2)
-        T104Frame_setNextByte(frame, (uint8_t) ((ca & 0xff00) >> 8));
+    FrameSpan_setNextByte(span, ca & 0xff);
+    if (CS101_SIZE_OF_CA(&(self->alParameters)) == 2)
+        FrameSpan_setNextByte(span, (ca & 0xff00) >> 8);
 }
 
 static void
-encodeIOA(CS104_Connection self, Frame frame, int ioa)
+encodeIOA(CS104_Connection self, FrameSpan span, int ioa)
 {
-    T104Frame_setNextByte(frame, (uint8_t) (ioa & 0xff));
+    FrameSpan_setNextByte(span, ioa & 0xff);
 
-    if (self->alParameters.sizeOfIOA > 1)
-        T104Frame_setNextByte(frame, (uint8_t) ((ioa / 0x100) & 0xff));
+    if (CS101_SIZE_OF_IOA(&(self->alParameters)) > 1)
+        FrameSpan_setNextByte(span, (ioa / 0x100) & 0xff);
 
-    if (self->alParameters.sizeOfIOA > 2)
-        T104Frame_setNextByte(frame, (uint8_t) ((ioa / 0x10000) & 0xff));
+    if (CS101_SIZE_OF_IOA(&(self->alParameters)) > 2)
+        FrameSpan_setNextByte(span, (ioa / 0x10000) & 0xff);
 }
 
 void
@@ -1175,6 +2425,8 @@ CS104_Connection_sendStartDT(CS104_Connection self)
 
     writeToSocket(self, STARTDT_ACT_MSG, STARTDT_ACT_MSG_SIZE);
 
+    self->uMessageSentTime = Hal_getMonotonicTimeInMs();
+
 #if (CONFIG_USE_SEMAPHORES == 1)
     Semaphore_post(self->conStateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
@@ -1205,27 +2457,6 @@ CS104_Connection_sendStopDT(CS104_Connection self)
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
 }
 
-static void
-sendIMessageAndUpdateSentASDUs(CS104_Connection self, Frame frame)
-{
-    int currentIndex = 0;
-
-    if (self->oldestSentASDU == -1)
-    {
-        self->oldestSentASDU = 0;
-        self->newestSentASDU = 0;
-
-    }
-    else
-    {
-        currentIndex = (self->newestSentASDU + 1) % self->maxSentASDUs;
-    }
-
-    self->sentASDUs [currentIndex].seqNo = sendIMessage (self, frame);
-    self->sentASDUs [currentIndex].sentTime = Hal_getMonotonicTimeInMs();
-
-    self->newestSentASDU = currentIndex;
-}
 
 static bool
 sendASDUInternal(CS104_Connection self, Frame frame)
@@ -1243,6 +2474,11 @@ sendASDUInternal(CS104_Connection self, Frame frame)
             sendIMessageAndUpdateSentASDUs(self, frame);
             retVal = true;
         }
+        else if (self->sendWindowFull == false)
+        {
+            self->sendWindowFull = true;
+            self->statistics.windowFullEvents++;
+        }
 
 #if (CONFIG_USE_SEMAPHORES == 1)
         Semaphore_post(self->conStateLock);
@@ -1257,72 +2493,112 @@ sendASDUInternal(CS104_Connection self, Frame frame)
 bool
 CS104_Connection_sendInterrogationCommand(CS104_Connection self, CS101_CauseOfTransmission cot, int ca, QualifierOfInterrogation qoi)
 {
-    Frame frame = (Frame) T104Frame_create();
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
+
+    if (frame == NULL)
+        return false;
 
-    encodeIdentificationField(self, frame, C_IC_NA_1, 1, cot, ca);
+    T104Frame_getSpan(frame, &span);
 
-    encodeIOA(self, frame, 0);
+    encodeIdentificationField(self, &span, C_IC_NA_1, 1, cot, ca);
+
+    encodeIOA(self, &span, 0);
 
     /* encode QOI (7.2.6.22) */
-    T104Frame_setNextByte(frame, qoi); /* 20 = station interrogation */
+    FrameSpan_setNextByte(&span, qoi); /* 20 = station interrogation */
 
-    return sendASDUInternal(self, frame);
+    T104Frame_commitSpan(frame, &span);
+
+    return sendASDUInternal(self, (Frame) frame);
 }
 
 bool
 CS104_Connection_sendCounterInterrogationCommand(CS104_Connection self, CS101_CauseOfTransmission cot, int ca, uint8_t qcc)
 {
-    Frame frame = (Frame) T104Frame_create();
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
+
+    if (frame == NULL)
+        return false;
+
+    T104Frame_getSpan(frame, &span);
 
-    encodeIdentificationField(self, frame, C_CI_NA_1, 1, cot, ca);
+    encodeIdentificationField(self, &span, C_CI_NA_1, 1, cot, ca);
 
-    encodeIOA(self, frame, 0);
+    encodeIOA(self, &span, 0);
 
     /* encode QCC */
-    T104Frame_setNextByte(frame, qcc);
+    FrameSpan_setNextByte(&span, qcc);
 
-    return sendASDUInternal(self, frame);
+    T104Frame_commitSpan(frame, &span);
+
+    return sendASDUInternal(self, (Frame) frame);
 }
 
 bool
 CS104_Connection_sendReadCommand(CS104_Connection self, int ca, int ioa)
 {
-    Frame frame = (Frame) T104Frame_create();
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
 
-    encodeIdentificationField(self, frame, C_RD_NA_1, 1, CS101_COT_REQUEST, ca);
+    if (frame == NULL)
+        return false;
 
-    encodeIOA(self, frame, ioa);
+    T104Frame_getSpan(frame, &span);
 
-    return sendASDUInternal(self, frame);
+    encodeIdentificationField(self, &span, C_RD_NA_1, 1, CS101_COT_REQUEST, ca);
+
+    encodeIOA(self, &span, ioa);
+
+    T104Frame_commitSpan(frame, &span);
+
+    return sendASDUInternal(self, (Frame) frame);
 }
 
 bool
 CS104_Connection_sendClockSyncCommand(CS104_Connection self, int ca, CP56Time2a newTime)
 {
-    Frame frame = (Frame) T104Frame_create();
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
+
+    if (frame == NULL)
+        return false;
 
-    encodeIdentificationField(self, frame, C_CS_NA_1, 1, CS101_COT_ACTIVATION, ca);
+    T104Frame_getSpan(frame, &span);
 
-    encodeIOA(self, frame, 0);
+    encodeIdentificationField(self, &span, C_CS_NA_1, 1, CS101_COT_ACTIVATION, ca);
 
-    T104Frame_appendBytes(frame, CP56Time2a_getEncodedValue(newTime), 7);
+    encodeIOA(self, &span, 0);
 
-    return sendASDUInternal(self, frame);
+    FrameSpan_appendBytes(&span, CP56Time2a_getEncodedValue(newTime), 7);
+
+    T104Frame_commitSpan(frame, &span);
+
+    return sendASDUInternal(self, (Frame) frame);
 }
 
 bool
 CS104_Connection_sendTestCommand(CS104_Connection self, int ca)
 {
-    Frame frame = (Frame) T104Frame_create();
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
 
-    encodeIdentificationField(self, frame, C_TS_NA_1, 1, CS101_COT_ACTIVATION, ca);
+    if (frame == NULL)
+        return false;
 
-    encodeIOA(self, frame, 0);
+    T104Frame_getSpan(frame, &span);
 
-    T104Frame_setNextByte(frame, 0xcc);
-    T104Frame_setNextByte(frame, 0x55);
+    encodeIdentificationField(self, &span, C_TS_NA_1, 1, CS101_COT_ACTIVATION, ca);
 
-    return sendASDUInternal(self, frame);
+    encodeIOA(self, &span, 0);
+
+    FrameSpan_setNextByte(&span, 0xcc);
+    FrameSpan_setNextByte(&span, 0x55);
+
+    T104Frame_commitSpan(frame, &span);
+
+    return sendASDUInternal(self, (Frame) frame);
 }
 
 bool
@@ -1338,42 +2614,228 @@ CS104_Connection_sendTestCommandWithTimestamp(CS104_Connection self, int ca, uin
 bool
 CS104_Connection_sendProcessCommand(CS104_Connection self, TypeID typeId, CS101_CauseOfTransmission cot, int ca, InformationObject sc)
 {
-    Frame frame = (Frame) T104Frame_create();
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
+
+    if (frame == NULL)
+        return false;
+
+    T104Frame_getSpan(frame, &span);
 
     if (typeId == 0)
         typeId = InformationObject_getType(sc);
 
-    encodeIdentificationField (self, frame, typeId, 1 /* SQ:false; NumIX:1 */, cot, ca);
+    encodeIdentificationField (self, &span, typeId, 1 /* SQ:false; NumIX:1 */, cot, ca);
 
-    InformationObject_encode(sc, frame, (CS101_AppLayerParameters) &(self->alParameters), false);
+    InformationObject_encodeToSpan(sc, &span, (CS101_AppLayerParameters) &(self->alParameters), false);
 
-    return sendASDUInternal(self, frame);
+    T104Frame_commitSpan(frame, &span);
+
+    return sendASDUInternal(self, (Frame) frame);
 }
 
-bool
-CS104_Connection_sendProcessCommandEx(CS104_Connection self, CS101_CauseOfTransmission cot, int ca, InformationObject sc)
+static Frame
+createProcessCommandFrame(CS104_Connection self, CS101_CauseOfTransmission cot, int ca, InformationObject sc)
 {
-    Frame frame = (Frame) T104Frame_create();
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
+
+    if (frame == NULL)
+        return NULL;
+
+    T104Frame_getSpan(frame, &span);
 
     TypeID typeId = InformationObject_getType(sc);
 
-    encodeIdentificationField (self, frame, typeId, 1 /* SQ:false; NumIX:1 */, cot, ca);
+    encodeIdentificationField (self, &span, typeId, 1 /* SQ:false; NumIX:1 */, cot, ca);
 
-    InformationObject_encode(sc, frame, (CS101_AppLayerParameters) &(self->alParameters), false);
+    InformationObject_encodeToSpan(sc, &span, (CS101_AppLayerParameters) &(self->alParameters), false);
+
+    T104Frame_commitSpan(frame, &span);
+
+    return (Frame) frame;
+}
+
+bool
+CS104_Connection_sendProcessCommandEx(CS104_Connection self, CS101_CauseOfTransmission cot, int ca, InformationObject sc)
+{
+    Frame frame = createProcessCommandFrame(self, cot, ca, sc);
+
+    if (frame == NULL)
+        return false;
 
     return sendASDUInternal(self, frame);
 }
 
+static Frame
+createASDUFrame(CS104_Connection self, CS101_ASDU asdu)
+{
+    T104Frame frame = T104FramePool_getFrame(self->framePool);
+    struct sFrameSpan span;
+
+    if (frame == NULL)
+        return NULL;
+
+    T104Frame_getSpan(frame, &span);
+
+    if (CS101_ASDU_encodeToSpan(asdu, &span) == false) {
+        T104Frame_destroy((Frame) frame);
+        return NULL;
+    }
+
+    T104Frame_commitSpan(frame, &span);
+
+    return (Frame) frame;
+}
+
 bool
 CS104_Connection_sendASDU(CS104_Connection self, CS101_ASDU asdu)
 {
-    Frame frame = (Frame) T104Frame_create();
+    Frame frame = createASDUFrame(self, asdu);
 
-    CS101_ASDU_encode(asdu, frame);
+    if (frame == NULL)
+        return false;
 
     return sendASDUInternal(self, frame);
 }
 
+bool
+CS104_Connection_setSendQueueSize(CS104_Connection self, int size)
+{
+    if ((size < 0) || isRunning(self))
+        return false;
+
+    /* each queued ASDU holds a frame of the pool -> keep the spare frames for the send functions */
+    T104FramePool framePool = T104FramePool_create(size + CONFIG_CS104_CONNECTION_FRAME_POOL_SIZE);
+
+    if (framePool == NULL)
+        return false;
+
+    T104FramePool_destroy(self->framePool);
+    self->framePool = framePool;
+
+    if (self->sendQueue) {
+        GLOBAL_FREEMEM(self->sendQueue);
+        self->sendQueue = NULL;
+    }
+
+    if (self->completions) {
+        GLOBAL_FREEMEM(self->completions);
+        self->completions = NULL;
+    }
+
+    self->sendQueueSize = 0;
+    self->maxCompletions = 0;
+
+    if (size > 0) {
+        /* up to two events for each ASDU of the queue and of the k-buffer */
+        int maxCompletions = 2 * (size + self->parameters.k);
+
+        self->sendQueue = (QueuedASDU*) GLOBAL_CALLOC(size, sizeof(QueuedASDU));
+        self->completions = (SendCompletion*) GLOBAL_CALLOC(maxCompletions, sizeof(SendCompletion));
+
+        if ((self->sendQueue == NULL) || (self->completions == NULL)) {
+            CS104_Connection_setSendQueueSize(self, 0);
+            return false;
+        }
+
+        self->sendQueueSize = size;
+        self->maxCompletions = maxCompletions;
+    }
+
+    self->firstQueuedASDU = 0;
+    self->numberOfQueuedASDUs = 0;
+    self->firstCompletion = 0;
+    self->numberOfCompletions = 0;
+    self->reservedCompletions = 0;
+
+    return true;
+}
+
+static bool
+queueFrame(CS104_Connection self, Frame frame, int timeoutInMs, CS104_SendCompletionHandler handler, void* parameter)
+{
+    bool retVal = false;
+
+    if (frame == NULL)
+        return false;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif
+
+    if (self->running && (self->numberOfQueuedASDUs < self->sendQueueSize)) {
+
+        /* the events of the ASDU need to fit into the event buffer */
+        if ((handler == NULL) || (self->reservedCompletions + 2 <= self->maxCompletions)) {
+            QueuedASDU* queuedASDU = &(self->sendQueue[(self->firstQueuedASDU + self->numberOfQueuedASDUs) % self->sendQueueSize]);
+
+            queuedASDU->frame = frame;
+            queuedASDU->deadline = (timeoutInMs > 0) ? (Hal_getMonotonicTimeInMs() + timeoutInMs) : 0;
+            queuedASDU->handler = handler;
+            queuedASDU->parameter = parameter;
+
+            self->numberOfQueuedASDUs++;
+
+            if (handler)
+                self->reservedCompletions += 2;
+
+            sendQueuedASDUs(self);
+
+            retVal = true;
+        }
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif
+
+    if (retVal)
+        dispatchCompletions(self);
+    else
+        T104Frame_destroy(frame);
+
+    return retVal;
+}
+
+bool
+CS104_Connection_queueASDU(CS104_Connection self, CS101_ASDU asdu, int timeoutInMs,
+        CS104_SendCompletionHandler handler, void* parameter)
+{
+    if (self->sendQueueSize == 0)
+        return false;
+
+    return queueFrame(self, createASDUFrame(self, asdu), timeoutInMs, handler, parameter);
+}
+
+bool
+CS104_Connection_queueProcessCommand(CS104_Connection self, CS101_CauseOfTransmission cot, int ca, InformationObject command,
+        int timeoutInMs, CS104_SendCompletionHandler handler, void* parameter)
+{
+    if (self->sendQueueSize == 0)
+        return false;
+
+    return queueFrame(self, createProcessCommandFrame(self, cot, ca, command), timeoutInMs, handler, parameter);
+}
+
+int
+CS104_Connection_getSendQueueLength(CS104_Connection self)
+{
+    int numberOfQueuedASDUs;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->conStateLock);
+#endif
+
+    numberOfQueuedASDUs = self->numberOfQueuedASDUs;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->conStateLock);
+#endif
+
+    return numberOfQueuedASDUs;
+}
+
 bool
 CS104_Connection_isTransmitBufferFull(CS104_Connection self)
 {
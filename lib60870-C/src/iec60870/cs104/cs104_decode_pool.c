@@ -0,0 +1,328 @@
+/*
+ *  cs104_decode_pool.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+
+#include "cs104_decode_pool.h"
+#include "cs104_connection_internal.h"
+#include "hal_thread.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* maximum number of ASDUs of a connection handled before the next queued connection is handled */
+#define DECODE_QUANTUM 32
+
+typedef struct {
+    CS104_DecodePool pool;
+    int index;
+
+    /* queued connections (FIFO) - a connection is queued at most once in all queues of the pool */
+    CS104_Connection* queue;
+    int first;
+    int count;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore lock;
+#endif
+
+#if (CONFIG_USE_THREADS == 1)
+    Thread thread;
+#endif
+} DecodeWorker;
+
+struct sCS104_DecodePool {
+    DecodeWorker* workers;
+    int numberOfWorkers;
+    int numberOfThreads; /* number of started threads */
+
+    int maxConnections;
+    int numberOfConnections;
+    int nextWorker; /* home thread of the next connection */
+
+    bool running;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore lock;
+
+    /* counts the queued connections - each pool thread takes one connection per wait */
+    Semaphore work;
+#endif
+};
+
+static void
+lockWorker(DecodeWorker* worker)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(worker->lock);
+#endif
+}
+
+static void
+unlockWorker(DecodeWorker* worker)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(worker->lock);
+#endif
+}
+
+static CS104_Connection
+dequeueConnection(CS104_DecodePool self, DecodeWorker* worker)
+{
+    CS104_Connection connection = NULL;
+
+    lockWorker(worker);
+
+    if (worker->count > 0) {
+        connection = worker->queue[worker->first];
+
+        worker->first = (worker->first + 1) % self->maxConnections;
+        worker->count--;
+    }
+
+    unlockWorker(worker);
+
+    return connection;
+}
+
+/**
+ * \brief Take the next connection from the own queue, or from the queue of another thread
+ */
+static CS104_Connection
+takeConnection(CS104_DecodePool self, DecodeWorker* worker)
+{
+    CS104_Connection connection = dequeueConnection(self, worker);
+
+    int i;
+
+    for (i = 1; (connection == NULL) && (i < self->numberOfThreads); i++)
+        connection = dequeueConnection(self, &(self->workers[(worker->index + i) % self->numberOfThreads]));
+
+    return connection;
+}
+
+void
+CS104_DecodePool_schedule(CS104_DecodePool self, int worker, CS104_Connection connection)
+{
+    DecodeWorker* w = &(self->workers[worker]);
+
+    lockWorker(w);
+
+    w->queue[(w->first + w->count) % self->maxConnections] = connection;
+    w->count++;
+
+    unlockWorker(w);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->work);
+#endif
+}
+
+#if (CONFIG_USE_THREADS == 1)
+static void*
+workerThread(void* parameter)
+{
+    DecodeWorker* worker = (DecodeWorker*) parameter;
+    CS104_DecodePool self = worker->pool;
+
+    while (true) {
+        Semaphore_wait(self->work);
+
+        if (self->running == false)
+            break;
+
+        /* there is at least one queued connection for each thread that returned from the wait */
+        CS104_Connection connection = takeConnection(self, worker);
+
+        if (connection) {
+            if (CS104_Connection_handleDecodeQueue(connection, DECODE_QUANTUM))
+                CS104_DecodePool_schedule(self, worker->index, connection);
+        }
+    }
+
+    return NULL;
+}
+#endif /* (CONFIG_USE_THREADS == 1) */
+
+CS104_DecodePool
+CS104_DecodePool_create(int numberOfThreads, int maxConnections)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if ((numberOfThreads < 1) || (maxConnections < 1))
+        return NULL;
+
+    CS104_DecodePool self = (CS104_DecodePool) GLOBAL_CALLOC(1, sizeof(struct sCS104_DecodePool));
+
+    if (self) {
+        self->maxConnections = maxConnections;
+        self->running = true;
+
+        self->lock = Semaphore_create(1);
+        self->work = Semaphore_create(0);
+
+        self->workers = (DecodeWorker*) GLOBAL_CALLOC(numberOfThreads, sizeof(DecodeWorker));
+
+        if (self->workers == NULL) {
+            CS104_DecodePool_destroy(self);
+            return NULL;
+        }
+
+        self->numberOfWorkers = numberOfThreads;
+
+        int i;
+
+        for (i = 0; i < numberOfThreads; i++) {
+            DecodeWorker* worker = &(self->workers[i]);
+
+            worker->pool = self;
+            worker->index = i;
+            worker->queue = (CS104_Connection*) GLOBAL_CALLOC(maxConnections, sizeof(CS104_Connection));
+            worker->lock = Semaphore_create(1);
+
+            if (worker->queue == NULL) {
+                CS104_DecodePool_destroy(self);
+                return NULL;
+            }
+
+            worker->thread = Thread_create(workerThread, (void*) worker, false);
+
+            if (worker->thread == NULL) {
+                CS104_DecodePool_destroy(self);
+                return NULL;
+            }
+
+            self->numberOfThreads++;
+
+            Thread_start(worker->thread);
+        }
+    }
+
+    return self;
+#else
+    (void) numberOfThreads;
+    (void) maxConnections;
+
+    return NULL;
+#endif /* (CONFIG_USE_THREADS == 1) */
+}
+
+int
+CS104_DecodePool_attach(CS104_DecodePool self)
+{
+    int worker = -1;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    if (self->numberOfConnections < self->maxConnections) {
+        self->numberOfConnections++;
+
+        worker = self->nextWorker;
+        self->nextWorker = (self->nextWorker + 1) % self->numberOfThreads;
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return worker;
+}
+
+void
+CS104_DecodePool_detach(CS104_DecodePool self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    self->numberOfConnections--;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+}
+
+int
+CS104_DecodePool_getNumberOfConnections(CS104_DecodePool self)
+{
+    int numberOfConnections;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    numberOfConnections = self->numberOfConnections;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    return numberOfConnections;
+}
+
+void
+CS104_DecodePool_destroy(CS104_DecodePool self)
+{
+    if (self) {
+        int i;
+
+#if (CONFIG_USE_THREADS == 1)
+        self->running = false;
+
+        /* wake up all threads */
+        for (i = 0; i < self->numberOfThreads; i++)
+            Semaphore_post(self->work);
+#endif /* (CONFIG_USE_THREADS == 1) */
+
+        if (self->workers) {
+            for (i = 0; i < self->numberOfWorkers; i++) {
+                DecodeWorker* worker = &(self->workers[i]);
+
+#if (CONFIG_USE_THREADS == 1)
+                if (worker->thread)
+                    Thread_destroy(worker->thread);
+#endif
+
+                GLOBAL_FREEMEM(worker->queue);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+                if (worker->lock)
+                    Semaphore_destroy(worker->lock);
+#endif
+            }
+
+            GLOBAL_FREEMEM(self->workers);
+        }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        if (self->lock)
+            Semaphore_destroy(self->lock);
+
+        if (self->work)
+            Semaphore_destroy(self->work);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
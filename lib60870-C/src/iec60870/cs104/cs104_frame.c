@@ -23,8 +23,11 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "frame.h"
+#include "hal_thread.h"
+#include "lib60870_config.h"
 #include "lib60870_internal.h"
 #include "lib_memory.h"
 
@@ -39,12 +42,24 @@ struct sT104Frame {
     uint8_t buffer[256];
     int msgSize;
 
+    T104FramePool pool; /* the pool that owns the frame, or NULL */
+    T104Frame nextFree;
+
 #if (CONFIG_LIB60870_STATIC_FRAMES == 1)
     /* TODO move to base class? */
     uint8_t allocated;
 #endif
 };
 
+struct sT104FramePool {
+    struct sT104Frame* frames;
+    T104Frame firstFree;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore lock;
+#endif
+};
+
 static struct sFrameVFT t104FrameVFT = {
         T104Frame_destroy,
         T104Frame_resetFrame,
@@ -74,6 +89,7 @@ initializeFrames(void)
         staticFrames[i].virtualFunctionTable = &t104FrameVFT;
         staticFrames[i].allocated = 0;
         staticFrames[i].buffer[0] = 0x68;
+        staticFrames[i].pool = NULL;
     }
 }
 
@@ -113,15 +129,12 @@ T104Frame_create()
 #else
     T104Frame self = (T104Frame) GLOBAL_MALLOC(sizeof(struct sT104Frame));
 
+    /* the buffer is not cleared - only the first msgSize bytes are sent */
     if (self != NULL) {
-
-        int i;
-        for (i = 0; i < 256; i++)
-            self->buffer[i] = 0;
-
         self->virtualFunctionTable = &t104FrameVFT;
         self->buffer[0] = 0x68;
         self->msgSize = 6;
+        self->pool = NULL;
     }
 #endif
 
@@ -133,6 +146,23 @@ T104Frame_destroy(Frame super)
 {
     T104Frame self = (T104Frame) super;
 
+    if (self->pool) {
+        T104FramePool pool = self->pool;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_wait(pool->lock);
+#endif
+
+        self->nextFree = pool->firstFree;
+        pool->firstFree = self;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_post(pool->lock);
+#endif
+
+        return;
+    }
+
 #if (CONFIG_LIB60870_STATIC_FRAMES == 1)
     self->allocated = 0;
 #else
@@ -175,12 +205,7 @@ T104Frame_appendBytes(Frame super, const uint8_t* bytes, int numberOfBytes)
 {
     T104Frame self = (T104Frame) super;
 
-    int i;
-
-    uint8_t* target = self->buffer + self->msgSize;
-
-    for (i = 0; i < numberOfBytes; i++)
-        target[i] = bytes[i];
+    memcpy(self->buffer + self->msgSize, bytes, numberOfBytes);
 
     self->msgSize += numberOfBytes;
 }
@@ -208,3 +233,87 @@ T104Frame_getSpaceLeft(Frame super)
 
     return (IEC60870_5_104_MAX_ASDU_LENGTH + IEC60870_5_104_APCI_LENGTH - self->msgSize);
 }
+
+void
+T104Frame_getSpan(T104Frame self, FrameSpan span)
+{
+    FrameSpan_initialize(span, self->buffer, self->msgSize, IEC60870_5_104_MAX_ASDU_LENGTH + IEC60870_5_104_APCI_LENGTH);
+}
+
+void
+T104Frame_commitSpan(T104Frame self, FrameSpan span)
+{
+    self->msgSize = span->pos;
+}
+
+T104FramePool
+T104FramePool_create(int numberOfFrames)
+{
+    T104FramePool self = (T104FramePool) GLOBAL_CALLOC(1, sizeof(struct sT104FramePool));
+
+    if (self) {
+        self->frames = (struct sT104Frame*) GLOBAL_MALLOC(numberOfFrames * sizeof(struct sT104Frame));
+
+        if (self->frames == NULL) {
+            GLOBAL_FREEMEM(self);
+            return NULL;
+        }
+
+        int i;
+
+        for (i = 0; i < numberOfFrames; i++) {
+            T104Frame frame = &(self->frames[i]);
+
+            frame->virtualFunctionTable = &t104FrameVFT;
+            frame->buffer[0] = 0x68;
+            frame->msgSize = 6;
+            frame->pool = self;
+            frame->nextFree = self->firstFree;
+
+            self->firstFree = frame;
+        }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Semaphore_create(1);
+#endif
+    }
+
+    return self;
+}
+
+void
+T104FramePool_destroy(T104FramePool self)
+{
+    if (self) {
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_destroy(self->lock);
+#endif
+
+        GLOBAL_FREEMEM(self->frames);
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+T104Frame
+T104FramePool_getFrame(T104FramePool self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+
+    T104Frame frame = self->firstFree;
+
+    if (frame)
+        self->firstFree = frame->nextFree;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+
+    if (frame)
+        frame->msgSize = 6;
+    else
+        frame = T104Frame_create(); /* all frames of the pool are in use */
+
+    return frame;
+}
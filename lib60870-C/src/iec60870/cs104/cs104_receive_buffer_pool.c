@@ -0,0 +1,374 @@
+/*
+ *  cs104_receive_buffer_pool.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+
+#include "cs104_receive_buffer_pool.h"
+#include "cs104_connection_internal.h"
+#include "cs104_apdu_parser.h"
+#include "cs101_asdu_internal.h"
+#include "hal_thread.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+#define NO_ENTRY -1
+
+typedef struct {
+    struct sCS101_ASDU asdu; /* has to be the first element */
+
+    /* copy of the parameters - the connection can be destroyed while the ASDU is retained */
+    struct sCS101_AppLayerParameters parameters;
+
+    bool isRetained;
+    int nextFree;
+} RetainedASDU;
+
+struct sCS104_ReceiveBufferPool {
+    uint8_t* memory; /* the buffers */
+    int numberOfBuffers;
+    int bufferSize;
+
+    int* referenceCounts;
+    int* nextFreeBuffer;
+    int firstFreeBuffer;
+    int numberOfFreeBuffers;
+
+    RetainedASDU* retainedASDUs;
+    int maxRetainedASDUs;
+    int firstFreeASDU;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore lock;
+#endif
+};
+
+static void
+lockPool(CS104_ReceiveBufferPool self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+}
+
+static void
+unlockPool(CS104_ReceiveBufferPool self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+}
+
+CS104_ReceiveBufferPool
+CS104_ReceiveBufferPool_create(int numberOfBuffers, int bufferSize, int maxRetainedASDUs)
+{
+    if ((numberOfBuffers < 1) || (bufferSize < CS104_APDU_PARSER_MAX_APDU_SIZE) || (maxRetainedASDUs < 1))
+        return NULL;
+
+    CS104_ReceiveBufferPool self = (CS104_ReceiveBufferPool) GLOBAL_CALLOC(1, sizeof(struct sCS104_ReceiveBufferPool));
+
+    if (self) {
+        self->numberOfBuffers = numberOfBuffers;
+        self->bufferSize = bufferSize;
+        self->maxRetainedASDUs = maxRetainedASDUs;
+
+        self->memory = (uint8_t*) GLOBAL_MALLOC(numberOfBuffers * bufferSize);
+        self->referenceCounts = (int*) GLOBAL_CALLOC(numberOfBuffers, sizeof(int));
+        self->nextFreeBuffer = (int*) GLOBAL_CALLOC(numberOfBuffers, sizeof(int));
+        self->retainedASDUs = (RetainedASDU*) GLOBAL_CALLOC(maxRetainedASDUs, sizeof(RetainedASDU));
+
+        if ((self->memory == NULL) || (self->referenceCounts == NULL) || (self->nextFreeBuffer == NULL) ||
+                (self->retainedASDUs == NULL))
+        {
+            CS104_ReceiveBufferPool_destroy(self);
+            return NULL;
+        }
+
+        int i;
+
+        for (i = 0; i < numberOfBuffers; i++)
+            self->nextFreeBuffer[i] = i + 1;
+
+        self->nextFreeBuffer[numberOfBuffers - 1] = NO_ENTRY;
+        self->firstFreeBuffer = 0;
+        self->numberOfFreeBuffers = numberOfBuffers;
+
+        for (i = 0; i < maxRetainedASDUs; i++)
+            self->retainedASDUs[i].nextFree = i + 1;
+
+        self->retainedASDUs[maxRetainedASDUs - 1].nextFree = NO_ENTRY;
+        self->firstFreeASDU = 0;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Semaphore_create(1);
+#endif
+    }
+
+    return self;
+}
+
+/**
+ * \brief Get the index of the buffer that contains the data
+ *
+ * \return the index, or NO_ENTRY when the data is not located in a buffer of the pool
+ */
+static int
+getBufferIndex(CS104_ReceiveBufferPool self, uint8_t* data)
+{
+    if ((data >= self->memory) && (data < self->memory + (self->numberOfBuffers * self->bufferSize)))
+        return (int) ((data - self->memory) / self->bufferSize);
+    else
+        return NO_ENTRY;
+}
+
+/* has to be called with the lock held */
+static int
+takeBuffer(CS104_ReceiveBufferPool self)
+{
+    int index = self->firstFreeBuffer;
+
+    if (index != NO_ENTRY) {
+        self->firstFreeBuffer = self->nextFreeBuffer[index];
+        self->numberOfFreeBuffers--;
+        self->referenceCounts[index] = 1;
+    }
+
+    return index;
+}
+
+/* has to be called with the lock held */
+static void
+releaseBuffer(CS104_ReceiveBufferPool self, int index)
+{
+    self->referenceCounts[index]--;
+
+    if (self->referenceCounts[index] == 0) {
+        self->nextFreeBuffer[index] = self->firstFreeBuffer;
+        self->firstFreeBuffer = index;
+        self->numberOfFreeBuffers++;
+    }
+}
+
+/**
+ * \brief Get a buffer with a reference for the data, and copy the data when it is not located in a buffer of the pool
+ *
+ * \return the data in the buffer of the pool, or NULL when no buffer is free
+ */
+static uint8_t*
+retainData(CS104_ReceiveBufferPool self, uint8_t* data, int size)
+{
+    int index = getBufferIndex(self, data);
+
+    if (index != NO_ENTRY) {
+        self->referenceCounts[index]++;
+
+        return data;
+    }
+
+    if (size > self->bufferSize)
+        return NULL;
+
+    index = takeBuffer(self);
+
+    if (index == NO_ENTRY)
+        return NULL;
+
+    uint8_t* buffer = self->memory + (index * self->bufferSize);
+
+    memcpy(buffer, data, size);
+
+    return buffer;
+}
+
+int
+CS104_ReceiveBufferPool_getNumberOfFreeBuffers(CS104_ReceiveBufferPool self)
+{
+    lockPool(self);
+
+    int numberOfFreeBuffers = self->numberOfFreeBuffers;
+
+    unlockPool(self);
+
+    return numberOfFreeBuffers;
+}
+
+CS101_ASDU
+CS104_ReceiveBufferPool_retainASDU(CS104_ReceiveBufferPool self, CS101_ASDU asdu)
+{
+    CS101_ASDU retainedASDU = NULL;
+
+    lockPool(self);
+
+    if (self->firstFreeASDU != NO_ENTRY) {
+        uint8_t* data = retainData(self, asdu->asdu, asdu->asduHeaderLength + asdu->payloadSize);
+
+        if (data) {
+            RetainedASDU* entry = &(self->retainedASDUs[self->firstFreeASDU]);
+
+            self->firstFreeASDU = entry->nextFree;
+
+            entry->asdu = *asdu;
+            entry->parameters = *(asdu->parameters);
+
+            entry->asdu.parameters = &(entry->parameters);
+            entry->asdu.asdu = data;
+            entry->asdu.payload = data + asdu->asduHeaderLength;
+            entry->isRetained = true;
+
+            retainedASDU = &(entry->asdu);
+        }
+    }
+
+    unlockPool(self);
+
+    return retainedASDU;
+}
+
+/**
+ * \brief Get the entry of an ASDU returned by CS104_ReceiveBufferPool_retainASDU
+ *
+ * \return the entry, or NULL when the ASDU has not been retained by the pool (or is already released)
+ */
+static RetainedASDU*
+getRetainedASDU(CS104_ReceiveBufferPool self, CS101_ASDU asdu)
+{
+    uint8_t* address = (uint8_t*) asdu;
+    uint8_t* first = (uint8_t*) self->retainedASDUs;
+
+    if ((address < first) || (address >= (uint8_t*) (self->retainedASDUs + self->maxRetainedASDUs)))
+        return NULL;
+
+    if (((size_t) (address - first) % sizeof(RetainedASDU)) != 0)
+        return NULL;
+
+    RetainedASDU* entry = (RetainedASDU*) asdu;
+
+    if (entry->isRetained == false)
+        return NULL;
+
+    return entry;
+}
+
+void
+CS104_ReceiveBufferPool_releaseASDU(CS104_ReceiveBufferPool self, CS101_ASDU asdu)
+{
+    if (asdu == NULL)
+        return;
+
+    lockPool(self);
+
+    RetainedASDU* entry = getRetainedASDU(self, asdu);
+
+    if (entry) {
+        int index = getBufferIndex(self, entry->asdu.asdu);
+
+        if (index != NO_ENTRY)
+            releaseBuffer(self, index);
+
+        entry->isRetained = false;
+        entry->nextFree = self->firstFreeASDU;
+        self->firstFreeASDU = (int) (entry - self->retainedASDUs);
+    }
+    else
+        DEBUG_PRINT("CS104 receive buffer pool: ASDU has not been retained by the pool\n");
+
+    unlockPool(self);
+}
+
+uint8_t*
+CS104_ReceiveBufferPool_retainMessage(CS104_ReceiveBufferPool self, uint8_t* msg, int msgSize)
+{
+    lockPool(self);
+
+    uint8_t* retainedMsg = retainData(self, msg, msgSize);
+
+    unlockPool(self);
+
+    return retainedMsg;
+}
+
+void
+CS104_ReceiveBufferPool_releaseMessage(CS104_ReceiveBufferPool self, uint8_t* msg)
+{
+    lockPool(self);
+
+    int index = getBufferIndex(self, msg);
+
+    if (index != NO_ENTRY)
+        releaseBuffer(self, index);
+
+    unlockPool(self);
+}
+
+uint8_t*
+CS104_ReceiveBufferPool_renewBuffer(CS104_ReceiveBufferPool self, uint8_t* buffer)
+{
+    lockPool(self);
+
+    if (buffer) {
+        int index = getBufferIndex(self, buffer);
+
+        /* the buffer can be reused when it isn't retained by the application */
+        if (self->referenceCounts[index] == 1) {
+            unlockPool(self);
+            return buffer;
+        }
+
+        releaseBuffer(self, index);
+    }
+
+    int newIndex = takeBuffer(self);
+
+    unlockPool(self);
+
+    if (newIndex == NO_ENTRY)
+        return NULL;
+    else
+        return self->memory + (newIndex * self->bufferSize);
+}
+
+int
+CS104_ReceiveBufferPool_getBufferSize(CS104_ReceiveBufferPool self)
+{
+    return self->bufferSize;
+}
+
+void
+CS104_ReceiveBufferPool_destroy(CS104_ReceiveBufferPool self)
+{
+    if (self) {
+        GLOBAL_FREEMEM(self->memory);
+        GLOBAL_FREEMEM(self->referenceCounts);
+        GLOBAL_FREEMEM(self->nextFreeBuffer);
+        GLOBAL_FREEMEM(self->retainedASDUs);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        if (self->lock)
+            Semaphore_destroy(self->lock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
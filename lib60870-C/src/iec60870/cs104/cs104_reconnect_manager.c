@@ -0,0 +1,630 @@
+/*
+ *  cs104_reconnect_manager.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cs104_reconnect_manager.h"
+#include "cs104_connection_internal.h"
+#include "timer_wheel.h"
+#include "hal_thread.h"
+#include "hal_time.h"
+#include "lib_memory.h"
+#include "lib60870_config.h"
+#include "lib60870_internal.h"
+
+/* number of slots of the timer wheel - one revolution is ~10 s with the tick interval of the manager */
+#define TIMER_WHEEL_SLOTS 1024
+
+#define NO_ENTRY -1
+
+typedef struct {
+    struct sTimerWheelEntry timer; /* has to be the first element */
+
+    CS104_Connection connection; /* NULL for an unused entry */
+    CS104_ReconnectState state;
+
+    int initialDelay;
+    int maxDelay;
+    int jitter;
+    int currentDelay;
+
+    int nextQueued; /* next entry in the queue of due connects */
+    int nextFree;
+} ReconnectEntry;
+
+/* state change to report after the lock is released */
+typedef struct {
+    CS104_Connection connection;
+    CS104_ReconnectState state;
+    int delay;
+} StateChange;
+
+struct sCS104_ReconnectManager {
+    ReconnectEntry* entries;
+    int maxConnections;
+    int firstFree;
+
+    int maxConcurrentConnects;
+    int numberOfConnecting;
+
+    /* due connects (FIFO) */
+    int firstQueued;
+    int lastQueued;
+
+    TimerWheel timerWheel;
+
+    /* connections to connect in the current tick */
+    CS104_Connection* connects;
+
+    uint32_t randomState;
+
+    CS104_ReconnectStateHandler stateHandler;
+    void* stateHandlerParameter;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore lock;
+
+    /* held during the tick - a removed connection is not connected by a running tick */
+    Semaphore tickLock;
+#endif
+
+#if (CONFIG_USE_THREADS == 1)
+    Thread thread;
+    bool isRunning;
+#endif
+};
+
+static void
+lockManager(CS104_ReconnectManager self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->lock);
+#endif
+}
+
+static void
+unlockManager(CS104_ReconnectManager self)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->lock);
+#endif
+}
+
+static void
+notifyStateChange(CS104_ReconnectManager self, StateChange* change)
+{
+    if (self->stateHandler)
+        self->stateHandler(self->stateHandlerParameter, change->connection, change->state, change->delay);
+}
+
+/* xorshift32 */
+static uint32_t
+getRandom(CS104_ReconnectManager self)
+{
+    uint32_t x = self->randomState;
+
+    x ^= x << 13;
+    x ^= x >> 17;
+    x ^= x << 5;
+
+    self->randomState = x;
+
+    return x;
+}
+
+/* the next backoff delay - reduced by a random part of up to jitter percent */
+static int
+getNextDelay(CS104_ReconnectManager self, ReconnectEntry* entry)
+{
+    int delay = entry->currentDelay;
+
+    if (entry->jitter > 0) {
+        uint64_t maxReduction = ((uint64_t) delay * (uint64_t) entry->jitter) / 100;
+
+        delay -= (int) ((maxReduction * getRandom(self)) >> 32);
+    }
+
+    if (entry->currentDelay < entry->maxDelay) {
+        entry->currentDelay *= 2;
+
+        if (entry->currentDelay > entry->maxDelay)
+            entry->currentDelay = entry->maxDelay;
+    }
+
+    return delay;
+}
+
+static void
+enqueue(CS104_ReconnectManager self, int index)
+{
+    ReconnectEntry* entry = &(self->entries[index]);
+
+    entry->state = CS104_RECONNECT_STATE_QUEUED;
+    entry->nextQueued = NO_ENTRY;
+
+    if (self->lastQueued == NO_ENTRY)
+        self->firstQueued = index;
+    else
+        self->entries[self->lastQueued].nextQueued = index;
+
+    self->lastQueued = index;
+}
+
+static void
+removeFromQueue(CS104_ReconnectManager self, int index)
+{
+    int previous = NO_ENTRY;
+    int current = self->firstQueued;
+
+    while (current != NO_ENTRY) {
+        if (current == index) {
+            if (previous == NO_ENTRY)
+                self->firstQueued = self->entries[current].nextQueued;
+            else
+                self->entries[previous].nextQueued = self->entries[current].nextQueued;
+
+            if (self->lastQueued == current)
+                self->lastQueued = previous;
+
+            return;
+        }
+
+        previous = current;
+        current = self->entries[current].nextQueued;
+    }
+}
+
+/* stop the reconnect procedure of the entry (the entry has to be in use) */
+static void
+stopEntry(CS104_ReconnectManager self, int index)
+{
+    ReconnectEntry* entry = &(self->entries[index]);
+
+    if (entry->state == CS104_RECONNECT_STATE_CONNECTING)
+        self->numberOfConnecting--;
+    else if (entry->state == CS104_RECONNECT_STATE_QUEUED)
+        removeFromQueue(self, index);
+
+    TimerWheel_cancel(self->timerWheel, &(entry->timer));
+
+    entry->state = CS104_RECONNECT_STATE_STOPPED;
+}
+
+CS104_ReconnectManager
+CS104_ReconnectManager_create(int maxConnections, int maxConcurrentConnects)
+{
+    if ((maxConnections < 1) || (maxConcurrentConnects < 1))
+        return NULL;
+
+    CS104_ReconnectManager self = (CS104_ReconnectManager) GLOBAL_CALLOC(1, sizeof(struct sCS104_ReconnectManager));
+
+    if (self) {
+        self->maxConnections = maxConnections;
+        self->maxConcurrentConnects = maxConcurrentConnects;
+
+        self->entries = (ReconnectEntry*) GLOBAL_CALLOC(maxConnections, sizeof(ReconnectEntry));
+        self->connects = (CS104_Connection*) GLOBAL_CALLOC(maxConcurrentConnects, sizeof(CS104_Connection));
+        self->timerWheel = TimerWheel_create(TIMER_WHEEL_SLOTS, CS104_RECONNECT_MANAGER_TICK_INTERVAL, Hal_getMonotonicTimeInMs());
+
+        if ((self->entries == NULL) || (self->connects == NULL) || (self->timerWheel == NULL)) {
+            CS104_ReconnectManager_destroy(self);
+            return NULL;
+        }
+
+        int i;
+
+        for (i = 0; i < maxConnections; i++) {
+            TimerWheelEntry_initialize(&(self->entries[i].timer));
+            self->entries[i].nextFree = i + 1;
+        }
+
+        self->entries[maxConnections - 1].nextFree = NO_ENTRY;
+        self->firstFree = 0;
+
+        self->firstQueued = NO_ENTRY;
+        self->lastQueued = NO_ENTRY;
+
+        self->randomState = (uint32_t) (Hal_getMonotonicTimeInMs() ^ (uintptr_t) self) | 1;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        self->lock = Semaphore_create(1);
+        self->tickLock = Semaphore_create(1);
+#endif
+    }
+
+    return self;
+}
+
+void
+CS104_ReconnectManager_setStateHandler(CS104_ReconnectManager self, CS104_ReconnectStateHandler handler, void* parameter)
+{
+    self->stateHandler = handler;
+    self->stateHandlerParameter = parameter;
+}
+
+bool
+CS104_ReconnectManager_addConnection(CS104_ReconnectManager self, CS104_Connection connection, int initialDelayInMs,
+        int maxDelayInMs, int jitter)
+{
+    bool added = false;
+
+    if (initialDelayInMs < CS104_RECONNECT_MANAGER_TICK_INTERVAL)
+        initialDelayInMs = CS104_RECONNECT_MANAGER_TICK_INTERVAL;
+
+    if (maxDelayInMs < initialDelayInMs)
+        maxDelayInMs = initialDelayInMs;
+
+    if (jitter < 0)
+        jitter = 0;
+    else if (jitter > 100)
+        jitter = 100;
+
+    lockManager(self);
+
+    if ((self->firstFree != NO_ENTRY) && (CS104_Connection_getReconnectEntry(connection, self) == NO_ENTRY)) {
+        int index = self->firstFree;
+        ReconnectEntry* entry = &(self->entries[index]);
+
+        self->firstFree = entry->nextFree;
+
+        entry->connection = connection;
+        entry->initialDelay = initialDelayInMs;
+        entry->maxDelay = maxDelayInMs;
+        entry->jitter = jitter;
+        entry->currentDelay = initialDelayInMs;
+
+        CS104_Connection_setReconnectManager(connection, self, index);
+
+        /* the first connect is started by the next tick */
+        enqueue(self, index);
+
+        added = true;
+    }
+
+    unlockManager(self);
+
+    if (added) {
+        StateChange change = { connection, CS104_RECONNECT_STATE_QUEUED, 0 };
+
+        notifyStateChange(self, &change);
+    }
+
+    return added;
+}
+
+void
+CS104_ReconnectManager_removeConnection(CS104_ReconnectManager self, CS104_Connection connection)
+{
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->tickLock);
+#endif
+
+    lockManager(self);
+
+    int index = CS104_Connection_getReconnectEntry(connection, self);
+
+    if (index != NO_ENTRY) {
+        ReconnectEntry* entry = &(self->entries[index]);
+
+        stopEntry(self, index);
+
+        CS104_Connection_setReconnectManager(connection, NULL, NO_ENTRY);
+
+        entry->connection = NULL;
+        entry->nextFree = self->firstFree;
+        self->firstFree = index;
+    }
+
+    unlockManager(self);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->tickLock);
+#endif
+}
+
+bool
+CS104_ReconnectManager_connect(CS104_ReconnectManager self, CS104_Connection connection)
+{
+    bool queued = false;
+
+    lockManager(self);
+
+    int index = CS104_Connection_getReconnectEntry(connection, self);
+
+    if (index != NO_ENTRY) {
+        ReconnectEntry* entry = &(self->entries[index]);
+
+        if ((entry->state == CS104_RECONNECT_STATE_STOPPED) || (entry->state == CS104_RECONNECT_STATE_WAITING)) {
+            TimerWheel_cancel(self->timerWheel, &(entry->timer));
+
+            entry->currentDelay = entry->initialDelay;
+
+            enqueue(self, index);
+
+            queued = true;
+        }
+        else if (entry->state == CS104_RECONNECT_STATE_QUEUED) {
+            entry->currentDelay = entry->initialDelay;
+
+            queued = true;
+        }
+    }
+
+    unlockManager(self);
+
+    if (queued) {
+        StateChange change = { connection, CS104_RECONNECT_STATE_QUEUED, 0 };
+
+        notifyStateChange(self, &change);
+    }
+
+    return queued;
+}
+
+int
+CS104_ReconnectManager_getState(CS104_ReconnectManager self, CS104_Connection connection)
+{
+    int state = -1;
+
+    lockManager(self);
+
+    int index = CS104_Connection_getReconnectEntry(connection, self);
+
+    if (index != NO_ENTRY)
+        state = (int) self->entries[index].state;
+
+    unlockManager(self);
+
+    return state;
+}
+
+int
+CS104_ReconnectManager_getNumberOfConnecting(CS104_ReconnectManager self)
+{
+    int numberOfConnecting;
+
+    lockManager(self);
+
+    numberOfConnecting = self->numberOfConnecting;
+
+    unlockManager(self);
+
+    return numberOfConnecting;
+}
+
+void
+CS104_ReconnectManager_handleConnectionEvent(CS104_ReconnectManager self, int index, CS104_Connection connection,
+        CS104_ConnectionEvent event, bool closeRequested)
+{
+    StateChange change;
+    bool changed = false;
+
+    lockManager(self);
+
+    ReconnectEntry* entry = &(self->entries[index]);
+
+    if (entry->connection == connection) {
+        if (entry->state == CS104_RECONNECT_STATE_CONNECTING)
+            self->numberOfConnecting--;
+
+        if (event == CS104_CONNECTION_OPENED) {
+            if (entry->state == CS104_RECONNECT_STATE_CONNECTING) {
+                entry->state = CS104_RECONNECT_STATE_CONNECTED;
+                entry->currentDelay = entry->initialDelay;
+
+                change.state = CS104_RECONNECT_STATE_CONNECTED;
+                change.delay = 0;
+                changed = true;
+            }
+        }
+        else if ((event == CS104_CONNECTION_CLOSED) || (event == CS104_CONNECTION_FAILED)) {
+            if ((entry->state == CS104_RECONNECT_STATE_CONNECTING) || (entry->state == CS104_RECONNECT_STATE_CONNECTED)) {
+                if (closeRequested) {
+                    entry->state = CS104_RECONNECT_STATE_STOPPED;
+
+                    change.state = CS104_RECONNECT_STATE_STOPPED;
+                    change.delay = 0;
+                }
+                else {
+                    int delay = getNextDelay(self, entry);
+
+                    entry->state = CS104_RECONNECT_STATE_WAITING;
+
+                    TimerWheel_schedule(self->timerWheel, &(entry->timer), Hal_getMonotonicTimeInMs() + (uint64_t) delay);
+
+                    change.state = CS104_RECONNECT_STATE_WAITING;
+                    change.delay = delay;
+                }
+
+                changed = true;
+            }
+        }
+
+        change.connection = connection;
+    }
+
+    unlockManager(self);
+
+    if (changed)
+        notifyStateChange(self, &change);
+}
+
+static void
+handleDueConnection(void* parameter, TimerWheelEntry timer, uint64_t currentTime)
+{
+    CS104_ReconnectManager self = (CS104_ReconnectManager) parameter;
+    ReconnectEntry* entry = (ReconnectEntry*) timer;
+
+    (void) currentTime;
+
+    enqueue(self, (int) (entry - self->entries));
+}
+
+void
+CS104_ReconnectManager_tick(CS104_ReconnectManager self)
+{
+    int numberOfConnects = 0;
+    int i;
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_wait(self->tickLock);
+#endif
+
+    lockManager(self);
+
+    TimerWheel_advance(self->timerWheel, Hal_getMonotonicTimeInMs(), handleDueConnection, self);
+
+    while ((self->firstQueued != NO_ENTRY) && (self->numberOfConnecting < self->maxConcurrentConnects)) {
+        int index = self->firstQueued;
+        ReconnectEntry* entry = &(self->entries[index]);
+
+        self->firstQueued = entry->nextQueued;
+
+        if (self->firstQueued == NO_ENTRY)
+            self->lastQueued = NO_ENTRY;
+
+        entry->state = CS104_RECONNECT_STATE_CONNECTING;
+        self->numberOfConnecting++;
+
+        self->connects[numberOfConnects++] = entry->connection;
+    }
+
+    unlockManager(self);
+
+    /* the connection events of the new connects are reported to the manager (without tick lock) */
+    for (i = 0; i < numberOfConnects; i++) {
+        StateChange change = { self->connects[i], CS104_RECONNECT_STATE_CONNECTING, 0 };
+
+        notifyStateChange(self, &change);
+
+        CS104_Connection_connectAsync(self->connects[i]);
+    }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+    Semaphore_post(self->tickLock);
+#endif
+}
+
+#if (CONFIG_USE_THREADS == 1)
+
+static bool
+isRunning(CS104_ReconnectManager self)
+{
+    bool running;
+
+    lockManager(self);
+
+    running = self->isRunning;
+
+    unlockManager(self);
+
+    return running;
+}
+
+static void*
+managerThread(void* parameter)
+{
+    CS104_ReconnectManager self = (CS104_ReconnectManager) parameter;
+
+    while (isRunning(self)) {
+        CS104_ReconnectManager_tick(self);
+
+        Thread_sleep(CS104_RECONNECT_MANAGER_TICK_INTERVAL);
+    }
+
+    return NULL;
+}
+
+#endif /* (CONFIG_USE_THREADS == 1) */
+
+void
+CS104_ReconnectManager_start(CS104_ReconnectManager self)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->thread == NULL) {
+        self->isRunning = true;
+
+        self->thread = Thread_create(managerThread, (void*) self, false);
+
+        if (self->thread)
+            Thread_start(self->thread);
+        else
+            self->isRunning = false;
+    }
+#endif
+}
+
+void
+CS104_ReconnectManager_stop(CS104_ReconnectManager self)
+{
+#if (CONFIG_USE_THREADS == 1)
+    if (self->thread) {
+        lockManager(self);
+
+        self->isRunning = false;
+
+        unlockManager(self);
+
+        Thread_destroy(self->thread);
+
+        self->thread = NULL;
+    }
+#endif
+}
+
+void
+CS104_ReconnectManager_destroy(CS104_ReconnectManager self)
+{
+    if (self) {
+#if (CONFIG_USE_THREADS == 1)
+        CS104_ReconnectManager_stop(self);
+#endif
+
+        if (self->entries) {
+            int i;
+
+            for (i = 0; i < self->maxConnections; i++) {
+                if (self->entries[i].connection)
+                    CS104_Connection_setReconnectManager(self->entries[i].connection, NULL, NO_ENTRY);
+            }
+
+            GLOBAL_FREEMEM(self->entries);
+        }
+
+        if (self->timerWheel)
+            TimerWheel_destroy(self->timerWheel);
+
+        GLOBAL_FREEMEM(self->connects);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        if (self->lock)
+            Semaphore_destroy(self->lock);
+
+        if (self->tickLock)
+            Semaphore_destroy(self->tickLock);
+#endif
+
+        GLOBAL_FREEMEM(self);
+    }
+}
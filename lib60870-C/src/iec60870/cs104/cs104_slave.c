@@ -30,13 +30,13 @@
 
 #include "cs104_slave.h"
 #include "cs104_frame.h"
+#include "cs104_apdu_parser.h"
 #include "frame.h"
 #include "hal_socket.h"
 #include "hal_thread.h"
 #include "hal_time.h"
 #include "lib_memory.h"
 #include "linked_list.h"
-#include "buffer_frame.h"
 
 #include "lib60870_config.h"
 #include "lib60870_internal.h"
@@ -44,6 +44,7 @@
 
 #include "apl_types_internal.h"
 #include "cs101_asdu_internal.h"
+#include "cs101_process_image_internal.h"
 
 #if (CONFIG_CS104_SUPPORT_TLS == 1)
 #include "tls_socket.h"
@@ -325,10 +326,10 @@ MessageQueue_enqueueASDU(MessageQueue self, CS101_ASDU asdu)
 
     self->entryCounter++;
 
-    struct sBufferFrame bufferFrame;
+    struct sFrameSpan span;
 
-    Frame frame = BufferFrame_initialize(&bufferFrame, nextMsgPtr + sizeof(struct sMessageQueueEntryInfo), 0);
-    CS101_ASDU_encode(asdu, frame);
+    FrameSpan_initialize(&span, nextMsgPtr + sizeof(struct sMessageQueueEntryInfo), 0, asduSize);
+    CS101_ASDU_encodeToSpan(asdu, &span);
 
     entryInfo.size = asduSize;
     entryInfo.entryId = self->entryId++;
@@ -791,10 +792,10 @@ HighPriorityASDUQueue_enqueue(HighPriorityASDUQueue self, CS101_ASDU asdu)
         self->lastEntry = nextMsgPtr;
         self->entryCounter++;
 
-        struct sBufferFrame bufferFrame;
+        struct sFrameSpan span;
 
-        Frame frame = BufferFrame_initialize(&bufferFrame, nextMsgPtr + sizeof(uint16_t), 0);
-        CS101_ASDU_encode(asdu, frame);
+        FrameSpan_initialize(&span, nextMsgPtr + sizeof(uint16_t), 0, asduSize);
+        CS101_ASDU_encodeToSpan(asdu, &span);
 
         msgSize = asduSize;
 
@@ -1078,6 +1079,9 @@ struct sCS104_Slave {
     CS101_InterrogationHandler interrogationHandler;
     void* interrogationHandlerParameter;
 
+    CS101_ProcessImage processImage; /* used to answer interrogation commands (optional) */
+    int historyReplayEntries; /* number of history entries per point that are replayed at STARTDT (0 = no replay) */
+
     CS101_CounterInterrogationHandler counterInterrogationHandler;
     void* counterInterrogationHandlerParameter;
 
@@ -1215,13 +1219,28 @@ struct sMasterConnection {
     HandleSet handleSet;
 
     uint8_t recvBuffer[260];
-    int recvBufPos;
+    sCS104_APDUParser apduParser;
 
     uint8_t sendBuffer[260];
 
     MessageQueue lowPrioQueue;
     HighPriorityASDUQueue highPrioQueue;
 
+    /* running interrogation that is answered from the process image */
+    sCS101_InterrogationCursor interrogation;
+    int interrogationOA;
+    int interrogationCA;
+    uint8_t interrogationQOI;
+
+    /* running counter interrogation (read of the frozen integrated totals) that is answered from the process image */
+    sCS101_InterrogationCursor counterInterrogation;
+    int counterInterrogationOA;
+    int counterInterrogationCA;
+    uint8_t counterInterrogationQCC;
+
+    /* running replay of the history of the process image (started by STARTDT) */
+    sCS101_InterrogationCursor historyReplay;
+
 #if (CONFIG_CS104_SUPPORT_SERVER_MODE_MULTIPLE_REDUNDANCY_GROUPS == 1)
     CS104_RedundancyGroup redundancyGroup;
 #endif
@@ -1361,6 +1380,7 @@ createSlave(int maxLowPrioQueueSize, int maxHighPrioQueueSize)
 
         self->asduHandler = NULL;
         self->interrogationHandler = NULL;
+        self->processImage = NULL;
         self->counterInterrogationHandler = NULL;
         self->readHandler = NULL;
         self->clockSyncHandler = NULL;
@@ -1629,6 +1649,18 @@ CS104_Slave_setInterrogationHandler(CS104_Slave self, CS101_InterrogationHandler
     self->interrogationHandlerParameter = parameter;
 }
 
+void
+CS104_Slave_setProcessImage(CS104_Slave self, CS101_ProcessImage processImage)
+{
+    self->processImage = processImage;
+}
+
+void
+CS104_Slave_setHistoryReplay(CS104_Slave self, int numberOfEntries)
+{
+    self->historyReplayEntries = numberOfEntries;
+}
+
 void
 CS104_Slave_setCounterInterrogationHandler(CS104_Slave self, CS101_CounterInterrogationHandler handler, void*  parameter)
 {
@@ -1725,66 +1757,6 @@ readFromSocket(MasterConnection self, uint8_t* buffer, int size)
 #endif
 }
 
-/**
- * \brief Read message part into receive buffer
- *
- * \return -1 in case of an error, 0 when no complete message can be read, > 0 when a complete message is in buffer
- */
-static int
-receiveMessage(MasterConnection self)
-{
-    uint8_t* buffer = self->recvBuffer;
-    int bufPos = self->recvBufPos;
-
-    /* read start byte */
-    if (bufPos == 0) {
-        int readFirst = readFromSocket(self, buffer, 1);
-
-        if (readFirst < 1)
-            return readFirst;
-
-        if (buffer[0] != 0x68)
-            return -1; /* message error */
-
-        bufPos++;
-    }
-
-    /* read length byte */
-    if (bufPos == 1)  {
-        if (readFromSocket(self, buffer + 1, 1) != 1) {
-            self->recvBufPos = 0;
-            return -1;
-        }
-
-        bufPos++;
-    }
-
-    /* read remaining frame */
-    if (bufPos > 1) {
-        int length = buffer[1];
-
-        int remainingLength = length - bufPos + 2;
-
-        int readCnt = readFromSocket(self, buffer + bufPos, remainingLength);
-
-        if (readCnt == remainingLength) {
-            self->recvBufPos = 0;
-            return length + 2;
-        }
-        else if (readCnt == -1) {
-            self->recvBufPos = 0;
-            return -1;
-        }
-        else {
-            self->recvBufPos = bufPos + readCnt;
-            return 0;
-        }
-    }
-
-    self->recvBufPos = bufPos;
-    return 0;
-}
-
 static int
 writeToSocket(MasterConnection self, uint8_t* buf, int size)
 {
@@ -1876,6 +1848,22 @@ sendASDU(MasterConnection self, uint8_t* buffer, int msgSize, uint64_t entryId,
     printSendBuffer(self);
 }
 
+/* encode and send the ASDU - the caller has to hold the sentASDUsLock and to check that the k-buffer is not full */
+static void
+sendASDUImmediately(MasterConnection self, CS101_ASDU asdu)
+{
+    FrameBuffer frameBuffer;
+
+    struct sFrameSpan span;
+
+    FrameSpan_initialize(&span, frameBuffer.msg, IEC60870_5_104_APCI_LENGTH, sizeof(frameBuffer.msg));
+    CS101_ASDU_encodeToSpan(asdu, &span);
+
+    frameBuffer.msgSize = span.pos;
+
+    sendASDU(self, frameBuffer.msg, frameBuffer.msgSize, 0, NULL);
+}
+
 static bool
 sendASDUInternal(MasterConnection self, CS101_ASDU asdu)
 {
@@ -1889,16 +1877,7 @@ sendASDUInternal(MasterConnection self, CS101_ASDU asdu)
 
         if (isSentBufferFull(self) == false) {
 
-            FrameBuffer frameBuffer;
-
-            struct sBufferFrame bufferFrame;
-
-            Frame frame = BufferFrame_initialize(&bufferFrame, frameBuffer.msg, IEC60870_5_104_APCI_LENGTH);
-            CS101_ASDU_encode(asdu, frame);
-
-            frameBuffer.msgSize = Frame_getMsgSize(frame);
-
-            sendASDU(self, frameBuffer.msg, frameBuffer.msgSize, 0, NULL);
+            sendASDUImmediately(self, asdu);
 
 #if (CONFIG_USE_SEMAPHORES == 1)
             Semaphore_post(self->sentASDUsLock);
@@ -1938,6 +1917,288 @@ responseCOTUnknown(CS101_ASDU asdu, MasterConnection self)
     responseNegative(asdu, self, CS101_COT_UNKNOWN_COT);
 }
 
+/*
+ * Answer a read command from the process image. The point is found with the hash index and
+ * encoded directly into a static ASDU - no user code is called and no memory is allocated.
+ */
+static void
+handleReadFromProcessImage(MasterConnection self, CS101_ASDU asdu, int ioa)
+{
+    CS101_ProcessImage processImage = self->slave->processImage;
+
+    int ca = CS101_ASDU_getCA(asdu);
+    int index = CS101_ProcessImage_lookup(processImage, ca, ioa);
+
+    if (index == -1)
+    {
+        if (CS101_ProcessImage_hasCA(processImage, ca))
+        {
+            DEBUG_PRINT("CS104 SLAVE: read command for unknown IOA %i\n", ioa);
+            responseNegative(asdu, self, CS101_COT_UNKNOWN_IOA);
+        }
+        else
+        {
+            DEBUG_PRINT("CS104 SLAVE: read command for unknown CA %i\n", ca);
+            responseNegative(asdu, self, CS101_COT_UNKNOWN_CA);
+        }
+
+        return;
+    }
+
+    sCS101_StaticASDU _response;
+
+    CS101_ASDU response = CS101_ASDU_initializeStatic(&_response, &(self->slave->alParameters), false,
+            CS101_COT_REQUEST, CS101_ASDU_getOA(asdu), ca, false, false);
+
+    if (CS101_ProcessImage_addToASDU(processImage, index, response))
+        sendASDUInternal(self, response);
+}
+
+/* CA requested by a command - -1 for the broadcast address (all CAs of the process image) */
+static int
+getRequestedCA(MasterConnection self, CS101_ASDU asdu)
+{
+    int ca = CS101_ASDU_getCA(asdu);
+    int broadcastCA = (CS101_SIZE_OF_CA(&(self->slave->alParameters)) == 1) ? 0xff : 0xffff;
+
+    return (ca == broadcastCA) ? -1 : ca;
+}
+
+/*
+ * Answer an interrogation command from the process image. Only the ACT_CON is sent here. The
+ * information objects and the ACT_TERM are sent by sendNextInterrogationASDUs when the k-window has space.
+ */
+static void
+handleInterrogationFromProcessImage(MasterConnection self, CS101_ASDU asdu, uint8_t qoi)
+{
+    CS101_ProcessImage processImage = self->slave->processImage;
+
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_DEACTIVATION)
+    {
+        CS101_InterrogationCursor_stop(&(self->interrogation));
+
+        CS101_ASDU_setCOT(asdu, CS101_COT_DEACTIVATION_CON);
+        sendASDUInternal(self, asdu);
+
+        return;
+    }
+
+    if ((qoi < IEC60870_QOI_STATION) || (qoi > IEC60870_QOI_GROUP_16))
+    {
+        DEBUG_PRINT("CS104 SLAVE: interrogation with unsupported QOI %i\n", qoi);
+        responseNegative(asdu, self, CS101_COT_ACTIVATION_CON);
+        return;
+    }
+
+    if (CS101_InterrogationCursor_isRunning(&(self->interrogation)))
+    {
+        DEBUG_PRINT("CS104 SLAVE: interrogation already running\n");
+        responseNegative(asdu, self, CS101_COT_ACTIVATION_CON);
+        return;
+    }
+
+    int ca = CS101_ASDU_getCA(asdu);
+    int requestedCA = getRequestedCA(self, asdu);
+
+    if ((requestedCA != -1) && (CS101_ProcessImage_hasCA(processImage, requestedCA) == false))
+    {
+        DEBUG_PRINT("CS104 SLAVE: interrogation for unknown CA %i\n", ca);
+        responseNegative(asdu, self, CS101_COT_UNKNOWN_CA);
+        return;
+    }
+
+    CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
+
+    if (sendASDUInternal(self, asdu))
+    {
+        self->interrogationOA = CS101_ASDU_getOA(asdu);
+        self->interrogationCA = ca;
+        self->interrogationQOI = qoi;
+
+        CS101_InterrogationCursor_start(&(self->interrogation), qoi - IEC60870_QOI_STATION, requestedCA);
+    }
+}
+
+/*
+ * Answer a counter interrogation command from the process image. Freeze and reset requests are executed
+ * immediately (ACT_CON and ACT_TERM). For a read request only the ACT_CON is sent here - the frozen
+ * integrated totals and the ACT_TERM are sent by sendNextInterrogationASDUs.
+ */
+static void
+handleCounterInterrogationFromProcessImage(MasterConnection self, CS101_ASDU asdu, QualifierOfCIC qcc)
+{
+    CS101_ProcessImage processImage = self->slave->processImage;
+
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_DEACTIVATION)
+    {
+        CS101_InterrogationCursor_stop(&(self->counterInterrogation));
+
+        CS101_ASDU_setCOT(asdu, CS101_COT_DEACTIVATION_CON);
+        sendASDUInternal(self, asdu);
+
+        return;
+    }
+
+    int rqt = qcc & 0x3f;
+    int frz = qcc & 0xc0;
+
+    if ((rqt < IEC60870_QCC_RQT_GROUP_1) || (rqt > IEC60870_QCC_RQT_GENERAL))
+    {
+        DEBUG_PRINT("CS104 SLAVE: counter interrogation with unsupported QCC %i\n", qcc);
+        responseNegative(asdu, self, CS101_COT_ACTIVATION_CON);
+        return;
+    }
+
+    int group = (rqt == IEC60870_QCC_RQT_GENERAL) ? 0 : rqt;
+
+    int ca = CS101_ASDU_getCA(asdu);
+    int requestedCA = getRequestedCA(self, asdu);
+
+    if ((requestedCA != -1) && (CS101_ProcessImage_hasCA(processImage, requestedCA) == false))
+    {
+        DEBUG_PRINT("CS104 SLAVE: counter interrogation for unknown CA %i\n", ca);
+        responseNegative(asdu, self, CS101_COT_UNKNOWN_CA);
+        return;
+    }
+
+    if (frz == IEC60870_QCC_FRZ_READ)
+    {
+        if (CS101_InterrogationCursor_isRunning(&(self->counterInterrogation)))
+        {
+            DEBUG_PRINT("CS104 SLAVE: counter interrogation already running\n");
+            responseNegative(asdu, self, CS101_COT_ACTIVATION_CON);
+            return;
+        }
+
+        CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
+
+        if (sendASDUInternal(self, asdu))
+        {
+            self->counterInterrogationOA = CS101_ASDU_getOA(asdu);
+            self->counterInterrogationCA = ca;
+            self->counterInterrogationQCC = qcc;
+
+            CS101_InterrogationCursor_startCounterInterrogation(&(self->counterInterrogation), group, requestedCA);
+        }
+    }
+    else
+    {
+        if (frz == IEC60870_QCC_FRZ_COUNTER_RESET)
+            CS101_ProcessImage_resetCounters(processImage, requestedCA, group);
+        else
+            CS101_ProcessImage_freezeCounters(processImage, requestedCA, group, (frz == IEC60870_QCC_FRZ_FREEZE_WITH_RESET), 0);
+
+        CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_CON);
+        sendASDUInternal(self, asdu);
+
+        CS101_ASDU_setCOT(asdu, CS101_COT_ACTIVATION_TERMINATION);
+        sendASDUInternal(self, asdu);
+    }
+}
+
+/*
+ * Send the next ASDUs of a running interrogation while the k-window has space. Pending high priority
+ * ASDUs (e.g. command responses) are sent first. Returns true when the interrogation is
+ * still running and ASDUs could be sent immediately.
+ */
+static bool
+sendNextInterrogationASDUs(MasterConnection self)
+{
+    bool waiting = false;
+
+    while (CS101_InterrogationCursor_isRunning(&(self->interrogation)) ||
+            CS101_InterrogationCursor_isRunning(&(self->counterInterrogation)) ||
+            CS101_InterrogationCursor_isRunning(&(self->historyReplay)))
+    {
+        if (HighPriorityASDUQueue_isAsduAvailable(self->highPrioQueue)) {
+            waiting = true;
+            break;
+        }
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_wait(self->sentASDUsLock);
+#endif
+
+        if (isSentBufferFull(self))
+        {
+#if (CONFIG_USE_SEMAPHORES == 1)
+            Semaphore_post(self->sentASDUsLock);
+#endif
+            break;
+        }
+
+        sCS101_StaticASDU _asdu;
+        CS101_ASDU asdu;
+        union uInformationObject _io;
+
+        if (CS101_InterrogationCursor_isRunning(&(self->interrogation)))
+        {
+            CS101_InterrogationCursor cursor = &(self->interrogation);
+
+            asdu = CS101_ASDU_initializeStatic(&_asdu, &(self->slave->alParameters), false,
+                    (CS101_CauseOfTransmission) (CS101_COT_INTERROGATED_BY_STATION + cursor->group),
+                    self->interrogationOA, self->interrogationCA, false, false);
+
+            if (CS101_ProcessImage_getNextInterrogationASDU(self->slave->processImage, cursor, asdu) == false)
+            {
+                asdu = CS101_ASDU_initializeStatic(&_asdu, &(self->slave->alParameters), false, CS101_COT_ACTIVATION_TERMINATION,
+                        self->interrogationOA, self->interrogationCA, false, false);
+
+                CS101_ASDU_addInformationObject(asdu,
+                        (InformationObject) InterrogationCommand_create((InterrogationCommand) &_io, 0, self->interrogationQOI));
+
+                CS101_InterrogationCursor_stop(cursor);
+            }
+        }
+        else if (CS101_InterrogationCursor_isRunning(&(self->counterInterrogation)))
+        {
+            CS101_InterrogationCursor cursor = &(self->counterInterrogation);
+
+            int rqt = self->counterInterrogationQCC & 0x3f;
+
+            CS101_CauseOfTransmission cot = (rqt == IEC60870_QCC_RQT_GENERAL) ? CS101_COT_REQUESTED_BY_GENERAL_COUNTER :
+                    (CS101_CauseOfTransmission) (CS101_COT_REQUESTED_BY_GROUP_1_COUNTER + rqt - IEC60870_QCC_RQT_GROUP_1);
+
+            asdu = CS101_ASDU_initializeStatic(&_asdu, &(self->slave->alParameters), false, cot,
+                    self->counterInterrogationOA, self->counterInterrogationCA, false, false);
+
+            if (CS101_ProcessImage_getNextInterrogationASDU(self->slave->processImage, cursor, asdu) == false)
+            {
+                asdu = CS101_ASDU_initializeStatic(&_asdu, &(self->slave->alParameters), false, CS101_COT_ACTIVATION_TERMINATION,
+                        self->counterInterrogationOA, self->counterInterrogationCA, false, false);
+
+                CS101_ASDU_addInformationObject(asdu,
+                        (InformationObject) CounterInterrogationCommand_create((CounterInterrogationCommand) &_io, 0, self->counterInterrogationQCC));
+
+                CS101_InterrogationCursor_stop(cursor);
+            }
+        }
+        else
+        {
+            CS101_InterrogationCursor cursor = &(self->historyReplay);
+
+            asdu = CS101_ASDU_initializeStatic(&_asdu, &(self->slave->alParameters), false, CS101_COT_SPONTANEOUS,
+                    self->slave->alParameters.originatorAddress, 0, false, false);
+
+            /* the history replay has no termination message */
+            if (CS101_ProcessImage_getNextHistoryASDU(self->slave->processImage, cursor, asdu) == false)
+            {
+                CS101_InterrogationCursor_stop(cursor);
+                asdu = NULL;
+            }
+        }
+
+        if (asdu)
+            sendASDUImmediately(self, asdu);
+
+#if (CONFIG_USE_SEMAPHORES == 1)
+        Semaphore_post(self->sentASDUsLock);
+#endif
+    }
+
+    return waiting;
+}
+
 /*
  * Handle received ASDUs
  *
@@ -1980,7 +2241,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
         if ((cot == CS101_COT_ACTIVATION) || (cot == CS101_COT_DEACTIVATION))
         {
-            if (slave->interrogationHandler != NULL)
+            if ((slave->interrogationHandler != NULL) || (slave->processImage != NULL))
             {
                 union uInformationObject _io;
 
@@ -1995,6 +2256,11 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
                         responseNegative(asdu, self, CS101_COT_UNKNOWN_IOA);
                         messageHandled = true;
                     }
+                    else if (slave->processImage != NULL)
+                    {
+                        handleInterrogationFromProcessImage(self, asdu, InterrogationCommand_getQOI(irc));
+                        messageHandled = true;
+                    }
                     else
                     {
                         if (slave->interrogationHandler(slave->interrogationHandlerParameter,
@@ -2020,7 +2286,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
         if ((cot == CS101_COT_ACTIVATION) || (cot == CS101_COT_DEACTIVATION))
         {
-            if (slave->counterInterrogationHandler != NULL)
+            if ((slave->counterInterrogationHandler != NULL) || (slave->processImage != NULL))
             {
                 union uInformationObject _io;
 
@@ -2035,6 +2301,11 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
                         responseNegative(asdu, self, CS101_COT_UNKNOWN_IOA);
                         messageHandled = true;
                     }
+                    else if (slave->processImage != NULL)
+                    {
+                        handleCounterInterrogationFromProcessImage(self, asdu, CounterInterrogationCommand_getQCC(cic));
+                        messageHandled = true;
+                    }
                     else
                     {
                         if (slave->counterInterrogationHandler(slave->counterInterrogationHandlerParameter,
@@ -2060,7 +2331,7 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
         if (cot == CS101_COT_REQUEST)
         {
-            if (slave->readHandler != NULL)
+            if ((slave->readHandler != NULL) || (slave->processImage != NULL))
             {
                 union uInformationObject _io;
 
@@ -2068,7 +2339,12 @@ handleASDU(MasterConnection self, CS101_ASDU asdu)
 
                 if (rc)
                 {
-                    if (slave->readHandler(slave->readHandlerParameter,
+                    if (slave->processImage != NULL)
+                    {
+                        handleReadFromProcessImage(self, asdu, InformationObject_getObjectAddress((InformationObject) rc));
+                        messageHandled = true;
+                    }
+                    else if (slave->readHandler(slave->readHandlerParameter,
                             &(self->iMasterConnection), asdu, InformationObject_getObjectAddress((InformationObject) rc)))
                         messageHandled = true;
                 }
@@ -2565,27 +2841,17 @@ sendSMessage(MasterConnection self)
 }
 
 static bool
-handleMessage(MasterConnection self, uint8_t* buffer, int msgSize)
+handleMessage(MasterConnection self, CS104_APDU apdu)
 {
     uint64_t currentTime = Hal_getMonotonicTimeInMs();
 
-    if (msgSize >= 3)
-    {
-        if (buffer[0] != 0x68) {
-            DEBUG_PRINT("CS104 SLAVE: Invalid START character!");
-            return false;
-        }
+    uint8_t* buffer = apdu->apdu;
 
-        uint8_t lengthOfApdu = buffer[1];
-
-        if (lengthOfApdu != msgSize - 2) {
-            DEBUG_PRINT("CS104 SLAVE: Invalid length of APDU");
-            return false;
-        }
-
-        if ((buffer[2] & 1) == 0) /* I message */
+    if (apdu->apduSize >= 3)
+    {
+        if (apdu->format == CS104_APDU_FORMAT_I)
         {
-            if (msgSize < 7) {
+            if (apdu->asduSize < 1) {
                 DEBUG_PRINT("CS104 SLAVE: Received I msg too small!");
                 return false;
             }
@@ -2613,8 +2879,8 @@ handleMessage(MasterConnection self, uint8_t* buffer, int msgSize)
             Semaphore_post(self->stateLock);
 #endif
 
-            int frameSendSequenceNumber = ((buffer [3] * 0x100) + (buffer [2] & 0xfe)) / 2;
-            int frameRecvSequenceNumber = ((buffer [5] * 0x100) + (buffer [4] & 0xfe)) / 2;
+            int frameSendSequenceNumber = apdu->sendSequenceNumber;
+            int frameRecvSequenceNumber = apdu->receiveSequenceNumber;
 
             DEBUG_PRINT("CS104 SLAVE: Received I frame: N(S) = %i N(R) = %i\n", frameSendSequenceNumber, frameRecvSequenceNumber);
 
@@ -2652,7 +2918,7 @@ handleMessage(MasterConnection self, uint8_t* buffer, int msgSize)
             {
                 struct sCS101_ASDU _asdu;
 
-                CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(&_asdu, &(self->slave->alParameters), buffer + 6, msgSize - 6);
+                CS101_ASDU asdu = CS101_ASDU_createFromBufferEx(&_asdu, &(self->slave->alParameters), apdu->asdu, apdu->asduSize);
 
                 if (asdu)
                 {
@@ -2688,6 +2954,15 @@ handleMessage(MasterConnection self, uint8_t* buffer, int msgSize)
 
             HighPriorityASDUQueue_resetConnectionQueue(self->highPrioQueue);
 
+            CS101_InterrogationCursor_stop(&(self->interrogation));
+            CS101_InterrogationCursor_stop(&(self->counterInterrogation));
+
+            /* replay the last changes from the history of the process image */
+            if (self->slave->processImage && (self->slave->historyReplayEntries > 0))
+                CS101_InterrogationCursor_startHistoryReplay(&(self->historyReplay), self->slave->historyReplayEntries, -1);
+            else
+                CS101_InterrogationCursor_stop(&(self->historyReplay));
+
             DEBUG_PRINT("CS104 SLAVE: Send STARTDT_CON\n");
 
             if (writeToSocket(self, STARTDT_CON_MSG, STARTDT_CON_MSG_SIZE) < 0)
@@ -2701,6 +2976,10 @@ handleMessage(MasterConnection self, uint8_t* buffer, int msgSize)
 
             MasterConnection_deactivate(self);
 
+            CS101_InterrogationCursor_stop(&(self->interrogation));
+            CS101_InterrogationCursor_stop(&(self->counterInterrogation));
+            CS101_InterrogationCursor_stop(&(self->historyReplay));
+
             /* Send S-Message to confirm all outstanding messages */
 
 #if (CONFIG_USE_SEMAPHORES == 1)
@@ -2764,7 +3043,7 @@ handleMessage(MasterConnection self, uint8_t* buffer, int msgSize)
 
         else if (buffer [2] == 0x01) /* S-message */
         {
-            int seqNo = (buffer[4] + buffer[5] * 0x100) / 2;
+            int seqNo = apdu->receiveSequenceNumber;
 
             DEBUG_PRINT("CS104 SLAVE: Rcvd S(%i) (own sendcounter = %i)\n", seqNo, self->sendCount);
 
@@ -2808,6 +3087,65 @@ handleMessage(MasterConnection self, uint8_t* buffer, int msgSize)
     }
 }
 
+/**
+ * \brief Read the available data from the socket and handle all complete APDUs
+ *
+ * \return false in case of a socket error or when the connection has to be closed
+ */
+static bool
+receiveAndHandleMessages(MasterConnection self)
+{
+    int readBytes = readFromSocket(self, self->recvBuffer, sizeof(self->recvBuffer));
+
+    if (readBytes < 0) {
+        DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
+        return false;
+    }
+
+    int pos = 0;
+
+    while (pos < readBytes)
+    {
+        sCS104_APDU apdu;
+        int bytesConsumed;
+
+        CS104_APDUParserResult result = CS104_APDUParser_parse(&(self->apduParser), self->recvBuffer + pos,
+                readBytes - pos, &bytesConsumed, &apdu);
+
+        pos += bytesConsumed;
+
+        if (result == CS104_APDU_PARSER_ERROR) {
+            DEBUG_PRINT("CS104 SLAVE: Invalid APDU - close connection\n");
+            return false;
+        }
+
+        if (result == CS104_APDU_PARSER_APDU_COMPLETE)
+        {
+            DEBUG_PRINT("CS104 SLAVE: Connection: rcvd msg(%i bytes)\n", apdu.apduSize);
+
+            if (self->slave->rawMessageHandler)
+                self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
+                        &(self->iMasterConnection), apdu.apdu, apdu.apduSize, false);
+
+            if (handleMessage(self, &apdu) == false)
+                return false;
+
+            if (self->unconfirmedReceivedIMessages >= self->slave->conParameters.w)
+            {
+                self->lastConfirmationTime = Hal_getMonotonicTimeInMs();
+
+                self->unconfirmedReceivedIMessages = 0;
+
+                self->timeoutT2Triggered = false;
+
+                sendSMessage(self);
+            }
+        }
+    }
+
+    return true;
+}
+
 static void
 MasterConnection_deinit(MasterConnection self)
 {
@@ -2951,7 +3289,10 @@ sendWaitingASDUs(MasterConnection self)
     /* send messages from low-priority queue */
     sendNextLowPriorityASDU(self);
 
-    if (MessageQueue_isAsduAvailable(self->lowPrioQueue))
+    /* fill the remaining k-window with the response of a running interrogation */
+    bool interrogationWaiting = sendNextInterrogationASDUs(self);
+
+    if (MessageQueue_isAsduAvailable(self->lowPrioQueue) || interrogationWaiting)
         return true;
     else
         return false;
@@ -3118,43 +3459,17 @@ connectionHandlingThread(void* parameter)
 
         if (Handleset_waitReady(self->handleSet, socketTimeout))
         {
-            int bytesRec = receiveMessage(self);
-
-            if (bytesRec == -1) {
-                DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
-                break;
-            }
-
-            if (bytesRec > 0)
+            if (receiveAndHandleMessages(self) == false)
             {
-                DEBUG_PRINT("CS104 SLAVE: Connection: rcvd msg(%i bytes)\n", bytesRec);
-
-                if (self->slave->rawMessageHandler)
-                    self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
-                            &(self->iMasterConnection), self->recvBuffer, bytesRec, false);
-
-                if (handleMessage(self, self->recvBuffer, bytesRec) == false)
-                {
 #if (CONFIG_USE_SEMAPHORES == 1)
-                    Semaphore_wait(self->stateLock);
-#endif /* (CONFIG_USE_SEMAPHORES == 1) */                  
-                    self->isRunning = false;
-
-#if (CONFIG_USE_SEMAPHORES == 1)
-                    Semaphore_post(self->stateLock);
+                Semaphore_wait(self->stateLock);
 #endif /* (CONFIG_USE_SEMAPHORES == 1) */
-                }
 
-                if (self->unconfirmedReceivedIMessages >= self->slave->conParameters.w)
-                {
-                    self->lastConfirmationTime = Hal_getMonotonicTimeInMs();
-
-                    self->unconfirmedReceivedIMessages = 0;
+                self->isRunning = false;
 
-                    self->timeoutT2Triggered = false;
-
-                    sendSMessage(self);
-                }
+#if (CONFIG_USE_SEMAPHORES == 1)
+                Semaphore_post(self->stateLock);
+#endif /* (CONFIG_USE_SEMAPHORES == 1) */
             }
         }
 
@@ -3363,7 +3678,7 @@ MasterConnection_init(MasterConnection self, Socket skt, MessageQueue lowPrioQue
         self->isRunning = false;
         self->receiveCount = 0;
         self->sendCount = 0;
-        self->recvBufPos = 0;
+        CS104_APDUParser_initialize(&(self->apduParser));
 
         if (self->maxSentASDUs != self->slave->conParameters.k)
         {
@@ -3423,6 +3738,10 @@ MasterConnection_init(MasterConnection self, Socket skt, MessageQueue lowPrioQue
 
         HighPriorityASDUQueue_resetConnectionQueue(self->highPrioQueue);
 
+        CS101_InterrogationCursor_stop(&(self->interrogation));
+        CS101_InterrogationCursor_stop(&(self->counterInterrogation));
+        CS101_InterrogationCursor_stop(&(self->historyReplay));
+
         self->waitingForTestFRcon = false;
 
         return true;
@@ -3550,33 +3869,8 @@ MasterConnection_activate(MasterConnection self)
 static void
 MasterConnection_handleTcpConnection(MasterConnection self)
 {
-    int bytesRec = receiveMessage(self);
-
-    if (bytesRec < 0) {
-        DEBUG_PRINT("CS104 SLAVE: Error reading from socket\n");
+    if (receiveAndHandleMessages(self) == false)
         self->isRunning = false;
-    }
-
-    if ((bytesRec > 0) && (self->isRunning))
-    {
-        if (self->slave->rawMessageHandler)
-            self->slave->rawMessageHandler(self->slave->rawMessageHandlerParameter,
-                    &(self->iMasterConnection), self->recvBuffer, bytesRec, false);
-
-        if (handleMessage(self, self->recvBuffer, bytesRec) == false)
-            self->isRunning = false;
-
-        if (self->unconfirmedReceivedIMessages >= self->slave->conParameters.w)
-        {
-            self->lastConfirmationTime = Hal_getMonotonicTimeInMs();
-
-            self->unconfirmedReceivedIMessages = 0;
-
-            self->timeoutT2Triggered = false;
-
-            sendSMessage(self);
-        }
-    }
 }
 
 static void
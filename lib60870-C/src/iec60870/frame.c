@@ -69,3 +69,11 @@ Frame_getSpaceLeft(Frame self)
 {
     return self->virtualFunctionTable->getSpaceLeft(self);
 }
+
+void
+FrameSpan_initialize(FrameSpan self, uint8_t* buffer, int pos, int capacity)
+{
+    self->buffer = buffer;
+    self->pos = pos;
+    self->capacity = capacity;
+}
@@ -21,6 +21,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "frame.h"
 #include "buffer_frame.h"
@@ -77,12 +78,7 @@ BufferFrame_appendBytes(Frame super, const uint8_t* bytes, int numberOfBytes)
 {
     BufferFrame self = (BufferFrame) super;
 
-    int i;
-
-    uint8_t* target = self->buffer + self->msgSize;
-
-    for (i = 0; i < numberOfBytes; i++)
-        target[i] = bytes[i];
+    memcpy(self->buffer + self->msgSize, bytes, numberOfBytes);
 
     self->msgSize += numberOfBytes;
 }
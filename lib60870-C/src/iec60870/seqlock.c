@@ -0,0 +1,124 @@
+/*
+ *  seqlock.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "seqlock.h"
+#include "hal_thread.h"
+#include "lib60870_config.h"
+
+/*
+ * Writers: CAS (acquire) to an odd sequence number, release fence, data, release store of the even number.
+ * Readers: acquire load of the sequence number, data, acquire fence, load of the sequence number.
+ */
+#if defined(_MSC_VER)
+#include <windows.h>
+#define SEQLOCK_COMPARE_AND_SWAP(ptr, oldValue, newValue) \
+    (InterlockedCompareExchange((volatile LONG*) (ptr), (LONG) (newValue), (LONG) (oldValue)) == (LONG) (oldValue))
+#define SEQLOCK_FENCE_ACQUIRE() MemoryBarrier()
+#define SEQLOCK_FENCE_RELEASE() MemoryBarrier()
+#define SEQLOCK_LOAD_ACQUIRE(ptr) (MemoryBarrier(), *(ptr))
+#define SEQLOCK_STORE_RELEASE(ptr, value) do { MemoryBarrier(); *(ptr) = (value); } while (0)
+#elif defined(__GNUC__) && defined(__ATOMIC_ACQUIRE)
+#define SEQLOCK_COMPARE_AND_SWAP(ptr, oldValue, newValue) \
+    __atomic_compare_exchange_n((ptr), &(oldValue), (newValue), false, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)
+#define SEQLOCK_FENCE_ACQUIRE() __atomic_thread_fence(__ATOMIC_ACQUIRE)
+#define SEQLOCK_FENCE_RELEASE() __atomic_thread_fence(__ATOMIC_RELEASE)
+#define SEQLOCK_LOAD_ACQUIRE(ptr) __atomic_load_n((ptr), __ATOMIC_ACQUIRE)
+#define SEQLOCK_STORE_RELEASE(ptr, value) __atomic_store_n((ptr), (value), __ATOMIC_RELEASE)
+#elif defined(__GNUC__)
+#define SEQLOCK_COMPARE_AND_SWAP(ptr, oldValue, newValue) __sync_bool_compare_and_swap((ptr), (oldValue), (newValue))
+#define SEQLOCK_FENCE_ACQUIRE() __sync_synchronize()
+#define SEQLOCK_FENCE_RELEASE() __sync_synchronize()
+#define SEQLOCK_LOAD_ACQUIRE(ptr) (__sync_synchronize(), *(ptr))
+#define SEQLOCK_STORE_RELEASE(ptr, value) do { __sync_synchronize(); *(ptr) = (value); } while (0)
+#else
+/* unknown compiler - only safe without concurrent writers */
+#define SEQLOCK_COMPARE_AND_SWAP(ptr, oldValue, newValue) ((*(ptr) = (newValue)), true)
+#define SEQLOCK_FENCE_ACQUIRE()
+#define SEQLOCK_FENCE_RELEASE()
+#define SEQLOCK_LOAD_ACQUIRE(ptr) (*(ptr))
+#define SEQLOCK_STORE_RELEASE(ptr, value) (*(ptr) = (value))
+#endif
+
+/* number of spins before the thread gives up the CPU (the other side may have been preempted) */
+#define SEQLOCK_SPINS_BEFORE_YIELD 1000
+
+static void
+backOff(int* spins)
+{
+    (*spins)++;
+
+#if (CONFIG_USE_THREADS == 1)
+    if (*spins >= SEQLOCK_SPINS_BEFORE_YIELD) {
+        Thread_sleep(0);
+        *spins = 0;
+    }
+#endif
+}
+
+void
+SeqLock_writeBegin(SeqLock* self)
+{
+    int spins = 0;
+
+    while (true) {
+        uint32_t sequence = *self;
+
+        if (((sequence & 1) == 0) && SEQLOCK_COMPARE_AND_SWAP(self, sequence, sequence + 1))
+            break;
+
+        backOff(&spins);
+    }
+
+    /* odd sequence number has to be visible before the data is modified */
+    SEQLOCK_FENCE_RELEASE();
+}
+
+void
+SeqLock_writeEnd(SeqLock* self)
+{
+    SEQLOCK_STORE_RELEASE(self, *self + 1);
+}
+
+uint32_t
+SeqLock_readBegin(SeqLock* self)
+{
+    int spins = 0;
+
+    uint32_t sequence = SEQLOCK_LOAD_ACQUIRE(self);
+
+    while (sequence & 1) {
+        backOff(&spins);
+        sequence = SEQLOCK_LOAD_ACQUIRE(self);
+    }
+
+    return sequence;
+}
+
+bool
+SeqLock_readRetry(SeqLock* self, uint32_t sequence)
+{
+    /* the data has to be read before the sequence number is checked again */
+    SEQLOCK_FENCE_ACQUIRE();
+
+    return (*self != sequence);
+}
@@ -0,0 +1,187 @@
+/*
+ *  timer_wheel.c
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#include "timer_wheel.h"
+#include "lib_memory.h"
+#include "lib60870_internal.h"
+
+struct sTimerWheel {
+    TimerWheelEntry* slots;
+    uint32_t slotMask;
+    int tickInterval;
+    uint64_t currentTick; /* last processed tick */
+    int numberOfTimers;
+};
+
+TimerWheel
+TimerWheel_create(int numberOfSlots, int tickInterval, uint64_t currentTime)
+{
+    TimerWheel self = (TimerWheel) GLOBAL_MALLOC(sizeof(struct sTimerWheel));
+
+    if (self) {
+        uint32_t size = 1;
+
+        while (size < (uint32_t) numberOfSlots)
+            size *= 2;
+
+        self->slots = (TimerWheelEntry*) GLOBAL_CALLOC(size, sizeof(TimerWheelEntry));
+
+        if (self->slots == NULL) {
+            GLOBAL_FREEMEM(self);
+            return NULL;
+        }
+
+        self->slotMask = size - 1;
+        self->tickInterval = (tickInterval > 0) ? tickInterval : 1;
+        self->currentTick = currentTime / self->tickInterval;
+        self->numberOfTimers = 0;
+    }
+
+    return self;
+}
+
+void
+TimerWheel_destroy(TimerWheel self)
+{
+    if (self) {
+        GLOBAL_FREEMEM(self->slots);
+        GLOBAL_FREEMEM(self);
+    }
+}
+
+void
+TimerWheelEntry_initialize(TimerWheelEntry self)
+{
+    self->next = NULL;
+    self->prev = NULL;
+    self->expiryTime = 0;
+    self->isScheduled = false;
+}
+
+/* timers are rounded up to the next tick so that they never expire early */
+static uint64_t
+getExpiryTick(TimerWheel self, uint64_t expiryTime)
+{
+    return (expiryTime + self->tickInterval - 1) / self->tickInterval;
+}
+
+static void
+removeEntry(TimerWheel self, TimerWheelEntry entry)
+{
+    if (entry->prev)
+        entry->prev->next = entry->next;
+    else
+        self->slots[getExpiryTick(self, entry->expiryTime) & self->slotMask] = entry->next;
+
+    if (entry->next)
+        entry->next->prev = entry->prev;
+
+    entry->next = NULL;
+    entry->prev = NULL;
+    entry->isScheduled = false;
+
+    self->numberOfTimers--;
+}
+
+void
+TimerWheel_schedule(TimerWheel self, TimerWheelEntry entry, uint64_t expiryTime)
+{
+    if (entry->isScheduled)
+        removeEntry(self, entry);
+
+    /* expired timers are handled with the next tick */
+    if (getExpiryTick(self, expiryTime) <= self->currentTick)
+        expiryTime = (self->currentTick + 1) * self->tickInterval;
+
+    uint32_t slot = (uint32_t) getExpiryTick(self, expiryTime) & self->slotMask;
+
+    entry->expiryTime = expiryTime;
+    entry->prev = NULL;
+    entry->next = self->slots[slot];
+
+    if (entry->next)
+        entry->next->prev = entry;
+
+    self->slots[slot] = entry;
+
+    entry->isScheduled = true;
+
+    self->numberOfTimers++;
+}
+
+void
+TimerWheel_cancel(TimerWheel self, TimerWheelEntry entry)
+{
+    if (entry->isScheduled)
+        removeEntry(self, entry);
+}
+
+int
+TimerWheel_getNumberOfTimers(TimerWheel self)
+{
+    return self->numberOfTimers;
+}
+
+int
+TimerWheel_advance(TimerWheel self, uint64_t currentTime, TimerWheel_ExpiryHandler handler, void* parameter)
+{
+    uint64_t targetTick = currentTime / self->tickInterval;
+
+    if (targetTick <= self->currentTick)
+        return 0;
+
+    /* after a long pause every slot is visited only once */
+    if (targetTick - self->currentTick > (uint64_t) self->slotMask + 1)
+        self->currentTick = targetTick - (self->slotMask + 1);
+
+    int expiredTimers = 0;
+
+    while (self->currentTick < targetTick) {
+
+        self->currentTick++;
+
+        uint32_t slot = (uint32_t) self->currentTick & self->slotMask;
+
+        /*
+         * Start again at the head of the slot after each expired timer because the handler
+         * can schedule or cancel other timers.
+         */
+        TimerWheelEntry entry = self->slots[slot];
+
+        while (entry) {
+            if (getExpiryTick(self, entry->expiryTime) <= self->currentTick) {
+                removeEntry(self, entry);
+
+                expiredTimers++;
+
+                handler(parameter, entry, currentTime);
+
+                entry = self->slots[slot];
+            }
+            else
+                entry = entry->next;
+        }
+    }
+
+    return expiredTimers;
+}
@@ -0,0 +1,192 @@
+/*
+ *  cs101_asdu_template.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS101_ASDU_TEMPLATE_H_
+#define SRC_INC_API_CS101_ASDU_TEMPLATE_H_
+
+/**
+ * \file cs101_asdu_template.h
+ * \brief Pre-encoded ASDUs for cyclic transmission with in-place update of values
+ */
+
+#include "iec60870_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup COMMON Common API functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup ASDU_TEMPLATE Pre-encoded ASDU templates
+ *
+ * An ASDU template keeps an encoded ASDU (header and information object addresses) and
+ * the offsets of the information elements. Values, quality descriptors, and time tags can
+ * be updated in place without encoding the whole ASDU again. This is intended for cyclic
+ * (periodic) or background transmission of the same set of data points.
+ *
+ * Supported are the monitoring direction types for single and double points, step positions,
+ * bitstrings, measured values (normalized, scaled, short floating point), and integrated totals
+ * with and without time tag.
+ *
+ * @{
+ */
+
+typedef struct sCS101_ASDUTemplate* CS101_ASDUTemplate;
+
+/**
+ * \brief Create a new template from a prepared ASDU
+ *
+ * The ASDU has to contain all information objects of the template. The template stores
+ * a copy of the encoded ASDU and of the application layer parameters.
+ *
+ * \param asdu the prepared ASDU
+ *
+ * \return the new template instance or NULL when the ASDU is empty, the type is not supported,
+ *         or the ASDU payload is inconsistent
+ */
+CS101_ASDUTemplate
+CS101_ASDUTemplate_create(CS101_ASDU asdu);
+
+/**
+ * \brief Release all resources of the template
+ */
+void
+CS101_ASDUTemplate_destroy(CS101_ASDUTemplate self);
+
+/**
+ * \brief Get the ASDU of the template
+ *
+ * The returned ASDU can be passed to functions like CS104_Slave_enqueueASDU. It remains valid until the
+ * template is destroyed. The ASDU header (e.g. COT) can be changed with the CS101_ASDU functions but no
+ * information objects must be added or removed.
+ *
+ * \return the ASDU with the current values
+ */
+CS101_ASDU
+CS101_ASDUTemplate_getASDU(CS101_ASDUTemplate self);
+
+/**
+ * \brief Get the type ID of the template
+ */
+TypeID
+CS101_ASDUTemplate_getTypeID(CS101_ASDUTemplate self);
+
+/**
+ * \brief Get the number of information objects of the template
+ */
+int
+CS101_ASDUTemplate_getNumberOfElements(CS101_ASDUTemplate self);
+
+/**
+ * \brief Update the quality descriptor of an element
+ *
+ * \param index the index of the information object in the ASDU
+ * \param quality the new quality descriptor
+ *
+ * \return true on success, false when the index is out of range or the type has no quality descriptor
+ */
+bool
+CS101_ASDUTemplate_setQuality(CS101_ASDUTemplate self, int index, QualityDescriptor quality);
+
+/**
+ * \brief Update the time tag of an element (types with CP24Time2a or CP56Time2a time tag)
+ *
+ * For types with CP24Time2a time tag only the first three bytes (milliseconds and minutes) are used.
+ *
+ * \return true on success, false when the index is out of range or the type has no time tag
+ */
+bool
+CS101_ASDUTemplate_setTimestamp(CS101_ASDUTemplate self, int index, const CP56Time2a timestamp);
+
+/**
+ * \brief Update value and quality of a single point information (M_SP_NA_1, M_SP_TA_1, M_SP_TB_1)
+ */
+bool
+CS101_ASDUTemplate_setSinglePoint(CS101_ASDUTemplate self, int index, bool value, QualityDescriptor quality);
+
+/**
+ * \brief Update value and quality of a double point information (M_DP_NA_1, M_DP_TA_1, M_DP_TB_1)
+ */
+bool
+CS101_ASDUTemplate_setDoublePoint(CS101_ASDUTemplate self, int index, DoublePointValue value, QualityDescriptor quality);
+
+/**
+ * \brief Update value and quality of a step position information (M_ST_NA_1, M_ST_TA_1, M_ST_TB_1)
+ *
+ * \param value the step position (range -64 ... 63)
+ */
+bool
+CS101_ASDUTemplate_setStepPosition(CS101_ASDUTemplate self, int index, int value, bool isTransient, QualityDescriptor quality);
+
+/**
+ * \brief Update value and quality of a bitstring of 32 bit (M_BO_NA_1, M_BO_TA_1, M_BO_TB_1)
+ */
+bool
+CS101_ASDUTemplate_setBitstring32(CS101_ASDUTemplate self, int index, uint32_t value, QualityDescriptor quality);
+
+/**
+ * \brief Update value and quality of a normalized measured value (M_ME_NA_1, M_ME_TA_1, M_ME_TD_1, M_ME_ND_1)
+ *
+ * For M_ME_ND_1 the quality parameter is ignored.
+ *
+ * \param value the normalized value (range -1.0 ... 1.0)
+ */
+bool
+CS101_ASDUTemplate_setNormalizedValue(CS101_ASDUTemplate self, int index, float value, QualityDescriptor quality);
+
+/**
+ * \brief Update value and quality of a scaled measured value (M_ME_NB_1, M_ME_TB_1, M_ME_TE_1)
+ */
+bool
+CS101_ASDUTemplate_setScaledValue(CS101_ASDUTemplate self, int index, int value, QualityDescriptor quality);
+
+/**
+ * \brief Update value and quality of a short floating point measured value (M_ME_NC_1, M_ME_TC_1, M_ME_TF_1)
+ */
+bool
+CS101_ASDUTemplate_setShortValue(CS101_ASDUTemplate self, int index, float value, QualityDescriptor quality);
+
+/**
+ * \brief Update the binary counter reading of an integrated totals element (M_IT_NA_1, M_IT_TA_1, M_IT_TB_1)
+ */
+bool
+CS101_ASDUTemplate_setIntegratedTotals(CS101_ASDUTemplate self, int index, const BinaryCounterReading value);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_ASDU_TEMPLATE_H_ */
@@ -0,0 +1,237 @@
+/*
+ *  cs101_change_detector.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS101_CHANGE_DETECTOR_H_
+#define SRC_INC_API_CS101_CHANGE_DETECTOR_H_
+
+/**
+ * \file cs101_change_detector.h
+ * \brief Deadband and change detection on top of the process image that creates spontaneous events
+ */
+
+#include "iec60870_common.h"
+#include "cs101_process_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SLAVE Slave related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CHANGE_DETECTOR Change detector (deadbands and spontaneous events)
+ *
+ * The change detector receives new samples of the points of a process image (usually all samples
+ * of a scan cycle at once), updates the process image, and creates spontaneous events for
+ *
+ * - status points (single and double points) when the value changes
+ * - measured values when the deviation from the last reported value exceeds the deadband
+ * - all points when the quality changes
+ *
+ * The first sample of a point only sets the reference value and quality, it doesn't create an event.
+ *
+ * The events are collected in ASDUs with multiple information objects (one ASDU per type ID and CA).
+ * The ASDUs are passed to the event handler, usually to put them in the event queue of the slave
+ * (e.g. with \ref CS104_Slave_enqueueASDU). The change detector doesn't use locks; the update functions
+ * of an instance have to be called by one thread at a time.
+ *
+ * @{
+ */
+
+typedef struct sCS101_ChangeDetector* CS101_ChangeDetector;
+
+/**
+ * \brief Deadband types for measured values
+ */
+typedef enum {
+    CS101_DEADBAND_NONE = 0, /**< every change of the value is reported */
+    CS101_DEADBAND_ABSOLUTE = 1, /**< report when the absolute deviation from the last reported value exceeds the deadband */
+    CS101_DEADBAND_INTEGRATED = 2 /**< report when the integral of the deviation over time (value * s) exceeds the deadband */
+} CS101_DeadbandType;
+
+/**
+ * \brief Handler that is called for each ASDU with events
+ *
+ * The ASDU is only valid during the call of the handler.
+ *
+ * \param parameter user provided parameter
+ * \param asdu ASDU with one or more events (COT = spontaneous)
+ */
+typedef void (*CS101_ChangeDetector_EventHandler) (void* parameter, CS101_ASDU asdu);
+
+/**
+ * \brief Create a new change detector for a process image
+ *
+ * All memory is allocated at once for the maximum number of points of the process image.
+ *
+ * \param processImage the process image that is updated with the new samples
+ * \param parameters the application layer parameters used to create the event ASDUs
+ *
+ * \return the new instance or NULL when the memory cannot be allocated
+ */
+CS101_ChangeDetector
+CS101_ChangeDetector_create(CS101_ProcessImage processImage, CS101_AppLayerParameters parameters);
+
+/**
+ * \brief Release all resources of the change detector (the process image is not released)
+ */
+void
+CS101_ChangeDetector_destroy(CS101_ChangeDetector self);
+
+/**
+ * \brief Set the handler that receives the ASDUs with the events
+ */
+void
+CS101_ChangeDetector_setEventHandler(CS101_ChangeDetector self, CS101_ChangeDetector_EventHandler handler, void* parameter);
+
+/**
+ * \brief Set the originator address (OA) of the event ASDUs (default is 0)
+ */
+void
+CS101_ChangeDetector_setOriginatorAddress(CS101_ChangeDetector self, int oa);
+
+/**
+ * \brief Set the type ID used to report events of a point
+ *
+ * By default the type of the point is used. This can be used to report events with time tag
+ * (e.g. M_ME_TF_1) for a point that is sent without time tag (e.g. M_ME_NC_1) in interrogation responses.
+ *
+ * \param index the point index
+ * \param typeId the type ID for events - has to be a type with the same kind of value
+ *
+ * \return true on success, false when the index is invalid or the type is not compatible
+ */
+bool
+CS101_ChangeDetector_setEventType(CS101_ChangeDetector self, int index, TypeID typeId);
+
+/**
+ * \brief Set an absolute or integrated deadband for a measured value
+ *
+ * \param index the point index
+ * \param type the deadband type
+ * \param deadband the deadband (in units of the value, or value * s for the integrated deadband)
+ *
+ * \return true on success, false when the index is invalid
+ */
+bool
+CS101_ChangeDetector_setDeadband(CS101_ChangeDetector self, int index, CS101_DeadbandType type, float deadband);
+
+/**
+ * \brief Set a deadband in percent of the measurement range (converted to an absolute deadband)
+ *
+ * \param index the point index
+ * \param percent the deadband in percent of the range
+ * \param rangeMin the lower limit of the measurement range
+ * \param rangeMax the upper limit of the measurement range
+ *
+ * \return true on success, false when the index is invalid
+ */
+bool
+CS101_ChangeDetector_setPercentDeadband(CS101_ChangeDetector self, int index, float percent, float rangeMin, float rangeMax);
+
+/**
+ * \brief Process new samples of normalized or short floating point measured values
+ *
+ * \param indices the point indices
+ * \param values the new values
+ * \param qualities the new qualities, or NULL when all values have good quality
+ * \param count number of samples
+ * \param timestamp the time of the samples in ms since epoch, or 0 to use the current time
+ *
+ * \return the number of created events
+ */
+int
+CS101_ChangeDetector_updateFloatValues(CS101_ChangeDetector self, const int* indices, const float* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp);
+
+/**
+ * \brief Process new samples of scaled measured values (see \ref CS101_ChangeDetector_updateFloatValues)
+ */
+int
+CS101_ChangeDetector_updateScaledValues(CS101_ChangeDetector self, const int* indices, const int* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp);
+
+/**
+ * \brief Process new samples of single points (see \ref CS101_ChangeDetector_updateFloatValues)
+ */
+int
+CS101_ChangeDetector_updateSinglePoints(CS101_ChangeDetector self, const int* indices, const bool* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp);
+
+/**
+ * \brief Process new samples of double points (see \ref CS101_ChangeDetector_updateFloatValues)
+ */
+int
+CS101_ChangeDetector_updateDoublePoints(CS101_ChangeDetector self, const int* indices, const DoublePointValue* values,
+        const QualityDescriptor* qualities, int count, uint64_t timestamp);
+
+/**
+ * \brief Set or clear quality flags of all points in an IOA range and create the events
+ *
+ * This is used to mark many points at once (e.g. invalid when a field bus segment fails). An event is created for
+ * each point with changed quality. The events are packed into ASDUs with multiple information objects.
+ * See \ref CS101_ProcessImage_setQualityFlags.
+ *
+ * \param ca the CA of the points, or -1 for all CAs
+ * \param firstIoa the first IOA of the range
+ * \param lastIoa the last IOA of the range
+ * \param flags the quality flags (e.g. IEC60870_QUALITY_INVALID)
+ * \param set true to set the flags, false to clear the flags
+ * \param timestamp the time of the change in ms since epoch, or 0 to use the current time
+ *
+ * \return the number of created events
+ */
+int
+CS101_ChangeDetector_setQualityFlags(CS101_ChangeDetector self, int ca, int firstIoa, int lastIoa, QualityDescriptor flags,
+        bool set, uint64_t timestamp);
+
+/**
+ * \brief Set or clear quality flags of all points of an interrogation group and create the events
+ * (see \ref CS101_ChangeDetector_setQualityFlags)
+ *
+ * \param ca the CA of the points, or -1 for all CAs
+ * \param group the interrogation group (0 = station, 1 ... 16)
+ *
+ * \return the number of created events
+ */
+int
+CS101_ChangeDetector_setQualityFlagsOfGroup(CS101_ChangeDetector self, int ca, int group, QualityDescriptor flags,
+        bool set, uint64_t timestamp);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_CHANGE_DETECTOR_H_ */
@@ -0,0 +1,184 @@
+/*
+ *  cs101_command_tracker.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS101_COMMAND_TRACKER_H_
+#define SRC_INC_API_CS101_COMMAND_TRACKER_H_
+
+/**
+ * \file cs101_command_tracker.h
+ * \brief Master side tracking of the confirmations and terminations of commands
+ */
+
+#include "iec60870_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MASTER Master related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup COMMAND_TRACKER Command tracker (matching of ACT_CON and ACT_TERM to sent commands)
+ *
+ * The command tracker stores the outstanding commands (and interrogations) of a master. A command is identified by
+ * type ID, CA, and IOA (IOA 0 for interrogations, clock synchronization, etc.). Received ASDUs with
+ * COT ACT_CON, DEACT_CON, ACT_TERM, or unknown type ID/COT/CA/IOA are matched to the command in constant time,
+ * and the handler of the command is called. A command is removed after its final event.
+ *
+ * Each command has a timeout for the complete procedure (confirmation and termination). The timeouts are
+ * handled by a timer wheel with a resolution of \ref CS101_COMMAND_TRACKER_TICK_INTERVAL ms.
+ *
+ * A tracker can be attached to a connection (\ref CS104_Connection_setCommandTracker,
+ * \ref CS101_Master_setCommandTracker). Otherwise the application has to call \ref CS101_CommandTracker_handleASDU
+ * for the received ASDUs and \ref CS101_CommandTracker_checkTimeouts periodically.
+ *
+ * Only one command per type ID, CA, and IOA can be outstanding. For select before operate the execute
+ * command is added after the select is confirmed.
+ *
+ * @{
+ */
+
+/** \brief resolution of the command timeouts in ms */
+#define CS101_COMMAND_TRACKER_TICK_INTERVAL 50
+
+typedef struct sCS101_CommandTracker* CS101_CommandTracker;
+
+/**
+ * \brief Events of a tracked command
+ */
+typedef enum {
+    CS101_COMMAND_EVENT_CONFIRMED = 0,  /**< positive ACT_CON or DEACT_CON. Final event when no ACT_TERM is expected */
+    CS101_COMMAND_EVENT_NEGATIVE = 1,   /**< negative ACT_CON or DEACT_CON (final event) */
+    CS101_COMMAND_EVENT_TERMINATED = 2, /**< ACT_TERM (final event) */
+    CS101_COMMAND_EVENT_REJECTED = 3,   /**< unknown type ID, COT, CA, or IOA (final event) */
+    CS101_COMMAND_EVENT_TIMEOUT = 4,    /**< no final event within the timeout (final event) */
+    CS101_COMMAND_EVENT_CANCELED = 5    /**< the connection was closed (final event) */
+} CS101_CommandEvent;
+
+/**
+ * \brief Handler for the events of a tracked command
+ *
+ * The handler is called without holding internal locks. It can add and send new commands (e.g. the execute
+ * command after the select command is confirmed).
+ *
+ * \param parameter user provided parameter of the command
+ * \param typeId the type ID of the command
+ * \param ca the CA of the command
+ * \param ioa the IOA of the command
+ * \param event the event
+ * \param asdu the received ASDU, or NULL for timeout and cancel. Only valid during the call.
+ */
+typedef void (*CS101_CommandHandler) (void* parameter, TypeID typeId, int ca, int ioa, CS101_CommandEvent event,
+        CS101_ASDU asdu);
+
+/**
+ * \brief Create a new command tracker
+ *
+ * \param maxCommands maximum number of outstanding commands
+ *
+ * \return the new instance or NULL when the memory cannot be allocated
+ */
+CS101_CommandTracker
+CS101_CommandTracker_create(int maxCommands);
+
+/**
+ * \brief Release all resources. The handlers of outstanding commands are not called.
+ */
+void
+CS101_CommandTracker_destroy(CS101_CommandTracker self);
+
+/**
+ * \brief Add a command before it is sent
+ *
+ * \param typeId the type ID of the command (e.g. C_SC_NA_1 or C_IC_NA_1)
+ * \param ca the CA of the command
+ * \param ioa the IOA of the command (0 for interrogation, counter interrogation, clock synchronization, ...)
+ * \param waitForTermination true when the command is complete with ACT_TERM, false when complete with ACT_CON
+ * \param timeoutInMs timeout for the complete command procedure in ms, or 0 for no timeout
+ * \param handler the handler for the events of the command
+ * \param parameter user provided parameter that is passed to the handler
+ *
+ * \return true when the command has been added, false when the same command is outstanding or the tracker is full
+ */
+bool
+CS101_CommandTracker_add(CS101_CommandTracker self, TypeID typeId, int ca, int ioa, bool waitForTermination,
+        int timeoutInMs, CS101_CommandHandler handler, void* parameter);
+
+/**
+ * \brief Remove an outstanding command without calling its handler (e.g. when the command could not be sent)
+ *
+ * \return true when the command has been removed, false when the command is not outstanding
+ */
+bool
+CS101_CommandTracker_remove(CS101_CommandTracker self, TypeID typeId, int ca, int ioa);
+
+/**
+ * \brief Match a received ASDU to an outstanding command and call the handler of the command
+ *
+ * \return true when the ASDU is a response to an outstanding command, false otherwise
+ */
+bool
+CS101_CommandTracker_handleASDU(CS101_CommandTracker self, CS101_ASDU asdu);
+
+/**
+ * \brief Handle the timeouts of the outstanding commands (has to be called periodically)
+ *
+ * The handlers are called without lock. They must not call \ref CS101_CommandTracker_checkTimeouts
+ * or \ref CS101_CommandTracker_cancelAll.
+ *
+ * \return the number of commands with elapsed timeout
+ */
+int
+CS101_CommandTracker_checkTimeouts(CS101_CommandTracker self);
+
+/**
+ * \brief Cancel all outstanding commands (the handlers are called with CS101_COMMAND_EVENT_CANCELED)
+ *
+ * The handlers must not call \ref CS101_CommandTracker_checkTimeouts or \ref CS101_CommandTracker_cancelAll.
+ */
+void
+CS101_CommandTracker_cancelAll(CS101_CommandTracker self);
+
+/**
+ * \brief Get the number of outstanding commands
+ */
+int
+CS101_CommandTracker_getNumberOfCommands(CS101_CommandTracker self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_COMMAND_TRACKER_H_ */
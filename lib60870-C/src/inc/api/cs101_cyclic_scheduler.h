@@ -0,0 +1,191 @@
+/*
+ *  cs101_cyclic_scheduler.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS101_CYCLIC_SCHEDULER_H_
+#define SRC_INC_API_CS101_CYCLIC_SCHEDULER_H_
+
+/**
+ * \file cs101_cyclic_scheduler.h
+ * \brief Scheduler for cyclic (periodic) and background scan transmission of process image points
+ */
+
+#include "iec60870_common.h"
+#include "cs101_process_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SLAVE Slave related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CYCLIC_SCHEDULER Cyclic and background scan transmission
+ *
+ * The scheduler sends groups of process image points with individual cycle times, with
+ * COT = periodic (CS101_COT_PERIODIC) or background scan (CS101_COT_BACKGROUND_SCAN).
+ *
+ * The ASDUs of a group are encoded once when the group is added (see \ref ASDU_TEMPLATE). At each cycle only the
+ * values, quality descriptors, and time tags are updated from the process image before the ASDUs are passed to the
+ * ASDU handler (usually to put them into the event queue of the slave, e.g. with \ref CS104_Slave_enqueueASDU).
+ *
+ * The groups are managed by a timer wheel with a resolution of \ref CS101_CYCLIC_SCHEDULER_TICK_INTERVAL ms,
+ * so that a single thread can handle thousands of groups. The first transmission of a group is delayed by a
+ * group specific offset within the cycle time, to distribute the transmissions of groups with the same cycle
+ * time over the cycle. When the scheduler cannot keep up (e.g. the thread was blocked), the missed cycles
+ * are skipped and reported as overruns.
+ *
+ * @{
+ */
+
+/** \brief resolution of the scheduler in ms */
+#define CS101_CYCLIC_SCHEDULER_TICK_INTERVAL 10
+
+typedef struct sCS101_CyclicScheduler* CS101_CyclicScheduler;
+
+/**
+ * \brief Handler that is called for each ASDU to send
+ *
+ * The ASDU is only valid during the call of the handler. Functions of the scheduler must not be called by the handler.
+ *
+ * \param parameter user provided parameter
+ * \param groupId the ID of the group
+ * \param asdu the ASDU
+ */
+typedef void (*CS101_CyclicScheduler_ASDUHandler) (void* parameter, int groupId, CS101_ASDU asdu);
+
+/**
+ * \brief Handler that is called when cycles of a group have been missed
+ *
+ * \param parameter user provided parameter
+ * \param groupId the ID of the group
+ * \param missedCycles number of missed cycles since the last transmission
+ */
+typedef void (*CS101_CyclicScheduler_OverrunHandler) (void* parameter, int groupId, int missedCycles);
+
+/**
+ * \brief Create a new scheduler
+ *
+ * \param processImage the process image with the points to send
+ * \param parameters the application layer parameters used to encode the ASDUs
+ * \param maxNumberOfGroups the maximum number of groups
+ *
+ * \return the new instance or NULL when the memory cannot be allocated
+ */
+CS101_CyclicScheduler
+CS101_CyclicScheduler_create(CS101_ProcessImage processImage, CS101_AppLayerParameters parameters, int maxNumberOfGroups);
+
+/**
+ * \brief Stop the scheduler thread (when running) and release all resources
+ */
+void
+CS101_CyclicScheduler_destroy(CS101_CyclicScheduler self);
+
+/**
+ * \brief Set the handler that receives the ASDUs to send
+ */
+void
+CS101_CyclicScheduler_setASDUHandler(CS101_CyclicScheduler self, CS101_CyclicScheduler_ASDUHandler handler, void* parameter);
+
+/**
+ * \brief Set the handler that is called when cycles have been missed
+ */
+void
+CS101_CyclicScheduler_setOverrunHandler(CS101_CyclicScheduler self, CS101_CyclicScheduler_OverrunHandler handler, void* parameter);
+
+/**
+ * \brief Set the originator address (OA) of the ASDUs of groups that are added later (default is 0)
+ */
+void
+CS101_CyclicScheduler_setOriginatorAddress(CS101_CyclicScheduler self, int oa);
+
+/**
+ * \brief Add a group of points
+ *
+ * The points are sent in the given order. A new ASDU is started when the type ID or the CA changes, or
+ * when the ASDU is full.
+ *
+ * \param pointIndices the point indices of the process image
+ * \param numberOfPoints the number of points
+ * \param cot CS101_COT_PERIODIC or CS101_COT_BACKGROUND_SCAN
+ * \param cycleTime the cycle time in ms (at least \ref CS101_CYCLIC_SCHEDULER_TICK_INTERVAL)
+ *
+ * \return the group ID, or -1 when the maximum number of groups is reached or the parameters are invalid
+ */
+int
+CS101_CyclicScheduler_addGroup(CS101_CyclicScheduler self, const int* pointIndices, int numberOfPoints,
+        CS101_CauseOfTransmission cot, int cycleTime);
+
+/**
+ * \brief Remove a group
+ *
+ * \return true on success, false when the group doesn't exist
+ */
+bool
+CS101_CyclicScheduler_removeGroup(CS101_CyclicScheduler self, int groupId);
+
+/**
+ * \brief Get the number of missed cycles of a group
+ */
+uint32_t
+CS101_CyclicScheduler_getOverrunCount(CS101_CyclicScheduler self, int groupId);
+
+/**
+ * \brief Send the ASDUs of all groups that are due
+ *
+ * Has to be called periodically (at least every \ref CS101_CYCLIC_SCHEDULER_TICK_INTERVAL ms) when the
+ * scheduler thread is not used.
+ */
+void
+CS101_CyclicScheduler_tick(CS101_CyclicScheduler self);
+
+/**
+ * \brief Start a thread that calls \ref CS101_CyclicScheduler_tick periodically
+ *
+ * NOTE: Only available when the library is compiled with thread support (CONFIG_USE_THREADS)
+ */
+void
+CS101_CyclicScheduler_start(CS101_CyclicScheduler self);
+
+/**
+ * \brief Stop the scheduler thread
+ */
+void
+CS101_CyclicScheduler_stop(CS101_CyclicScheduler self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_CYCLIC_SCHEDULER_H_ */
@@ -31,6 +31,8 @@
 #define SRC_INC_API_CS101_MASTER_H_
 
 #include "iec60870_master.h"
+#include "cs101_mirror.h"
+#include "cs101_command_tracker.h"
 #include "link_layer_parameters.h"
 
 #ifdef __cplusplus
@@ -301,6 +303,28 @@ CS101_Master_sendASDU(CS101_Master self, CS101_ASDU asdu);
 void
 CS101_Master_setASDUReceivedHandler(CS101_Master self, CS101_ASDUReceivedHandler handler, void* parameter);
 
+/**
+ * \brief Attach a mirror that is updated with the received monitoring ASDUs
+ *
+ * The mirror is updated before the ASDU received handler is called. The stale timeout of the
+ * stations is checked by \ref CS101_Master_run.
+ *
+ * \param mirror the mirror, or NULL to detach the mirror
+ */
+void
+CS101_Master_setMirror(CS101_Master self, CS101_Mirror mirror);
+
+/**
+ * \brief Attach a command tracker that is updated with the received confirmations and terminations
+ *
+ * The tracker is updated after the ASDU received handler is called. The timeouts of the tracker
+ * are checked by \ref CS101_Master_run.
+ *
+ * \param tracker the command tracker, or NULL to detach the tracker
+ */
+void
+CS101_Master_setCommandTracker(CS101_Master self, CS101_CommandTracker tracker);
+
 /**
  * \brief Set a callback handler for link layer state changes
  */
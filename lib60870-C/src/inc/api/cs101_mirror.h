@@ -0,0 +1,210 @@
+/*
+ *  cs101_mirror.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS101_MIRROR_H_
+#define SRC_INC_API_CS101_MIRROR_H_
+
+/**
+ * \file cs101_mirror.h
+ * \brief Master side mirror of the process image of the outstations
+ */
+
+#include "iec60870_common.h"
+#include "cs101_process_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MASTER Master related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup MIRROR Mirror of the outstation data (master side process image)
+ *
+ * The mirror decodes received monitoring ASDUs (single points, double points, step positions,
+ * bitstrings, measured values, and integrated totals) into a process image that is indexed by
+ * (CA, IOA). A point is added when it is received for the first time. The type of the first received
+ * information object is the type of the point.
+ *
+ * The mirror is updated by the thread that receives the ASDUs (see \ref CS104_Connection_setMirror and
+ * \ref CS101_Master_setMirror). Other threads (e.g. HMI or historian) can read the points at the same
+ * time without locks:
+ *
+ * - \ref CS101_Mirror_lookup finds the index of a point
+ * - the getters of the process image (\ref CS101_Mirror_getProcessImage) return the state of a point.
+ *   \ref CS101_ProcessImage_getInformationObject returns value, quality, and time of the same update.
+ *
+ * Changes of values and qualities are reported in batches (one call per received ASDU). The mirror
+ * also keeps the time of the last update of each station (CA). A station is stale when there was no
+ * update within the stale timeout, or when the connection that updated it last is lost.
+ *
+ * A mirror can be attached to several connections (e.g. redundant connections). Updates of the
+ * connections are serialized by the mirror.
+ *
+ * Decoding doesn't allocate memory. All memory is allocated when the mirror is created.
+ *
+ * @{
+ */
+
+typedef struct sCS101_Mirror* CS101_Mirror;
+
+/**
+ * \brief Handler for changed points
+ *
+ * The handler is called by the receiving thread after the points of an ASDU have been updated. No lock
+ * is held during the call.
+ *
+ * \param parameter user provided parameter
+ * \param mirror the mirror
+ * \param indices indices of the points with changed value or quality (or new points). Only valid during the call.
+ * \param numberOfIndices number of changed points
+ */
+typedef void (*CS101_MirrorChangeHandler) (void* parameter, CS101_Mirror mirror, const int* indices, int numberOfIndices);
+
+/**
+ * \brief Handler for changes of the state of a station
+ *
+ * \param parameter user provided parameter
+ * \param mirror the mirror
+ * \param ca the common address of the station
+ * \param isStale true when the station became stale, false when it has been updated again (or for the first time)
+ */
+typedef void (*CS101_MirrorStationHandler) (void* parameter, CS101_Mirror mirror, int ca, bool isStale);
+
+/**
+ * \brief Create a new mirror
+ *
+ * \param maxNumberOfPoints the maximum number of points - points received when the mirror is full are ignored
+ * \param maxNumberOfStations the maximum number of stations (CAs) with staleness tracking
+ *
+ * \return the new instance or NULL when the memory cannot be allocated
+ */
+CS101_Mirror
+CS101_Mirror_create(int maxNumberOfPoints, int maxNumberOfStations);
+
+/**
+ * \brief Release all resources of the mirror
+ *
+ * The mirror has to be detached from all connections before.
+ */
+void
+CS101_Mirror_destroy(CS101_Mirror self);
+
+/**
+ * \brief Get the process image with the mirrored points
+ *
+ * The process image must not be updated by the application. Use \ref CS101_Mirror_lookup instead
+ * of \ref CS101_ProcessImage_lookup when the mirror is updated concurrently.
+ */
+CS101_ProcessImage
+CS101_Mirror_getProcessImage(CS101_Mirror self);
+
+/**
+ * \brief Find the index of a point (can be called while points are added)
+ *
+ * \return the point index or -1 when the point has not been received yet
+ */
+int
+CS101_Mirror_lookup(CS101_Mirror self, int ca, int ioa);
+
+/**
+ * \brief Set the handler for changed points
+ */
+void
+CS101_Mirror_setChangeHandler(CS101_Mirror self, CS101_MirrorChangeHandler handler, void* parameter);
+
+/**
+ * \brief Set the handler for changes of the station state
+ */
+void
+CS101_Mirror_setStationHandler(CS101_Mirror self, CS101_MirrorStationHandler handler, void* parameter);
+
+/**
+ * \brief Set the time after which a station without updates is stale
+ *
+ * \param timeoutInMs the timeout in ms or 0 to disable the timeout (default)
+ */
+void
+CS101_Mirror_setStaleTimeout(CS101_Mirror self, int timeoutInMs);
+
+/**
+ * \brief Update the mirror with a received ASDU
+ *
+ * This function is called by the connections the mirror is attached to. It can also be called from
+ * an ASDU received handler. The station of the ASDU is not associated with a connection (it only
+ * becomes stale by the stale timeout or \ref CS101_Mirror_setStationsStale).
+ *
+ * \return true when the ASDU contains monitoring data that has been mirrored, false otherwise
+ */
+bool
+CS101_Mirror_handleASDU(CS101_Mirror self, CS101_ASDU asdu);
+
+/**
+ * \brief Check for stations without updates within the stale timeout
+ *
+ * This function is called periodically by the connection the mirror is attached to.
+ *
+ * \param currentTime the current time in ms since epoch
+ */
+void
+CS101_Mirror_checkStations(CS101_Mirror self, uint64_t currentTime);
+
+/**
+ * \brief Mark all stations as stale (e.g. when the connection is lost)
+ */
+void
+CS101_Mirror_setStationsStale(CS101_Mirror self);
+
+/**
+ * \brief Check if a station is stale
+ *
+ * \return true when the station is stale or has not been updated yet
+ */
+bool
+CS101_Mirror_isStationStale(CS101_Mirror self, int ca);
+
+/**
+ * \brief Get the time of the last update of a station
+ *
+ * \return the time in ms since epoch or 0 when the station has not been updated yet
+ */
+uint64_t
+CS101_Mirror_getLastUpdateTime(CS101_Mirror self, int ca);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_MIRROR_H_ */
@@ -0,0 +1,500 @@
+/*
+ *  cs101_process_image.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS101_PROCESS_IMAGE_H_
+#define SRC_INC_API_CS101_PROCESS_IMAGE_H_
+
+/**
+ * \file cs101_process_image.h
+ * \brief Process image (point database) of a slave indexed by common address (CA) and information object address (IOA)
+ */
+
+#include <stddef.h>
+
+#include "iec60870_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup SLAVE Slave related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup PROCESS_IMAGE Process image (point database)
+ *
+ * The process image stores the current state (value, quality, and time of the last update) of the
+ * monitoring points of a slave. The points are identified by CA and IOA. Each point is added once
+ * and gets a point index that is used by the update and read functions. The point index can also be
+ * found with \ref CS101_ProcessImage_lookup.
+ *
+ * The state of the points is stored in separate arrays per attribute (structure of arrays) to keep
+ * the memory access of bulk updates and of interrogations local.
+ *
+ * Supported point types (the type is used when a point is sent as response to an interrogation or read command):
+ *
+ * - M_SP_NA_1, M_SP_TB_1 (single point)
+ * - M_DP_NA_1, M_DP_TB_1 (double point)
+ * - M_ST_NA_1, M_ST_TB_1 (step position)
+ * - M_BO_NA_1, M_BO_TB_1 (bitstring of 32 bit)
+ * - M_ME_NA_1, M_ME_TD_1, M_ME_ND_1 (normalized measured value)
+ * - M_ME_NB_1, M_ME_TE_1 (scaled measured value)
+ * - M_ME_NC_1, M_ME_TF_1 (short floating point measured value)
+ * - M_IT_NA_1, M_IT_TB_1 (integrated totals)
+ *
+ * Points can be assigned to the interrogation groups 1 to 16 (QOI 21 to 36). Group 0 represents the
+ * station interrogation (QOI 20). New points are members of the station interrogation, except
+ * integrated totals that are only reported by counter interrogation.
+ *
+ * Integrated totals can be frozen (\ref CS101_ProcessImage_freezeCounters). The frozen state is double
+ * buffered: a freeze writes the running value into the inactive buffer of each counter and then switches
+ * the buffer index. The frozen values (used to answer counter interrogation requests) can therefore be read
+ * without locks while the application keeps updating the running values. Integrated totals can be assigned
+ * to the counter groups 1 to 4 (RQT 1 to 4).
+ *
+ * Optionally the process image keeps a history of the last changes of each point (\ref CS101_ProcessImage_enableHistory).
+ * The history is a ring buffer per point with a fixed number of entries (time, value, and quality). The entries
+ * of all points are stored in one memory block that is allocated at once.
+ *
+ * @{
+ */
+
+/** \brief highest interrogation group number (group 1 ... 16 is requested with QOI 21 ... 36) */
+#define CS101_PROCESS_IMAGE_MAX_GROUP 16
+
+/** \brief highest counter group number (group 1 ... 4 is requested with RQT 1 ... 4) */
+#define CS101_PROCESS_IMAGE_MAX_COUNTER_GROUP 4
+
+typedef struct sCS101_ProcessImage* CS101_ProcessImage;
+
+/**
+ * \brief Create a new process image
+ *
+ * \param maxNumberOfPoints the maximum number of points (memory is allocated at once)
+ *
+ * \return the new instance or NULL when the memory cannot be allocated
+ */
+CS101_ProcessImage
+CS101_ProcessImage_create(int maxNumberOfPoints);
+
+/**
+ * \brief Release all resources of the process image
+ */
+void
+CS101_ProcessImage_destroy(CS101_ProcessImage self);
+
+/**
+ * \brief Add a new point
+ *
+ * The initial value is 0/off with quality IEC60870_QUALITY_INVALID and timestamp 0.
+ *
+ * \param ca the common address of the point
+ * \param ioa the information object address of the point
+ * \param typeId the type used to send the point (see list of supported point types)
+ *
+ * \return the point index, or -1 when the process image is full, the point already exists, or the type is not supported
+ */
+int
+CS101_ProcessImage_addPoint(CS101_ProcessImage self, int ca, int ioa, TypeID typeId);
+
+/**
+ * \brief Get the number of points
+ */
+int
+CS101_ProcessImage_getNumberOfPoints(CS101_ProcessImage self);
+
+/**
+ * \brief Find the point index of a point
+ *
+ * \return the point index or -1 when the point doesn't exist
+ */
+int
+CS101_ProcessImage_lookup(CS101_ProcessImage self, int ca, int ioa);
+
+/**
+ * \brief Get the common address (CA) of a point
+ */
+int
+CS101_ProcessImage_getCA(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the information object address (IOA) of a point
+ */
+int
+CS101_ProcessImage_getIOA(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the type ID of a point
+ */
+TypeID
+CS101_ProcessImage_getTypeID(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the quality of a point (for integrated totals the quality is derived from the invalid flag)
+ */
+QualityDescriptor
+CS101_ProcessImage_getQuality(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the time of the last update of a point
+ *
+ * \return the time in ms since epoch
+ */
+uint64_t
+CS101_ProcessImage_getTimestamp(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Add a point to an interrogation group
+ *
+ * \param index the point index
+ * \param group the interrogation group (1 ... 16), or 0 for the station interrogation
+ *
+ * \return true on success, false when the index or group is invalid
+ */
+bool
+CS101_ProcessImage_addToGroup(CS101_ProcessImage self, int index, int group);
+
+/**
+ * \brief Remove a point from an interrogation group
+ *
+ * \param index the point index
+ * \param group the interrogation group (1 ... 16), or 0 for the station interrogation
+ *
+ * \return true on success, false when the index or group is invalid
+ */
+bool
+CS101_ProcessImage_removeFromGroup(CS101_ProcessImage self, int index, int group);
+
+/**
+ * \brief Check if a point is member of an interrogation group
+ *
+ * \param index the point index
+ * \param group the interrogation group (1 ... 16), or 0 for the station interrogation
+ */
+bool
+CS101_ProcessImage_isInGroup(CS101_ProcessImage self, int index, int group);
+
+/**
+ * \brief Add integrated totals to a counter group
+ *
+ * \param index the point index (has to be integrated totals)
+ * \param group the counter group (1 ... 4)
+ *
+ * \return true on success, false when the index or group is invalid
+ */
+bool
+CS101_ProcessImage_addToCounterGroup(CS101_ProcessImage self, int index, int group);
+
+/**
+ * \brief Remove integrated totals from a counter group
+ *
+ * \param index the point index (has to be integrated totals)
+ * \param group the counter group (1 ... 4)
+ *
+ * \return true on success, false when the index or group is invalid
+ */
+bool
+CS101_ProcessImage_removeFromCounterGroup(CS101_ProcessImage self, int index, int group);
+
+/**
+ * \brief Freeze the integrated totals of a counter group
+ *
+ * The running values are copied into the inactive frozen buffer of each counter, then the buffer index is
+ * switched. The sequence number of the frozen binary counter reading is incremented with each freeze.
+ *
+ * When reset is true the running values are reset after the freeze. The reset is applied as an offset to the
+ * values provided by the application (\ref CS101_ProcessImage_updateIntegratedTotals), so the application can
+ * continue to provide the absolute counter values.
+ *
+ * \param ca the CA of the counters, or -1 for the counters of all CAs
+ * \param group the counter group (1 ... 4), or 0 for all counters (general request)
+ * \param reset reset the running values after the freeze
+ * \param timestamp the time of the freeze in ms since epoch, or 0 to use the current time
+ *
+ * \return the number of frozen counters
+ */
+int
+CS101_ProcessImage_freezeCounters(CS101_ProcessImage self, int ca, int group, bool reset, uint64_t timestamp);
+
+/**
+ * \brief Reset the running values of the integrated totals of a counter group (without freeze)
+ *
+ * \param ca the CA of the counters, or -1 for the counters of all CAs
+ * \param group the counter group (1 ... 4), or 0 for all counters (general request)
+ *
+ * \return the number of counters that have been reset
+ */
+int
+CS101_ProcessImage_resetCounters(CS101_ProcessImage self, int ca, int group);
+
+/**
+ * \brief Update the value of a single point
+ *
+ * The update functions store the value, the quality, and the time of the update. They don't allocate memory
+ * and don't use locks.
+ *
+ * \param index the point index
+ * \param value the new value
+ * \param quality the new quality
+ * \param timestamp the time of the update in ms since epoch, or 0 to use the current time
+ *
+ * \return true on success, false when the index is invalid or the point has another type
+ */
+bool
+CS101_ProcessImage_updateSinglePoint(CS101_ProcessImage self, int index, bool value, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the value of a double point (see \ref CS101_ProcessImage_updateSinglePoint)
+ */
+bool
+CS101_ProcessImage_updateDoublePoint(CS101_ProcessImage self, int index, DoublePointValue value, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the value of a step position (see \ref CS101_ProcessImage_updateSinglePoint)
+ *
+ * \param value the step position (range -64 ... 63)
+ */
+bool
+CS101_ProcessImage_updateStepPosition(CS101_ProcessImage self, int index, int value, bool isTransient, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the value of a bitstring of 32 bit (see \ref CS101_ProcessImage_updateSinglePoint)
+ */
+bool
+CS101_ProcessImage_updateBitstring32(CS101_ProcessImage self, int index, uint32_t value, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the value of a normalized measured value (see \ref CS101_ProcessImage_updateSinglePoint)
+ *
+ * \param value the normalized value (range -1.0 ... 1.0)
+ */
+bool
+CS101_ProcessImage_updateNormalizedValue(CS101_ProcessImage self, int index, float value, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the value of a scaled measured value (see \ref CS101_ProcessImage_updateSinglePoint)
+ */
+bool
+CS101_ProcessImage_updateScaledValue(CS101_ProcessImage self, int index, int value, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the value of a short floating point measured value (see \ref CS101_ProcessImage_updateSinglePoint)
+ */
+bool
+CS101_ProcessImage_updateShortValue(CS101_ProcessImage self, int index, float value, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the binary counter reading of integrated totals (see \ref CS101_ProcessImage_updateSinglePoint)
+ */
+bool
+CS101_ProcessImage_updateIntegratedTotals(CS101_ProcessImage self, int index, const BinaryCounterReading value, uint64_t timestamp);
+
+/**
+ * \brief Update only the quality of a point (e.g. when the connection to the data source is lost)
+ *
+ * For integrated totals the invalid flag of the binary counter reading is set according to the quality.
+ *
+ * \param timestamp the time of the update in ms since epoch, or 0 to use the current time
+ */
+bool
+CS101_ProcessImage_updateQuality(CS101_ProcessImage self, int index, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Set or clear quality flags of all points in an IOA range (e.g. when a field bus segment fails or recovers)
+ *
+ * Only the quality flags given by the parameter flags are changed, the other flags of the points are kept.
+ * For integrated totals only the invalid flag is used. The timestamp of the points with changed quality is updated.
+ * Use \ref CS101_ChangeDetector_setQualityFlags to also create the events.
+ *
+ * \param ca the CA of the points, or -1 for all CAs
+ * \param firstIoa the first IOA of the range
+ * \param lastIoa the last IOA of the range
+ * \param flags the quality flags (e.g. IEC60870_QUALITY_INVALID | IEC60870_QUALITY_NON_TOPICAL)
+ * \param set true to set the flags, false to clear the flags
+ * \param timestamp the time of the update in ms since epoch, or 0 to use the current time
+ *
+ * \return the number of points with changed quality
+ */
+int
+CS101_ProcessImage_setQualityFlags(CS101_ProcessImage self, int ca, int firstIoa, int lastIoa, QualityDescriptor flags,
+        bool set, uint64_t timestamp);
+
+/**
+ * \brief Set or clear quality flags of all points of an interrogation group (see \ref CS101_ProcessImage_setQualityFlags)
+ *
+ * \param ca the CA of the points, or -1 for all CAs
+ * \param group the interrogation group (0 = station, 1 ... 16)
+ *
+ * \return the number of points with changed quality
+ */
+int
+CS101_ProcessImage_setQualityFlagsOfGroup(CS101_ProcessImage self, int ca, int group, QualityDescriptor flags,
+        bool set, uint64_t timestamp);
+
+/**
+ * \brief Get the value of a single point
+ */
+bool
+CS101_ProcessImage_getSinglePointValue(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the value of a double point
+ */
+DoublePointValue
+CS101_ProcessImage_getDoublePointValue(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the value of a step position
+ *
+ * \param[out] isTransient when not NULL the transient flag is stored here
+ */
+int
+CS101_ProcessImage_getStepPositionValue(CS101_ProcessImage self, int index, bool* isTransient);
+
+/**
+ * \brief Get the value of a bitstring of 32 bit
+ */
+uint32_t
+CS101_ProcessImage_getBitstring32Value(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the value of a normalized or short floating point measured value
+ */
+float
+CS101_ProcessImage_getFloatValue(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the value of a scaled measured value
+ */
+int
+CS101_ProcessImage_getScaledValue(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get the binary counter reading of integrated totals
+ *
+ * The value is the last value provided by the application minus the value at the last reset.
+ *
+ * \param[out] value the binary counter reading
+ */
+bool
+CS101_ProcessImage_getIntegratedTotals(CS101_ProcessImage self, int index, BinaryCounterReading value);
+
+/**
+ * \brief Get the binary counter reading of integrated totals at the last freeze
+ *
+ * Before the first freeze the invalid flag of the reading is set.
+ *
+ * \param[out] value the frozen binary counter reading
+ * \param[out] timestamp when not NULL the time of the freeze is stored here
+ */
+bool
+CS101_ProcessImage_getFrozenIntegratedTotals(CS101_ProcessImage self, int index, BinaryCounterReading value, uint64_t* timestamp);
+
+/**
+ * \brief Create an information object with the current state of a point
+ *
+ * \param index the point index
+ * \param io memory to store the information object (at least \ref InformationObject_getMaxSizeInMemory bytes), or NULL to allocate a new object
+ *
+ * \return the information object (of the type of the point), or NULL when the index is invalid
+ */
+InformationObject
+CS101_ProcessImage_getInformationObject(CS101_ProcessImage self, int index, InformationObject io);
+
+/**
+ * \brief Add the current state of a point to an ASDU
+ *
+ * The type of the ASDU has to match the type of the point (or the ASDU has to be empty). This can
+ * be used to build responses to interrogation and read commands. The function doesn't allocate memory.
+ *
+ * \return true when the information object has been added, false otherwise (e.g. the ASDU is full)
+ */
+bool
+CS101_ProcessImage_addToASDU(CS101_ProcessImage self, int index, CS101_ASDU asdu);
+
+/**
+ * \brief Get the size of the memory that is required for the history of a process image
+ *
+ * \param maxNumberOfPoints the maximum number of points of the process image
+ * \param depth the number of history entries per point
+ *
+ * \return the size of the history memory block in bytes
+ */
+size_t
+CS101_ProcessImage_getHistoryMemorySize(int maxNumberOfPoints, int depth);
+
+/**
+ * \brief Keep a history of the last changes of each point
+ *
+ * A change of the value or of the quality of a point is recorded in the history of the point. When the
+ * history of a point is full the oldest entry is overwritten. The memory for all points is allocated at once
+ * (see \ref CS101_ProcessImage_getHistoryMemorySize).
+ *
+ * NOTE: Has to be called before the points are updated. The history can only be enabled once.
+ *
+ * \param depth the number of history entries per point (1 ... 65535)
+ *
+ * \return true on success, false when the memory cannot be allocated or the history is already enabled
+ */
+bool
+CS101_ProcessImage_enableHistory(CS101_ProcessImage self, int depth);
+
+/**
+ * \brief Get the number of entries in the history of a point
+ *
+ * \return the number of entries (at most the history depth), or 0 when the history is not enabled
+ */
+int
+CS101_ProcessImage_getHistoryLength(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Get an entry of the history of a point
+ *
+ * The entry is returned as information object with time tag (e.g. M_ME_TF_1 for a M_ME_NC_1 point).
+ * The function can be called while the point is updated.
+ *
+ * \param index the point index
+ * \param entry the entry number (0 = newest change, 1 = change before the newest change, ...)
+ * \param io memory to store the information object (at least \ref InformationObject_getMaxSizeInMemory bytes), or NULL to allocate a new object
+ *
+ * \return the information object, or NULL when the entry doesn't exist
+ */
+InformationObject
+CS101_ProcessImage_getHistoryInformationObject(CS101_ProcessImage self, int index, int entry, InformationObject io);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS101_PROCESS_IMAGE_H_ */
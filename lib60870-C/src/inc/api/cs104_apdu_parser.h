@@ -0,0 +1,137 @@
+/*
+ *  cs104_apdu_parser.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS104_APDU_PARSER_H_
+#define SRC_INC_API_CS104_APDU_PARSER_H_
+
+/**
+ * \file cs104_apdu_parser.h
+ * \brief Incremental parser for the CS 104 APDU framing (APCI)
+ */
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup CS104_APDU_PARSER CS 104 APDU parser
+ *
+ * The parser splits a byte stream into CS 104 APDUs. The data can be provided in chunks of
+ * arbitrary size (e.g. as returned by a socket or TLS read, or from a capture file). The parser
+ * doesn't allocate memory and doesn't depend on the socket layer.
+ *
+ * @{
+ */
+
+/** \brief maximum size of an APDU (start byte, length byte, and 255 bytes) */
+#define CS104_APDU_PARSER_MAX_APDU_SIZE 257
+
+typedef enum {
+    CS104_APDU_FORMAT_I = 0, /**< I format (information transfer) */
+    CS104_APDU_FORMAT_S = 1, /**< S format (numbered supervisory function) */
+    CS104_APDU_FORMAT_U = 2  /**< U format (unnumbered control function) */
+} CS104_APDUFormat;
+
+typedef enum {
+    CS104_APDU_PARSER_ERROR = -1,         /**< invalid start byte or length - the stream cannot be synchronized again */
+    CS104_APDU_PARSER_NEED_MORE_DATA = 0, /**< all provided bytes are consumed, no complete APDU available */
+    CS104_APDU_PARSER_APDU_COMPLETE = 1   /**< a complete APDU is available */
+} CS104_APDUParserResult;
+
+/**
+ * \brief A complete APDU as returned by the parser
+ */
+typedef struct {
+    CS104_APDUFormat format;
+
+    uint8_t* apdu; /**< the complete APDU (including start and length byte) */
+    int apduSize;
+
+    int sendSequenceNumber;    /**< N(S) (only I format) */
+    int receiveSequenceNumber; /**< N(R) (I and S format) */
+
+    uint8_t controlField;      /**< first byte of the control field (function of U format APDUs, e.g. 0x07 for STARTDT act) */
+
+    uint8_t* asdu;             /**< the ASDU (only I format) */
+    int asduSize;
+} sCS104_APDU;
+
+typedef sCS104_APDU* CS104_APDU;
+
+/**
+ * \brief Parser state. Can be allocated statically or as part of another structure.
+ */
+typedef struct {
+    uint8_t buffer[CS104_APDU_PARSER_MAX_APDU_SIZE];
+    int bufPos;
+} sCS104_APDUParser;
+
+typedef sCS104_APDUParser* CS104_APDUParser;
+
+/**
+ * \brief Initialize (or reset) a parser instance
+ */
+void
+CS104_APDUParser_initialize(CS104_APDUParser self);
+
+/**
+ * \brief Check if the parser holds the beginning of an incomplete APDU
+ */
+bool
+CS104_APDUParser_hasPartialAPDU(CS104_APDUParser self);
+
+/**
+ * \brief Parse the next APDU from a chunk of data
+ *
+ * The function consumes bytes until an APDU is complete, an error is detected, or all data is consumed.
+ * When the chunk contains more than one APDU the function has to be called again with the remaining bytes.
+ *
+ * When the complete APDU is contained in the chunk the APDU references the provided data (no copy). Otherwise
+ * it references the internal buffer of the parser. In both cases the APDU is only valid until the next call of
+ * the function.
+ *
+ * After an error the parser is reset. The connection should be closed because the start of the
+ * next APDU cannot be determined.
+ *
+ * \param data the received data
+ * \param dataSize number of bytes in data
+ * \param[out] bytesConsumed number of bytes of data consumed by the parser
+ * \param[out] apdu the decoded APDU (only valid when CS104_APDU_PARSER_APDU_COMPLETE is returned)
+ *
+ * \return the parser result
+ */
+CS104_APDUParserResult
+CS104_APDUParser_parse(CS104_APDUParser self, uint8_t* data, int dataSize, int* bytesConsumed, CS104_APDU apdu);
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS104_APDU_PARSER_H_ */
@@ -0,0 +1,137 @@
+/*
+ *  cs104_client_engine.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS104_CLIENT_ENGINE_H_
+#define SRC_INC_API_CS104_CLIENT_ENGINE_H_
+
+/**
+ * \file cs104_client_engine.h
+ * \brief Event loop for many CS 104 client connections
+ */
+
+#include <stdbool.h>
+
+#include "cs104_connection.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MASTER Master related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS104_CLIENT_ENGINE CS 104 client engine (many connections with few threads)
+ *
+ * Without a client engine each connection uses its own thread. A client engine handles the connections
+ * that are added to it with a fixed number of event loop threads. Each connection is assigned to one of
+ * the threads. The thread connects the socket (non-blocking), starts TLS, receives and handles the
+ * messages, and handles the timeouts (T0 - T3) of the connection.
+ *
+ * The connections are used in the same way as without an engine: \ref CS104_Connection_connectAsync
+ * requests the connection, \ref CS104_Connection_close requests to close it, and all handlers of the
+ * connection are called (by the event loop thread). Handlers must not block, because they delay the
+ * other connections of the same thread. Messages can be sent from any thread.
+ *
+ * NOTE: The TLS handshake is executed by the event loop thread and blocks the thread until the handshake is complete.
+ *
+ * @{
+ */
+
+typedef struct sCS104_ClientEngine* CS104_ClientEngine;
+
+/**
+ * \brief Create a new client engine
+ *
+ * \param numberOfThreads number of event loop threads (at least 1)
+ *
+ * \return the new client engine, or NULL when the engine cannot be created
+ */
+CS104_ClientEngine
+CS104_ClientEngine_create(int numberOfThreads);
+
+/**
+ * \brief Start the event loop threads
+ */
+void
+CS104_ClientEngine_start(CS104_ClientEngine self);
+
+/**
+ * \brief Stop the event loop threads
+ *
+ * The connections are not closed. They are handled again when the engine is restarted.
+ */
+void
+CS104_ClientEngine_stop(CS104_ClientEngine self);
+
+/**
+ * \brief Add a connection to the engine
+ *
+ * The connection is assigned to the thread with the lowest number of connections. The connection has to be
+ * closed when it is added. Use \ref CS104_Connection_connectAsync to connect.
+ *
+ * \return true when the connection has been added, false when it already belongs to an engine
+ */
+bool
+CS104_ClientEngine_addConnection(CS104_ClientEngine self, CS104_Connection connection);
+
+/**
+ * \brief Remove a connection from the engine
+ *
+ * An open connection is closed (the connection handler is called by the calling thread). The function
+ * is called by \ref CS104_Connection_destroy. It must not be called from a handler of a connection of
+ * the engine.
+ */
+void
+CS104_ClientEngine_removeConnection(CS104_ClientEngine self, CS104_Connection connection);
+
+/**
+ * \brief Get the number of connections of the engine
+ */
+int
+CS104_ClientEngine_getNumberOfConnections(CS104_ClientEngine self);
+
+/**
+ * \brief Stop the engine, remove all connections, and release all resources
+ *
+ * The connections are closed but not destroyed.
+ */
+void
+CS104_ClientEngine_destroy(CS104_ClientEngine self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS104_CLIENT_ENGINE_H_ */
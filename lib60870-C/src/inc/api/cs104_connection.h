@@ -27,6 +27,10 @@
 
 #include "tls_config.h"
 #include "iec60870_master.h"
+#include "cs101_mirror.h"
+#include "cs101_command_tracker.h"
+#include "cs104_decode_pool.h"
+#include "cs104_receive_buffer_pool.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -164,6 +168,78 @@ CS104_Connection_connectAsync(CS104_Connection self);
 bool
 CS104_Connection_connect(CS104_Connection self);
 
+/**
+ * \brief Start to connect in threadless mode
+ *
+ * In threadless mode the connection doesn't use a thread. The connect is non-blocking. The application
+ * has to call \ref CS104_Connection_tick to establish the connection, to receive and handle the messages,
+ * and to handle the timeouts. Together with \ref CS104_Connection_getSocketFileDescriptor and
+ * \ref CS104_Connection_getNextDeadline the connection can be handled by the event loop of the
+ * application. One thread can handle any number of connections.
+ *
+ * NOTE: With TLS the handshake is executed by \ref CS104_Connection_tick when the TCP connection is
+ * established. It blocks the calling thread until the handshake is complete.
+ *
+ * \param self CS104_Connection instance
+ *
+ * \return true when the connect was started, false when it failed (the connection handler is called with
+ * CS104_CONNECTION_FAILED)
+ */
+bool
+CS104_Connection_connectThreadless(CS104_Connection self);
+
+/**
+ * \brief Handle a connection in threadless mode
+ *
+ * The function checks if a connect is complete, reads and handles the received messages, handles the
+ * timeouts (T0 - T3), and closes the connection when required. It has to be called when the socket is
+ * readable (or writable while connecting) and when the next deadline is reached. The function doesn't
+ * block, except for the TLS handshake (see \ref CS104_Connection_connectThreadless).
+ *
+ * The handlers of the connection are called by this function.
+ *
+ * \param self CS104_Connection instance
+ *
+ * \return true when the connection is connecting or connected, false when it is closed
+ */
+bool
+CS104_Connection_tick(CS104_Connection self);
+
+/**
+ * \brief Get the socket descriptor of a connection (to wait for the socket with poll, select, epoll, ...)
+ *
+ * The descriptor changes with each connect. While \ref CS104_Connection_isConnecting returns true the
+ * application has to wait until the socket is writable, afterwards until it is readable. Use a level
+ * triggered event mechanism, because \ref CS104_Connection_tick doesn't always read all available data.
+ *
+ * \param self CS104_Connection instance
+ *
+ * \return the socket descriptor, or -1 when the connection is closed
+ */
+int
+CS104_Connection_getSocketFileDescriptor(CS104_Connection self);
+
+/**
+ * \brief Check if a non-blocking connect is in progress
+ *
+ * \param self CS104_Connection instance
+ *
+ * \return true when the TCP connection is not yet established
+ */
+bool
+CS104_Connection_isConnecting(CS104_Connection self);
+
+/**
+ * \brief Get the time when \ref CS104_Connection_tick has to be called next to handle the timeouts
+ *
+ * \param self CS104_Connection instance
+ *
+ * \return the deadline (monotonic time in ms, see Hal_getMonotonicTimeInMs), or UINT64_MAX when the
+ * connection is closed
+ */
+uint64_t
+CS104_Connection_getNextDeadline(CS104_Connection self);
+
 /**
  * \brief start data transmission on this connection
  *
@@ -189,6 +265,65 @@ CS104_Connection_sendStopDT(CS104_Connection self);
 bool
 CS104_Connection_isTransmitBufferFull(CS104_Connection self);
 
+/**
+ * \brief Send window and acknowledgement statistics of a connection (see \ref CS104_Connection_getWindowStatistics)
+ */
+typedef struct sCS104_WindowStatistics* CS104_WindowStatistics;
+
+struct sCS104_WindowStatistics {
+    int smoothedRtt;       /**< smoothed round trip time in ms (-1 when not measured) */
+    int minRtt;            /**< minimum round trip time in ms (-1 when not measured) */
+    int sendWindow;        /**< current maximum number of unconfirmed sent I messages (k) */
+    int ackThreshold;      /**< current number of received I messages that are confirmed by one S message (w) */
+    int maxOutstanding;    /**< maximum number of unconfirmed sent I messages */
+    int windowUtilization; /**< average number of unconfirmed sent I messages in percent of the send window */
+    uint32_t sentIMessages;
+    uint32_t receivedIMessages;
+    uint32_t sentSMessages;
+    uint32_t windowFullEvents; /**< number of times the send window was full while ASDUs were waiting to be sent */
+};
+
+/**
+ * \brief Adapt the send window (k) and the acknowledgement of received I messages (w) to the connection
+ *
+ * The round trip time is measured from sending an I message to its confirmation, and from sending
+ * STARTDT ACT or TESTFR ACT to the confirmation.
+ *
+ * The send window is increased by one when it was full before a confirmation and the smoothed round trip
+ * time is less than twice the minimum round trip time. It is decreased by one when the smoothed round trip
+ * time exceeds four times the minimum round trip time (messages are queued by the link or by the server).
+ * The minimum should not be smaller than the w parameter of the server - the server delays its confirmation
+ * until it has received w I messages (or until timeout t2).
+ *
+ * The acknowledgement threshold is set so that the server (with the same k parameter as the connection)
+ * receives the S message before its send window is full - the number of I messages received during the
+ * minimum round trip time is subtracted from k. On fast links the received I messages are confirmed with fewer
+ * S messages. In adaptive mode the S message is sent after all APDUs of a socket read have been handled.
+ *
+ * Has to be called before connecting.
+ *
+ * \param enable true to enable the adaptive mode, false to use the k and w of the APCI parameters
+ * \param minK minimum send window
+ * \param maxK maximum send window
+ * \param minW minimum acknowledgement threshold
+ * \param maxW maximum acknowledgement threshold
+ *
+ * \return true when the mode has been set, false when the connection is open or the bounds are invalid
+ */
+bool
+CS104_Connection_setAdaptiveWindow(CS104_Connection self, bool enable, int minK, int maxK, int minW, int maxW);
+
+/**
+ * \brief Get the send window and acknowledgement statistics of the current (or last) connection
+ *
+ * The statistics are reset when the connection is established. They are also available when the adaptive mode is
+ * not used, to find suitable k and w parameters for a connection.
+ *
+ * \param statistics the statistics are stored here
+ */
+void
+CS104_Connection_getWindowStatistics(CS104_Connection self, CS104_WindowStatistics statistics);
+
 /**
  * \brief send an interrogation command
  *
@@ -301,6 +436,86 @@ CS104_Connection_sendProcessCommandEx(CS104_Connection self, CS101_CauseOfTransm
 bool
 CS104_Connection_sendASDU(CS104_Connection self, CS101_ASDU asdu);
 
+/**
+ * \brief Events of an ASDU of the send queue
+ */
+typedef enum {
+    CS104_SEND_EVENT_SENT = 0,      /**< the ASDU has been sent (I frame) */
+    CS104_SEND_EVENT_CONFIRMED = 1, /**< the server confirmed the I frame (receive sequence number N(R)) */
+    CS104_SEND_EVENT_FAILED = 2,    /**< the connection was closed before the I frame was confirmed */
+    CS104_SEND_EVENT_TIMEOUT = 3    /**< the deadline elapsed before the ASDU could be sent */
+} CS104_SendEvent;
+
+/**
+ * \brief Handler for the events of an ASDU of the send queue
+ *
+ * The handler is called with CS104_SEND_EVENT_SENT when the ASDU has been sent, and afterwards with exactly one
+ * of the other events. The handler is called without holding internal locks and can send or queue ASDUs.
+ *
+ * \param parameter user provided parameter of the ASDU (e.g. to identify the command)
+ * \param connection the connection object
+ * \param event the event
+ */
+typedef void (*CS104_SendCompletionHandler) (void* parameter, CS104_Connection connection, CS104_SendEvent event);
+
+/**
+ * \brief Set the size of the send queue
+ *
+ * The send queue stores ASDUs while the k-buffer is full (the server didn't confirm the last k I frames), or
+ * before the STARTDT_CON is received. The ASDUs are sent in the order they are queued as soon as the
+ * server confirms sent I frames. The size has to be set before connecting. The preallocated frame pool
+ * of the connection is resized to hold one frame for each queued ASDU.
+ *
+ * \param size maximum number of queued ASDUs (0 to disable the send queue)
+ *
+ * \return true when the size has been set, false when the memory cannot be allocated or the connection is open
+ */
+bool
+CS104_Connection_setSendQueueSize(CS104_Connection self, int size);
+
+/**
+ * \brief Queue an ASDU to be sent as soon as the k-buffer has space
+ *
+ * The ASDU is sent immediately when data transmission is started (STARTDT) and the k-buffer has space.
+ * The handler is informed when the ASDU has been sent and confirmed. Queued and sent ASDUs fail when the
+ * connection is closed.
+ *
+ * Other than \ref CS104_Connection_sendASDU, an ASDU of the queue is only sent after STARTDT_CON.
+ * ASDUs sent with \ref CS104_Connection_sendASDU are not queued and can overtake queued ASDUs.
+ *
+ * \param asdu the ASDU to send (the ASDU is encoded and can be reused after the call)
+ * \param timeoutInMs maximum time in ms until the ASDU has to be sent, or 0 for no timeout
+ * \param handler the handler for the events of the ASDU (can be NULL)
+ * \param parameter user provided parameter that is passed to the handler
+ *
+ * \return true when the ASDU has been queued (or sent), false when the queue is full or the connection is closed
+ */
+bool
+CS104_Connection_queueASDU(CS104_Connection self, CS101_ASDU asdu, int timeoutInMs,
+        CS104_SendCompletionHandler handler, void* parameter);
+
+/**
+ * \brief Queue a process command (see \ref CS104_Connection_queueASDU and \ref CS104_Connection_sendProcessCommandEx)
+ *
+ * \param cot the cause of transmission (should be ACTIVATION to select/execute or ACT_TERM to cancel the command)
+ * \param ca the common address of the information object
+ * \param command the command information object (e.g. SingleCommand or DoubleCommand)
+ * \param timeoutInMs maximum time in ms until the command has to be sent, or 0 for no timeout
+ * \param handler the handler for the events of the command (can be NULL)
+ * \param parameter user provided parameter that is passed to the handler
+ *
+ * \return true when the command has been queued (or sent), false when the queue is full or the connection is closed
+ */
+bool
+CS104_Connection_queueProcessCommand(CS104_Connection self, CS101_CauseOfTransmission cot, int ca, InformationObject command,
+        int timeoutInMs, CS104_SendCompletionHandler handler, void* parameter);
+
+/**
+ * \brief Get the number of ASDUs in the send queue (not yet sent)
+ */
+int
+CS104_Connection_getSendQueueLength(CS104_Connection self);
+
 /**
  * \brief Register a callback handler for received ASDUs
  *
@@ -310,6 +525,86 @@ CS104_Connection_sendASDU(CS104_Connection self, CS101_ASDU asdu);
 void
 CS104_Connection_setASDUReceivedHandler(CS104_Connection self, CS101_ASDUReceivedHandler handler, void* parameter);
 
+/**
+ * \brief Set a callback handler for batches of received ASDUs
+ *
+ * The batch handler replaces the ASDU received handler. It is called with all ASDUs received with one
+ * read from the socket (up to maxBatchSize ASDUs). The handler is called without holding the internal
+ * lock of the connection. The S message to confirm the received I messages is sent after the handler returns.
+ * The handler has to be set before connecting.
+ *
+ * \param handler user provided callback handler function, or NULL to use the ASDU received handler
+ * \param parameter user provided parameter that is passed to the callback handler
+ * \param maxBatchSize maximum number of ASDUs in a batch
+ *
+ * \return true when the handler has been set, false when the connection is open or the memory cannot be allocated
+ */
+bool
+CS104_Connection_setASDUBatchHandler(CS104_Connection self, CS101_ASDUBatchHandler handler, void* parameter, int maxBatchSize);
+
+/**
+ * \brief Handle the received ASDUs by the threads of a decode pool
+ *
+ * The mirror, the ASDU received handler (or batch handler), and the command tracker are called by a pool thread
+ * in the order the ASDUs have been received. The return value of the ASDU received handler is ignored. The
+ * batch handler is called with the ASDUs that are queued when the pool thread handles the connection.
+ * ASDUs received before the connection is closed are still delivered after the connection is closed.
+ * The decode pool has to be set before connecting.
+ *
+ * \param pool the decode pool, or NULL to handle the received ASDUs by the thread of the connection
+ * \param queueSize maximum number of received ASDUs that are waiting to be handled
+ *
+ * \return true when the pool has been set, false when the connection is open, the pool is full, or the memory
+ *         cannot be allocated
+ */
+bool
+CS104_Connection_setDecodePool(CS104_Connection self, CS104_DecodePool pool, int queueSize);
+
+/**
+ * \brief Get the number of received ASDUs that are waiting to be handled by the decode pool
+ */
+int
+CS104_Connection_getNumberOfPendingASDUs(CS104_Connection self);
+
+/**
+ * \brief Read the received messages into the buffers of a receive buffer pool
+ *
+ * The received ASDUs (and the messages passed to the raw message handler) can be retained with
+ * \ref CS104_ReceiveBufferPool_retainASDU without copying them. The pool has to be set before connecting.
+ *
+ * \param pool the receive buffer pool, or NULL to use the internal receive buffer
+ *
+ * \return true when the pool has been set, false when the connection is open
+ */
+bool
+CS104_Connection_setReceiveBufferPool(CS104_Connection self, CS104_ReceiveBufferPool pool);
+
+/**
+ * \brief Attach a mirror that is updated with the received monitoring ASDUs
+ *
+ * The mirror is updated without holding a lock of the connection, so the handlers of the mirror can
+ * send commands. In batch mode the mirror is updated before the batch handler is called, otherwise
+ * after the ASDU received handler. The stations that have been updated last by this connection become
+ * stale when the connection is closed.
+ *
+ * \param mirror the mirror, or NULL to detach the mirror
+ */
+void
+CS104_Connection_setMirror(CS104_Connection self, CS101_Mirror mirror);
+
+/**
+ * \brief Attach a command tracker that is updated with the received confirmations and terminations
+ *
+ * The tracker is updated after the ASDU received handler is called. The command handlers are called
+ * without holding the internal lock of the connection (the next command can be sent from the handler).
+ * The timeouts of the tracker are handled by the connection. All outstanding commands are canceled
+ * when the connection is closed.
+ *
+ * \param tracker the command tracker, or NULL to detach the tracker
+ */
+void
+CS104_Connection_setCommandTracker(CS104_Connection self, CS101_CommandTracker tracker);
+
 typedef enum {
     CS104_CONNECTION_OPENED = 0,
     CS104_CONNECTION_CLOSED = 1,
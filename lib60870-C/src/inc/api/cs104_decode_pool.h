@@ -0,0 +1,105 @@
+/*
+ *  cs104_decode_pool.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS104_DECODE_POOL_H_
+#define SRC_INC_API_CS104_DECODE_POOL_H_
+
+/**
+ * \file cs104_decode_pool.h
+ * \brief Pool of threads that handle the received ASDUs of CS 104 client connections
+ */
+
+#include <stdbool.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MASTER Master related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS104_DECODE_POOL CS 104 decode pool
+ *
+ * With a decode pool the thread that handles a connection (the connection thread or the thread of a client
+ * engine) only receives the APDUs, checks the sequence numbers, and confirms the received I messages. The ASDUs
+ * are copied to a queue of the connection and are decoded by the threads of the pool. The mirror, the ASDU
+ * received handler (or batch handler), and the command tracker are called by the pool threads without holding
+ * the internal lock of the connection. A slow handler doesn't delay the confirmation of received messages
+ * (timeout t2) or the test frames of the connection.
+ *
+ * Each thread has its own queue of connections with received ASDUs. A connection is queued on its home thread
+ * and idle threads take connections from the queues of the other threads. A connection is only handled by one
+ * thread at a time - the ASDUs of a connection are delivered in the order they have been received.
+ *
+ * When the queue of a connection is full the connection stops reading from the socket until the pool threads
+ * have handled the queued ASDUs (the server is slowed down by TCP flow control and the k parameter).
+ *
+ * NOTE: Only available when the library is compiled with thread support (CONFIG_USE_THREADS)
+ *
+ * @{
+ */
+
+typedef struct sCS104_DecodePool* CS104_DecodePool;
+
+/**
+ * \brief Create a decode pool and start the pool threads
+ *
+ * \param numberOfThreads number of decoder threads
+ * \param maxConnections maximum number of connections that use the pool
+ *
+ * \return the new decode pool, or NULL when the pool cannot be created
+ */
+CS104_DecodePool
+CS104_DecodePool_create(int numberOfThreads, int maxConnections);
+
+/**
+ * \brief Get the number of connections that use the pool
+ */
+int
+CS104_DecodePool_getNumberOfConnections(CS104_DecodePool self);
+
+/**
+ * \brief Stop the pool threads and release all resources
+ *
+ * The connections have to be destroyed (or detached with \ref CS104_Connection_setDecodePool) before.
+ */
+void
+CS104_DecodePool_destroy(CS104_DecodePool self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS104_DECODE_POOL_H_ */
@@ -0,0 +1,147 @@
+/*
+ *  cs104_receive_buffer_pool.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS104_RECEIVE_BUFFER_POOL_H_
+#define SRC_INC_API_CS104_RECEIVE_BUFFER_POOL_H_
+
+/**
+ * \file cs104_receive_buffer_pool.h
+ * \brief Reference counted receive buffers to keep received ASDUs after the callback without copying them
+ */
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "iec60870_common.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MASTER Master related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS104_RECEIVE_BUFFER_POOL CS 104 receive buffer pool
+ *
+ * Without a receive buffer pool the ASDUs passed to the ASDU received handler (and the messages passed to the
+ * raw message handler) are only valid during the call. A connection with a receive buffer pool reads from the socket
+ * into a buffer of the pool. The application can retain a received ASDU (or message) in the callback and release it
+ * later, e.g. after it has been handled by another thread. The retained ASDU references the receive buffer - the
+ * buffer is not reused while it is retained. The connection takes a new buffer from the pool for the next read.
+ *
+ * ASDUs that are not located in a buffer of the pool are copied to a free buffer when they are retained. This is
+ * the case for an APDU that is received with two reads, for the messages sent by the connection, and for the ASDUs
+ * handled by a decode pool. When all buffers are retained the connection reads into its internal buffer
+ * (the received ASDUs have to be copied to be retained).
+ *
+ * The functions to retain and release ASDUs are thread-safe. A pool can be used by many connections.
+ *
+ * @{
+ */
+
+typedef struct sCS104_ReceiveBufferPool* CS104_ReceiveBufferPool;
+
+/**
+ * \brief Create a receive buffer pool
+ *
+ * \param numberOfBuffers number of receive buffers
+ * \param bufferSize size of each receive buffer (at least 257 bytes - the maximum APDU size)
+ * \param maxRetainedASDUs maximum number of ASDUs retained at the same time
+ *
+ * \return the new pool, or NULL when the parameters are invalid or the memory cannot be allocated
+ */
+CS104_ReceiveBufferPool
+CS104_ReceiveBufferPool_create(int numberOfBuffers, int bufferSize, int maxRetainedASDUs);
+
+/**
+ * \brief Get the number of buffers that are not used by a connection and not retained
+ */
+int
+CS104_ReceiveBufferPool_getNumberOfFreeBuffers(CS104_ReceiveBufferPool self);
+
+/**
+ * \brief Retain a received ASDU
+ *
+ * Can be called in the ASDU received handler (or batch handler). The returned ASDU is valid until it is released
+ * with \ref CS104_ReceiveBufferPool_releaseASDU. The ASDU passed to the handler is not changed.
+ *
+ * \param asdu the received ASDU
+ *
+ * \return the retained ASDU, or NULL when the maximum number of retained ASDUs is reached (or the ASDU has
+ *         to be copied and no buffer is free)
+ */
+CS101_ASDU
+CS104_ReceiveBufferPool_retainASDU(CS104_ReceiveBufferPool self, CS101_ASDU asdu);
+
+/**
+ * \brief Release an ASDU returned by \ref CS104_ReceiveBufferPool_retainASDU
+ *
+ * ASDUs that have not been retained by this pool (or are already released) are ignored.
+ */
+void
+CS104_ReceiveBufferPool_releaseASDU(CS104_ReceiveBufferPool self, CS101_ASDU asdu);
+
+/**
+ * \brief Retain a message passed to the raw message handler
+ *
+ * \param msg the message
+ * \param msgSize the size of the message
+ *
+ * \return the retained message (the same pointer when the message is located in a buffer of the pool),
+ *         or NULL when the message has to be copied and no buffer is free
+ */
+uint8_t*
+CS104_ReceiveBufferPool_retainMessage(CS104_ReceiveBufferPool self, uint8_t* msg, int msgSize);
+
+/**
+ * \brief Release a message returned by \ref CS104_ReceiveBufferPool_retainMessage
+ */
+void
+CS104_ReceiveBufferPool_releaseMessage(CS104_ReceiveBufferPool self, uint8_t* msg);
+
+/**
+ * \brief Release all resources of the pool
+ *
+ * The connections have to be destroyed (or detached with \ref CS104_Connection_setReceiveBufferPool) and all
+ * retained ASDUs and messages have to be released before.
+ */
+void
+CS104_ReceiveBufferPool_destroy(CS104_ReceiveBufferPool self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS104_RECEIVE_BUFFER_POOL_H_ */
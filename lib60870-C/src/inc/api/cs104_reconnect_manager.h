@@ -0,0 +1,206 @@
+/*
+ *  cs104_reconnect_manager.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_API_CS104_RECONNECT_MANAGER_H_
+#define SRC_INC_API_CS104_RECONNECT_MANAGER_H_
+
+/**
+ * \file cs104_reconnect_manager.h
+ * \brief Automatic reconnect of many CS 104 client connections with backoff and a limit of concurrent connects
+ */
+
+#include <stdbool.h>
+
+#include "cs104_connection.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * @addtogroup MASTER Master related functions
+ *
+ * @{
+ */
+
+/**
+ * @defgroup CS104_RECONNECT_MANAGER CS 104 reconnect manager
+ *
+ * The reconnect manager connects the connections that are added to it and reconnects them when the
+ * connection fails or is closed by the server. After a failure the next attempt is delayed by the backoff
+ * delay of the connection. The delay starts with the initial delay, is doubled after each failed attempt
+ * up to the maximum delay, and is reset when the connection is established. Each delay is reduced by a random
+ * part (jitter) so that connections that failed at the same time don't reconnect at the same time.
+ *
+ * The number of connections that are connecting at the same time (TCP connect and TLS handshake) is limited.
+ * Connections that are due while the limit is reached are connected in the order they became due.
+ *
+ * The manager uses \ref CS104_Connection_connectAsync. With a client engine (\ref CS104_ClientEngine_addConnection)
+ * no additional threads are created to reconnect the connections.
+ *
+ * When the application closes a connection with \ref CS104_Connection_close the connection is not reconnected
+ * until \ref CS104_ReconnectManager_connect is called.
+ *
+ * The timers of the manager have a resolution of \ref CS104_RECONNECT_MANAGER_TICK_INTERVAL ms.
+ *
+ * @{
+ */
+
+/** \brief resolution of the reconnect manager in ms */
+#define CS104_RECONNECT_MANAGER_TICK_INTERVAL 10
+
+typedef struct sCS104_ReconnectManager* CS104_ReconnectManager;
+
+/**
+ * \brief Reconnect states of a connection
+ */
+typedef enum {
+    CS104_RECONNECT_STATE_WAITING = 0,    /**< waiting for the backoff delay */
+    CS104_RECONNECT_STATE_QUEUED = 1,     /**< waiting because the limit of concurrent connects is reached */
+    CS104_RECONNECT_STATE_CONNECTING = 2, /**< connect (and TLS handshake) in progress */
+    CS104_RECONNECT_STATE_CONNECTED = 3,  /**< the connection is established */
+    CS104_RECONNECT_STATE_STOPPED = 4     /**< the connection has been closed by the application */
+} CS104_ReconnectState;
+
+/**
+ * \brief Handler for the reconnect state changes of the connections
+ *
+ * The handler is called without holding internal locks by the thread of the manager, or by the thread that handles
+ * the connection. It must not call \ref CS104_ReconnectManager_removeConnection.
+ *
+ * \param parameter user provided parameter
+ * \param connection the connection
+ * \param state the new state
+ * \param delayInMs delay until the next connect attempt (only for CS104_RECONNECT_STATE_WAITING, otherwise 0)
+ */
+typedef void (*CS104_ReconnectStateHandler) (void* parameter, CS104_Connection connection, CS104_ReconnectState state,
+        int delayInMs);
+
+/**
+ * \brief Create a new reconnect manager
+ *
+ * \param maxConnections maximum number of connections
+ * \param maxConcurrentConnects maximum number of connections that are connecting at the same time
+ *
+ * \return the new reconnect manager, or NULL when the memory cannot be allocated
+ */
+CS104_ReconnectManager
+CS104_ReconnectManager_create(int maxConnections, int maxConcurrentConnects);
+
+/**
+ * \brief Set the handler for reconnect state changes
+ */
+void
+CS104_ReconnectManager_setStateHandler(CS104_ReconnectManager self, CS104_ReconnectStateHandler handler, void* parameter);
+
+/**
+ * \brief Add a connection and connect it
+ *
+ * The connection has to be closed when it is added.
+ *
+ * \param initialDelayInMs delay after the first failed attempt (and after an established connection is lost)
+ * \param maxDelayInMs maximum delay
+ * \param jitter maximum random reduction of the delay in percent (0 - 100)
+ *
+ * \return true when the connection has been added, false when it is already managed or the manager is full
+ */
+bool
+CS104_ReconnectManager_addConnection(CS104_ReconnectManager self, CS104_Connection connection, int initialDelayInMs,
+        int maxDelayInMs, int jitter);
+
+/**
+ * \brief Remove a connection from the manager
+ *
+ * The connection is not closed.
+ */
+void
+CS104_ReconnectManager_removeConnection(CS104_ReconnectManager self, CS104_Connection connection);
+
+/**
+ * \brief Connect a stopped connection (or a waiting connection without further delay)
+ *
+ * The backoff delay is reset to the initial delay.
+ *
+ * \return true when the connection is managed and is not connecting or connected
+ */
+bool
+CS104_ReconnectManager_connect(CS104_ReconnectManager self, CS104_Connection connection);
+
+/**
+ * \brief Get the reconnect state of a connection
+ *
+ * \return the state, or -1 when the connection is not managed
+ */
+int
+CS104_ReconnectManager_getState(CS104_ReconnectManager self, CS104_Connection connection);
+
+/**
+ * \brief Get the number of connections that are connecting
+ */
+int
+CS104_ReconnectManager_getNumberOfConnecting(CS104_ReconnectManager self);
+
+/**
+ * \brief Start the connects that are due
+ *
+ * Has to be called periodically (at least every \ref CS104_RECONNECT_MANAGER_TICK_INTERVAL ms) when the
+ * manager thread is not used.
+ */
+void
+CS104_ReconnectManager_tick(CS104_ReconnectManager self);
+
+/**
+ * \brief Start a thread that calls \ref CS104_ReconnectManager_tick periodically
+ *
+ * NOTE: Only available when the library is compiled with thread support (CONFIG_USE_THREADS)
+ */
+void
+CS104_ReconnectManager_start(CS104_ReconnectManager self);
+
+/**
+ * \brief Stop the manager thread
+ */
+void
+CS104_ReconnectManager_stop(CS104_ReconnectManager self);
+
+/**
+ * \brief Stop the manager thread, remove all connections, and release all resources
+ *
+ * The connections are not closed.
+ */
+void
+CS104_ReconnectManager_destroy(CS104_ReconnectManager self);
+
+/**
+ * @}
+ */
+
+/**
+ * @}
+ */
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_API_CS104_RECONNECT_MANAGER_H_ */
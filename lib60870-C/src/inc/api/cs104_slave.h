@@ -25,6 +25,7 @@
 #define SRC_INC_API_CS104_SLAVE_H_
 
 #include "iec60870_slave.h"
+#include "cs101_process_image.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -209,6 +210,45 @@ CS104_Slave_setConnectionEventHandler(CS104_Slave self, CS104_ConnectionEventHan
 void
 CS104_Slave_setInterrogationHandler(CS104_Slave self, CS101_InterrogationHandler handler, void*  parameter);
 
+/**
+ * \brief Answer interrogation, counter interrogation, and read commands automatically from a process image
+ *
+ * When a process image is set, station and group interrogation commands (QOI 20 ... 36) are answered by the
+ * slave and the interrogation handler is not called. After the ACT_CON the points of the requested group
+ * are sent in packed ASDUs (SQ = 1 for consecutive IOAs) whenever the k-window of the connection has space,
+ * followed by the ACT_TERM. Spontaneous ASDUs from the event queue and command responses are sent in between.
+ * Another interrogation command received while an interrogation is running is rejected with a negative ACT_CON.
+ * An interrogation with the broadcast CA includes the points of all CAs.
+ *
+ * Read commands (C_RD_NA_1) are answered with the current state of the point (type of the point, COT = request)
+ * and the read handler is not called. A read command for an unknown point is rejected with COT = unknown IOA
+ * (or unknown CA). The process image is read without locks, so the application can update points concurrently.
+ *
+ * Counter interrogation commands (C_CI_NA_1) are answered and the counter interrogation handler is not called.
+ * The freeze and reset requests of the QCC are executed for the requested counter group
+ * (see \ref CS101_ProcessImage_freezeCounters) and confirmed with ACT_CON and ACT_TERM. A read request
+ * (FRZ = 0) is answered with the frozen integrated totals in packed ASDUs like an interrogation.
+ *
+ * \param self the slave instance
+ * \param processImage the process image, or NULL to use the interrogation, counter interrogation, and read handlers
+ */
+void
+CS104_Slave_setProcessImage(CS104_Slave self, CS101_ProcessImage processImage);
+
+/**
+ * \brief Replay the last changes of each point to a master connection when it is activated (STARTDT)
+ *
+ * Requires a process image with history (see \ref CS101_ProcessImage_enableHistory). After STARTDT the
+ * last changes of each point are sent in chronological order (per point) with time tag and COT = spontaneous.
+ * Like an interrogation response the entries are sent in packed ASDUs whenever the k-window of the connection
+ * has space. A master that reconnects can use this to fill the gaps of the link loss.
+ *
+ * \param self the slave instance
+ * \param numberOfEntries the maximum number of history entries per point (0 = no replay, default)
+ */
+void
+CS104_Slave_setHistoryReplay(CS104_Slave self, int numberOfEntries);
+
 void
 CS104_Slave_setCounterInterrogationHandler(CS104_Slave self, CS101_CounterInterrogationHandler handler, void*  parameter);
 
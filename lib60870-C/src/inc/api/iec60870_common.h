@@ -221,6 +221,7 @@ typedef struct {
     int asduHeaderLength;
     uint8_t* payload;
     int payloadSize;
+    bool isValidated;
     uint8_t encodedData[256];
 } sCS101_StaticASDU;
 
@@ -476,6 +477,27 @@ CS101_ASDU_getElement(CS101_ASDU self, int index);
 InformationObject
 CS101_ASDU_getElementEx(CS101_ASDU self, InformationObject io, int index);
 
+/**
+ * \brief Check that the payload size matches the type ID and the number of information objects
+ *
+ * The expected payload size is calculated from the fixed size of the information elements of the type ID
+ * (taking the SQ flag into account). When the check succeeds the ASDU is marked as validated and
+ * \ref CS101_ASDU_getElementEx only has to check the index. ASDUs created with \ref CS101_ASDU_createFromBuffer
+ * are validated automatically. Changing the type ID, the number of elements, or the payload resets the state.
+ *
+ * NOTE: ASDUs with types of variable size (e.g. F_SG_NA_1) or private types cannot be validated.
+ *
+ * \return true when the payload size is valid, false otherwise
+ */
+bool
+CS101_ASDU_validate(CS101_ASDU self);
+
+/**
+ * \brief Check if the ASDU has been validated successfully (see \ref CS101_ASDU_validate)
+ */
+bool
+CS101_ASDU_isValidated(CS101_ASDU self);
+
 /**
  * \brief Create a new ASDU. The type ID will be derived from the first InformationObject that will be added
  *
@@ -52,6 +52,20 @@ extern "C" {
  */
 typedef bool (*CS101_ASDUReceivedHandler) (void* parameter, int address, CS101_ASDU asdu);
 
+/**
+ * \brief Callback handler for a batch of received ASDUs
+ *
+ * This callback handler is called with the ASDUs that have been received together (e.g. with one read
+ * from the socket). The ASDU objects reference the receive buffer (no copy) and are only valid in the
+ * context of the callback function.
+ *
+ * \param parameter user provided parameter
+ * \param address address of the sender (slave/other station) - undefined for CS 104
+ * \param asdus the received ASDUs in the order of reception
+ * \param numberOfASDUs number of ASDUs in the batch (at least 1)
+ */
+typedef void (*CS101_ASDUBatchHandler) (void* parameter, int address, CS101_ASDU* asdus, int numberOfASDUs);
+
 #ifdef __cplusplus
 }
 #endif
@@ -37,15 +37,29 @@ extern "C" {
 void
 CS101_ASDU_encode(CS101_ASDU self, Frame frame);
 
+/**
+ * \brief Copy the encoded ASDU (header and payload) into a contiguous buffer
+ *
+ * \return true on success, false when the span has not enough space left
+ */
+bool
+CS101_ASDU_encodeToSpan(CS101_ASDU self, FrameSpan span);
+
 bool
 CP16Time2a_getFromBuffer (CP16Time2a self, const uint8_t* msg, int msgSize, int startIndex);
 
+void
+CP16Time2a_decode(CP16Time2a self, const uint8_t* msg, int startIndex);
+
 uint8_t*
 CP16Time2a_getEncodedValue(CP16Time2a self);
 
 bool
 CP24Time2a_getFromBuffer (CP24Time2a self, const uint8_t* msg, int msgSize, int startIndex);
 
+void
+CP24Time2a_decode(CP24Time2a self, const uint8_t* msg, int startIndex);
+
 bool
 CP32Time2a_getFromBuffer (CP32Time2a self, const uint8_t* msg, int msgSize, int startIndex);
 
@@ -55,6 +69,9 @@ CP32Time2a_getEncodedValue(CP32Time2a self);
 bool
 CP56Time2a_getFromBuffer (CP56Time2a self, const uint8_t* msg, int msgSize, int startIndex);
 
+void
+CP56Time2a_decode(CP56Time2a self, const uint8_t* msg, int startIndex);
+
 uint8_t*
 CP56Time2a_getEncodedValue(CP56Time2a self);
 
@@ -38,6 +38,7 @@ struct sCS101_ASDU {
     int asduHeaderLength;
     uint8_t* payload;
     int payloadSize;
+    bool isValidated; /* payload size matches type ID and number of elements (see CS101_ASDU_validate) */
 };
 
 #ifdef __cplusplus
@@ -57,6 +58,14 @@ extern "C" {
 CS101_ASDU
 CS101_ASDU_createFromBufferEx(CS101_ASDU asdu, CS101_AppLayerParameters parameters, uint8_t* msg, int msgLength);
 
+/**
+ * \brief Get the size of a single information element (without IOA) of the given type
+ *
+ * \return the size in bytes or -1 when the type is not supported or has no fixed size
+ */
+int
+CS101_getInformationElementSize(TypeID typeId);
+
 #ifdef __cplusplus
 }
 #endif
@@ -0,0 +1,55 @@
+/*
+ *  cs101_mirror_internal.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_INTERNAL_CS101_MIRROR_INTERNAL_H_
+#define SRC_INC_INTERNAL_CS101_MIRROR_INTERNAL_H_
+
+#include "cs101_mirror.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * \brief Update the mirror with an ASDU received by a connection
+ *
+ * The connection is recorded as the source of the updated stations.
+ *
+ * \param source the connection that received the ASDU
+ */
+bool
+CS101_Mirror_handleASDUFromSource(CS101_Mirror self, CS101_ASDU asdu, const void* source);
+
+/**
+ * \brief Mark the stations as stale that have been updated last by the given connection
+ *
+ * \param source the connection that has been closed
+ */
+void
+CS101_Mirror_setStationsOfSourceStale(CS101_Mirror self, const void* source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_INTERNAL_CS101_MIRROR_INTERNAL_H_ */
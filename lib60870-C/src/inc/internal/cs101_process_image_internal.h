@@ -0,0 +1,202 @@
+/*
+ *  cs101_process_image_internal.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_INTERNAL_CS101_PROCESS_IMAGE_INTERNAL_H_
+#define SRC_INC_INTERNAL_CS101_PROCESS_IMAGE_INTERNAL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include "cs101_process_image.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Number of points per block. The state of the points of a block is protected by a sequence lock.
+ * Readers copy the state of a block (or point) and repeat the copy when it was modified concurrently.
+ */
+#define CS101_PROCESS_IMAGE_BLOCK_SIZE 64
+
+/**
+ * \brief Position of a running interrogation in the process image
+ *
+ * The cursor is used to send the interrogation response in chunks (e.g. whenever
+ * the k-window of a CS 104 connection has space for new ASDUs).
+ */
+typedef struct {
+    int group; /* 0 = station, 1 ... 16 = group, -1 = no interrogation running (counter interrogations use internal group numbers) */
+    int ca; /* requested CA or -1 for all CAs (broadcast address) */
+    int nextIndex; /* next point index to check */
+
+    /* history replay: maximum number of entries per point (0 = no history replay) and number of the next entry */
+    int historyEntries;
+    uint32_t historyNext;
+    bool historyStarted; /* historyNext is valid for the point nextIndex */
+
+    /* copy of the block that contains the points that are sent next */
+    int snapshotBlock;
+    uint32_t snapshotValue[CS101_PROCESS_IMAGE_BLOCK_SIZE];
+    uint8_t snapshotQuality[CS101_PROCESS_IMAGE_BLOCK_SIZE];
+    uint64_t snapshotTimestamp[CS101_PROCESS_IMAGE_BLOCK_SIZE];
+} sCS101_InterrogationCursor;
+
+typedef sCS101_InterrogationCursor* CS101_InterrogationCursor;
+
+void
+CS101_InterrogationCursor_start(CS101_InterrogationCursor self, int group, int ca);
+
+/**
+ * \brief Start a counter interrogation that reads the frozen integrated totals
+ *
+ * \param group the counter group (1 ... 4), or 0 for all integrated totals
+ * \param ca the requested CA or -1 for all CAs
+ */
+void
+CS101_InterrogationCursor_startCounterInterrogation(CS101_InterrogationCursor self, int group, int ca);
+
+/**
+ * \brief Start the replay of the last changes of each point from the history
+ *
+ * \param numberOfEntries the maximum number of history entries per point
+ * \param ca the CA of the points or -1 for all CAs
+ */
+void
+CS101_InterrogationCursor_startHistoryReplay(CS101_InterrogationCursor self, int numberOfEntries, int ca);
+
+void
+CS101_InterrogationCursor_stop(CS101_InterrogationCursor self);
+
+bool
+CS101_InterrogationCursor_isRunning(CS101_InterrogationCursor self);
+
+int
+CS101_ProcessImage_getMaxNumberOfPoints(CS101_ProcessImage self);
+
+/**
+ * \brief Start a consistent read of the state of a point (e.g. with the value getters)
+ *
+ * \return the sequence number to be checked with CS101_ProcessImage_retryRead
+ */
+uint32_t
+CS101_ProcessImage_beginRead(CS101_ProcessImage self, int index);
+
+/**
+ * \brief Check if the state of the point has been updated since CS101_ProcessImage_beginRead
+ *
+ * \return true when the read has to be repeated
+ */
+bool
+CS101_ProcessImage_retryRead(CS101_ProcessImage self, int index, uint32_t sequence);
+
+/**
+ * \brief Update a normalized or short floating point measured value
+ */
+bool
+CS101_ProcessImage_updateFloatValue(CS101_ProcessImage self, int index, float value, QualityDescriptor quality, uint64_t timestamp);
+
+/**
+ * \brief Update the state of a point from a received information object (e.g. of a monitoring ASDU)
+ *
+ * The value of the information object has to be of the same kind as the value of the point. The time
+ * tag of the information object is used as timestamp when present.
+ *
+ * \param typeId the type ID of the information object
+ * \param io the information object
+ * \param timestamp timestamp for information objects without time tag, or 0 to use the current time
+ * \param changed (output) true when the value or the quality has changed - can be NULL
+ *
+ * \return true when the point has been updated, false when the index or the type is not valid
+ */
+bool
+CS101_ProcessImage_updateFromInformationObject(CS101_ProcessImage self, int index, TypeID typeId, InformationObject io,
+        uint64_t timestamp, bool* changed);
+
+/**
+ * \brief Handler that is called for each point with changed quality by CS101_ProcessImage_modifyQualityFlags
+ */
+typedef void (*CS101_ProcessImage_QualityChangedHandler) (void* parameter, int index);
+
+/**
+ * \brief Set or clear quality flags of the selected points
+ *
+ * The points are selected by CA, IOA range, and (optionally) group. The selection is evaluated for a
+ * block of points at once and the block lock is taken only once per block with selected points.
+ *
+ * \param ca the CA of the points, or -1 for all CAs
+ * \param group the interrogation group, or -1 to select points independent of the group
+ * \param handler called for each point with changed quality after the block has been updated (can be NULL)
+ *
+ * \return the number of points with changed quality
+ */
+int
+CS101_ProcessImage_modifyQualityFlags(CS101_ProcessImage self, int ca, int firstIoa, int lastIoa, int group, uint8_t flags,
+        bool set, uint64_t timestamp, CS101_ProcessImage_QualityChangedHandler handler, void* parameter);
+
+/**
+ * \brief Check if the point can be sent with another type ID (e.g. M_ME_TF_1 for a M_ME_NC_1 point)
+ */
+bool
+CS101_ProcessImage_isCompatibleType(CS101_ProcessImage self, int index, TypeID typeId);
+
+/**
+ * \brief Like CS101_ProcessImage_getInformationObject but with the given (compatible) type ID
+ */
+InformationObject
+CS101_ProcessImage_getInformationObjectOfType(CS101_ProcessImage self, int index, TypeID typeId, InformationObject io);
+
+/**
+ * \brief Check if the process image contains at least one point with the CA
+ */
+bool
+CS101_ProcessImage_hasCA(CS101_ProcessImage self, int ca);
+
+/**
+ * \brief Add the next points of a running interrogation to the ASDU and advance the cursor
+ *
+ * The ASDU has to be empty. The function sets the CA and the SQ flag of the ASDU. Points with
+ * consecutive IOAs are packed into a sequence (SQ = 1) ASDU. A counter interrogation adds the
+ * frozen state of the integrated totals.
+ *
+ * \return true when points have been added, false when all points of the interrogation have been sent
+ */
+bool
+CS101_ProcessImage_getNextInterrogationASDU(CS101_ProcessImage self, CS101_InterrogationCursor cursor, CS101_ASDU asdu);
+
+/**
+ * \brief Add the next history entries of a running history replay to the ASDU and advance the cursor
+ *
+ * The ASDU has to be empty. The entries of a point are added in chronological order with the type with
+ * time tag. The function sets the CA of the ASDU.
+ *
+ * \return true when entries have been added, false when the replay is complete
+ */
+bool
+CS101_ProcessImage_getNextHistoryASDU(CS101_ProcessImage self, CS101_InterrogationCursor cursor, CS101_ASDU asdu);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_INTERNAL_CS101_PROCESS_IMAGE_INTERNAL_H_ */
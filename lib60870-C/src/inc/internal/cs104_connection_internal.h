@@ -0,0 +1,179 @@
+/*
+ *  cs104_connection_internal.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_INTERNAL_CS104_CONNECTION_INTERNAL_H_
+#define SRC_INC_INTERNAL_CS104_CONNECTION_INTERNAL_H_
+
+#include <stdbool.h>
+
+#include "cs104_connection.h"
+#include "cs104_client_engine.h"
+#include "cs104_reconnect_manager.h"
+#include "cs104_decode_pool.h"
+#include "cs104_receive_buffer_pool.h"
+#include "hal_socket.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Functions to drive a connection by an event loop (client engine) instead of the connection thread.
+ * The functions are called by the event loop thread only.
+ */
+
+/**
+ * \brief Assign the connection to a client engine (or NULL to use the connection thread)
+ */
+void
+CS104_Connection_setEngine(CS104_Connection self, CS104_ClientEngine engine);
+
+/**
+ * \brief Return and reset the connect request of an idle connection (set by \ref CS104_Connection_connectAsync)
+ */
+bool
+CS104_Connection_takeConnectRequest(CS104_Connection self);
+
+/**
+ * \brief Start a non-blocking connect. The connection handler is called with CS104_CONNECTION_FAILED
+ * when the connect fails immediately.
+ */
+void
+CS104_Connection_startConnectNonBlocking(CS104_Connection self);
+
+/**
+ * \brief Get the socket of an established connection
+ *
+ * \return the socket, or NULL when the connection is not established
+ */
+Socket
+CS104_Connection_getSocket(CS104_Connection self);
+
+/**
+ * \brief Handle connect progress, received messages, timeouts, and close requests without blocking
+ *
+ * \param readable true when the socket has data to read
+ *
+ * \return true when the connection is still connecting or connected
+ */
+bool
+CS104_Connection_handleEvents(CS104_Connection self, bool readable);
+
+/*
+ * Functions to connect a connection with a reconnect manager
+ */
+
+/**
+ * \brief Assign the connection to a reconnect manager (or NULL)
+ *
+ * \param entry index of the connection in the reconnect manager
+ */
+void
+CS104_Connection_setReconnectManager(CS104_Connection self, CS104_ReconnectManager manager, int entry);
+
+/**
+ * \brief Get the index of the connection in the reconnect manager
+ *
+ * \return the index, or -1 when the connection doesn't belong to the manager
+ */
+int
+CS104_Connection_getReconnectEntry(CS104_Connection self, CS104_ReconnectManager manager);
+
+/**
+ * \brief Report the opening and closing of a connection to the reconnect manager
+ *
+ * Called by the thread that handles the connection (without holding the lock of the connection).
+ *
+ * \param closeRequested true when the connection has been closed by \ref CS104_Connection_close
+ */
+void
+CS104_ReconnectManager_handleConnectionEvent(CS104_ReconnectManager self, int entry, CS104_Connection connection,
+        CS104_ConnectionEvent event, bool closeRequested);
+
+/*
+ * Functions to connect a connection with a decode pool
+ */
+
+/**
+ * \brief Check if the connection stops reading because the decode queue is full
+ */
+bool
+CS104_Connection_isReceivePaused(CS104_Connection self);
+
+/**
+ * \brief Handle the queued ASDUs of the connection (called by a thread of the decode pool)
+ *
+ * \param maxASDUs maximum number of ASDUs to handle
+ *
+ * \return true when there are more queued ASDUs (the connection has to be queued again)
+ */
+bool
+CS104_Connection_handleDecodeQueue(CS104_Connection self, int maxASDUs);
+
+/**
+ * \brief Add a connection to the pool
+ *
+ * \return the index of the home thread of the connection, or -1 when the pool is full
+ */
+int
+CS104_DecodePool_attach(CS104_DecodePool self);
+
+/**
+ * \brief Remove a connection from the pool (the connection must not be queued)
+ */
+void
+CS104_DecodePool_detach(CS104_DecodePool self);
+
+/**
+ * \brief Queue a connection with received ASDUs on a pool thread
+ *
+ * \param worker index of the thread
+ */
+void
+CS104_DecodePool_schedule(CS104_DecodePool self, int worker, CS104_Connection connection);
+
+/*
+ * Functions to read into the buffers of a receive buffer pool
+ */
+
+/**
+ * \brief Get the buffer for the next read of a connection
+ *
+ * \param buffer the buffer of the previous read (or NULL). It is reused when it is not retained by the application.
+ *
+ * \return the buffer for the next read, or NULL when no buffer is free
+ */
+uint8_t*
+CS104_ReceiveBufferPool_renewBuffer(CS104_ReceiveBufferPool self, uint8_t* buffer);
+
+/**
+ * \brief Get the size of the buffers of the pool
+ */
+int
+CS104_ReceiveBufferPool_getBufferSize(CS104_ReceiveBufferPool self);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_INTERNAL_CS104_CONNECTION_INTERNAL_H_ */
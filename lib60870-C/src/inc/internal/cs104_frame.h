@@ -28,6 +28,14 @@
 
 typedef struct sT104Frame* T104Frame;
 
+/**
+ * \brief Thread-safe pool of preallocated frames
+ *
+ * Frames of the pool are returned to the pool by T104Frame_destroy. When all frames are in use
+ * T104FramePool_getFrame allocates a new frame with T104Frame_create.
+ */
+typedef struct sT104FramePool* T104FramePool;
+
 T104Frame
 T104Frame_create(void);
 
@@ -55,5 +63,31 @@ T104Frame_getBuffer(Frame self);
 int
 T104Frame_getSpaceLeft(Frame self);
 
+/**
+ * \brief Get a span over the frame buffer to encode the ASDU directly into the frame
+ *
+ * The span starts at the current message size and ends at the maximum APDU size.
+ */
+void
+T104Frame_getSpan(T104Frame self, FrameSpan span);
+
+/**
+ * \brief Update the frame message size after encoding into a span from T104Frame_getSpan
+ */
+void
+T104Frame_commitSpan(T104Frame self, FrameSpan span);
+
+T104FramePool
+T104FramePool_create(int numberOfFrames);
+
+/**
+ * \brief Release the pool. All frames of the pool have to be returned before.
+ */
+void
+T104FramePool_destroy(T104FramePool self);
+
+T104Frame
+T104FramePool_getFrame(T104FramePool self);
+
 
 #endif /* SRC_INC_T104_FRAME_H_ */
@@ -23,6 +23,7 @@
 #define SRC_INC_FRAME_H_
 
 #include <stdint.h>
+#include <string.h>
 
 #include "iec60870_common.h"
 
@@ -38,4 +39,39 @@ struct sFrameVFT {
     int (*getSpaceLeft)(Frame self);
 };
 
+typedef struct sFrameSpan* FrameSpan;
+
+/**
+ * \brief Write cursor over a contiguous encode buffer
+ *
+ * Encoders check the required size once with FrameSpan_getSpaceLeft and then write
+ * directly into the buffer. The accessors are macros so that the per-byte writes
+ * compile to plain stores instead of indirect calls through the frame VFT.
+ */
+struct sFrameSpan {
+    uint8_t* buffer; /* start of the target buffer */
+    int pos; /* next write position (= number of bytes written) */
+    int capacity; /* size of the target buffer */
+};
+
+#define FrameSpan_getSpaceLeft(self) ((self)->capacity - (self)->pos)
+
+#define FrameSpan_setNextByte(self, byte) ((self)->buffer[(self)->pos++] = (uint8_t) (byte))
+
+#define FrameSpan_appendBytes(self, bytes, numberOfBytes) \
+    do { \
+        memcpy((self)->buffer + (self)->pos, (bytes), (numberOfBytes)); \
+        (self)->pos += (numberOfBytes); \
+    } while (0)
+
+/**
+ * \brief Initialize a span over a buffer
+ *
+ * \param buffer the target buffer
+ * \param pos the start position (number of bytes already used in the buffer)
+ * \param capacity the total size of the buffer
+ */
+void
+FrameSpan_initialize(FrameSpan self, uint8_t* buffer, int pos, int capacity);
+
 #endif /* SRC_INC_FRAME_H_ */
@@ -27,6 +27,15 @@
 
 typedef struct sInformationObjectVFT* InformationObjectVFT;
 
+/**
+ * \brief Encode the information object directly into a contiguous buffer
+ *
+ * \return true on success, false when the span has not enough space left
+ */
+bool
+InformationObject_encodeToSpan(InformationObject self, FrameSpan span, CS101_AppLayerParameters parameters, bool isSequence);
+
+/* compatibility wrapper for arbitrary Frame implementations (uses InformationObject_encodeToSpan) */
 bool
 InformationObject_encode(InformationObject self, Frame frame, CS101_AppLayerParameters parameters, bool isSequence);
 
@@ -40,258 +49,514 @@ SinglePointInformation
 SinglePointInformation_getFromBuffer(SinglePointInformation self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+SinglePointInformation
+SinglePointInformation_decode(SinglePointInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueScaledWithCP56Time2a
 MeasuredValueScaledWithCP56Time2a_getFromBuffer(MeasuredValueScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueScaledWithCP56Time2a
+MeasuredValueScaledWithCP56Time2a_decode(MeasuredValueScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 StepPositionInformation
 StepPositionInformation_getFromBuffer(StepPositionInformation self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+StepPositionInformation
+StepPositionInformation_decode(StepPositionInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 StepPositionWithCP56Time2a
 StepPositionWithCP56Time2a_getFromBuffer(StepPositionWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+StepPositionWithCP56Time2a
+StepPositionWithCP56Time2a_decode(StepPositionWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 StepPositionWithCP24Time2a
 StepPositionWithCP24Time2a_getFromBuffer(StepPositionWithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+StepPositionWithCP24Time2a
+StepPositionWithCP24Time2a_decode(StepPositionWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 DoublePointInformation
 DoublePointInformation_getFromBuffer(DoublePointInformation self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+DoublePointInformation
+DoublePointInformation_decode(DoublePointInformation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 DoublePointWithCP24Time2a
 DoublePointWithCP24Time2a_getFromBuffer(DoublePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+DoublePointWithCP24Time2a
+DoublePointWithCP24Time2a_decode(DoublePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 DoublePointWithCP56Time2a
 DoublePointWithCP56Time2a_getFromBuffer(DoublePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+DoublePointWithCP56Time2a
+DoublePointWithCP56Time2a_decode(DoublePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 SinglePointWithCP24Time2a
 SinglePointWithCP24Time2a_getFromBuffer(SinglePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+SinglePointWithCP24Time2a
+SinglePointWithCP24Time2a_decode(SinglePointWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 SinglePointWithCP56Time2a
 SinglePointWithCP56Time2a_getFromBuffer(SinglePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+SinglePointWithCP56Time2a
+SinglePointWithCP56Time2a_decode(SinglePointWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 BitString32
 BitString32_getFromBuffer(BitString32 self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+BitString32
+BitString32_decode(BitString32 self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 Bitstring32WithCP24Time2a
 Bitstring32WithCP24Time2a_getFromBuffer(Bitstring32WithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+Bitstring32WithCP24Time2a
+Bitstring32WithCP24Time2a_decode(Bitstring32WithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 Bitstring32WithCP56Time2a
 Bitstring32WithCP56Time2a_getFromBuffer(Bitstring32WithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+Bitstring32WithCP56Time2a
+Bitstring32WithCP56Time2a_decode(Bitstring32WithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueNormalized
 MeasuredValueNormalized_getFromBuffer(MeasuredValueNormalized self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueNormalized
+MeasuredValueNormalized_decode(MeasuredValueNormalized self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueNormalizedWithCP24Time2a
 MeasuredValueNormalizedWithCP24Time2a_getFromBuffer(MeasuredValueNormalizedWithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueNormalizedWithCP24Time2a
+MeasuredValueNormalizedWithCP24Time2a_decode(MeasuredValueNormalizedWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueNormalizedWithCP56Time2a
 MeasuredValueNormalizedWithCP56Time2a_getFromBuffer(MeasuredValueNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueNormalizedWithCP56Time2a
+MeasuredValueNormalizedWithCP56Time2a_decode(MeasuredValueNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueScaled
 MeasuredValueScaled_getFromBuffer(MeasuredValueScaled self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueScaled
+MeasuredValueScaled_decode(MeasuredValueScaled self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueScaledWithCP24Time2a
 MeasuredValueScaledWithCP24Time2a_getFromBuffer(MeasuredValueScaledWithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueScaledWithCP24Time2a
+MeasuredValueScaledWithCP24Time2a_decode(MeasuredValueScaledWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueShort
 MeasuredValueShort_getFromBuffer(MeasuredValueShort self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueShort
+MeasuredValueShort_decode(MeasuredValueShort self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueShortWithCP24Time2a
 MeasuredValueShortWithCP24Time2a_getFromBuffer(MeasuredValueShortWithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueShortWithCP24Time2a
+MeasuredValueShortWithCP24Time2a_decode(MeasuredValueShortWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueShortWithCP56Time2a
 MeasuredValueShortWithCP56Time2a_getFromBuffer(MeasuredValueShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueShortWithCP56Time2a
+MeasuredValueShortWithCP56Time2a_decode(MeasuredValueShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 IntegratedTotals
 IntegratedTotals_getFromBuffer(IntegratedTotals self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+IntegratedTotals
+IntegratedTotals_decode(IntegratedTotals self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 IntegratedTotalsWithCP24Time2a
 IntegratedTotalsWithCP24Time2a_getFromBuffer(IntegratedTotalsWithCP24Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+IntegratedTotalsWithCP24Time2a
+IntegratedTotalsWithCP24Time2a_decode(IntegratedTotalsWithCP24Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 IntegratedTotalsWithCP56Time2a
 IntegratedTotalsWithCP56Time2a_getFromBuffer(IntegratedTotalsWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+IntegratedTotalsWithCP56Time2a
+IntegratedTotalsWithCP56Time2a_decode(IntegratedTotalsWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 EventOfProtectionEquipment
 EventOfProtectionEquipment_getFromBuffer(EventOfProtectionEquipment self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+EventOfProtectionEquipment
+EventOfProtectionEquipment_decode(EventOfProtectionEquipment self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 PackedStartEventsOfProtectionEquipment
 PackedStartEventsOfProtectionEquipment_getFromBuffer(PackedStartEventsOfProtectionEquipment self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+PackedStartEventsOfProtectionEquipment
+PackedStartEventsOfProtectionEquipment_decode(PackedStartEventsOfProtectionEquipment self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 PackedOutputCircuitInfo
 PackedOutputCircuitInfo_getFromBuffer(PackedOutputCircuitInfo self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+PackedOutputCircuitInfo
+PackedOutputCircuitInfo_decode(PackedOutputCircuitInfo self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 PackedSinglePointWithSCD
 PackedSinglePointWithSCD_getFromBuffer(PackedSinglePointWithSCD self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+PackedSinglePointWithSCD
+PackedSinglePointWithSCD_decode(PackedSinglePointWithSCD self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 MeasuredValueNormalizedWithoutQuality
 MeasuredValueNormalizedWithoutQuality_getFromBuffer(MeasuredValueNormalizedWithoutQuality self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+MeasuredValueNormalizedWithoutQuality
+MeasuredValueNormalizedWithoutQuality_decode(MeasuredValueNormalizedWithoutQuality self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 EventOfProtectionEquipmentWithCP56Time2a
 EventOfProtectionEquipmentWithCP56Time2a_getFromBuffer(EventOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+EventOfProtectionEquipmentWithCP56Time2a
+EventOfProtectionEquipmentWithCP56Time2a_decode(EventOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 PackedStartEventsOfProtectionEquipmentWithCP56Time2a
 PackedStartEventsOfProtectionEquipmentWithCP56Time2a_getFromBuffer(PackedStartEventsOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+PackedStartEventsOfProtectionEquipmentWithCP56Time2a
+PackedStartEventsOfProtectionEquipmentWithCP56Time2a_decode(PackedStartEventsOfProtectionEquipmentWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 PackedOutputCircuitInfoWithCP56Time2a
 PackedOutputCircuitInfoWithCP56Time2a_getFromBuffer(PackedOutputCircuitInfoWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+PackedOutputCircuitInfoWithCP56Time2a
+PackedOutputCircuitInfoWithCP56Time2a_decode(PackedOutputCircuitInfoWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 SingleCommand
 SingleCommand_getFromBuffer(SingleCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SingleCommand
+SingleCommand_decode(SingleCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SingleCommandWithCP56Time2a
 SingleCommandWithCP56Time2a_getFromBuffer(SingleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SingleCommandWithCP56Time2a
+SingleCommandWithCP56Time2a_decode(SingleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 DoubleCommand
 DoubleCommand_getFromBuffer(DoubleCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+DoubleCommand
+DoubleCommand_decode(DoubleCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 StepCommand
 StepCommand_getFromBuffer(StepCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+StepCommand
+StepCommand_decode(StepCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SetpointCommandNormalized
 SetpointCommandNormalized_getFromBuffer(SetpointCommandNormalized self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SetpointCommandNormalized
+SetpointCommandNormalized_decode(SetpointCommandNormalized self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SetpointCommandScaled
 SetpointCommandScaled_getFromBuffer(SetpointCommandScaled self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SetpointCommandScaled
+SetpointCommandScaled_decode(SetpointCommandScaled self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SetpointCommandShort
 SetpointCommandShort_getFromBuffer(SetpointCommandShort self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SetpointCommandShort
+SetpointCommandShort_decode(SetpointCommandShort self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 Bitstring32Command
 Bitstring32Command_getFromBuffer(Bitstring32Command self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+Bitstring32Command
+Bitstring32Command_decode(Bitstring32Command self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 ReadCommand
 ReadCommand_getFromBuffer(ReadCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+ReadCommand
+ReadCommand_decode(ReadCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 ClockSynchronizationCommand
 ClockSynchronizationCommand_getFromBuffer(ClockSynchronizationCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+ClockSynchronizationCommand
+ClockSynchronizationCommand_decode(ClockSynchronizationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 InterrogationCommand
 InterrogationCommand_getFromBuffer(InterrogationCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+InterrogationCommand
+InterrogationCommand_decode(InterrogationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 ParameterNormalizedValue
 ParameterNormalizedValue_getFromBuffer(ParameterNormalizedValue self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+ParameterNormalizedValue
+ParameterNormalizedValue_decode(ParameterNormalizedValue self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 ParameterScaledValue
 ParameterScaledValue_getFromBuffer(ParameterScaledValue self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+ParameterScaledValue
+ParameterScaledValue_decode(ParameterScaledValue self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 ParameterFloatValue
 ParameterFloatValue_getFromBuffer(ParameterFloatValue self, CS101_AppLayerParameters parameters,
         uint8_t* msqg, int msgSize, int startIndex);
 
+ParameterFloatValue
+ParameterFloatValue_decode(ParameterFloatValue self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 ParameterActivation
 ParameterActivation_getFromBuffer(ParameterActivation self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+ParameterActivation
+ParameterActivation_decode(ParameterActivation self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 EndOfInitialization
 EndOfInitialization_getFromBuffer(EndOfInitialization self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+EndOfInitialization
+EndOfInitialization_decode(EndOfInitialization self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 DoubleCommandWithCP56Time2a
 DoubleCommandWithCP56Time2a_getFromBuffer(DoubleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+DoubleCommandWithCP56Time2a
+DoubleCommandWithCP56Time2a_decode(DoubleCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 StepCommandWithCP56Time2a
 StepCommandWithCP56Time2a_getFromBuffer(StepCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+StepCommandWithCP56Time2a
+StepCommandWithCP56Time2a_decode(StepCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SetpointCommandNormalizedWithCP56Time2a
 SetpointCommandNormalizedWithCP56Time2a_getFromBuffer(SetpointCommandNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SetpointCommandNormalizedWithCP56Time2a
+SetpointCommandNormalizedWithCP56Time2a_decode(SetpointCommandNormalizedWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SetpointCommandScaledWithCP56Time2a
 SetpointCommandScaledWithCP56Time2a_getFromBuffer(SetpointCommandScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SetpointCommandScaledWithCP56Time2a
+SetpointCommandScaledWithCP56Time2a_decode(SetpointCommandScaledWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SetpointCommandShortWithCP56Time2a
 SetpointCommandShortWithCP56Time2a_getFromBuffer(SetpointCommandShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SetpointCommandShortWithCP56Time2a
+SetpointCommandShortWithCP56Time2a_decode(SetpointCommandShortWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 Bitstring32CommandWithCP56Time2a
 Bitstring32CommandWithCP56Time2a_getFromBuffer(Bitstring32CommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+Bitstring32CommandWithCP56Time2a
+Bitstring32CommandWithCP56Time2a_decode(Bitstring32CommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 CounterInterrogationCommand
 CounterInterrogationCommand_getFromBuffer(CounterInterrogationCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+CounterInterrogationCommand
+CounterInterrogationCommand_decode(CounterInterrogationCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 TestCommand
 TestCommand_getFromBuffer(TestCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+TestCommand
+TestCommand_decode(TestCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 TestCommandWithCP56Time2a
 TestCommandWithCP56Time2a_getFromBuffer(TestCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+TestCommandWithCP56Time2a
+TestCommandWithCP56Time2a_decode(TestCommandWithCP56Time2a self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 ResetProcessCommand
 ResetProcessCommand_getFromBuffer(ResetProcessCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+ResetProcessCommand
+ResetProcessCommand_decode(ResetProcessCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 DelayAcquisitionCommand
 DelayAcquisitionCommand_getFromBuffer(DelayAcquisitionCommand self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+DelayAcquisitionCommand
+DelayAcquisitionCommand_decode(DelayAcquisitionCommand self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 FileReady
 FileReady_getFromBuffer(FileReady self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+FileReady
+FileReady_decode(FileReady self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 SectionReady
 SectionReady_getFromBuffer(SectionReady self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+SectionReady
+SectionReady_decode(SectionReady self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 FileCallOrSelect
 FileCallOrSelect_getFromBuffer(FileCallOrSelect self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+FileCallOrSelect
+FileCallOrSelect_decode(FileCallOrSelect self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 FileLastSegmentOrSection
 FileLastSegmentOrSection_getFromBuffer(FileLastSegmentOrSection self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+FileLastSegmentOrSection
+FileLastSegmentOrSection_decode(FileLastSegmentOrSection self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 FileACK
 FileACK_getFromBuffer(FileACK self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+FileACK
+FileACK_decode(FileACK self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 FileSegment
 FileSegment_getFromBuffer(FileSegment self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
@@ -300,10 +565,18 @@ FileDirectory
 FileDirectory_getFromBuffer(FileDirectory self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex, bool isSequence);
 
+FileDirectory
+FileDirectory_decode(FileDirectory self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex, bool isSequence);
+
 QueryLog
 QueryLog_getFromBuffer(QueryLog self, CS101_AppLayerParameters parameters,
         uint8_t* msg, int msgSize, int startIndex);
 
+QueryLog
+QueryLog_decode(QueryLog self, CS101_AppLayerParameters parameters,
+        uint8_t* msg, int startIndex);
+
 
 /********************************************
  * static InformationObject type definitions
@@ -38,4 +38,19 @@ lib60870_debug_print(const char *format, ...);
 
 #define UNUSED_PARAMETER(x) (void)(x)
 
+/*
+ * Access to the size of the variable length ASDU fields. When the library is compiled with
+ * CONFIG_CS101_FIXED_APP_LAYER_PARAMETERS = 1 the sizes are compile time constants and the
+ * values in the application layer parameters are ignored.
+ */
+#if (CONFIG_CS101_FIXED_APP_LAYER_PARAMETERS == 1)
+#define CS101_SIZE_OF_COT(parameters) ((void) (parameters), CONFIG_CS101_FIXED_SIZE_OF_COT)
+#define CS101_SIZE_OF_CA(parameters) ((void) (parameters), CONFIG_CS101_FIXED_SIZE_OF_CA)
+#define CS101_SIZE_OF_IOA(parameters) ((void) (parameters), CONFIG_CS101_FIXED_SIZE_OF_IOA)
+#else
+#define CS101_SIZE_OF_COT(parameters) ((parameters)->sizeOfCOT)
+#define CS101_SIZE_OF_CA(parameters) ((parameters)->sizeOfCA)
+#define CS101_SIZE_OF_IOA(parameters) ((parameters)->sizeOfIOA)
+#endif
+
 #endif /* SRC_INC_INTERNAL_LIB60870_INTERNAL_H_ */
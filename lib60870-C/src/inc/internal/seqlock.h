@@ -0,0 +1,71 @@
+/*
+ *  seqlock.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_INTERNAL_SEQLOCK_H_
+#define SRC_INC_INTERNAL_SEQLOCK_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Sequence lock
+ *
+ * Protects data that is updated by writers and read by readers without blocking the writers.
+ * The sequence number is odd while a write is in progress. A reader copies the data and checks
+ * afterwards that the sequence number is still the same (otherwise the copy has to be repeated).
+ *
+ * Writers of the same lock exclude each other (by spinning - the write sections have to be short).
+ * Writers never wait for readers.
+ *
+ * The sequence numbers can be part of arrays (e.g. one per block of data). They have to be initialized with 0.
+ */
+
+typedef volatile uint32_t SeqLock;
+
+void
+SeqLock_writeBegin(SeqLock* self);
+
+void
+SeqLock_writeEnd(SeqLock* self);
+
+/**
+ * \return the sequence number to be checked with SeqLock_readRetry
+ */
+uint32_t
+SeqLock_readBegin(SeqLock* self);
+
+/**
+ * \return true when the data has been modified during the read (the read has to be repeated)
+ */
+bool
+SeqLock_readRetry(SeqLock* self, uint32_t sequence);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_INTERNAL_SEQLOCK_H_ */
@@ -0,0 +1,99 @@
+/*
+ *  timer_wheel.h
+ *
+ *  Copyright 2024 Michael Zillgith
+ *
+ *  This file is part of lib60870-C
+ *
+ *  lib60870-C is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  lib60870-C is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with lib60870-C.  If not, see <http://www.gnu.org/licenses/>.
+ *
+ *  See COPYING file for the complete license text.
+ */
+
+#ifndef SRC_INC_INTERNAL_TIMER_WHEEL_H_
+#define SRC_INC_INTERNAL_TIMER_WHEEL_H_
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * Hashed timer wheel
+ *
+ * Timers are stored in the slot of their expiry tick (modulo the number of slots). Timers that
+ * expire after more than one revolution stay in their slot until they are due. Scheduling and
+ * canceling are O(1), advancing the wheel only visits the slots of the elapsed ticks.
+ *
+ * The entries are embedded in the data structures of the user (no memory allocation when scheduling).
+ * The wheel is not thread-safe. The user has to provide locking when required.
+ */
+
+typedef struct sTimerWheelEntry* TimerWheelEntry;
+
+struct sTimerWheelEntry {
+    TimerWheelEntry next;
+    TimerWheelEntry prev;
+    uint64_t expiryTime; /* in ms (same time base as the currentTime parameters) */
+    bool isScheduled;
+};
+
+typedef struct sTimerWheel* TimerWheel;
+
+/*
+ * Called for each expired timer. The timer is already removed from the wheel and can be scheduled again.
+ */
+typedef void (*TimerWheel_ExpiryHandler) (void* parameter, TimerWheelEntry entry, uint64_t currentTime);
+
+/*
+ * \param numberOfSlots number of slots (rounded up to a power of 2)
+ * \param tickInterval resolution of the wheel in ms
+ * \param currentTime the current time in ms
+ */
+TimerWheel
+TimerWheel_create(int numberOfSlots, int tickInterval, uint64_t currentTime);
+
+void
+TimerWheel_destroy(TimerWheel self);
+
+void
+TimerWheelEntry_initialize(TimerWheelEntry self);
+
+/*
+ * Schedule (or reschedule) a timer. Timers with an expiry time in the past expire with the next tick.
+ */
+void
+TimerWheel_schedule(TimerWheel self, TimerWheelEntry entry, uint64_t expiryTime);
+
+void
+TimerWheel_cancel(TimerWheel self, TimerWheelEntry entry);
+
+int
+TimerWheel_getNumberOfTimers(TimerWheel self);
+
+/*
+ * Process all ticks until currentTime and call the handler for the expired timers
+ *
+ * \return number of expired timers
+ */
+int
+TimerWheel_advance(TimerWheel self, uint64_t currentTime, TimerWheel_ExpiryHandler handler, void* parameter);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* SRC_INC_INTERNAL_TIMER_WHEEL_H_ */
@@ -1,10 +1,22 @@
 #include "unity.h"
 #include "iec60870_common.h"
+#include "cs101_asdu_template.h"
+#include "cs104_apdu_parser.h"
+#include "cs101_process_image.h"
+#include "cs101_change_detector.h"
+#include "cs101_cyclic_scheduler.h"
+#include "cs101_mirror.h"
+#include "cs101_mirror_internal.h"
 #include "cs104_slave.h"
 #include "cs104_connection.h"
+#include "cs104_client_engine.h"
+#include "cs104_reconnect_manager.h"
+#include "cs104_decode_pool.h"
+#include "cs104_receive_buffer_pool.h"
 #include "hal_time.h"
 #include "hal_thread.h"
 #include "buffer_frame.h"
+#include "timer_wheel.h"
 #include <string.h>
 #include <stdlib.h>
 
@@ -188,6 +200,9 @@ extern "C" {
 void
 CS101_ASDU_encode(CS101_ASDU self, Frame frame);
 
+bool
+CS101_ASDU_encodeToSpan(CS101_ASDU self, FrameSpan span);
+
 #ifdef __cplusplus
 }
 #endif
@@ -858,357 +873,3449 @@ test_addMaxNumberOfIOsToASDU(void)
 }
 
 void
-test_SingleEventType(void)
+test_ASDUEncodeToSpan(void)
 {
-    tSingleEvent singleEvent = 0;
+    sCS101_StaticASDU staticAsdu;
 
-    EventState eventState = SingleEvent_getEventState(&singleEvent);
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&staticAsdu, &defaultAppLayerParameters, true, CS101_COT_PERIODIC, 0, 1, false, false);
 
-    TEST_ASSERT_EQUAL_INT(IEC60870_EVENTSTATE_INDETERMINATE_0, eventState);
+    int i;
 
-    QualityDescriptorP qdp = SingleEvent_getQDP(&singleEvent);
+    for (i = 0; i < 3; i++) {
+        MeasuredValueShort io = MeasuredValueShort_create(NULL, 100 + i, 1.5f * i, IEC60870_QUALITY_GOOD);
 
-    TEST_ASSERT_EQUAL_INT(0, qdp);
+        TEST_ASSERT_TRUE(CS101_ASDU_addInformationObject(asdu, (InformationObject) io));
+
+        MeasuredValueShort_destroy(io);
+    }
+
+    /* SQ: IOA once + 3 * (4 value bytes + QDS) */
+    TEST_ASSERT_EQUAL_INT(3 + 3 * 5, CS101_ASDU_getPayloadSize(asdu));
+
+    uint8_t spanBuffer[256];
+    struct sFrameSpan span;
+
+    /* span too small -> nothing written */
+    FrameSpan_initialize(&span, spanBuffer, 0, 6 + 3 + 3 * 5 - 1);
+    TEST_ASSERT_FALSE(CS101_ASDU_encodeToSpan(asdu, &span));
+    TEST_ASSERT_EQUAL_INT(0, span.pos);
+
+    FrameSpan_initialize(&span, spanBuffer, 0, 6 + 3 + 3 * 5);
+    TEST_ASSERT_TRUE(CS101_ASDU_encodeToSpan(asdu, &span));
+    TEST_ASSERT_EQUAL_INT(6 + 3 + 3 * 5, span.pos);
+
+    /* result has to be identical to the encoding with the frame interface */
+    uint8_t frameBuffer[256];
+    struct sBufferFrame bufferFrame;
+
+    Frame frame = BufferFrame_initialize(&bufferFrame, frameBuffer, 0);
+    CS101_ASDU_encode(asdu, frame);
+
+    TEST_ASSERT_EQUAL_INT(span.pos, Frame_getMsgSize(frame));
+    TEST_ASSERT_EQUAL_UINT8_ARRAY(frameBuffer, spanBuffer, span.pos);
+
+    CS101_ASDU decoded = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, spanBuffer, span.pos);
+
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_EQUAL_INT(3, CS101_ASDU_getNumberOfElements(decoded));
+
+    MeasuredValueShort mvs = (MeasuredValueShort) CS101_ASDU_getElement(decoded, 2);
+
+    TEST_ASSERT_NOT_NULL(mvs);
+    TEST_ASSERT_EQUAL_INT(102, InformationObject_getObjectAddress((InformationObject) mvs));
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, MeasuredValueShort_getValue(mvs));
+
+    MeasuredValueShort_destroy(mvs);
+    CS101_ASDU_destroy(decoded);
 }
 
 void
-test_EventOfProtectionEquipmentWithTime(void)
+test_ASDUValidate(void)
 {
-#ifndef _WIN32
-    tSingleEvent singleEvent = 0;
-    struct sCP16Time2a elapsedTime;
-    struct sCP56Time2a timestamp;
+    sCS101_StaticASDU staticAsdu;
 
-    EventOfProtectionEquipmentWithCP56Time2a e = EventOfProtectionEquipmentWithCP56Time2a_create(NULL, 1, &singleEvent, &elapsedTime, &timestamp);
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&staticAsdu, &defaultAppLayerParameters, true, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    TEST_ASSERT_FALSE(CS101_ASDU_isValidated(asdu));
+
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        SinglePointInformation io = SinglePointInformation_create(NULL, 200 + i, (i % 2) == 1, IEC60870_QUALITY_GOOD);
+
+        TEST_ASSERT_TRUE(CS101_ASDU_addInformationObject(asdu, (InformationObject) io));
+
+        SinglePointInformation_destroy(io);
+    }
+
+    TEST_ASSERT_TRUE(CS101_ASDU_validate(asdu));
 
     uint8_t buffer[256];
+    struct sFrameSpan span;
 
-    struct sBufferFrame bf;
+    FrameSpan_initialize(&span, buffer, 0, sizeof(buffer));
+    TEST_ASSERT_TRUE(CS101_ASDU_encodeToSpan(asdu, &span));
 
-    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+    /* complete ASDU is validated when parsed */
+    CS101_ASDU decoded = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, span.pos);
 
-    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_TRUE(CS101_ASDU_isValidated(decoded));
 
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) e);
-    CS101_ASDU_addInformationObject(asdu, (InformationObject) e);
+    SinglePointInformation spi = (SinglePointInformation) CS101_ASDU_getElement(decoded, 3);
 
-    CS101_ASDU_encode(asdu, f);
+    TEST_ASSERT_NOT_NULL(spi);
+    TEST_ASSERT_EQUAL_INT(203, InformationObject_getObjectAddress((InformationObject) spi));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue(spi));
+    SinglePointInformation_destroy(spi);
 
-    InformationObject_destroy((InformationObject) e);
-    CS101_ASDU_destroy(asdu);
+    TEST_ASSERT_NULL(CS101_ASDU_getElement(decoded, 4));
+    TEST_ASSERT_NULL(CS101_ASDU_getElement(decoded, -1));
 
-    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+    CS101_ASDU_destroy(decoded);
 
-    InformationObject io = CS101_ASDU_getElement(asdu2, 1);
+    /* truncated payload is not validated and elements outside of the payload are not accessible */
+    decoded = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, span.pos - 1);
 
-    TEST_ASSERT_NOT_NULL(io);
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_FALSE(CS101_ASDU_isValidated(decoded));
 
-    EventOfProtectionEquipmentWithCP56Time2a e2 = (EventOfProtectionEquipmentWithCP56Time2a) io;
+    spi = (SinglePointInformation) CS101_ASDU_getElement(decoded, 2);
+    TEST_ASSERT_NOT_NULL(spi);
+    SinglePointInformation_destroy(spi);
 
-    SingleEvent se = EventOfProtectionEquipmentWithCP56Time2a_getEvent(e2);
+    TEST_ASSERT_NULL(CS101_ASDU_getElement(decoded, 3));
 
-    QualityDescriptorP qdp = SingleEvent_getQDP(se);
+    CS101_ASDU_destroy(decoded);
 
-    InformationObject_destroy(io);
-    CS101_ASDU_destroy(asdu2);
+    /* additional bytes are rejected as well */
+    buffer[span.pos] = 0;
 
-    TEST_ASSERT_EQUAL_INT(0, qdp);
-#endif
+    decoded = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, span.pos + 1);
+
+    TEST_ASSERT_NOT_NULL(decoded);
+    TEST_ASSERT_FALSE(CS101_ASDU_isValidated(decoded));
+
+    CS101_ASDU_destroy(decoded);
+
+    /* changing the ASDU resets the state */
+    CS101_ASDU_setSequence(asdu, false);
+    TEST_ASSERT_FALSE(CS101_ASDU_isValidated(asdu));
+    TEST_ASSERT_FALSE(CS101_ASDU_validate(asdu));
 }
 
-struct test_CS104SlaveConnectionIsRedundancyGroup_Info
+void
+test_APDUParser(void)
 {
-    bool running;
-    CS104_Slave slave;
-};
+    uint8_t stream[] = {
+        0x68, 0x0e, 0x04, 0x00, 0x06, 0x00, 0x64, 0x01, 0x06, 0x00, 0x01, 0x00, 0x00, 0x00, 0x00, 0x14, /* I(2,3) C_IC_NA_1 */
+        0x68, 0x04, 0x01, 0x00, 0x0a, 0x00, /* S(5) */
+        0x68, 0x04, 0x07, 0x00, 0x00, 0x00  /* STARTDT act */
+    };
 
-static void*
-test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction(void* parameter)
-{
-    struct test_CS104SlaveConnectionIsRedundancyGroup_Info* info =  (struct test_CS104SlaveConnectionIsRedundancyGroup_Info*) parameter;
+    int chunkSize;
 
-    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(info->slave);
+    /* deliver the stream in chunks of all sizes */
+    for (chunkSize = 1; chunkSize <= (int) sizeof(stream); chunkSize++) {
+        sCS104_APDUParser parser;
+        CS104_APDUParser_initialize(&parser);
 
-    int16_t scaledValue = 0;
+        sCS104_APDU apdus[3];
+        uint8_t copies[3][16];
+        int numberOfApdus = 0;
+        int chunkStart;
 
-    while (info->running) {
+        for (chunkStart = 0; chunkStart < (int) sizeof(stream); chunkStart += chunkSize) {
+            int size = (int) sizeof(stream) - chunkStart;
+            int pos = 0;
 
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_PERIODIC, 0, 1, false, false);
+            if (size > chunkSize)
+                size = chunkSize;
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+            while (pos < size) {
+                int bytesConsumed;
 
-        scaledValue++;
+                CS104_APDUParserResult result = CS104_APDUParser_parse(&parser, stream + chunkStart + pos, size - pos, &bytesConsumed, &(apdus[numberOfApdus]));
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+                TEST_ASSERT_NOT_EQUAL(CS104_APDU_PARSER_ERROR, result);
+                TEST_ASSERT_TRUE(bytesConsumed > 0);
 
-        InformationObject_destroy(io);
+                pos += bytesConsumed;
 
-        CS104_Slave_enqueueASDU(info->slave, newAsdu);
+                if (result == CS104_APDU_PARSER_APDU_COMPLETE) {
+                    TEST_ASSERT_TRUE(numberOfApdus < 3);
+                    memcpy(copies[numberOfApdus], apdus[numberOfApdus].apdu, apdus[numberOfApdus].apduSize);
+                    numberOfApdus++;
+                }
+            }
+        }
 
-        CS101_ASDU_destroy(newAsdu);
+        TEST_ASSERT_EQUAL_INT(3, numberOfApdus);
+        TEST_ASSERT_FALSE(CS104_APDUParser_hasPartialAPDU(&parser));
 
-        Thread_sleep(10);
+        TEST_ASSERT_EQUAL_INT(CS104_APDU_FORMAT_I, apdus[0].format);
+        TEST_ASSERT_EQUAL_INT(16, apdus[0].apduSize);
+        TEST_ASSERT_EQUAL_INT(2, apdus[0].sendSequenceNumber);
+        TEST_ASSERT_EQUAL_INT(3, apdus[0].receiveSequenceNumber);
+        TEST_ASSERT_EQUAL_INT(10, apdus[0].asduSize);
+        TEST_ASSERT_EQUAL_UINT8_ARRAY(stream, copies[0], 16);
+
+        TEST_ASSERT_EQUAL_INT(CS104_APDU_FORMAT_S, apdus[1].format);
+        TEST_ASSERT_EQUAL_INT(5, apdus[1].receiveSequenceNumber);
+
+        TEST_ASSERT_EQUAL_INT(CS104_APDU_FORMAT_U, apdus[2].format);
+        TEST_ASSERT_EQUAL_INT(0x07, apdus[2].controlField);
     }
 
-    return NULL;
+    /* the complete ASDU of an I frame can be parsed */
+    sCS104_APDUParser parser;
+    sCS104_APDU apdu;
+    int bytesConsumed;
+
+    CS104_APDUParser_initialize(&parser);
+
+    TEST_ASSERT_EQUAL_INT(CS104_APDU_PARSER_APDU_COMPLETE, CS104_APDUParser_parse(&parser, stream, sizeof(stream), &bytesConsumed, &apdu));
+    TEST_ASSERT_EQUAL_INT(16, bytesConsumed);
+
+    CS101_ASDU asdu = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, apdu.asdu, apdu.asduSize);
+
+    TEST_ASSERT_NOT_NULL(asdu);
+    TEST_ASSERT_EQUAL_INT(C_IC_NA_1, CS101_ASDU_getTypeID(asdu));
+    CS101_ASDU_destroy(asdu);
+
+    /* invalid start byte */
+    uint8_t invalidStart[] = { 0x67, 0x04, 0x01, 0x00, 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_INT(CS104_APDU_PARSER_ERROR, CS104_APDUParser_parse(&parser, invalidStart, sizeof(invalidStart), &bytesConsumed, &apdu));
+
+    /* length too small (split after the start byte) */
+    uint8_t invalidLength[] = { 0x68, 0x03, 0x01, 0x00, 0x00 };
+    TEST_ASSERT_EQUAL_INT(CS104_APDU_PARSER_NEED_MORE_DATA, CS104_APDUParser_parse(&parser, invalidLength, 1, &bytesConsumed, &apdu));
+    TEST_ASSERT_TRUE(CS104_APDUParser_hasPartialAPDU(&parser));
+    TEST_ASSERT_EQUAL_INT(CS104_APDU_PARSER_ERROR, CS104_APDUParser_parse(&parser, invalidLength + 1, sizeof(invalidLength) - 1, &bytesConsumed, &apdu));
+    TEST_ASSERT_FALSE(CS104_APDUParser_hasPartialAPDU(&parser));
 }
 
 void
-test_CS104SlaveConnectionIsRedundancyGroup()
+test_ProcessImage(void)
 {
-    CS104_Slave slave = CS104_Slave_create(100, 100);
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(1000);
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    TEST_ASSERT_NOT_NULL(processImage);
 
-    CS104_Slave_start(slave);
+    int i;
 
-    struct test_CS104SlaveConnectionIsRedundancyGroup_Info info;
-    info.running = true;
-    info.slave = slave;
+    for (i = 0; i < 1000; i++) {
+        TypeID typeId = (i < 500) ? M_SP_NA_1 : M_ME_TF_1;
 
-    Thread enqueueThread = Thread_create(test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction, &info, false);
-    Thread_start(enqueueThread);
+        TEST_ASSERT_EQUAL_INT(i, CS101_ProcessImage_addPoint(processImage, 1 + (i % 2), 100 + i, typeId));
+    }
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+    /* process image is full, duplicates and unsupported types are rejected */
+    TEST_ASSERT_EQUAL_INT(-1, CS101_ProcessImage_addPoint(processImage, 1, 5000, M_SP_NA_1));
+    TEST_ASSERT_EQUAL_INT(1000, CS101_ProcessImage_getNumberOfPoints(processImage));
 
-    int i;
+    for (i = 0; i < 1000; i++)
+        TEST_ASSERT_EQUAL_INT(i, CS101_ProcessImage_lookup(processImage, 1 + (i % 2), 100 + i));
 
-    for (i = 0; i < 50; i++) {
-        bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_EQUAL_INT(-1, CS101_ProcessImage_lookup(processImage, 2, 100));
+    TEST_ASSERT_EQUAL_INT(-1, CS101_ProcessImage_lookup(processImage, 1, 99));
 
-        TEST_ASSERT_TRUE(result);
+    int spIndex = CS101_ProcessImage_lookup(processImage, 1, 110);
+    int mvIndex = CS101_ProcessImage_lookup(processImage, 2, 701);
 
-        CS104_Connection_sendStartDT(con);
+    /* new points are invalid */
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, CS101_ProcessImage_getQuality(processImage, spIndex));
 
-        Thread_sleep(10);
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateSinglePoint(processImage, spIndex, true, IEC60870_QUALITY_GOOD, 1700000000000ULL));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_updateShortValue(processImage, spIndex, 1.0f, IEC60870_QUALITY_GOOD, 0));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_updateSinglePoint(processImage, 1000, true, IEC60870_QUALITY_GOOD, 0));
 
-        CS104_Connection_close(con);
-    }
+    TEST_ASSERT_TRUE(CS101_ProcessImage_getSinglePointValue(processImage, spIndex));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, CS101_ProcessImage_getQuality(processImage, spIndex));
+    TEST_ASSERT_EQUAL_UINT64(1700000000000ULL, CS101_ProcessImage_getTimestamp(processImage, spIndex));
 
-    info.running = false;
-    Thread_destroy(enqueueThread);
+    /* timestamp 0 -> current time */
+    uint64_t before = Hal_getTimeInMs();
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateShortValue(processImage, mvIndex, 12.5f, IEC60870_QUALITY_OVERFLOW, 0));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_getTimestamp(processImage, mvIndex) >= before);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, CS101_ProcessImage_getFloatValue(processImage, mvIndex));
 
-    CS104_Connection_destroy(con);
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateQuality(processImage, mvIndex, IEC60870_QUALITY_INVALID, 1700000005000ULL));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, CS101_ProcessImage_getQuality(processImage, mvIndex));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, CS101_ProcessImage_getFloatValue(processImage, mvIndex));
 
-    CS104_Slave_destroy(slave);
+    /* points are encoded with their type */
+    sCS101_StaticASDU staticAsdu;
+
+    CS101_ASDU asdu = CS101_ASDU_initializeStatic(&staticAsdu, &defaultAppLayerParameters, false, CS101_COT_INTERROGATED_BY_STATION, 0, 2, false, false);
+
+    TEST_ASSERT_TRUE(CS101_ProcessImage_addToASDU(processImage, mvIndex, asdu));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_addToASDU(processImage, spIndex, asdu));
+    TEST_ASSERT_EQUAL_INT(M_ME_TF_1, CS101_ASDU_getTypeID(asdu));
+
+    MeasuredValueShortWithCP56Time2a mv = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(asdu, 0);
+
+    TEST_ASSERT_NOT_NULL(mv);
+    TEST_ASSERT_EQUAL_INT(701, InformationObject_getObjectAddress((InformationObject) mv));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort) mv));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, MeasuredValueShort_getQuality((MeasuredValueShort) mv));
+    TEST_ASSERT_EQUAL_UINT64(1700000005000ULL, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mv)));
+
+    MeasuredValueShortWithCP56Time2a_destroy(mv);
+
+    CS101_ProcessImage_destroy(processImage);
 }
 
 void
-test_CS104SlaveSingleRedundancyGroup()
+test_ProcessImagePointTypes(void)
 {
-    CS104_Slave slave = CS104_Slave_create(100, 100);
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(10);
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    int st = CS101_ProcessImage_addPoint(processImage, 1, 1, M_ST_NA_1);
+    int it = CS101_ProcessImage_addPoint(processImage, 1, 2, M_IT_TB_1);
+    int dp = CS101_ProcessImage_addPoint(processImage, 1, 3, M_DP_TB_1);
 
-    CS104_Slave_start(slave);
+    TEST_ASSERT_EQUAL_INT(-1, CS101_ProcessImage_addPoint(processImage, 1, 4, C_SC_NA_1));
+    TEST_ASSERT_EQUAL_INT(-1, CS101_ProcessImage_addPoint(processImage, 1, 3, M_SP_NA_1));
 
-    struct test_CS104SlaveConnectionIsRedundancyGroup_Info info;
-    info.running = true;
-    info.slave = slave;
+    /* integrated totals are not part of the station interrogation */
+    TEST_ASSERT_TRUE(CS101_ProcessImage_isInGroup(processImage, st, 0));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_isInGroup(processImage, it, 0));
 
-    Thread enqueueThread = Thread_create(test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction, &info, false);
-    Thread_start(enqueueThread);
+    TEST_ASSERT_TRUE(CS101_ProcessImage_addToGroup(processImage, dp, 16));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_addToGroup(processImage, dp, 17));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_addToGroup(processImage, 3, 1));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_isInGroup(processImage, dp, 16));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_removeFromGroup(processImage, dp, 16));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_isInGroup(processImage, dp, 16));
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+    bool isTransient = false;
 
-    int i;
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateStepPosition(processImage, st, -12, true, IEC60870_QUALITY_GOOD, 0));
+    TEST_ASSERT_EQUAL_INT(-12, CS101_ProcessImage_getStepPositionValue(processImage, st, &isTransient));
+    TEST_ASSERT_TRUE(isTransient);
 
-    for (i = 0; i < 50; i++) {
-        bool result = CS104_Connection_connect(con);
-        TEST_ASSERT_TRUE(result);
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateDoublePoint(processImage, dp, IEC60870_DOUBLE_POINT_ON, IEC60870_QUALITY_BLOCKED, 0));
+    TEST_ASSERT_EQUAL_INT(IEC60870_DOUBLE_POINT_ON, CS101_ProcessImage_getDoublePointValue(processImage, dp));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_BLOCKED, CS101_ProcessImage_getQuality(processImage, dp));
 
-        CS104_Connection_sendStartDT(con);
+    struct sBinaryCounterReading bcr;
+    BinaryCounterReading_create(&bcr, 123456, 7, true, false, false);
 
-        CS104_Connection_close(con);
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, CS101_ProcessImage_getQuality(processImage, it));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateIntegratedTotals(processImage, it, &bcr, 0));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, CS101_ProcessImage_getQuality(processImage, it));
 
-        Thread_sleep(10);
-    }
+    TEST_ASSERT_TRUE(CS101_ProcessImage_updateQuality(processImage, it, IEC60870_QUALITY_INVALID, 0));
 
-    info.running = false;
-    Thread_destroy(enqueueThread);
+    struct sBinaryCounterReading result;
+    TEST_ASSERT_TRUE(CS101_ProcessImage_getIntegratedTotals(processImage, it, &result));
+    TEST_ASSERT_EQUAL_INT(123456, BinaryCounterReading_getValue(&result));
+    TEST_ASSERT_EQUAL_INT(7, BinaryCounterReading_getSequenceNumber(&result));
+    TEST_ASSERT_TRUE(BinaryCounterReading_hasCarry(&result));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(&result));
 
-    CS104_Connection_destroy(con);
+    InformationObject io = CS101_ProcessImage_getInformationObject(processImage, st, NULL);
 
-    CS104_Slave_destroy(slave);
-}
+    TEST_ASSERT_NOT_NULL(io);
+    TEST_ASSERT_EQUAL_INT(M_ST_NA_1, InformationObject_getType(io));
+    TEST_ASSERT_EQUAL_INT(-12, StepPositionInformation_getValue((StepPositionInformation) io));
 
-static void
-test_CS104SlaveSingleRedundancyGroupMultipleConnectionsEventHandler(void* parameter, IMasterConnection connection, CS104_PeerConnectionEvent event)
-{
-    char ipAddrBuf[100];
-    ipAddrBuf[0] = 0;
+    InformationObject_destroy(io);
 
-    IMasterConnection_getPeerAddress(connection, ipAddrBuf, 100);
+    CS101_ProcessImage_destroy(processImage);
 }
 
 void
-test_CS104SlaveSingleRedundancyGroupMultipleConnections()
+test_ProcessImageCounterFreeze(void)
 {
-    CS104_Slave slave = CS104_Slave_create(100, 100);
-
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(10);
 
-    CS104_Slave_start(slave);
-    CS104_Slave_setMaxOpenConnections(slave, 20);
-    CS104_Slave_setConnectionEventHandler(slave, test_CS104SlaveSingleRedundancyGroupMultipleConnectionsEventHandler, NULL);
+    int counter1 = CS101_ProcessImage_addPoint(processImage, 1, 100, M_IT_NA_1);
+    int counter2 = CS101_ProcessImage_addPoint(processImage, 1, 101, M_IT_TB_1);
+    int counter3 = CS101_ProcessImage_addPoint(processImage, 2, 100, M_IT_NA_1);
+    int singlePoint = CS101_ProcessImage_addPoint(processImage, 1, 1, M_SP_NA_1);
 
-    struct test_CS104SlaveConnectionIsRedundancyGroup_Info info;
-    info.running = true;
-    info.slave = slave;
+    TEST_ASSERT_TRUE(CS101_ProcessImage_addToCounterGroup(processImage, counter2, 1));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_addToCounterGroup(processImage, counter2, 5));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_addToCounterGroup(processImage, singlePoint, 1));
 
-    CS104_Connection cons[3];
-    int conState[3]; /* 0 = idle, 1 = connected, 2 = START_DT sent */
+    struct sBinaryCounterReading bcr;
+    uint64_t frozenTime;
 
-    cons[0] = CS104_Connection_create("127.0.0.1", 20004);
-    cons[1] = CS104_Connection_create("127.0.0.1", 20004);
-    cons[2] = CS104_Connection_create("127.0.0.1", 20004);
+    /* frozen value is invalid before the first freeze */
+    TEST_ASSERT_TRUE(CS101_ProcessImage_getFrozenIntegratedTotals(processImage, counter1, &bcr, NULL));
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(&bcr));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_getFrozenIntegratedTotals(processImage, singlePoint, &bcr, NULL));
 
-    conState[0] = 0;
-    conState[1] = 0;
-    conState[2] = 0;
+    BinaryCounterReading_create(&bcr, 1000, 0, false, false, false);
+    CS101_ProcessImage_updateIntegratedTotals(processImage, counter1, &bcr, 0);
+    BinaryCounterReading_create(&bcr, 2000, 0, false, false, false);
+    CS101_ProcessImage_updateIntegratedTotals(processImage, counter2, &bcr, 0);
+    BinaryCounterReading_create(&bcr, 3000, 0, false, false, false);
+    CS101_ProcessImage_updateIntegratedTotals(processImage, counter3, &bcr, 0);
 
-    Thread enqueueThread = Thread_create(test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction, &info, false);
-    Thread_start(enqueueThread);
+    /* general freeze of CA 1 */
+    TEST_ASSERT_EQUAL_INT(2, CS101_ProcessImage_freezeCounters(processImage, 1, 0, false, 1700000000000ULL));
 
-    int i;
-    for (i = 0; i < 200; i++)
-    {
-       // printf("round %i\n", i);
+    CS101_ProcessImage_getFrozenIntegratedTotals(processImage, counter1, &bcr, &frozenTime);
+    TEST_ASSERT_EQUAL_INT(1000, BinaryCounterReading_getValue(&bcr));
+    TEST_ASSERT_EQUAL_INT(1, BinaryCounterReading_getSequenceNumber(&bcr));
+    TEST_ASSERT_FALSE(BinaryCounterReading_isInvalid(&bcr));
+    TEST_ASSERT_EQUAL_UINT64(1700000000000ULL, frozenTime);
 
-        int con = rand() % 3;
+    CS101_ProcessImage_getFrozenIntegratedTotals(processImage, counter3, &bcr, NULL);
+    TEST_ASSERT_TRUE(BinaryCounterReading_isInvalid(&bcr));
 
-        if (conState[con] == 0) {
-            bool result = CS104_Connection_connect(cons[con]);
-            TEST_ASSERT_TRUE(result);
-            conState[con] = 1;
-        }
-        else if (conState[con] == 1) {
-            CS104_Connection_sendStartDT(cons[con]);
-            conState[con] = 2;
-        }
-        else if (conState[con] == 2) {
-            CS104_Connection_close(cons[con]);
-            conState[con] = 0;
-        }
+    /* running value changes, frozen value is kept */
+    BinaryCounterReading_create(&bcr, 1500, 0, false, false, false);
+    CS101_ProcessImage_updateIntegratedTotals(processImage, counter1, &bcr, 0);
 
-        Thread_sleep(50);
-    }
+    CS101_ProcessImage_getFrozenIntegratedTotals(processImage, counter1, &bcr, NULL);
+    TEST_ASSERT_EQUAL_INT(1000, BinaryCounterReading_getValue(&bcr));
 
-    CS104_Connection_destroy(cons[0]);
-    CS104_Connection_destroy(cons[1]);
-    CS104_Connection_destroy(cons[2]);
+    /* freeze counter group 1 with reset */
+    TEST_ASSERT_EQUAL_INT(1, CS101_ProcessImage_freezeCounters(processImage, -1, 1, true, 0));
 
-    info.running = false;
-    Thread_destroy(enqueueThread);
+    CS101_ProcessImage_getFrozenIntegratedTotals(processImage, counter2, &bcr, NULL);
+    TEST_ASSERT_EQUAL_INT(2000, BinaryCounterReading_getValue(&bcr));
+    TEST_ASSERT_EQUAL_INT(2, BinaryCounterReading_getSequenceNumber(&bcr));
 
-    CS104_Slave_destroy(slave);
-}
+    CS101_ProcessImage_getIntegratedTotals(processImage, counter2, &bcr);
+    TEST_ASSERT_EQUAL_INT(0, BinaryCounterReading_getValue(&bcr));
 
-struct stest_CS104SlaveEventQueue1 {
-    int asduHandlerCalled;
-    int spontCount;
-    int16_t lastScaledValue;
-};
+    /* the application continues with the absolute counter value */
+    BinaryCounterReading_create(&bcr, 2025, 0, false, false, false);
+    CS101_ProcessImage_updateIntegratedTotals(processImage, counter2, &bcr, 0);
 
-static bool
-test_CS104SlaveEventQueue1_asduReceivedHandler (void* parameter, int address, CS101_ASDU asdu)
-{
-    struct stest_CS104SlaveEventQueue1* info = (struct stest_CS104SlaveEventQueue1*) parameter;
+    CS101_ProcessImage_getIntegratedTotals(processImage, counter2, &bcr);
+    TEST_ASSERT_EQUAL_INT(25, BinaryCounterReading_getValue(&bcr));
 
-    info->asduHandlerCalled++;
+    TEST_ASSERT_EQUAL_INT(3, CS101_ProcessImage_freezeCounters(processImage, -1, 0, false, 0));
 
-    if (CS101_ASDU_getCOT(asdu) == CS101_COT_SPONTANEOUS)
-    {
-        info->spontCount++;
+    CS101_ProcessImage_getFrozenIntegratedTotals(processImage, counter1, &bcr, NULL);
+    TEST_ASSERT_EQUAL_INT(1500, BinaryCounterReading_getValue(&bcr));
+    TEST_ASSERT_EQUAL_INT(2, BinaryCounterReading_getSequenceNumber(&bcr));
 
-        if (CS101_ASDU_getTypeID(asdu) == M_ME_NB_1)
-        {
-            static uint8_t ioBuf[250];
+    CS101_ProcessImage_getFrozenIntegratedTotals(processImage, counter2, &bcr, NULL);
+    TEST_ASSERT_EQUAL_INT(25, BinaryCounterReading_getValue(&bcr));
 
-            MeasuredValueScaled mv = (MeasuredValueScaled) CS101_ASDU_getElementEx(asdu, (InformationObject) ioBuf, 0);
+    /* reset without freeze */
+    TEST_ASSERT_EQUAL_INT(1, CS101_ProcessImage_resetCounters(processImage, 2, 0));
 
-            info->lastScaledValue = MeasuredValueScaled_getValue(mv);
-        }
-    }
+    CS101_ProcessImage_getIntegratedTotals(processImage, counter3, &bcr);
+    TEST_ASSERT_EQUAL_INT(0, BinaryCounterReading_getValue(&bcr));
 
-    return true;
+    CS101_ProcessImage_destroy(processImage);
 }
 
-struct sTestMessageQueueEntryInfo {
-	uint64_t entryTimestamp;
-	unsigned int entryState : 2;
-	unsigned int size : 8;
-};
-
 void
-test_CS104SlaveEventQueue1()
+test_ProcessImageHistory(void)
 {
-    CS104_Slave slave = CS104_Slave_create(10, 10);
+    TEST_ASSERT_EQUAL_UINT64(100000ULL * 64 * 13 + 100000 * 4, (uint64_t) CS101_ProcessImage_getHistoryMemorySize(100000, 64));
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(10);
 
-    CS104_Slave_start(slave);
+    int mv = CS101_ProcessImage_addPoint(processImage, 1, 100, M_ME_NC_1);
+    int sp = CS101_ProcessImage_addPoint(processImage, 1, 1, M_SP_NA_1);
 
-    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+    TEST_ASSERT_EQUAL_INT(0, CS101_ProcessImage_getHistoryLength(processImage, mv));
+    TEST_ASSERT_NULL(CS101_ProcessImage_getHistoryInformationObject(processImage, mv, 0, NULL));
 
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
+    TEST_ASSERT_FALSE(CS101_ProcessImage_enableHistory(processImage, 0));
+    TEST_ASSERT_TRUE(CS101_ProcessImage_enableHistory(processImage, 4));
+    TEST_ASSERT_FALSE(CS101_ProcessImage_enableHistory(processImage, 4));
 
-    int16_t scaledValue = 0;
+    int i;
 
-    for (int i = 0; i < 15; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+    for (i = 1; i <= 6; i++)
+        CS101_ProcessImage_updateShortValue(processImage, mv, (float) i, IEC60870_QUALITY_GOOD, 1700000000000ULL + i);
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+    /* an update without change is not recorded */
+    CS101_ProcessImage_updateShortValue(processImage, mv, 6.0f, IEC60870_QUALITY_GOOD, 1700000000100ULL);
 
-        scaledValue++;
+    TEST_ASSERT_EQUAL_INT(4, CS101_ProcessImage_getHistoryLength(processImage, mv));
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+    InformationObject io = CS101_ProcessImage_getHistoryInformationObject(processImage, mv, 0, NULL);
 
-        InformationObject_destroy(io);
+    TEST_ASSERT_NOT_NULL(io);
+    TEST_ASSERT_EQUAL_INT(M_ME_TF_1, InformationObject_getType(io));
+    TEST_ASSERT_EQUAL_INT(100, InformationObject_getObjectAddress(io));
+    TEST_ASSERT_EQUAL_FLOAT(6.0f, MeasuredValueShort_getValue((MeasuredValueShort) io));
+    TEST_ASSERT_EQUAL_UINT64(1700000000006ULL,
+            CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp((MeasuredValueShortWithCP56Time2a) io)));
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+    InformationObject_destroy(io);
 
-        CS101_ASDU_destroy(newAsdu);
-    }
+    /* oldest entry - older changes have been overwritten */
+    io = CS101_ProcessImage_getHistoryInformationObject(processImage, mv, 3, NULL);
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, MeasuredValueShort_getValue((MeasuredValueShort) io));
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+    InformationObject_destroy(io);
 
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    TEST_ASSERT_NULL(CS101_ProcessImage_getHistoryInformationObject(processImage, mv, 4, NULL));
+
+    /* quality changes are recorded */
+    CS101_ProcessImage_updateSinglePoint(processImage, sp, true, IEC60870_QUALITY_GOOD, 1000);
+    CS101_ProcessImage_updateQuality(processImage, sp, IEC60870_QUALITY_INVALID, 2000);
+
+    TEST_ASSERT_EQUAL_INT(2, CS101_ProcessImage_getHistoryLength(processImage, sp));
+
+    io = CS101_ProcessImage_getHistoryInformationObject(processImage, sp, 0, NULL);
+
+    TEST_ASSERT_EQUAL_INT(M_SP_TB_1, InformationObject_getType(io));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue((SinglePointInformation) io));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, SinglePointInformation_getQuality((SinglePointInformation) io));
+
+    InformationObject_destroy(io);
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+#define TEST_CONCURRENT_UPDATE_POINTS 200
+#define TEST_CONCURRENT_UPDATE_BASE_TIME 1700000000000ULL
+
+void
+test_ProcessImageQualityFlags(void)
+{
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(200);
+
+    int i;
+
+    for (i = 0; i < 100; i++)
+        CS101_ProcessImage_addPoint(processImage, 1, 1000 + i, M_ME_NC_1);
+
+    for (i = 0; i < 50; i++)
+        CS101_ProcessImage_addPoint(processImage, 2, 1000 + i, M_SP_NA_1);
+
+    int counter = CS101_ProcessImage_addPoint(processImage, 1, 5000, M_IT_NA_1);
+
+    CS101_ProcessImage_addToGroup(processImage, 100, 3);
+    CS101_ProcessImage_addToGroup(processImage, 101, 3);
+
+    /* new points are invalid */
+    TEST_ASSERT_EQUAL_INT(151, CS101_ProcessImage_setQualityFlags(processImage, -1, 0, 0xffffff, IEC60870_QUALITY_INVALID, false, 500));
+
+    /* IOA range crossing a block boundary - only the points of CA 1 */
+    TEST_ASSERT_EQUAL_INT(70, CS101_ProcessImage_setQualityFlags(processImage, 1, 1010, 1079, IEC60870_QUALITY_INVALID, true, 1000));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, CS101_ProcessImage_getQuality(processImage, 9));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, CS101_ProcessImage_getQuality(processImage, 10));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, CS101_ProcessImage_getQuality(processImage, 79));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, CS101_ProcessImage_getQuality(processImage, 80));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, CS101_ProcessImage_getQuality(processImage, 110));
+    TEST_ASSERT_EQUAL_UINT64(1000, CS101_ProcessImage_getTimestamp(processImage, 10));
+
+    /* already set flags are not counted as change */
+    TEST_ASSERT_EQUAL_INT(0, CS101_ProcessImage_setQualityFlags(processImage, 1, 1010, 1079, IEC60870_QUALITY_INVALID, true, 2000));
+    TEST_ASSERT_EQUAL_UINT64(1000, CS101_ProcessImage_getTimestamp(processImage, 10));
+
+    /* all CAs */
+    TEST_ASSERT_EQUAL_INT(20, CS101_ProcessImage_setQualityFlags(processImage, -1, 1000, 1009, IEC60870_QUALITY_NON_TOPICAL, true, 3000));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_NON_TOPICAL, CS101_ProcessImage_getQuality(processImage, 100));
+
+    /* group selection */
+    TEST_ASSERT_EQUAL_INT(2, CS101_ProcessImage_setQualityFlagsOfGroup(processImage, 2, 3, IEC60870_QUALITY_BLOCKED, true, 4000));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_NON_TOPICAL | IEC60870_QUALITY_BLOCKED, CS101_ProcessImage_getQuality(processImage, 100));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_NON_TOPICAL, CS101_ProcessImage_getQuality(processImage, 102));
+    TEST_ASSERT_EQUAL_INT(0, CS101_ProcessImage_setQualityFlagsOfGroup(processImage, 1, 3, IEC60870_QUALITY_BLOCKED, true, 4000));
+    TEST_ASSERT_EQUAL_INT(0, CS101_ProcessImage_setQualityFlagsOfGroup(processImage, 1, 17, IEC60870_QUALITY_BLOCKED, true, 4000));
+
+    /* clear flags */
+    TEST_ASSERT_EQUAL_INT(70, CS101_ProcessImage_setQualityFlags(processImage, 1, 0, 0xffffff, IEC60870_QUALITY_INVALID, false, 5000));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, CS101_ProcessImage_getQuality(processImage, 10));
+
+    /* integrated totals only support the invalid flag */
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, CS101_ProcessImage_getQuality(processImage, counter));
+    TEST_ASSERT_EQUAL_INT(0, CS101_ProcessImage_setQualityFlags(processImage, 1, 5000, 5000, IEC60870_QUALITY_BLOCKED, true, 6000));
+    TEST_ASSERT_EQUAL_INT(1, CS101_ProcessImage_setQualityFlags(processImage, 1, 5000, 5000,
+            IEC60870_QUALITY_INVALID | IEC60870_QUALITY_BLOCKED, true, 6000));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_INVALID, CS101_ProcessImage_getQuality(processImage, counter));
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_ProcessImageConcurrentUpdate {
+    CS101_ProcessImage processImage;
+    volatile bool running;
+    int updates;
+};
+
+static void*
+test_ProcessImageConcurrentUpdate_writerThread(void* parameter)
+{
+    struct stest_ProcessImageConcurrentUpdate* info = (struct stest_ProcessImageConcurrentUpdate*) parameter;
+
+    int value = 0;
+
+    while (info->running) {
+        int i;
+
+        value++;
+
+        /* value and timestamp are written together and have to be read together */
+        for (i = 0; i < TEST_CONCURRENT_UPDATE_POINTS; i++)
+            CS101_ProcessImage_updateShortValue(info->processImage, i, (float) value, IEC60870_QUALITY_GOOD,
+                    TEST_CONCURRENT_UPDATE_BASE_TIME + value);
+
+        info->updates++;
+    }
+
+    return NULL;
+}
+
+void
+test_ProcessImageConcurrentUpdate(void)
+{
+    struct stest_ProcessImageConcurrentUpdate info;
+    int i;
+
+    info.processImage = CS101_ProcessImage_create(TEST_CONCURRENT_UPDATE_POINTS);
+    info.running = true;
+    info.updates = 0;
+
+    for (i = 0; i < TEST_CONCURRENT_UPDATE_POINTS; i++)
+        CS101_ProcessImage_addPoint(info.processImage, 1, 1000 + i, M_ME_TF_1);
+
+    Thread writer = Thread_create(test_ProcessImageConcurrentUpdate_writerThread, &info, false);
+    Thread_start(writer);
+
+    InformationObject io = (InformationObject) malloc(InformationObject_getMaxSizeInMemory());
+
+    int reads = 0;
+    int inconsistentReads = 0;
+
+    uint64_t endTime = Hal_getTimeInMs() + 200;
+
+    while (Hal_getTimeInMs() < endTime) {
+        for (i = 0; i < TEST_CONCURRENT_UPDATE_POINTS; i++) {
+            MeasuredValueShortWithCP56Time2a mv =
+                    (MeasuredValueShortWithCP56Time2a) CS101_ProcessImage_getInformationObject(info.processImage, i, io);
+
+            int value = (int) MeasuredValueShort_getValue((MeasuredValueShort) mv);
+            uint64_t timestamp = CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(mv));
+
+            if (value != 0) {
+                if (timestamp != TEST_CONCURRENT_UPDATE_BASE_TIME + value)
+                    inconsistentReads++;
+
+                reads++;
+            }
+        }
+    }
+
+    info.running = false;
+    Thread_destroy(writer);
+
+    free(io);
+
+    TEST_ASSERT_TRUE(reads > 0);
+    TEST_ASSERT_TRUE(info.updates > 0);
+    TEST_ASSERT_EQUAL_INT(0, inconsistentReads);
+
+    CS101_ProcessImage_destroy(info.processImage);
+}
+
+struct stest_ChangeDetector {
+    int asduCount;
+    int objectCount;
+    TypeID lastTypeId;
+    int lastCA;
+    int lastIOA;
+};
+
+static void
+test_ChangeDetector_eventHandler(void* parameter, CS101_ASDU asdu)
+{
+    struct stest_ChangeDetector* info = (struct stest_ChangeDetector*) parameter;
+
+    TEST_ASSERT_EQUAL_INT(CS101_COT_SPONTANEOUS, CS101_ASDU_getCOT(asdu));
+
+    info->asduCount++;
+    info->objectCount += CS101_ASDU_getNumberOfElements(asdu);
+    info->lastTypeId = CS101_ASDU_getTypeID(asdu);
+    info->lastCA = CS101_ASDU_getCA(asdu);
+
+    InformationObject io = CS101_ASDU_getElement(asdu, CS101_ASDU_getNumberOfElements(asdu) - 1);
+    info->lastIOA = InformationObject_getObjectAddress(io);
+    InformationObject_destroy(io);
+}
+
+void
+test_ChangeDetector(void)
+{
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(100);
+
+    int indices[10];
+    float values[10];
+    bool spValues[2] = { false, false };
+    QualityDescriptor qualities[10];
+
+    int i;
+
+    for (i = 0; i < 10; i++) {
+        indices[i] = CS101_ProcessImage_addPoint(processImage, 1, 100 + i, M_ME_NC_1);
+        values[i] = 10.f;
+        qualities[i] = IEC60870_QUALITY_GOOD;
+    }
+
+    int spIndices[2];
+    spIndices[0] = CS101_ProcessImage_addPoint(processImage, 2, 1, M_SP_NA_1);
+    spIndices[1] = CS101_ProcessImage_addPoint(processImage, 2, 2, M_SP_NA_1);
+
+    CS101_ChangeDetector detector = CS101_ChangeDetector_create(processImage, &defaultAppLayerParameters);
+
+    TEST_ASSERT_NOT_NULL(detector);
+
+    struct stest_ChangeDetector info;
+    memset(&info, 0, sizeof(info));
+
+    CS101_ChangeDetector_setEventHandler(detector, test_ChangeDetector_eventHandler, &info);
+
+    for (i = 0; i < 8; i++)
+        TEST_ASSERT_TRUE(CS101_ChangeDetector_setDeadband(detector, indices[i], CS101_DEADBAND_ABSOLUTE, 1.0f));
+
+    TEST_ASSERT_TRUE(CS101_ChangeDetector_setPercentDeadband(detector, indices[8], 1.0f, 0.f, 200.f));
+    TEST_ASSERT_TRUE(CS101_ChangeDetector_setDeadband(detector, indices[9], CS101_DEADBAND_INTEGRATED, 10.f));
+
+    TEST_ASSERT_TRUE(CS101_ChangeDetector_setEventType(detector, spIndices[0], M_SP_TB_1));
+    TEST_ASSERT_TRUE(CS101_ChangeDetector_setEventType(detector, spIndices[1], M_SP_TB_1));
+    TEST_ASSERT_FALSE(CS101_ChangeDetector_setEventType(detector, spIndices[1], M_ME_TF_1));
+
+    uint64_t timestamp = 1700000000000ULL;
+
+    /* first sample only sets the reference values */
+    TEST_ASSERT_EQUAL_INT(0, CS101_ChangeDetector_updateFloatValues(detector, indices, values, NULL, 10, timestamp));
+    TEST_ASSERT_EQUAL_INT(0, CS101_ChangeDetector_updateSinglePoints(detector, spIndices, spValues, NULL, 2, timestamp));
+    TEST_ASSERT_EQUAL_INT(0, info.asduCount);
+    TEST_ASSERT_EQUAL_FLOAT(10.f, CS101_ProcessImage_getFloatValue(processImage, indices[0]));
+
+    /* points 0 - 3 inside deadband, 4 - 7 outside, 8: 1.5 < 2 % of range */
+    for (i = 0; i < 10; i++)
+        values[i] = (i < 4) ? 10.5f : 11.5f;
+
+    timestamp += 1000;
+
+    TEST_ASSERT_EQUAL_INT(4, CS101_ChangeDetector_updateFloatValues(detector, indices, values, NULL, 10, timestamp));
+    TEST_ASSERT_EQUAL_INT(1, info.asduCount);
+    TEST_ASSERT_EQUAL_INT(4, info.objectCount);
+    TEST_ASSERT_EQUAL_INT(M_ME_NC_1, info.lastTypeId);
+    TEST_ASSERT_EQUAL_INT(107, info.lastIOA);
+
+    /* quality change is reported regardless of the deadband */
+    qualities[0] = IEC60870_QUALITY_INVALID;
+
+    timestamp += 1000;
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ChangeDetector_updateFloatValues(detector, indices, values, qualities, 1, timestamp));
+    TEST_ASSERT_EQUAL_INT(100, info.lastIOA);
+
+    /* integrated deadband: deviation of 1.5 -> integral 1.5, 4.5 (2 s later), 6, 7.5, 9, 10.5 (reported), 0 */
+    int events = 0;
+
+    for (i = 0; i < 6; i++) {
+        timestamp += 1000;
+        events += CS101_ChangeDetector_updateFloatValues(detector, indices + 9, values + 9, NULL, 1, timestamp);
+
+        if (i < 4)
+            TEST_ASSERT_EQUAL_INT(0, events);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, events);
+    TEST_ASSERT_EQUAL_INT(109, info.lastIOA);
+
+    /* status changes with event type */
+    spValues[1] = true;
+
+    info.asduCount = 0;
+
+    TEST_ASSERT_EQUAL_INT(1, CS101_ChangeDetector_updateSinglePoints(detector, spIndices, spValues, NULL, 2, timestamp));
+    TEST_ASSERT_EQUAL_INT(0, CS101_ChangeDetector_updateSinglePoints(detector, spIndices, spValues, NULL, 2, timestamp));
+    TEST_ASSERT_EQUAL_INT(1, info.asduCount);
+    TEST_ASSERT_EQUAL_INT(M_SP_TB_1, info.lastTypeId);
+    TEST_ASSERT_EQUAL_INT(2, info.lastCA);
+    TEST_ASSERT_EQUAL_INT(2, info.lastIOA);
+    TEST_ASSERT_TRUE(CS101_ProcessImage_getSinglePointValue(processImage, spIndices[1]));
+
+    /* wrong point type is ignored */
+    TEST_ASSERT_EQUAL_INT(0, CS101_ChangeDetector_updateFloatValues(detector, spIndices, values, NULL, 2, timestamp));
+
+    CS101_ChangeDetector_destroy(detector);
+    CS101_ProcessImage_destroy(processImage);
+}
+
+void
+test_ChangeDetectorQualityFlags(void)
+{
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(1000);
+
+    int i;
+
+    for (i = 0; i < 1000; i++)
+        CS101_ProcessImage_addPoint(processImage, 1, 1 + i, M_ME_NC_1);
+
+    CS101_ProcessImage_setQualityFlags(processImage, 1, 0, 0xffffff, IEC60870_QUALITY_INVALID, false, 0);
+
+    CS101_ChangeDetector detector = CS101_ChangeDetector_create(processImage, &defaultAppLayerParameters);
+
+    struct stest_ChangeDetector info;
+    memset(&info, 0, sizeof(info));
+
+    CS101_ChangeDetector_setEventHandler(detector, test_ChangeDetector_eventHandler, &info);
+
+    TEST_ASSERT_EQUAL_INT(1000, CS101_ChangeDetector_setQualityFlags(detector, 1, 1, 1000, IEC60870_QUALITY_INVALID, true, 0));
+    TEST_ASSERT_EQUAL_INT(1000, info.objectCount);
+    TEST_ASSERT_TRUE(info.asduCount < 100);
+    TEST_ASSERT_EQUAL_INT(1000, info.lastIOA);
+
+    /* no events when the quality does not change */
+    TEST_ASSERT_EQUAL_INT(0, CS101_ChangeDetector_setQualityFlagsOfGroup(detector, 1, 0, IEC60870_QUALITY_INVALID, true, 0));
+    TEST_ASSERT_EQUAL_INT(1000, info.objectCount);
+
+    /* an update with the same quality does not create an event */
+    float value = 0.f;
+    int index = 0;
+    QualityDescriptor quality = IEC60870_QUALITY_INVALID;
+
+    TEST_ASSERT_EQUAL_INT(0, CS101_ChangeDetector_updateFloatValues(detector, &index, &value, &quality, 1, 0));
+
+    CS101_ChangeDetector_destroy(detector);
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_TimerWheel {
+    TimerWheel wheel;
+    struct sTimerWheelEntry entries[3];
+    int fired[3];
+};
+
+static void
+test_TimerWheel_expiryHandler(void* parameter, TimerWheelEntry entry, uint64_t currentTime)
+{
+    struct stest_TimerWheel* info = (struct stest_TimerWheel*) parameter;
+
+    info->fired[entry - info->entries]++;
+
+    /* the first timer is periodic (100 ms) */
+    if (entry == &(info->entries[0]))
+        TimerWheel_schedule(info->wheel, entry, entry->expiryTime + 100);
+}
+
+void
+test_TimerWheel(void)
+{
+    struct stest_TimerWheel info;
+    memset(&info, 0, sizeof(info));
+
+    info.wheel = TimerWheel_create(64, 10, 1000);
+
+    TEST_ASSERT_NOT_NULL(info.wheel);
+
+    int i;
+
+    for (i = 0; i < 3; i++)
+        TimerWheelEntry_initialize(&(info.entries[i]));
+
+    TimerWheel_schedule(info.wheel, &(info.entries[0]), 1100);
+    /* more than one revolution of the wheel (640 ms) */
+    TimerWheel_schedule(info.wheel, &(info.entries[1]), 2000);
+    TimerWheel_schedule(info.wheel, &(info.entries[2]), 1500);
+
+    TEST_ASSERT_EQUAL_INT(3, TimerWheel_getNumberOfTimers(info.wheel));
+
+    TEST_ASSERT_EQUAL_INT(0, TimerWheel_advance(info.wheel, 1090, test_TimerWheel_expiryHandler, &info));
+    TEST_ASSERT_EQUAL_INT(1, TimerWheel_advance(info.wheel, 1100, test_TimerWheel_expiryHandler, &info));
+    TEST_ASSERT_EQUAL_INT(1, info.fired[0]);
+
+    TimerWheel_cancel(info.wheel, &(info.entries[2]));
+    TEST_ASSERT_FALSE(info.entries[2].isScheduled);
+
+    uint64_t currentTime;
+
+    for (currentTime = 1110; currentTime < 2000; currentTime += 10)
+        TimerWheel_advance(info.wheel, currentTime, test_TimerWheel_expiryHandler, &info);
+    TEST_ASSERT_EQUAL_INT(9, info.fired[0]);
+    TEST_ASSERT_EQUAL_INT(0, info.fired[1]);
+    TEST_ASSERT_EQUAL_INT(0, info.fired[2]);
+
+    TimerWheel_advance(info.wheel, 2000, test_TimerWheel_expiryHandler, &info);
+    TEST_ASSERT_EQUAL_INT(10, info.fired[0]);
+    TEST_ASSERT_EQUAL_INT(1, info.fired[1]);
+
+    /* expiry time between two ticks - never expires early */
+    TimerWheel_schedule(info.wheel, &(info.entries[2]), 2015);
+
+    TEST_ASSERT_EQUAL_INT(0, TimerWheel_advance(info.wheel, 2011, test_TimerWheel_expiryHandler, &info));
+    TEST_ASSERT_EQUAL_INT(0, TimerWheel_advance(info.wheel, 2019, test_TimerWheel_expiryHandler, &info));
+    TEST_ASSERT_EQUAL_INT(1, TimerWheel_advance(info.wheel, 2020, test_TimerWheel_expiryHandler, &info));
+    TEST_ASSERT_EQUAL_INT(1, info.fired[2]);
+
+    TEST_ASSERT_EQUAL_INT(1, TimerWheel_getNumberOfTimers(info.wheel));
+
+    TimerWheel_destroy(info.wheel);
+}
+
+struct stest_CyclicScheduler {
+    int groupsSent[50]; /* number of ASDUs per group */
+    float lastValue;
+    int overruns;
+};
+
+static void
+test_CyclicScheduler_asduHandler(void* parameter, int groupId, CS101_ASDU asdu)
+{
+    struct stest_CyclicScheduler* info = (struct stest_CyclicScheduler*) parameter;
+
+    info->groupsSent[groupId]++;
+
+    if (groupId == 0)
+        TEST_ASSERT_EQUAL_INT(CS101_COT_PERIODIC, CS101_ASDU_getCOT(asdu));
+    else
+        TEST_ASSERT_EQUAL_INT(CS101_COT_BACKGROUND_SCAN, CS101_ASDU_getCOT(asdu));
+
+    if ((groupId == 0) && (CS101_ASDU_getTypeID(asdu) == M_ME_NC_1)) {
+        MeasuredValueShort io = (MeasuredValueShort) CS101_ASDU_getElement(asdu, 0);
+        info->lastValue = MeasuredValueShort_getValue(io);
+        MeasuredValueShort_destroy(io);
+    }
+}
+
+static void
+test_CyclicScheduler_overrunHandler(void* parameter, int groupId, int missedCycles)
+{
+    struct stest_CyclicScheduler* info = (struct stest_CyclicScheduler*) parameter;
+
+    info->overruns += missedCycles;
+}
+
+void
+test_CyclicScheduler(void)
+{
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(100);
+
+    int indices[100];
+    int i;
+
+    for (i = 0; i < 100; i++)
+        indices[i] = CS101_ProcessImage_addPoint(processImage, 1, 100 + i, (i < 50) ? M_ME_NC_1 : M_SP_TB_1);
+
+    CS101_CyclicScheduler scheduler = CS101_CyclicScheduler_create(processImage, &defaultAppLayerParameters, 50);
+
+    TEST_ASSERT_NOT_NULL(scheduler);
+
+    struct stest_CyclicScheduler info;
+    memset(&info, 0, sizeof(info));
+
+    CS101_CyclicScheduler_setASDUHandler(scheduler, test_CyclicScheduler_asduHandler, &info);
+    CS101_CyclicScheduler_setOverrunHandler(scheduler, test_CyclicScheduler_overrunHandler, &info);
+
+    TEST_ASSERT_EQUAL_INT(-1, CS101_CyclicScheduler_addGroup(scheduler, indices, 2, CS101_COT_SPONTANEOUS, 1000));
+    TEST_ASSERT_EQUAL_INT(-1, CS101_CyclicScheduler_addGroup(scheduler, indices, 2, CS101_COT_PERIODIC, 1));
+
+    /* group 0 contains both types -> 2 ASDUs */
+    TEST_ASSERT_EQUAL_INT(0, CS101_CyclicScheduler_addGroup(scheduler, indices + 49, 2, CS101_COT_PERIODIC, 1000));
+
+    for (i = 1; i < 50; i++)
+        TEST_ASSERT_EQUAL_INT(i, CS101_CyclicScheduler_addGroup(scheduler, indices + i, 1, CS101_COT_BACKGROUND_SCAN, 1000));
+
+    TEST_ASSERT_EQUAL_INT(-1, CS101_CyclicScheduler_addGroup(scheduler, indices, 1, CS101_COT_PERIODIC, 1000));
+
+    /* group 0 is sent with the next tick, the other groups are distributed over the cycle */
+    CS101_ProcessImage_updateShortValue(processImage, indices[49], 12.5f, IEC60870_QUALITY_GOOD, 0);
+
+    Thread_sleep(CS101_CYCLIC_SCHEDULER_TICK_INTERVAL + 5);
+
+    CS101_CyclicScheduler_tick(scheduler);
+
+    TEST_ASSERT_EQUAL_INT(2, info.groupsSent[0]);
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, info.lastValue);
+
+    uint64_t start = Hal_getMonotonicTimeInMs();
+
+    while (Hal_getMonotonicTimeInMs() - start < 500) {
+        CS101_CyclicScheduler_tick(scheduler);
+        Thread_sleep(5);
+    }
+
+    int groupsSent = 0;
+
+    for (i = 1; i < 50; i++) {
+        TEST_ASSERT_TRUE(info.groupsSent[i] <= 1);
+        groupsSent += info.groupsSent[i];
+    }
+
+    TEST_ASSERT_TRUE(groupsSent > 15);
+    TEST_ASSERT_TRUE(groupsSent < 35);
+
+    TEST_ASSERT_TRUE(CS101_CyclicScheduler_removeGroup(scheduler, 0));
+    TEST_ASSERT_FALSE(CS101_CyclicScheduler_removeGroup(scheduler, 0));
+
+    /* the removed group ID is reused - missed cycles are reported as overrun */
+    TEST_ASSERT_EQUAL_INT(0, CS101_CyclicScheduler_addGroup(scheduler, indices, 1, CS101_COT_PERIODIC, 20));
+
+    memset(info.groupsSent, 0, sizeof(info.groupsSent));
+
+    Thread_sleep(CS101_CYCLIC_SCHEDULER_TICK_INTERVAL + 5);
+
+    CS101_CyclicScheduler_tick(scheduler);
+
+    TEST_ASSERT_EQUAL_INT(1, info.groupsSent[0]);
+    TEST_ASSERT_EQUAL_INT(0, info.overruns);
+
+    Thread_sleep(110);
+
+    CS101_CyclicScheduler_tick(scheduler);
+
+    TEST_ASSERT_TRUE(info.overruns >= 3);
+    TEST_ASSERT_EQUAL_INT(info.overruns, (int) CS101_CyclicScheduler_getOverrunCount(scheduler, 0));
+
+    CS101_CyclicScheduler_destroy(scheduler);
+    CS101_ProcessImage_destroy(processImage);
+}
+
+void
+test_ASDUTemplate(void)
+{
+    struct sCP56Time2a timestamp;
+    CP56Time2a_createFromMsTimestamp(&timestamp, 1700000000000ULL);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    int i;
+
+    for (i = 0; i < 3; i++) {
+        MeasuredValueShortWithCP56Time2a io = MeasuredValueShortWithCP56Time2a_create(NULL, 200 + i * 10, 0.0f, IEC60870_QUALITY_INVALID, &timestamp);
+
+        CS101_ASDU_addInformationObject(asdu, (InformationObject) io);
+
+        MeasuredValueShortWithCP56Time2a_destroy(io);
+    }
+
+    CS101_ASDUTemplate asduTemplate = CS101_ASDUTemplate_create(asdu);
+
+    CS101_ASDU_destroy(asdu);
+
+    TEST_ASSERT_NOT_NULL(asduTemplate);
+    TEST_ASSERT_EQUAL_INT(M_ME_TF_1, CS101_ASDUTemplate_getTypeID(asduTemplate));
+    TEST_ASSERT_EQUAL_INT(3, CS101_ASDUTemplate_getNumberOfElements(asduTemplate));
+
+    struct sCP56Time2a newTimestamp;
+    CP56Time2a_createFromMsTimestamp(&newTimestamp, 1700000001000ULL);
+
+    TEST_ASSERT_TRUE(CS101_ASDUTemplate_setShortValue(asduTemplate, 1, 12.5f, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_TRUE(CS101_ASDUTemplate_setTimestamp(asduTemplate, 1, &newTimestamp));
+    TEST_ASSERT_TRUE(CS101_ASDUTemplate_setQuality(asduTemplate, 2, IEC60870_QUALITY_NON_TOPICAL));
+
+    /* wrong type or index */
+    TEST_ASSERT_FALSE(CS101_ASDUTemplate_setSinglePoint(asduTemplate, 0, true, IEC60870_QUALITY_GOOD));
+    TEST_ASSERT_FALSE(CS101_ASDUTemplate_setShortValue(asduTemplate, 3, 1.0f, IEC60870_QUALITY_GOOD));
+
+    CS101_ASDU templateAsdu = CS101_ASDUTemplate_getASDU(asduTemplate);
+
+    MeasuredValueShortWithCP56Time2a element = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(templateAsdu, 1);
+
+    TEST_ASSERT_NOT_NULL(element);
+    TEST_ASSERT_EQUAL_INT(210, InformationObject_getObjectAddress((InformationObject) element));
+    TEST_ASSERT_EQUAL_FLOAT(12.5f, MeasuredValueShort_getValue((MeasuredValueShort) element));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_GOOD, MeasuredValueShort_getQuality((MeasuredValueShort) element));
+    TEST_ASSERT_EQUAL_UINT64(1700000001000ULL, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(element)));
+
+    MeasuredValueShortWithCP56Time2a_destroy(element);
+
+    element = (MeasuredValueShortWithCP56Time2a) CS101_ASDU_getElement(templateAsdu, 2);
+
+    TEST_ASSERT_NOT_NULL(element);
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_NON_TOPICAL, MeasuredValueShort_getQuality((MeasuredValueShort) element));
+    TEST_ASSERT_EQUAL_UINT64(1700000000000ULL, CP56Time2a_toMsTimestamp(MeasuredValueShortWithCP56Time2a_getTimestamp(element)));
+
+    MeasuredValueShortWithCP56Time2a_destroy(element);
+
+    CS101_ASDUTemplate_destroy(asduTemplate);
+
+    /* sequence of single points */
+    asdu = CS101_ASDU_create(&defaultAppLayerParameters, true, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    for (i = 0; i < 4; i++) {
+        SinglePointInformation io = SinglePointInformation_create(NULL, 100 + i, false, IEC60870_QUALITY_GOOD);
+
+        CS101_ASDU_addInformationObject(asdu, (InformationObject) io);
+
+        SinglePointInformation_destroy(io);
+    }
+
+    asduTemplate = CS101_ASDUTemplate_create(asdu);
+
+    CS101_ASDU_destroy(asdu);
+
+    TEST_ASSERT_NOT_NULL(asduTemplate);
+
+    TEST_ASSERT_TRUE(CS101_ASDUTemplate_setSinglePoint(asduTemplate, 3, true, IEC60870_QUALITY_SUBSTITUTED));
+    TEST_ASSERT_FALSE(CS101_ASDUTemplate_setTimestamp(asduTemplate, 3, &newTimestamp));
+
+    SinglePointInformation sp = (SinglePointInformation) CS101_ASDU_getElement(CS101_ASDUTemplate_getASDU(asduTemplate), 3);
+
+    TEST_ASSERT_NOT_NULL(sp);
+    TEST_ASSERT_EQUAL_INT(103, InformationObject_getObjectAddress((InformationObject) sp));
+    TEST_ASSERT_TRUE(SinglePointInformation_getValue(sp));
+    TEST_ASSERT_EQUAL_INT(IEC60870_QUALITY_SUBSTITUTED, SinglePointInformation_getQuality(sp));
+
+    SinglePointInformation_destroy(sp);
+
+    CS101_ASDUTemplate_destroy(asduTemplate);
+}
+
+void
+test_SingleEventType(void)
+{
+    tSingleEvent singleEvent = 0;
+
+    EventState eventState = SingleEvent_getEventState(&singleEvent);
+
+    TEST_ASSERT_EQUAL_INT(IEC60870_EVENTSTATE_INDETERMINATE_0, eventState);
+
+    QualityDescriptorP qdp = SingleEvent_getQDP(&singleEvent);
+
+    TEST_ASSERT_EQUAL_INT(0, qdp);
+}
+
+void
+test_EventOfProtectionEquipmentWithTime(void)
+{
+#ifndef _WIN32
+    tSingleEvent singleEvent = 0;
+    struct sCP16Time2a elapsedTime;
+    struct sCP56Time2a timestamp;
+
+    EventOfProtectionEquipmentWithCP56Time2a e = EventOfProtectionEquipmentWithCP56Time2a_create(NULL, 1, &singleEvent, &elapsedTime, &timestamp);
+
+    uint8_t buffer[256];
+
+    struct sBufferFrame bf;
+
+    Frame f = BufferFrame_initialize(&bf, buffer, 0);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) e);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) e);
+
+    CS101_ASDU_encode(asdu, f);
+
+    InformationObject_destroy((InformationObject) e);
+    CS101_ASDU_destroy(asdu);
+
+    CS101_ASDU asdu2 = CS101_ASDU_createFromBuffer(&defaultAppLayerParameters, buffer, Frame_getMsgSize(f));
+
+    InformationObject io = CS101_ASDU_getElement(asdu2, 1);
+
+    TEST_ASSERT_NOT_NULL(io);
+
+    EventOfProtectionEquipmentWithCP56Time2a e2 = (EventOfProtectionEquipmentWithCP56Time2a) io;
+
+    SingleEvent se = EventOfProtectionEquipmentWithCP56Time2a_getEvent(e2);
+
+    QualityDescriptorP qdp = SingleEvent_getQDP(se);
+
+    InformationObject_destroy(io);
+    CS101_ASDU_destroy(asdu2);
+
+    TEST_ASSERT_EQUAL_INT(0, qdp);
+#endif
+}
+
+struct test_CS104SlaveConnectionIsRedundancyGroup_Info
+{
+    bool running;
+    CS104_Slave slave;
+};
+
+static void*
+test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction(void* parameter)
+{
+    struct test_CS104SlaveConnectionIsRedundancyGroup_Info* info =  (struct test_CS104SlaveConnectionIsRedundancyGroup_Info*) parameter;
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(info->slave);
+
+    int16_t scaledValue = 0;
+
+    while (info->running) {
+
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(info->slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+
+        Thread_sleep(10);
+    }
+
+    return NULL;
+}
+
+void
+test_CS104SlaveConnectionIsRedundancyGroup()
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    struct test_CS104SlaveConnectionIsRedundancyGroup_Info info;
+    info.running = true;
+    info.slave = slave;
+
+    Thread enqueueThread = Thread_create(test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction, &info, false);
+    Thread_start(enqueueThread);
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    int i;
+
+    for (i = 0; i < 50; i++) {
+        bool result = CS104_Connection_connect(con);
+
+        TEST_ASSERT_TRUE(result);
+
+        CS104_Connection_sendStartDT(con);
+
+        Thread_sleep(10);
+
+        CS104_Connection_close(con);
+    }
+
+    info.running = false;
+    Thread_destroy(enqueueThread);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveSingleRedundancyGroup()
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    struct test_CS104SlaveConnectionIsRedundancyGroup_Info info;
+    info.running = true;
+    info.slave = slave;
+
+    Thread enqueueThread = Thread_create(test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction, &info, false);
+    Thread_start(enqueueThread);
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    int i;
+
+    for (i = 0; i < 50; i++) {
+        bool result = CS104_Connection_connect(con);
+        TEST_ASSERT_TRUE(result);
+
+        CS104_Connection_sendStartDT(con);
+
+        CS104_Connection_close(con);
+
+        Thread_sleep(10);
+    }
+
+    info.running = false;
+    Thread_destroy(enqueueThread);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+static void
+test_CS104SlaveSingleRedundancyGroupMultipleConnectionsEventHandler(void* parameter, IMasterConnection connection, CS104_PeerConnectionEvent event)
+{
+    char ipAddrBuf[100];
+    ipAddrBuf[0] = 0;
+
+    IMasterConnection_getPeerAddress(connection, ipAddrBuf, 100);
+}
+
+void
+test_CS104SlaveSingleRedundancyGroupMultipleConnections()
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+    CS104_Slave_setMaxOpenConnections(slave, 20);
+    CS104_Slave_setConnectionEventHandler(slave, test_CS104SlaveSingleRedundancyGroupMultipleConnectionsEventHandler, NULL);
+
+    struct test_CS104SlaveConnectionIsRedundancyGroup_Info info;
+    info.running = true;
+    info.slave = slave;
+
+    CS104_Connection cons[3];
+    int conState[3]; /* 0 = idle, 1 = connected, 2 = START_DT sent */
+
+    cons[0] = CS104_Connection_create("127.0.0.1", 20004);
+    cons[1] = CS104_Connection_create("127.0.0.1", 20004);
+    cons[2] = CS104_Connection_create("127.0.0.1", 20004);
+
+    conState[0] = 0;
+    conState[1] = 0;
+    conState[2] = 0;
+
+    Thread enqueueThread = Thread_create(test_CS104SlaveConnectionIsRedundancyGroup_enqueueThreadFunction, &info, false);
+    Thread_start(enqueueThread);
+
+    int i;
+    for (i = 0; i < 200; i++)
+    {
+       // printf("round %i\n", i);
+
+        int con = rand() % 3;
+
+        if (conState[con] == 0) {
+            bool result = CS104_Connection_connect(cons[con]);
+            TEST_ASSERT_TRUE(result);
+            conState[con] = 1;
+        }
+        else if (conState[con] == 1) {
+            CS104_Connection_sendStartDT(cons[con]);
+            conState[con] = 2;
+        }
+        else if (conState[con] == 2) {
+            CS104_Connection_close(cons[con]);
+            conState[con] = 0;
+        }
+
+        Thread_sleep(50);
+    }
+
+    CS104_Connection_destroy(cons[0]);
+    CS104_Connection_destroy(cons[1]);
+    CS104_Connection_destroy(cons[2]);
+
+    info.running = false;
+    Thread_destroy(enqueueThread);
+
+    CS104_Slave_destroy(slave);
+}
+
+struct stest_CS104SlaveEventQueue1 {
+    int asduHandlerCalled;
+    int spontCount;
+    int16_t lastScaledValue;
+};
+
+static bool
+test_CS104SlaveEventQueue1_asduReceivedHandler (void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104SlaveEventQueue1* info = (struct stest_CS104SlaveEventQueue1*) parameter;
+
+    info->asduHandlerCalled++;
+
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_SPONTANEOUS)
+    {
+        info->spontCount++;
+
+        if (CS101_ASDU_getTypeID(asdu) == M_ME_NB_1)
+        {
+            static uint8_t ioBuf[250];
+
+            MeasuredValueScaled mv = (MeasuredValueScaled) CS101_ASDU_getElementEx(asdu, (InformationObject) ioBuf, 0);
+
+            info->lastScaledValue = MeasuredValueScaled_getValue(mv);
+        }
+    }
+
+    return true;
+}
+
+struct sTestMessageQueueEntryInfo {
+	uint64_t entryTimestamp;
+	unsigned int entryState : 2;
+	unsigned int size : 8;
+};
+
+void
+test_CS104SlaveEventQueue1()
+{
+    CS104_Slave slave = CS104_Slave_create(10, 10);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    for (int i = 0; i < 15; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(500);
+
+    CS104_Connection_sendStopDT(con);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(14, info.lastScaledValue);
+
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+
+    result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    for (int i = 0; i < 15; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+
+        Thread_sleep(10);
+    }
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(15, info.asduHandlerCalled);
+    TEST_ASSERT_EQUAL_INT(15, info.spontCount);
+    TEST_ASSERT_EQUAL_INT(29, info.lastScaledValue);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveEventQueueOverflow()
+{
+    CS104_Slave slave = CS104_Slave_create(10, 10);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    for (int i = 0; i < 300; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(1500);
+
+    CS104_Connection_close(con);
+
+    int asduSize = 12;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
+
+    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+
+    result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    for (int i = 0; i < 150; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+
+        Thread_sleep(10);
+    }
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.asduHandlerCalled);
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.spontCount);
+    TEST_ASSERT_EQUAL_INT(449, info.lastScaledValue);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveEventQueueOverflow2()
+{
+    CS104_Slave slave = CS104_Slave_create(10, 10);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    for (int i = 0; i < 300; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+
+        scaledValue++;
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    int asduSize = 12;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
+
+    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+
+    result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    int typeNo = 0;
+
+    for (int i = 0; i < 20000; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io;
+
+        if (typeNo == 0) {
+            io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+            CS101_ASDU_addInformationObject(newAsdu, io);
+        }
+        else if (typeNo == 1) {
+            struct sCP56Time2a cp56;
+            CP56Time2a_createFromMsTimestamp(&cp56, Hal_getTimeInMs());
+
+            io =  (InformationObject) MeasuredValueScaledWithCP56Time2a_create(NULL, 111, scaledValue, IEC60870_QUALITY_GOOD, &cp56);
+
+            CS101_ASDU_addInformationObject(newAsdu, io);
+        }
+        else if (typeNo == 2) {
+            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
+
+            CS101_ASDU_addInformationObject(newAsdu, io);
+        }
+        else if (typeNo == 3) {
+            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
+            int j = 1;
+            while (CS101_ASDU_addInformationObject(newAsdu, io)) {
+                io = (InformationObject) SinglePointInformation_create((SinglePointInformation) io, 112 + j, true, IEC60870_QUALITY_GOOD);
+                j++;
+            }
+        }
+
+        typeNo++;
+
+        if (typeNo == 4)
+            typeNo = 0;
+
+        scaledValue++;
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+
+        //Thread_sleep(10);
+    }
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveEventQueueCheckCapacity()
+{
+    CS104_Slave slave = CS104_Slave_create(2, 2);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    /* Fill queue with small messages */
+    int asduSize = 6 + 3 + 1;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
+
+    for (int i = 0; i < 299; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        if (i >= msgQueueCapacity)
+            TEST_ASSERT_EQUAL_INT(msgQueueCapacity, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+        else
+            TEST_ASSERT_EQUAL_INT(i + 1, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(1000);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+
+    /* outstanding I messages that are not confirmed */
+    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+void
+test_CS104SlaveEventQueueOverflow3()
+{
+    /**
+     * Trigger code to remove multiple messages at once from the buffer
+     */
+
+    CS104_Slave slave = CS104_Slave_create(2, 2);
+
+    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    struct stest_CS104SlaveEventQueue1 info;
+    info.asduHandlerCalled = 0;
+    info.spontCount = 0;
+    info.lastScaledValue = 0;
+
+    int16_t scaledValue = 0;
+
+    /* Fill queue with small messages */
+
+    int asduSize = 6 + 3 + 1;
+    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
+    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
+
+    for (int i = 0; i < 35; i++) {
+
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+
+    int count1 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+
+
+
+    /* add a single large messages */
+    CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_PERIODIC, 0, 1, false, false);
+
+    for (int i = 0; i < 50; i++) {
+          SinglePointInformation spi = SinglePointInformation_create(NULL, 110, false, IEC60870_QUALITY_GOOD);;
+
+          CS101_ASDU_addInformationObject(newAsdu, (InformationObject) spi);
+
+          InformationObject_destroy((InformationObject) spi);
+    }
+
+    CS104_Slave_enqueueASDU(slave, newAsdu);
+
+    CS101_ASDU_destroy(newAsdu);
+
+    int count2 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+
+    /* check that multiple buffer entries were removed */
+    TEST_ASSERT_TRUE(count2 + 1 < count1);
+
+    info.asduHandlerCalled = 0;
+
+    bool result = CS104_Connection_connect(con);
+    TEST_ASSERT_TRUE(result);
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(500);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(count2, info.asduHandlerCalled);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+
+struct stest_CS104SlaveInterrogationFromProcessImage {
+    int actConCount;
+    int actTermCount;
+    int negativeCount;
+    int objectCount;
+    int sequenceAsduCount;
+    int spontCount;
+    int lastIoa;
+    bool orderOk;
+};
+
+static bool
+test_CS104SlaveInterrogationFromProcessImage_asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104SlaveInterrogationFromProcessImage* info = (struct stest_CS104SlaveInterrogationFromProcessImage*) parameter;
+
+    CS101_CauseOfTransmission cot = CS101_ASDU_getCOT(asdu);
+
+    if (CS101_ASDU_getTypeID(asdu) == C_IC_NA_1) {
+        if (CS101_ASDU_isNegative(asdu))
+            info->negativeCount++;
+        else if (cot == CS101_COT_ACTIVATION_CON)
+            info->actConCount++;
+        else if (cot == CS101_COT_ACTIVATION_TERMINATION)
+            info->actTermCount++;
+    }
+    else if (cot == CS101_COT_SPONTANEOUS) {
+        info->spontCount++;
+    }
+    else if ((cot >= CS101_COT_INTERROGATED_BY_STATION) && (cot <= CS101_COT_INTERROGATED_BY_GROUP_16)) {
+
+        /* objects have to be received after the ACT_CON and before the ACT_TERM */
+        if ((info->actConCount == 0) || (info->actTermCount != 0))
+            info->orderOk = false;
+
+        if (CS101_ASDU_isSequence(asdu))
+            info->sequenceAsduCount++;
+
+        static uint8_t ioBuf[250];
+
+        int i;
+
+        for (i = 0; i < CS101_ASDU_getNumberOfElements(asdu); i++) {
+            InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) ioBuf, i);
+
+            if (InformationObject_getObjectAddress(io) <= info->lastIoa)
+                info->orderOk = false;
+
+            info->lastIoa = InformationObject_getObjectAddress(io);
+            info->objectCount++;
+        }
+    }
+
+    return true;
+}
+
+void
+test_CS104SlaveInterrogationFromProcessImage()
+{
+    CS104_Slave slave = CS104_Slave_create(100, 10);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(100000);
+
+    int i;
+
+    /* consecutive IOAs, 4 gaps, every 10th point member of group 2 */
+    for (i = 0; i < 100000; i++) {
+        int ioa = 1 + i + (i / 25000);
+
+        int index = CS101_ProcessImage_addPoint(processImage, 1, ioa, (i < 50000) ? M_SP_NA_1 : M_ME_NC_1);
+
+        if ((i % 10) == 0)
+            CS101_ProcessImage_addToGroup(processImage, index, 2);
+    }
+
+    CS104_Slave_setProcessImage(slave, processImage);
+
+    CS104_Slave_start(slave);
+
+    struct stest_CS104SlaveInterrogationFromProcessImage info;
+    memset(&info, 0, sizeof(info));
+    info.orderOk = true;
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveInterrogationFromProcessImage_asduReceivedHandler, &info);
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(100);
+
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+
+    /* second interrogation while the first one is running is rejected */
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+
+    /* spontaneous events are sent while the interrogation is running */
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    for (i = 0; i < 10; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 1, true, IEC60870_QUALITY_GOOD);
+
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    for (i = 0; i < 100; i++) {
+        if (info.actTermCount > 0)
+            break;
+
+        Thread_sleep(100);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info.actConCount);
+    TEST_ASSERT_EQUAL_INT(1, info.actTermCount);
+    TEST_ASSERT_EQUAL_INT(1, info.negativeCount);
+    TEST_ASSERT_EQUAL_INT(100000, info.objectCount);
+    TEST_ASSERT_EQUAL_INT(10, info.spontCount);
+    TEST_ASSERT_TRUE(info.orderOk);
+    TEST_ASSERT_TRUE(info.sequenceAsduCount > 0);
+
+    /* group interrogation */
+    info.actConCount = 0;
+    info.actTermCount = 0;
+    info.objectCount = 0;
+    info.sequenceAsduCount = 0;
+    info.lastIoa = 0;
+
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_GROUP_2);
+
+    for (i = 0; i < 100; i++) {
+        if (info.actTermCount > 0)
+            break;
+
+        Thread_sleep(100);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info.actConCount);
+    TEST_ASSERT_EQUAL_INT(1, info.actTermCount);
+    TEST_ASSERT_EQUAL_INT(10000, info.objectCount);
+    TEST_ASSERT_EQUAL_INT(0, info.sequenceAsduCount);
+    TEST_ASSERT_TRUE(info.orderOk);
+
+    /* unknown CA */
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 2, IEC60870_QOI_STATION);
+
+    Thread_sleep(200);
+
+    TEST_ASSERT_EQUAL_INT(2, info.negativeCount);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_CS104SlaveReadFromProcessImage {
+    int responseCount;
+    int unknownIoaCount;
+    int unknownCaCount;
+    int wrongResponseCount;
+    int readHandlerCalls;
+    float lastValue;
+};
+
+static bool
+test_CS104SlaveReadFromProcessImage_readHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu, int ioa)
+{
+    struct stest_CS104SlaveReadFromProcessImage* info = (struct stest_CS104SlaveReadFromProcessImage*) parameter;
+
+    info->readHandlerCalls++;
+
+    return false;
+}
+
+static bool
+test_CS104SlaveReadFromProcessImage_asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104SlaveReadFromProcessImage* info = (struct stest_CS104SlaveReadFromProcessImage*) parameter;
+
+    if (CS101_ASDU_getTypeID(asdu) == C_RD_NA_1) {
+        if (CS101_ASDU_isNegative(asdu) && (CS101_ASDU_getCOT(asdu) == CS101_COT_UNKNOWN_IOA))
+            info->unknownIoaCount++;
+        else if (CS101_ASDU_isNegative(asdu) && (CS101_ASDU_getCOT(asdu) == CS101_COT_UNKNOWN_CA))
+            info->unknownCaCount++;
+        else
+            info->wrongResponseCount++;
+    }
+    else if ((CS101_ASDU_getCOT(asdu) == CS101_COT_REQUEST) && (CS101_ASDU_getNumberOfElements(asdu) == 1)) {
+        static uint8_t ioBuf[250];
+
+        InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) ioBuf, 0);
+
+        int ioa = InformationObject_getObjectAddress(io);
+
+        if ((ioa <= 100) && (CS101_ASDU_getTypeID(asdu) == M_SP_NA_1))
+            info->responseCount++;
+        else if ((ioa > 100) && (CS101_ASDU_getTypeID(asdu) == M_ME_TF_1)) {
+            info->lastValue = MeasuredValueShort_getValue((MeasuredValueShort) io);
+            info->responseCount++;
+        }
+        else
+            info->wrongResponseCount++;
+    }
+    else
+        info->wrongResponseCount++;
+
+    return true;
+}
+
+void
+test_CS104SlaveReadFromProcessImage()
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(200);
+
+    int i;
+
+    for (i = 1; i <= 200; i++)
+        CS101_ProcessImage_addPoint(processImage, 1, i, (i <= 100) ? M_SP_NA_1 : M_ME_TF_1);
+
+    int index = CS101_ProcessImage_lookup(processImage, 1, 150);
+
+    CS101_ProcessImage_updateShortValue(processImage, index, 47.11f, IEC60870_QUALITY_GOOD, 0);
+
+    struct stest_CS104SlaveReadFromProcessImage info;
+    memset(&info, 0, sizeof(info));
+
+    CS104_Slave_setReadHandler(slave, test_CS104SlaveReadFromProcessImage_readHandler, &info);
+    CS104_Slave_setProcessImage(slave, processImage);
+
+    CS104_Slave_start(slave);
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveReadFromProcessImage_asduReceivedHandler, &info);
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(100);
+
+    /* the client can only send k read commands without confirmation */
+    for (i = 0; i < 1000; i++) {
+        while (CS104_Connection_sendReadCommand(con, 1, 1 + (i % 200)) == false)
+            Thread_sleep(1);
+    }
+
+    while (CS104_Connection_sendReadCommand(con, 1, 150) == false)
+        Thread_sleep(1);
+
+    while (CS104_Connection_sendReadCommand(con, 1, 201) == false)
+        Thread_sleep(1);
+
+    while (CS104_Connection_sendReadCommand(con, 2, 1) == false)
+        Thread_sleep(1);
+
+    for (i = 0; i < 50; i++) {
+        if (info.responseCount + info.unknownIoaCount + info.unknownCaCount >= 1003)
+            break;
+
+        Thread_sleep(100);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1001, info.responseCount);
+    TEST_ASSERT_EQUAL_INT(1, info.unknownIoaCount);
+    TEST_ASSERT_EQUAL_INT(1, info.unknownCaCount);
+    TEST_ASSERT_EQUAL_INT(0, info.wrongResponseCount);
+    TEST_ASSERT_EQUAL_INT(0, info.readHandlerCalls);
+    TEST_ASSERT_EQUAL_FLOAT(47.11f, info.lastValue);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_CS104SlaveCounterInterrogationFromProcessImage {
+    int actConCount;
+    int actTermCount;
+    int negativeCount;
+    int objectCount;
+    int wrongValueCount;
+    int wrongCotCount;
+};
+
+static bool
+test_CS104SlaveCounterInterrogationFromProcessImage_asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104SlaveCounterInterrogationFromProcessImage* info = (struct stest_CS104SlaveCounterInterrogationFromProcessImage*) parameter;
+
+    CS101_CauseOfTransmission cot = CS101_ASDU_getCOT(asdu);
+
+    if (CS101_ASDU_getTypeID(asdu) == C_CI_NA_1) {
+        if (CS101_ASDU_isNegative(asdu))
+            info->negativeCount++;
+        else if (cot == CS101_COT_ACTIVATION_CON)
+            info->actConCount++;
+        else if (cot == CS101_COT_ACTIVATION_TERMINATION)
+            info->actTermCount++;
+    }
+    else if (CS101_ASDU_getTypeID(asdu) == M_IT_NA_1) {
+        if (cot != CS101_COT_REQUESTED_BY_GENERAL_COUNTER)
+            info->wrongCotCount++;
+
+        static uint8_t ioBuf[250];
+
+        int i;
+
+        for (i = 0; i < CS101_ASDU_getNumberOfElements(asdu); i++) {
+            IntegratedTotals io = (IntegratedTotals) CS101_ASDU_getElementEx(asdu, (InformationObject) ioBuf, i);
+
+            /* frozen value is the IOA, the running value has changed after the freeze */
+            if (BinaryCounterReading_getValue(IntegratedTotals_getBCR(io)) != InformationObject_getObjectAddress((InformationObject) io))
+                info->wrongValueCount++;
+
+            info->objectCount++;
+        }
+    }
+
+    return true;
+}
+
+void
+test_CS104SlaveCounterInterrogationFromProcessImage()
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(20000);
+
+    struct sBinaryCounterReading bcr;
+
+    int i;
+
+    for (i = 1; i <= 20000; i++) {
+        int index = CS101_ProcessImage_addPoint(processImage, 1, i, M_IT_NA_1);
+
+        BinaryCounterReading_create(&bcr, i, 0, false, false, false);
+        CS101_ProcessImage_updateIntegratedTotals(processImage, index, &bcr, 0);
+    }
+
+    CS104_Slave_setProcessImage(slave, processImage);
+
+    CS104_Slave_start(slave);
+
+    struct stest_CS104SlaveCounterInterrogationFromProcessImage info;
+    memset(&info, 0, sizeof(info));
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveCounterInterrogationFromProcessImage_asduReceivedHandler, &info);
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(100);
+
+    CS104_Connection_sendCounterInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QCC_RQT_GENERAL | IEC60870_QCC_FRZ_FREEZE_WITHOUT_RESET);
+
+    for (i = 0; i < 50; i++) {
+        if (info.actTermCount > 0)
+            break;
+
+        Thread_sleep(10);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info.actConCount);
+    TEST_ASSERT_EQUAL_INT(1, info.actTermCount);
+    TEST_ASSERT_EQUAL_INT(0, info.objectCount);
+
+    /* the acquisition continues - the read returns the frozen values */
+    for (i = 0; i < 20000; i++) {
+        BinaryCounterReading_create(&bcr, 100000 + i, 0, false, false, false);
+        CS101_ProcessImage_updateIntegratedTotals(processImage, i, &bcr, 0);
+    }
+
+    info.actConCount = 0;
+    info.actTermCount = 0;
+
+    CS104_Connection_sendCounterInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QCC_RQT_GENERAL | IEC60870_QCC_FRZ_READ);
+
+    /* invalid RQT */
+    CS104_Connection_sendCounterInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QCC_FRZ_READ);
+
+    for (i = 0; i < 100; i++) {
+        if (info.actTermCount > 0)
+            break;
+
+        Thread_sleep(100);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info.actConCount);
+    TEST_ASSERT_EQUAL_INT(1, info.actTermCount);
+    TEST_ASSERT_EQUAL_INT(1, info.negativeCount);
+    TEST_ASSERT_EQUAL_INT(20000, info.objectCount);
+    TEST_ASSERT_EQUAL_INT(0, info.wrongValueCount);
+    TEST_ASSERT_EQUAL_INT(0, info.wrongCotCount);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_CS104SlaveHistoryReplay {
+    int objectCount;
+    int wrongTypeCount;
+    int outOfOrderCount;
+    float lastValue[100];
+};
+
+static bool
+test_CS104SlaveHistoryReplay_asduReceivedHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104SlaveHistoryReplay* info = (struct stest_CS104SlaveHistoryReplay*) parameter;
+
+    if ((CS101_ASDU_getTypeID(asdu) != M_ME_TF_1) || (CS101_ASDU_getCOT(asdu) != CS101_COT_SPONTANEOUS)) {
+        info->wrongTypeCount++;
+        return true;
+    }
+
+    int i;
+
+    for (i = 0; i < CS101_ASDU_getNumberOfElements(asdu); i++) {
+        static uint8_t ioBuf[250];
+
+        InformationObject io = CS101_ASDU_getElementEx(asdu, (InformationObject) ioBuf, i);
+
+        int point = InformationObject_getObjectAddress(io) - 1000;
+        float value = MeasuredValueShort_getValue((MeasuredValueShort) io);
+
+        /* the changes of a point are replayed in chronological order */
+        if ((point >= 0) && (point < 100)) {
+            if (value <= info->lastValue[point])
+                info->outOfOrderCount++;
+
+            info->lastValue[point] = value;
+        }
+
+        info->objectCount++;
+    }
+
+    return true;
+}
+
+void
+test_CS104SlaveHistoryReplay(void)
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(100);
+
+    TEST_ASSERT_TRUE(CS101_ProcessImage_enableHistory(processImage, 8));
+
+    int i;
+
+    for (i = 0; i < 100; i++) {
+        int index = CS101_ProcessImage_addPoint(processImage, 1, 1000 + i, M_ME_NC_1);
+
+        CS101_ProcessImage_updateShortValue(processImage, index, 1.0f, IEC60870_QUALITY_GOOD, 0);
+        CS101_ProcessImage_updateShortValue(processImage, index, 2.0f, IEC60870_QUALITY_GOOD, 0);
+        CS101_ProcessImage_updateShortValue(processImage, index, 3.0f, IEC60870_QUALITY_GOOD, 0);
+    }
+
+    CS104_Slave_setProcessImage(slave, processImage);
+    CS104_Slave_setHistoryReplay(slave, 2);
+
+    CS104_Slave_start(slave);
+
+    struct stest_CS104SlaveHistoryReplay info;
+    memset(&info, 0, sizeof(info));
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveHistoryReplay_asduReceivedHandler, &info);
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    CS104_Connection_sendStartDT(con);
+
+    for (i = 0; i < 50; i++) {
+        if (info.objectCount >= 200)
+            break;
+
+        Thread_sleep(100);
+    }
+
+    TEST_ASSERT_EQUAL_INT(200, info.objectCount);
+    TEST_ASSERT_EQUAL_INT(0, info.wrongTypeCount);
+    TEST_ASSERT_EQUAL_INT(0, info.outOfOrderCount);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, info.lastValue[0]);
+    TEST_ASSERT_EQUAL_FLOAT(3.0f, info.lastValue[99]);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_CS101Mirror {
+    int changeCalls;
+    int changedPoints;
+    int staleCount;
+    int notStaleCount;
+    int lastStaleCA;
+    CS104_Connection connection; /* when set the change handler sends a read command */
+    int sentCommands;
+};
+
+static void
+test_CS101Mirror_changeHandler(void* parameter, CS101_Mirror mirror, const int* indices, int numberOfIndices)
+{
+    struct stest_CS101Mirror* info = (struct stest_CS101Mirror*) parameter;
+
+    info->changeCalls++;
+    info->changedPoints += numberOfIndices;
+
+    if (info->connection && CS104_Connection_sendReadCommand(info->connection, 1, 1000))
+        info->sentCommands++;
+}
+
+static void
+test_CS101Mirror_stationHandler(void* parameter, CS101_Mirror mirror, int ca, bool isStale)
+{
+    struct stest_CS101Mirror* info = (struct stest_CS101Mirror*) parameter;
+
+    if (isStale) {
+        info->staleCount++;
+        info->lastStaleCA = ca;
+    }
+    else
+        info->notStaleCount++;
+}
+
+static void
+test_CS101Mirror_addObject(CS101_ASDU asdu, InformationObject io)
+{
+    CS101_ASDU_addInformationObject(asdu, io);
+
+    InformationObject_destroy(io);
+}
+
+void
+test_CS101Mirror(void)
+{
+    CS101_Mirror mirror = CS101_Mirror_create(100, 4);
+
+    struct stest_CS101Mirror info;
+    memset(&info, 0, sizeof(info));
+
+    CS101_Mirror_setChangeHandler(mirror, test_CS101Mirror_changeHandler, &info);
+    CS101_Mirror_setStationHandler(mirror, test_CS101Mirror_stationHandler, &info);
+
+    CS101_ProcessImage processImage = CS101_Mirror_getProcessImage(mirror);
+
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+    test_CS101Mirror_addObject(asdu, (InformationObject) MeasuredValueShort_create(NULL, 100, 1.5f, IEC60870_QUALITY_GOOD));
+    test_CS101Mirror_addObject(asdu, (InformationObject) MeasuredValueShort_create(NULL, 101, 2.5f, IEC60870_QUALITY_GOOD));
+
+    TEST_ASSERT_TRUE(CS101_Mirror_handleASDU(mirror, asdu));
+
+    /* new points are reported in one batch */
+    TEST_ASSERT_EQUAL_INT(1, info.changeCalls);
+    TEST_ASSERT_EQUAL_INT(2, info.changedPoints);
+    TEST_ASSERT_EQUAL_INT(1, info.notStaleCount);
+    TEST_ASSERT_FALSE(CS101_Mirror_isStationStale(mirror, 1));
+    TEST_ASSERT_TRUE(CS101_Mirror_isStationStale(mirror, 2));
+
+    int index = CS101_Mirror_lookup(mirror, 1, 101);
+
+    TEST_ASSERT_TRUE(index >= 0);
+    TEST_ASSERT_EQUAL_INT(M_ME_NC_1, CS101_ProcessImage_getTypeID(processImage, index));
+    TEST_ASSERT_EQUAL_FLOAT(2.5f, CS101_ProcessImage_getFloatValue(processImage, index));
+    TEST_ASSERT_EQUAL_INT(-1, CS101_Mirror_lookup(mirror, 1, 102));
+
+    /* only changed points are reported */
+    CS101_ASDU_removeAllElements(asdu);
+    test_CS101Mirror_addObject(asdu, (InformationObject) MeasuredValueShort_create(NULL, 100, 1.5f, IEC60870_QUALITY_GOOD));
+    test_CS101Mirror_addObject(asdu, (InformationObject) MeasuredValueShort_create(NULL, 101, 3.5f, IEC60870_QUALITY_GOOD));
+
+    TEST_ASSERT_TRUE(CS101_Mirror_handleASDU(mirror, asdu));
+    TEST_ASSERT_EQUAL_INT(2, info.changeCalls);
+    TEST_ASSERT_EQUAL_INT(3, info.changedPoints);
+    TEST_ASSERT_EQUAL_FLOAT(3.5f, CS101_ProcessImage_getFloatValue(processImage, index));
+
+    /* the time tag of the information object is used as timestamp */
+    struct sCP56Time2a timestamp;
+
+    CP56Time2a_createFromMsTimestamp(&timestamp, 1700000000123ULL);
+
+    CS101_ASDU asdu2 = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 2, false, false);
+
+    test_CS101Mirror_addObject(asdu2, (InformationObject) SinglePointWithCP56Time2a_create(NULL, 1, true, IEC60870_QUALITY_GOOD, &timestamp));
+
+    TEST_ASSERT_TRUE(CS101_Mirror_handleASDU(mirror, asdu2));
+
+    index = CS101_Mirror_lookup(mirror, 2, 1);
+
+    TEST_ASSERT_TRUE(CS101_ProcessImage_getSinglePointValue(processImage, index));
+    TEST_ASSERT_EQUAL_UINT64(1700000000123ULL, CS101_ProcessImage_getTimestamp(processImage, index));
+    TEST_ASSERT_EQUAL_INT(2, info.notStaleCount);
+
+    /* a point with a different kind of value is ignored */
+    CS101_ASDU_destroy(asdu2);
+    asdu2 = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 2, false, false);
+
+    test_CS101Mirror_addObject(asdu2, (InformationObject) MeasuredValueShort_create(NULL, 1, 7.0f, IEC60870_QUALITY_GOOD));
+
+    TEST_ASSERT_TRUE(CS101_Mirror_handleASDU(mirror, asdu2));
+    TEST_ASSERT_EQUAL_INT(3, info.changeCalls);
+    TEST_ASSERT_TRUE(CS101_ProcessImage_getSinglePointValue(processImage, index));
+
+    /* commands are not mirrored */
+    CS101_ASDU_destroy(asdu2);
+    asdu2 = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_ACTIVATION_CON, 0, 2, false, false);
+
+    test_CS101Mirror_addObject(asdu2, (InformationObject) SingleCommand_create(NULL, 5000, true, false, 0));
+
+    TEST_ASSERT_FALSE(CS101_Mirror_handleASDU(mirror, asdu2));
+    TEST_ASSERT_EQUAL_INT(3, CS101_ProcessImage_getNumberOfPoints(processImage));
+
+    /* staleness */
+    uint64_t lastUpdateTime = CS101_Mirror_getLastUpdateTime(mirror, 1);
+
+    TEST_ASSERT_TRUE(lastUpdateTime > 0);
+    TEST_ASSERT_EQUAL_UINT64(0, CS101_Mirror_getLastUpdateTime(mirror, 3));
+
+    CS101_Mirror_checkStations(mirror, lastUpdateTime + 100000);
+    TEST_ASSERT_EQUAL_INT(0, info.staleCount);
+
+    CS101_Mirror_setStaleTimeout(mirror, 1000);
+
+    CS101_Mirror_checkStations(mirror, lastUpdateTime + 500);
+    TEST_ASSERT_EQUAL_INT(0, info.staleCount);
+
+    CS101_Mirror_checkStations(mirror, lastUpdateTime + 100000);
+    TEST_ASSERT_EQUAL_INT(2, info.staleCount);
+    TEST_ASSERT_TRUE(CS101_Mirror_isStationStale(mirror, 1));
+    TEST_ASSERT_TRUE(CS101_Mirror_isStationStale(mirror, 2));
+
+    /* an update of a stale station is reported */
+    TEST_ASSERT_TRUE(CS101_Mirror_handleASDU(mirror, asdu));
+    TEST_ASSERT_EQUAL_INT(3, info.notStaleCount);
+    TEST_ASSERT_FALSE(CS101_Mirror_isStationStale(mirror, 1));
+
+    CS101_Mirror_setStationsStale(mirror);
+    TEST_ASSERT_EQUAL_INT(3, info.staleCount);
+    TEST_ASSERT_EQUAL_INT(1, info.lastStaleCA);
+
+    /* a connection that is closed only makes its own stations stale */
+    int connectionA, connectionB;
+
+    CS101_ASDU asdu3 = CS101_ASDU_create(&defaultAppLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 2, false, false);
+
+    test_CS101Mirror_addObject(asdu3, (InformationObject) MeasuredValueShort_create(NULL, 2, 1.0f, IEC60870_QUALITY_GOOD));
+
+    TEST_ASSERT_TRUE(CS101_Mirror_handleASDUFromSource(mirror, asdu, &connectionA));
+    TEST_ASSERT_TRUE(CS101_Mirror_handleASDUFromSource(mirror, asdu3, &connectionB));
+
+    CS101_Mirror_setStationsOfSourceStale(mirror, &connectionA);
+    TEST_ASSERT_TRUE(CS101_Mirror_isStationStale(mirror, 1));
+    TEST_ASSERT_FALSE(CS101_Mirror_isStationStale(mirror, 2));
+
+    CS101_ASDU_destroy(asdu3);
+
+    CS101_ASDU_destroy(asdu2);
+    CS101_ASDU_destroy(asdu);
+
+    CS101_Mirror_destroy(mirror);
+}
+
+void
+test_CS104ConnectionMirror(void)
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(1000);
+
+    int i;
+
+    for (i = 0; i < 1000; i++) {
+        int index = CS101_ProcessImage_addPoint(processImage, 1, 1000 + i, M_ME_NC_1);
+
+        CS101_ProcessImage_updateShortValue(processImage, index, (float) i, IEC60870_QUALITY_GOOD, 0);
+    }
+
+    CS104_Slave_setProcessImage(slave, processImage);
+
+    CS104_Slave_start(slave);
+
+    CS101_Mirror mirror = CS101_Mirror_create(1000, 1);
+
+    struct stest_CS101Mirror info;
+    memset(&info, 0, sizeof(info));
+
+    CS101_Mirror_setChangeHandler(mirror, test_CS101Mirror_changeHandler, &info);
+    CS101_Mirror_setStationHandler(mirror, test_CS101Mirror_stationHandler, &info);
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setMirror(con, mirror);
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    CS104_Connection_sendStartDT(con);
+
+    Thread_sleep(100);
+
+    /* the change handler sends commands - the connection must not hold a lock while it is called */
+    info.connection = con;
+
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+
+    /* the points are read by the test thread while the connection thread updates the mirror */
+    for (i = 0; i < 50; i++) {
+        if (CS101_ProcessImage_getNumberOfPoints(CS101_Mirror_getProcessImage(mirror)) == 1000)
+            break;
+
+        Thread_sleep(100);
+    }
+
+    CS101_ProcessImage mirroredImage = CS101_Mirror_getProcessImage(mirror);
+
+    TEST_ASSERT_EQUAL_INT(1000, CS101_ProcessImage_getNumberOfPoints(mirroredImage));
+    TEST_ASSERT_EQUAL_INT(1000, info.changedPoints);
+    TEST_ASSERT_EQUAL_INT(1, info.notStaleCount);
+    TEST_ASSERT_TRUE(info.sentCommands > 0);
+
+    info.connection = NULL;
+
+    int index = CS101_Mirror_lookup(mirror, 1, 1500);
+
+    TEST_ASSERT_TRUE(index >= 0);
+    TEST_ASSERT_EQUAL_FLOAT(500.0f, CS101_ProcessImage_getFloatValue(mirroredImage, index));
+
+    CS104_Connection_destroy(con);
+
+    /* the station is stale after the connection is closed */
+    TEST_ASSERT_TRUE(CS101_Mirror_isStationStale(mirror, 1));
+    TEST_ASSERT_EQUAL_INT(1, info.staleCount);
+
+    CS104_Slave_destroy(slave);
+
+    CS101_Mirror_destroy(mirror);
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_CS104ClientEngine {
+    int opened;
+    int closed;
+    int failed;
+    int startDTConReceived;
+    int receivedObjects;
+};
+
+static void
+test_CS104ClientEngine_connectionHandler(void* parameter, CS104_Connection connection, CS104_ConnectionEvent event)
+{
+    struct stest_CS104ClientEngine* info = (struct stest_CS104ClientEngine*) parameter;
+
+    if (event == CS104_CONNECTION_OPENED)
+        info->opened++;
+    else if (event == CS104_CONNECTION_CLOSED)
+        info->closed++;
+    else if (event == CS104_CONNECTION_FAILED)
+        info->failed++;
+    else if (event == CS104_CONNECTION_STARTDT_CON_RECEIVED)
+        info->startDTConReceived++;
+}
+
+static bool
+test_CS104ClientEngine_asduHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104ClientEngine* info = (struct stest_CS104ClientEngine*) parameter;
+
+    if (CS101_ASDU_getCOT(asdu) == CS101_COT_INTERROGATED_BY_STATION)
+        info->receivedObjects += CS101_ASDU_getNumberOfElements(asdu);
+
+    return true;
+}
+
+void
+test_CS104ClientEngine(void)
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(100);
+
+    int i;
+
+    for (i = 0; i < 100; i++) {
+        int index = CS101_ProcessImage_addPoint(processImage, 1, 1000 + i, M_ME_NC_1);
+
+        CS101_ProcessImage_updateShortValue(processImage, index, (float) i, IEC60870_QUALITY_GOOD, 0);
+    }
+
+    CS104_Slave_setProcessImage(slave, processImage);
+
+    CS104_Slave_start(slave);
+
+    CS104_ClientEngine engine = CS104_ClientEngine_create(2);
+
+    TEST_ASSERT_NOT_NULL(engine);
+    TEST_ASSERT_NULL(CS104_ClientEngine_create(0));
+
+    struct stest_CS104ClientEngine info[5];
+    memset(info, 0, sizeof(info));
+
+    CS104_Connection cons[5];
+
+    /* the last connection has no server */
+    for (i = 0; i < 5; i++) {
+        cons[i] = CS104_Connection_create("127.0.0.1", (i < 4) ? 20004 : 20005);
+
+        CS104_Connection_setConnectionHandler(cons[i], test_CS104ClientEngine_connectionHandler, &(info[i]));
+        CS104_Connection_setASDUReceivedHandler(cons[i], test_CS104ClientEngine_asduHandler, &(info[i]));
+
+        TEST_ASSERT_TRUE(CS104_ClientEngine_addConnection(engine, cons[i]));
+    }
+
+    TEST_ASSERT_FALSE(CS104_ClientEngine_addConnection(engine, cons[0]));
+    TEST_ASSERT_EQUAL_INT(5, CS104_ClientEngine_getNumberOfConnections(engine));
+
+    CS104_ClientEngine_start(engine);
+
+    /* blocking connect is also handled by the engine */
+    TEST_ASSERT_TRUE(CS104_Connection_connect(cons[0]));
+
+    for (i = 1; i < 5; i++)
+        CS104_Connection_connectAsync(cons[i]);
+
+    int wait;
+
+    for (wait = 0; wait < 50; wait++) {
+        if ((info[0].opened + info[1].opened + info[2].opened + info[3].opened == 4) && (info[4].failed == 1))
+            break;
+
+        Thread_sleep(100);
+    }
+
+    for (i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(1, info[i].opened);
+
+        CS104_Connection_sendStartDT(cons[i]);
+    }
+
+    TEST_ASSERT_EQUAL_INT(0, info[4].opened);
+    TEST_ASSERT_EQUAL_INT(1, info[4].failed);
+
+    Thread_sleep(200);
+
+    for (i = 0; i < 4; i++) {
+        TEST_ASSERT_EQUAL_INT(1, info[i].startDTConReceived);
+
+        CS104_Connection_sendInterrogationCommand(cons[i], CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+    }
+
+    for (wait = 0; wait < 50; wait++) {
+        if (info[0].receivedObjects + info[1].receivedObjects + info[2].receivedObjects + info[3].receivedObjects == 400)
+            break;
+
+        Thread_sleep(100);
+    }
+
+    for (i = 0; i < 4; i++)
+        TEST_ASSERT_EQUAL_INT(100, info[i].receivedObjects);
+
+    /* close request is handled by the event loop */
+    CS104_Connection_close(cons[1]);
+
+    for (wait = 0; wait < 50; wait++) {
+        if (info[1].closed == 1)
+            break;
+
+        Thread_sleep(10);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info[1].closed);
+
+    /* destroy removes the connection from the engine and closes it */
+    CS104_Connection_destroy(cons[0]);
+
+    TEST_ASSERT_EQUAL_INT(1, info[0].closed);
+    TEST_ASSERT_EQUAL_INT(4, CS104_ClientEngine_getNumberOfConnections(engine));
+
+    CS104_ClientEngine_destroy(engine);
+
+    TEST_ASSERT_EQUAL_INT(1, info[2].closed);
+    TEST_ASSERT_EQUAL_INT(1, info[3].closed);
+
+    for (i = 1; i < 5; i++)
+        CS104_Connection_destroy(cons[i]);
+
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+void
+test_CS104ConnectionThreadless(void)
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS101_ProcessImage processImage = CS101_ProcessImage_create(100);
+
+    int i;
+
+    for (i = 0; i < 100; i++)
+        CS101_ProcessImage_addPoint(processImage, 1, 1000 + i, M_SP_NA_1);
+
+    CS104_Slave_setProcessImage(slave, processImage);
+
+    CS104_Slave_start(slave);
+
+    struct stest_CS104ClientEngine info;
+    memset(&info, 0, sizeof(info));
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setConnectionHandler(con, test_CS104ClientEngine_connectionHandler, &info);
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104ClientEngine_asduHandler, &info);
+
+    TEST_ASSERT_EQUAL_INT(-1, CS104_Connection_getSocketFileDescriptor(con));
+    TEST_ASSERT_EQUAL_UINT64(UINT64_MAX, CS104_Connection_getNextDeadline(con));
+    TEST_ASSERT_FALSE(CS104_Connection_tick(con));
+
+    TEST_ASSERT_TRUE(CS104_Connection_connectThreadless(con));
+    TEST_ASSERT_TRUE(CS104_Connection_getSocketFileDescriptor(con) >= 0);
+
+    /* the deadline of a connect is T0 */
+    TEST_ASSERT_TRUE(CS104_Connection_getNextDeadline(con) <= Hal_getMonotonicTimeInMs() + 30001);
+
+    for (i = 0; i < 1000; i++) {
+        if (CS104_Connection_isConnecting(con) == false)
+            break;
+
+        TEST_ASSERT_TRUE(CS104_Connection_tick(con));
+        Thread_sleep(1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info.opened);
+
+    /* the deadline is the T3 timeout (20 s) */
+    uint64_t deadline = CS104_Connection_getNextDeadline(con);
+
+    TEST_ASSERT_TRUE(deadline > Hal_getMonotonicTimeInMs() + 19000);
+    TEST_ASSERT_TRUE(deadline <= Hal_getMonotonicTimeInMs() + 20001);
+
+    CS104_Connection_sendStartDT(con);
+    CS104_Connection_sendInterrogationCommand(con, CS101_COT_ACTIVATION, 1, IEC60870_QOI_STATION);
+
+    for (i = 0; i < 1000; i++) {
+        if (info.receivedObjects == 100)
+            break;
+
+        TEST_ASSERT_TRUE(CS104_Connection_tick(con));
+        Thread_sleep(1);
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info.startDTConReceived);
+    TEST_ASSERT_EQUAL_INT(100, info.receivedObjects);
+
+    /* the received I frames are confirmed at the latest after T2 (10 s) */
+    TEST_ASSERT_TRUE(CS104_Connection_getNextDeadline(con) <= Hal_getMonotonicTimeInMs() + 10000);
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(1, info.closed);
+    TEST_ASSERT_EQUAL_INT(-1, CS104_Connection_getSocketFileDescriptor(con));
+    TEST_ASSERT_FALSE(CS104_Connection_tick(con));
+
+    /* connect to a port without server */
+    CS104_Connection_destroy(con);
+
+    con = CS104_Connection_create("127.0.0.1", 20005);
+
+    CS104_Connection_setConnectionHandler(con, test_CS104ClientEngine_connectionHandler, &info);
+
+    if (CS104_Connection_connectThreadless(con)) {
+        for (i = 0; i < 1000; i++) {
+            if (CS104_Connection_tick(con) == false)
+                break;
+
+            Thread_sleep(1);
+        }
+    }
+
+    TEST_ASSERT_EQUAL_INT(1, info.failed);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+
+    CS101_ProcessImage_destroy(processImage);
+}
+
+struct stest_CS104ConnectionSendQueue {
+    int commands[20]; /* parameters of the commands - has to be the first element */
+    int events[4];
+    int lastSentCommand;
+    bool orderError;
+};
+
+static void
+test_CS104ConnectionSendQueue_completionHandler(void* parameter, CS104_Connection connection, CS104_SendEvent event)
+{
+    int* command = (int*) parameter;
+    struct stest_CS104ConnectionSendQueue* info = (struct stest_CS104ConnectionSendQueue*) (command - *command);
+
+    info->events[event]++;
+
+    if (event == CS104_SEND_EVENT_SENT) {
+        if (*command <= info->lastSentCommand)
+            info->orderError = true;
+
+        info->lastSentCommand = *command;
+    }
+}
+
+void
+test_CS104ConnectionSendQueue(void)
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    /* the server confirms each received I frame */
+    CS104_Slave_getConnectionParameters(slave)->w = 1;
+
+    CS104_Slave_start(slave);
+
+    struct stest_CS104ConnectionSendQueue info;
+    memset(&info, 0, sizeof(info));
+    info.lastSentCommand = -1;
+
+    int i;
+
+    for (i = 0; i < 20; i++)
+        info.commands[i] = i;
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    /* only two unconfirmed I frames */
+    CS104_Connection_getAPCIParameters(con)->k = 2;
+
+    SingleCommand sc = SingleCommand_create(NULL, 5000, true, false, 0);
+
+    TEST_ASSERT_FALSE(CS104_Connection_queueProcessCommand(con, CS101_COT_ACTIVATION, 1, (InformationObject) sc, 0, NULL, NULL));
+    TEST_ASSERT_TRUE(CS104_Connection_setSendQueueSize(con, 15));
+
+    /* not connected */
+    TEST_ASSERT_FALSE(CS104_Connection_queueProcessCommand(con, CS101_COT_ACTIVATION, 1, (InformationObject) sc, 0, NULL, NULL));
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+    TEST_ASSERT_FALSE(CS104_Connection_setSendQueueSize(con, 10));
+
+    /* the commands are queued until STARTDT_CON is received */
+    TEST_ASSERT_TRUE(CS104_Connection_queueProcessCommand(con, CS101_COT_ACTIVATION, 1, (InformationObject) sc, 50,
+            test_CS104ConnectionSendQueue_completionHandler, &(info.commands[0])));
+
+    for (i = 1; i < 11; i++)
+        TEST_ASSERT_TRUE(CS104_Connection_queueProcessCommand(con, CS101_COT_ACTIVATION, 1, (InformationObject) sc, 0,
+                test_CS104ConnectionSendQueue_completionHandler, &(info.commands[i])));
+
+    TEST_ASSERT_EQUAL_INT(11, CS104_Connection_getSendQueueLength(con));
+
+    /* the deadline of the first command elapses */
+    Thread_sleep(300);
+
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS104_SEND_EVENT_TIMEOUT]);
+    TEST_ASSERT_EQUAL_INT(10, CS104_Connection_getSendQueueLength(con));
 
     CS104_Connection_sendStartDT(con);
 
+    for (i = 0; i < 50; i++) {
+        if (info.events[CS104_SEND_EVENT_CONFIRMED] == 10)
+            break;
+
+        Thread_sleep(50);
+    }
+
+    TEST_ASSERT_EQUAL_INT(10, info.events[CS104_SEND_EVENT_SENT]);
+    TEST_ASSERT_EQUAL_INT(10, info.events[CS104_SEND_EVENT_CONFIRMED]);
+    TEST_ASSERT_EQUAL_INT(0, CS104_Connection_getSendQueueLength(con));
+    TEST_ASSERT_FALSE(info.orderError);
+
+    /* queued commands fail when the connection is closed */
+    CS104_Connection_sendStopDT(con);
+
+    Thread_sleep(100);
+
+    for (i = 11; i < 14; i++)
+        TEST_ASSERT_TRUE(CS104_Connection_queueProcessCommand(con, CS101_COT_ACTIVATION, 1, (InformationObject) sc, 0,
+                test_CS104ConnectionSendQueue_completionHandler, &(info.commands[i])));
+
+    TEST_ASSERT_EQUAL_INT(3, CS104_Connection_getSendQueueLength(con));
+
+    CS104_Connection_close(con);
+
+    TEST_ASSERT_EQUAL_INT(3, info.events[CS104_SEND_EVENT_FAILED]);
+    TEST_ASSERT_EQUAL_INT(10, info.events[CS104_SEND_EVENT_SENT]);
+
+    SingleCommand_destroy(sc);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+struct stest_CS104ReconnectManager {
+    CS104_ReconnectManager manager;
+    Semaphore lock;
+    int events[5];
+    int maxConnecting;
+    int maxDelay;
+};
+
+static void
+test_CS104ReconnectManager_stateHandler(void* parameter, CS104_Connection connection, CS104_ReconnectState state, int delayInMs)
+{
+    struct stest_CS104ReconnectManager* info = (struct stest_CS104ReconnectManager*) parameter;
+
+    int connecting = CS104_ReconnectManager_getNumberOfConnecting(info->manager);
+
+    Semaphore_wait(info->lock);
+
+    info->events[state]++;
+
+    if (connecting > info->maxConnecting)
+        info->maxConnecting = connecting;
+
+    if (delayInMs > info->maxDelay)
+        info->maxDelay = delayInMs;
+
+    Semaphore_post(info->lock);
+}
+
+static int
+test_CS104ReconnectManager_countState(CS104_ReconnectManager manager, CS104_Connection* cons, int numberOfCons,
+        CS104_ReconnectState state)
+{
+    int count = 0;
+    int i;
+
+    for (i = 0; i < numberOfCons; i++) {
+        if (CS104_ReconnectManager_getState(manager, cons[i]) == (int) state)
+            count++;
+    }
+
+    return count;
+}
+
+void
+test_CS104ReconnectManager(void)
+{
+    struct stest_CS104ReconnectManager info;
+    memset(&info, 0, sizeof(info));
+
+    info.lock = Semaphore_create(1);
+
+    CS104_ClientEngine engine = CS104_ClientEngine_create(1);
+
+    CS104_ReconnectManager manager = CS104_ReconnectManager_create(10, 2);
+
+    TEST_ASSERT_NOT_NULL(manager);
+    TEST_ASSERT_NULL(CS104_ReconnectManager_create(10, 0));
+
+    info.manager = manager;
+
+    CS104_ReconnectManager_setStateHandler(manager, test_CS104ReconnectManager_stateHandler, &info);
+
+    CS104_Connection cons[6];
+
+    int i;
+
+    for (i = 0; i < 6; i++) {
+        cons[i] = CS104_Connection_create("127.0.0.1", 20004);
+
+        TEST_ASSERT_TRUE(CS104_ClientEngine_addConnection(engine, cons[i]));
+        TEST_ASSERT_TRUE(CS104_ReconnectManager_addConnection(manager, cons[i], 20, 100, 50));
+    }
+
+    TEST_ASSERT_FALSE(CS104_ReconnectManager_addConnection(manager, cons[0], 20, 100, 50));
+
+    CS104_ClientEngine_start(engine);
+    CS104_ReconnectManager_start(manager);
+
+    /* the server is not running - the connects fail and are repeated with increasing delay */
     Thread_sleep(500);
 
-    CS104_Connection_sendStopDT(con);
+    TEST_ASSERT_TRUE(info.events[CS104_RECONNECT_STATE_WAITING] >= 12);
+    TEST_ASSERT_EQUAL_INT(0, info.events[CS104_RECONNECT_STATE_CONNECTED]);
+    TEST_ASSERT_TRUE(info.maxConnecting <= 2);
+    TEST_ASSERT_TRUE(info.maxDelay <= 100);
 
-    CS104_Connection_close(con);
+    CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    TEST_ASSERT_EQUAL_INT(14, info.lastScaledValue);
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
 
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
+    CS104_Slave_start(slave);
 
-    result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    int wait;
 
-    CS104_Connection_sendStartDT(con);
+    for (wait = 0; wait < 40; wait++) {
+        if (test_CS104ReconnectManager_countState(manager, cons, 6, CS104_RECONNECT_STATE_CONNECTED) == 6)
+            break;
 
-    for (int i = 0; i < 15; i++) {
+        Thread_sleep(50);
+    }
+
+    TEST_ASSERT_EQUAL_INT(6, test_CS104ReconnectManager_countState(manager, cons, 6, CS104_RECONNECT_STATE_CONNECTED));
+    TEST_ASSERT_EQUAL_INT(0, CS104_ReconnectManager_getNumberOfConnecting(manager));
+    TEST_ASSERT_TRUE(info.maxConnecting <= 2);
+
+    /* a connection closed by the application is not reconnected */
+    CS104_Connection_close(cons[0]);
+
+    Thread_sleep(200);
+
+    TEST_ASSERT_EQUAL_INT(CS104_RECONNECT_STATE_STOPPED, CS104_ReconnectManager_getState(manager, cons[0]));
+
+    TEST_ASSERT_TRUE(CS104_ReconnectManager_connect(manager, cons[0]));
+
+    for (wait = 0; wait < 40; wait++) {
+        if (CS104_ReconnectManager_getState(manager, cons[0]) == CS104_RECONNECT_STATE_CONNECTED)
+            break;
+
+        Thread_sleep(50);
+    }
+
+    TEST_ASSERT_EQUAL_INT(CS104_RECONNECT_STATE_CONNECTED, CS104_ReconnectManager_getState(manager, cons[0]));
+
+    /* the connections are reconnected when the server closes them */
+    CS104_Slave_destroy(slave);
+
+    Thread_sleep(200);
+
+    TEST_ASSERT_EQUAL_INT(0, test_CS104ReconnectManager_countState(manager, cons, 6, CS104_RECONNECT_STATE_CONNECTED));
+    TEST_ASSERT_EQUAL_INT(0, test_CS104ReconnectManager_countState(manager, cons, 6, CS104_RECONNECT_STATE_STOPPED));
+
+    CS104_ReconnectManager_removeConnection(manager, cons[5]);
+    TEST_ASSERT_EQUAL_INT(-1, CS104_ReconnectManager_getState(manager, cons[5]));
+
+    CS104_ReconnectManager_stop(manager);
+
+    for (i = 0; i < 6; i++)
+        CS104_Connection_destroy(cons[i]);
+
+    CS104_ReconnectManager_destroy(manager);
+
+    CS104_ClientEngine_destroy(engine);
+
+    Semaphore_destroy(info.lock);
+}
+
+struct stest_CS104ConnectionConcurrentSenders {
+    CS104_Connection con;
+    int receivedCommands[4];
+    bool valueError;
+};
+
+struct stest_CS104ConnectionConcurrentSenders_sender {
+    struct stest_CS104ConnectionConcurrentSenders* info;
+    int senderId;
+};
+
+static bool
+test_CS104ConnectionConcurrentSenders_asduHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu)
+{
+    struct stest_CS104ConnectionConcurrentSenders* info = (struct stest_CS104ConnectionConcurrentSenders*) parameter;
+
+    if (CS101_ASDU_getTypeID(asdu) == C_SC_NA_1) {
+        SingleCommand sc = (SingleCommand) CS101_ASDU_getElement(asdu, 0);
+
+        int senderId = InformationObject_getObjectAddress((InformationObject) sc) - 1000;
+
+        if ((senderId >= 0) && (senderId < 4) && (SingleCommand_getState(sc) == (senderId % 2 == 0)))
+            info->receivedCommands[senderId]++;
+        else
+            info->valueError = true;
+
+        SingleCommand_destroy(sc);
+
+        return true;
+    }
+
+    return false;
+}
+
+static void*
+test_CS104ConnectionConcurrentSenders_senderThread(void* parameter)
+{
+    struct stest_CS104ConnectionConcurrentSenders_sender* sender = (struct stest_CS104ConnectionConcurrentSenders_sender*) parameter;
+
+    SingleCommand sc = SingleCommand_create(NULL, 1000 + sender->senderId, (sender->senderId % 2 == 0), false, 0);
+
+    int sent = 0;
+    int retries = 0;
+
+    while ((sent < 50) && (retries < 1000)) {
+        if (CS104_Connection_sendProcessCommandEx(sender->info->con, CS101_COT_ACTIVATION, 1, (InformationObject) sc))
+            sent++;
+        else {
+            /* k-buffer is full */
+            retries++;
+            Thread_sleep(1);
+        }
+    }
+
+    SingleCommand_destroy(sc);
+
+    return NULL;
+}
+
+void
+test_CS104ConnectionConcurrentSenders(void)
+{
+    CS104_Slave slave = CS104_Slave_create(100, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    /* the server confirms each received I frame */
+    CS104_Slave_getConnectionParameters(slave)->w = 1;
+
+    struct stest_CS104ConnectionConcurrentSenders info;
+    memset(&info, 0, sizeof(info));
+
+    CS104_Slave_setASDUHandler(slave, test_CS104ConnectionConcurrentSenders_asduHandler, &info);
+
+    CS104_Slave_start(slave);
+
+    info.con = CS104_Connection_create("127.0.0.1", 20004);
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(info.con));
+
+    CS104_Connection_sendStartDT(info.con);
+
+    Thread_sleep(100);
+
+    struct stest_CS104ConnectionConcurrentSenders_sender senders[4];
+    Thread threads[4];
+
+    int i;
+
+    for (i = 0; i < 4; i++) {
+        senders[i].info = &info;
+        senders[i].senderId = i;
+
+        threads[i] = Thread_create(test_CS104ConnectionConcurrentSenders_senderThread, &(senders[i]), false);
+        Thread_start(threads[i]);
+    }
+
+    for (i = 0; i < 4; i++)
+        Thread_destroy(threads[i]);
+
+    for (i = 0; i < 40; i++) {
+        if (info.receivedCommands[0] + info.receivedCommands[1] + info.receivedCommands[2] + info.receivedCommands[3] == 200)
+            break;
+
+        Thread_sleep(50);
+    }
+
+    TEST_ASSERT_FALSE(info.valueError);
+
+    for (i = 0; i < 4; i++)
+        TEST_ASSERT_EQUAL_INT(50, info.receivedCommands[i]);
+
+    CS104_Connection_destroy(info.con);
+
+    CS104_Slave_destroy(slave);
+}
+
+struct stest_CS104ConnectionBatchHandler {
+    int numberOfASDUs;
+    int numberOfBatches;
+    int maxBatchSize;
+    bool orderError;
+    int receivedHandlerCalls;
+};
+
+static void
+test_CS104ConnectionBatchHandler_batchHandler(void* parameter, int address, CS101_ASDU* asdus, int numberOfASDUs)
+{
+    struct stest_CS104ConnectionBatchHandler* info = (struct stest_CS104ConnectionBatchHandler*) parameter;
+
+    int i;
+
+    for (i = 0; i < numberOfASDUs; i++) {
+        if (CS101_ASDU_getTypeID(asdus[i]) == M_ME_NB_1) {
+            MeasuredValueScaled mv = (MeasuredValueScaled) CS101_ASDU_getElement(asdus[i], 0);
+
+            if (MeasuredValueScaled_getValue(mv) != info->numberOfASDUs)
+                info->orderError = true;
+
+            MeasuredValueScaled_destroy(mv);
+
+            info->numberOfASDUs++;
+        }
+    }
+
+    info->numberOfBatches++;
+
+    if (numberOfASDUs > info->maxBatchSize)
+        info->maxBatchSize = numberOfASDUs;
+}
+
+static bool
+test_CS104ConnectionBatchHandler_asduHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104ConnectionBatchHandler* info = (struct stest_CS104ConnectionBatchHandler*) parameter;
+
+    info->receivedHandlerCalls++;
+
+    return true;
+}
+
+void
+test_CS104ConnectionBatchHandler(void)
+{
+    CS104_Slave slave = CS104_Slave_create(200, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+
+    CS104_Slave_start(slave);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    int i;
+
+    for (i = 0; i < 100; i++) {
         CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, i, IEC60870_QUALITY_GOOD);
 
-        scaledValue++;
+        CS101_ASDU_addInformationObject(newAsdu, io);
+
+        InformationObject_destroy(io);
+
+        CS104_Slave_enqueueASDU(slave, newAsdu);
+
+        CS101_ASDU_destroy(newAsdu);
+    }
+
+    struct stest_CS104ConnectionBatchHandler info;
+    memset(&info, 0, sizeof(info));
+
+    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104ConnectionBatchHandler_asduHandler, &info);
+
+    TEST_ASSERT_FALSE(CS104_Connection_setASDUBatchHandler(con, test_CS104ConnectionBatchHandler_batchHandler, &info, 0));
+    TEST_ASSERT_TRUE(CS104_Connection_setASDUBatchHandler(con, test_CS104ConnectionBatchHandler_batchHandler, &info, 5));
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
+
+    /* the handler cannot be changed while connected */
+    TEST_ASSERT_FALSE(CS104_Connection_setASDUBatchHandler(con, NULL, NULL, 0));
+
+    CS104_Connection_sendStartDT(con);
+
+    for (i = 0; i < 40; i++) {
+        if (info.numberOfASDUs == 100)
+            break;
+
+        Thread_sleep(50);
+    }
+
+    TEST_ASSERT_EQUAL_INT(100, info.numberOfASDUs);
+    TEST_ASSERT_FALSE(info.orderError);
+    TEST_ASSERT_TRUE(info.maxBatchSize <= 5);
+    TEST_ASSERT_EQUAL_INT(0, info.receivedHandlerCalls);
+
+    CS104_Connection_destroy(con);
+
+    CS104_Slave_destroy(slave);
+}
+
+struct stest_CS104DecodePool {
+    int numberOfASDUs;
+    bool orderError;
+    int numberOfBatches;
+};
+
+static void
+test_CS104DecodePool_checkASDU(struct stest_CS104DecodePool* info, CS101_ASDU asdu)
+{
+    if (CS101_ASDU_getTypeID(asdu) == M_ME_NB_1) {
+        MeasuredValueScaled mv = (MeasuredValueScaled) CS101_ASDU_getElement(asdu, 0);
+
+        if (MeasuredValueScaled_getValue(mv) != info->numberOfASDUs)
+            info->orderError = true;
+
+        MeasuredValueScaled_destroy(mv);
+
+        info->numberOfASDUs++;
+    }
+}
+
+static bool
+test_CS104DecodePool_asduHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104DecodePool* info = (struct stest_CS104DecodePool*) parameter;
+
+    test_CS104DecodePool_checkASDU(info, asdu);
+
+    /* slow consumer */
+    if (info->numberOfASDUs % 10 == 0)
+        Thread_sleep(2);
+
+    return true;
+}
+
+static void
+test_CS104DecodePool_batchHandler(void* parameter, int address, CS101_ASDU* asdus, int numberOfASDUs)
+{
+    struct stest_CS104DecodePool* info = (struct stest_CS104DecodePool*) parameter;
+
+    int i;
+
+    for (i = 0; i < numberOfASDUs; i++)
+        test_CS104DecodePool_checkASDU(info, asdus[i]);
+
+    info->numberOfBatches++;
+}
+
+void
+test_CS104DecodePool(void)
+{
+    CS104_Slave slave = CS104_Slave_create(200, 100);
+
+    CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_setServerMode(slave, CS104_MODE_CONNECTION_IS_REDUNDANCY_GROUP);
+
+    CS104_Slave_start(slave);
+
+    CS104_DecodePool pool = CS104_DecodePool_create(2, 2);
+    TEST_ASSERT_NOT_NULL(pool);
+
+    struct stest_CS104DecodePool info[2];
+    memset(info, 0, sizeof(info));
+
+    CS104_Connection con1 = CS104_Connection_create("127.0.0.1", 20004);
+    CS104_Connection con2 = CS104_Connection_create("127.0.0.1", 20004);
+    CS104_Connection con3 = CS104_Connection_create("127.0.0.1", 20004);
+
+    CS104_Connection_setASDUReceivedHandler(con1, test_CS104DecodePool_asduHandler, &(info[0]));
+    TEST_ASSERT_TRUE(CS104_Connection_setASDUBatchHandler(con2, test_CS104DecodePool_batchHandler, &(info[1]), 8));
+
+    /* the small queue of the slow connection is full most of the time */
+    TEST_ASSERT_FALSE(CS104_Connection_setDecodePool(con1, pool, 0));
+    TEST_ASSERT_TRUE(CS104_Connection_setDecodePool(con1, pool, 4));
+    TEST_ASSERT_TRUE(CS104_Connection_setDecodePool(con2, pool, 32));
+
+    /* pool is full */
+    TEST_ASSERT_FALSE(CS104_Connection_setDecodePool(con3, pool, 4));
+    TEST_ASSERT_EQUAL_INT(2, CS104_DecodePool_getNumberOfConnections(pool));
+
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con1));
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con2));
+
+    /* the pool cannot be changed while connected */
+    TEST_ASSERT_FALSE(CS104_Connection_setDecodePool(con1, NULL, 0));
+
+    CS104_Connection_sendStartDT(con1);
+    CS104_Connection_sendStartDT(con2);
+
+    Thread_sleep(100);
+
+    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+
+    int i;
+
+    for (i = 0; i < 150; i++) {
+        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, i, IEC60870_QUALITY_GOOD);
 
         CS101_ASDU_addInformationObject(newAsdu, io);
 
@@ -1217,48 +4324,79 @@ test_CS104SlaveEventQueue1()
         CS104_Slave_enqueueASDU(slave, newAsdu);
 
         CS101_ASDU_destroy(newAsdu);
+    }
 
-        Thread_sleep(10);
+    for (i = 0; i < 100; i++) {
+        if ((info[0].numberOfASDUs == 150) && (info[1].numberOfASDUs == 150))
+            break;
+
+        Thread_sleep(50);
     }
 
-    Thread_sleep(500);
+    TEST_ASSERT_EQUAL_INT(150, info[0].numberOfASDUs);
+    TEST_ASSERT_FALSE(info[0].orderError);
+    TEST_ASSERT_EQUAL_INT(150, info[1].numberOfASDUs);
+    TEST_ASSERT_FALSE(info[1].orderError);
+    TEST_ASSERT_TRUE(info[1].numberOfBatches > 0);
 
-    CS104_Connection_close(con);
+    TEST_ASSERT_EQUAL_INT(0, CS104_Connection_getNumberOfPendingASDUs(con1));
+    TEST_ASSERT_EQUAL_INT(0, CS104_Connection_getNumberOfPendingASDUs(con2));
 
-    TEST_ASSERT_EQUAL_INT(15, info.asduHandlerCalled);
-    TEST_ASSERT_EQUAL_INT(15, info.spontCount);
-    TEST_ASSERT_EQUAL_INT(29, info.lastScaledValue);
+    CS104_Connection_destroy(con1);
+    CS104_Connection_destroy(con2);
+    CS104_Connection_destroy(con3);
 
-    CS104_Connection_destroy(con);
+    TEST_ASSERT_EQUAL_INT(0, CS104_DecodePool_getNumberOfConnections(pool));
+
+    CS104_DecodePool_destroy(pool);
+
+    CS104_Slave_destroy(slave);
+}
+
+struct stest_CS104ReceiveBufferPool {
+    CS104_ReceiveBufferPool pool;
+    CS101_ASDU retained[20];
+    int numberOfRetained;
+    int zeroCopies;
+};
+
+static bool
+test_CS104ReceiveBufferPool_asduHandler(void* parameter, int address, CS101_ASDU asdu)
+{
+    struct stest_CS104ReceiveBufferPool* info = (struct stest_CS104ReceiveBufferPool*) parameter;
+
+    if (info->numberOfRetained < 20) {
+        CS101_ASDU retained = CS104_ReceiveBufferPool_retainASDU(info->pool, asdu);
+
+        if (retained) {
+            /* the retained ASDU references the receive buffer when the APDU was received with one read */
+            if (CS101_ASDU_getPayload(retained) == CS101_ASDU_getPayload(asdu))
+                info->zeroCopies++;
+
+            info->retained[info->numberOfRetained++] = retained;
+        }
+    }
 
-    CS104_Slave_destroy(slave);
+    return true;
 }
 
 void
-test_CS104SlaveEventQueueOverflow()
+test_CS104ReceiveBufferPool(void)
 {
-    CS104_Slave slave = CS104_Slave_create(10, 10);
+    CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
     CS104_Slave_setLocalPort(slave, 20004);
 
     CS104_Slave_start(slave);
 
     CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
 
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
-
-    int16_t scaledValue = 0;
+    int i;
 
-    for (int i = 0; i < 300; i++) {
+    for (i = 0; i < 20; i++) {
         CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
-
-        scaledValue++;
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, i, IEC60870_QUALITY_GOOD);
 
         CS101_ASDU_addInformationObject(newAsdu, io);
 
@@ -1269,87 +4407,109 @@ test_CS104SlaveEventQueueOverflow()
         CS101_ASDU_destroy(newAsdu);
     }
 
+    /* buffer too small for an APDU */
+    TEST_ASSERT_NULL(CS104_ReceiveBufferPool_create(4, 100, 20));
+
+    struct stest_CS104ReceiveBufferPool info;
+    memset(&info, 0, sizeof(info));
+
+    info.pool = CS104_ReceiveBufferPool_create(32, 512, 20);
+    TEST_ASSERT_NOT_NULL(info.pool);
+
     CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+    CS104_Connection_setASDUReceivedHandler(con, test_CS104ReceiveBufferPool_asduHandler, &info);
+    TEST_ASSERT_TRUE(CS104_Connection_setReceiveBufferPool(con, info.pool));
 
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
 
     CS104_Connection_sendStartDT(con);
 
-    Thread_sleep(1500);
+    for (i = 0; i < 40; i++) {
+        if (info.numberOfRetained == 20)
+            break;
 
-    CS104_Connection_close(con);
+        Thread_sleep(50);
+    }
 
-    int asduSize = 12;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
+    TEST_ASSERT_EQUAL_INT(20, info.numberOfRetained);
+    TEST_ASSERT_TRUE(info.zeroCopies > 0);
 
-    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+    /* the maximum number of retained ASDUs is reached */
+    TEST_ASSERT_NULL(CS104_ReceiveBufferPool_retainASDU(info.pool, info.retained[0]));
 
-    result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    CS104_Connection_destroy(con);
 
-    CS104_Connection_sendStartDT(con);
+    /* the retained ASDUs are still valid after the connection has been destroyed */
+    for (i = 0; i < 20; i++) {
+        TEST_ASSERT_EQUAL_INT(M_ME_NB_1, CS101_ASDU_getTypeID(info.retained[i]));
 
-    for (int i = 0; i < 150; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+        MeasuredValueScaled mv = (MeasuredValueScaled) CS101_ASDU_getElement(info.retained[i], 0);
+        TEST_ASSERT_NOT_NULL(mv);
+        TEST_ASSERT_EQUAL_INT(i, MeasuredValueScaled_getValue(mv));
+        MeasuredValueScaled_destroy(mv);
+    }
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
+    TEST_ASSERT_TRUE(CS104_ReceiveBufferPool_getNumberOfFreeBuffers(info.pool) < 32);
 
-        scaledValue++;
+    for (i = 0; i < 20; i++)
+        CS104_ReceiveBufferPool_releaseASDU(info.pool, info.retained[i]);
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+    TEST_ASSERT_EQUAL_INT(32, CS104_ReceiveBufferPool_getNumberOfFreeBuffers(info.pool));
 
-        InformationObject_destroy(io);
+    /* ASDUs that are not retained by the pool are ignored */
+    CS104_ReceiveBufferPool_releaseASDU(info.pool, info.retained[0]);
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+    sCS101_StaticASDU staticAsdu;
+    CS101_ASDU otherAsdu = CS101_ASDU_initializeStatic(&staticAsdu, &defaultAppLayerParameters, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-        CS101_ASDU_destroy(newAsdu);
+    CS104_ReceiveBufferPool_releaseASDU(info.pool, otherAsdu);
 
-        Thread_sleep(10);
-    }
+    TEST_ASSERT_EQUAL_INT(32, CS104_ReceiveBufferPool_getNumberOfFreeBuffers(info.pool));
 
-    Thread_sleep(500);
+    /* a message outside of the pool is copied */
+    uint8_t msg[] = { 0x68, 0x04, 0x01, 0x00, 0x00, 0x00 };
 
-    CS104_Connection_close(con);
+    uint8_t* retainedMsg = CS104_ReceiveBufferPool_retainMessage(info.pool, msg, sizeof(msg));
+    TEST_ASSERT_NOT_NULL(retainedMsg);
+    TEST_ASSERT_TRUE(retainedMsg != msg);
+    TEST_ASSERT_EQUAL_MEMORY(msg, retainedMsg, sizeof(msg));
+    TEST_ASSERT_EQUAL_INT(31, CS104_ReceiveBufferPool_getNumberOfFreeBuffers(info.pool));
 
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.asduHandlerCalled);
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity + 150, info.spontCount);
-    TEST_ASSERT_EQUAL_INT(449, info.lastScaledValue);
+    /* a message in the pool is only referenced */
+    TEST_ASSERT_TRUE(CS104_ReceiveBufferPool_retainMessage(info.pool, retainedMsg, sizeof(msg)) == retainedMsg);
 
-    CS104_Connection_destroy(con);
+    CS104_ReceiveBufferPool_releaseMessage(info.pool, retainedMsg);
+    TEST_ASSERT_EQUAL_INT(31, CS104_ReceiveBufferPool_getNumberOfFreeBuffers(info.pool));
+
+    CS104_ReceiveBufferPool_releaseMessage(info.pool, retainedMsg);
+    TEST_ASSERT_EQUAL_INT(32, CS104_ReceiveBufferPool_getNumberOfFreeBuffers(info.pool));
+
+    CS104_ReceiveBufferPool_destroy(info.pool);
 
     CS104_Slave_destroy(slave);
 }
 
 void
-test_CS104SlaveEventQueueOverflow2()
+test_CS104ConnectionAdaptiveWindow(void)
 {
-    CS104_Slave slave = CS104_Slave_create(10, 10);
+    CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
     CS104_Slave_setLocalPort(slave, 20004);
 
+    /* the server confirms each received I frame */
+    CS104_Slave_getConnectionParameters(slave)->w = 1;
+
     CS104_Slave_start(slave);
 
     CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
 
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
-
-    int16_t scaledValue = 0;
+    int i;
 
-    for (int i = 0; i < 300; i++) {
+    for (i = 0; i < 50; i++) {
         CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
 
-        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
-
-        scaledValue++;
+        InformationObject io = (InformationObject) MeasuredValueScaled_create(NULL, 110, i, IEC60870_QUALITY_GOOD);
 
         CS101_ASDU_addInformationObject(newAsdu, io);
 
@@ -1362,244 +4522,260 @@ test_CS104SlaveEventQueueOverflow2()
 
     CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
-
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
-
-    CS104_Connection_sendStartDT(con);
-
-    Thread_sleep(500);
-
-    CS104_Connection_close(con);
+    struct sCS104_APCIParameters apciParams = *(CS104_Connection_getAPCIParameters(con));
+    apciParams.k = 2;
+    CS104_Connection_setAPCIParameters(con, &apciParams);
 
-    int asduSize = 12;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 10) / entrySize;
+    TEST_ASSERT_FALSE(CS104_Connection_setAdaptiveWindow(con, true, 4, 2, 1, 8));
+    TEST_ASSERT_FALSE(CS104_Connection_setAdaptiveWindow(con, true, 2, 20, 0, 8));
+    TEST_ASSERT_TRUE(CS104_Connection_setAdaptiveWindow(con, true, 2, 20, 1, 8));
 
-    TEST_ASSERT_EQUAL_INT(299, info.lastScaledValue);
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
 
-    result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    /* the mode cannot be changed while connected */
+    TEST_ASSERT_FALSE(CS104_Connection_setAdaptiveWindow(con, false, 0, 0, 0, 0));
 
     CS104_Connection_sendStartDT(con);
 
-    int typeNo = 0;
+    Thread_sleep(100);
 
-    for (int i = 0; i < 20000; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+    SingleCommand sc = SingleCommand_create(NULL, 1000, true, false, 0);
 
-        InformationObject io;
+    int sent = 0;
+    int retries = 0;
 
-        if (typeNo == 0) {
-            io = (InformationObject) MeasuredValueScaled_create(NULL, 110, scaledValue, IEC60870_QUALITY_GOOD);
-            CS101_ASDU_addInformationObject(newAsdu, io);
+    while ((sent < 200) && (retries < 5000)) {
+        if (CS104_Connection_sendProcessCommandEx(con, CS101_COT_ACTIVATION, 1, (InformationObject) sc))
+            sent++;
+        else {
+            /* send window is full */
+            retries++;
+            Thread_sleep(1);
         }
-        else if (typeNo == 1) {
-            struct sCP56Time2a cp56;
-            CP56Time2a_createFromMsTimestamp(&cp56, Hal_getTimeInMs());
+    }
 
-            io =  (InformationObject) MeasuredValueScaledWithCP56Time2a_create(NULL, 111, scaledValue, IEC60870_QUALITY_GOOD, &cp56);
+    SingleCommand_destroy(sc);
 
-            CS101_ASDU_addInformationObject(newAsdu, io);
-        }
-        else if (typeNo == 2) {
-            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
+    TEST_ASSERT_EQUAL_INT(200, sent);
 
-            CS101_ASDU_addInformationObject(newAsdu, io);
-        }
-        else if (typeNo == 3) {
-            io = (InformationObject) SinglePointInformation_create(NULL, 112, true, IEC60870_QUALITY_GOOD);
-            int j = 1;
-            while (CS101_ASDU_addInformationObject(newAsdu, io)) {
-                io = (InformationObject) SinglePointInformation_create((SinglePointInformation) io, 112 + j, true, IEC60870_QUALITY_GOOD);
-                j++;
-            }
-        }
+    Thread_sleep(100);
 
-        typeNo++;
+    struct sCS104_WindowStatistics statistics;
 
-        if (typeNo == 4)
-            typeNo = 0;
+    CS104_Connection_getWindowStatistics(con, &statistics);
 
-        scaledValue++;
+    TEST_ASSERT_EQUAL_UINT32(200, statistics.sentIMessages);
+    /* 50 monitoring ASDUs and a response for each command */
+    TEST_ASSERT_EQUAL_UINT32(250, statistics.receivedIMessages);
+    TEST_ASSERT_TRUE(statistics.sentSMessages > 0);
+    TEST_ASSERT_TRUE(statistics.sentSMessages < 250);
+    TEST_ASSERT_TRUE(statistics.smoothedRtt >= 0);
+    TEST_ASSERT_TRUE(statistics.minRtt >= 0);
+    TEST_ASSERT_TRUE(statistics.windowFullEvents > 0);
 
-        InformationObject_destroy(io);
+    /* the send window has been increased because it was full */
+    TEST_ASSERT_TRUE(statistics.sendWindow > 2);
+    TEST_ASSERT_TRUE(statistics.sendWindow <= 20);
+    TEST_ASSERT_TRUE(statistics.maxOutstanding <= 20);
+    TEST_ASSERT_TRUE(statistics.ackThreshold >= 1);
+    TEST_ASSERT_TRUE(statistics.ackThreshold <= 8);
+    TEST_ASSERT_TRUE(statistics.windowUtilization > 0);
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+    CS104_Connection_destroy(con);
 
-        CS101_ASDU_destroy(newAsdu);
+    CS104_Slave_destroy(slave);
+}
 
-        //Thread_sleep(10);
-    }
+struct stest_CommandTracker {
+    int events[6];
+    int lastIoa;
+    bool asduMissing;
+};
 
-    Thread_sleep(500);
+static void
+test_CommandTracker_commandHandler(void* parameter, TypeID typeId, int ca, int ioa, CS101_CommandEvent event, CS101_ASDU asdu)
+{
+    struct stest_CommandTracker* info = (struct stest_CommandTracker*) parameter;
 
-    CS104_Connection_close(con);
+    info->events[event]++;
+    info->lastIoa = ioa;
 
-    CS104_Connection_destroy(con);
+    if ((event < CS101_COMMAND_EVENT_TIMEOUT) && (asdu == NULL))
+        info->asduMissing = true;
+}
 
-    CS104_Slave_destroy(slave);
+static CS101_ASDU
+test_CommandTracker_createResponse(CS101_CauseOfTransmission cot, bool isNegative, int ca, int ioa)
+{
+    CS101_ASDU asdu = CS101_ASDU_create(&defaultAppLayerParameters, false, cot, 0, ca, false, isNegative);
+
+    SingleCommand sc = SingleCommand_create(NULL, ioa, true, false, 0);
+    CS101_ASDU_addInformationObject(asdu, (InformationObject) sc);
+    SingleCommand_destroy(sc);
+
+    return asdu;
 }
 
 void
-test_CS104SlaveEventQueueCheckCapacity()
+test_CS101CommandTracker(void)
 {
-    CS104_Slave slave = CS104_Slave_create(2, 2);
+    struct stest_CommandTracker info;
+    memset(&info, 0, sizeof(info));
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
-    CS104_Slave_setLocalPort(slave, 20004);
+    CS101_CommandTracker tracker = CS101_CommandTracker_create(3);
 
-    CS104_Slave_start(slave);
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 1, 100, true, 0, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 1, 101, false, 0, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 2, 100, false, 0, test_CommandTracker_commandHandler, &info));
 
-    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
+    /* already outstanding / tracker full */
+    TEST_ASSERT_FALSE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 1, 100, false, 0, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_FALSE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 3, 100, false, 0, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_EQUAL_INT(3, CS101_CommandTracker_getNumberOfCommands(tracker));
 
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
+    /* confirmation of a command that waits for the termination */
+    CS101_ASDU asdu = test_CommandTracker_createResponse(CS101_COT_ACTIVATION_CON, false, 1, 100);
+    TEST_ASSERT_TRUE(CS101_CommandTracker_handleASDU(tracker, asdu));
+    CS101_ASDU_destroy(asdu);
 
-    int16_t scaledValue = 0;
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_CONFIRMED]);
+    TEST_ASSERT_EQUAL_INT(3, CS101_CommandTracker_getNumberOfCommands(tracker));
 
-    /* Fill queue with small messages */
-    int asduSize = 6 + 3 + 1;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
+    asdu = test_CommandTracker_createResponse(CS101_COT_ACTIVATION_TERMINATION, false, 1, 100);
+    TEST_ASSERT_TRUE(CS101_CommandTracker_handleASDU(tracker, asdu));
+    CS101_ASDU_destroy(asdu);
 
-    for (int i = 0; i < 299; i++) {
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_TERMINATED]);
+    TEST_ASSERT_EQUAL_INT(2, CS101_CommandTracker_getNumberOfCommands(tracker));
 
-        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
+    /* response to a command that is not outstanding (any more) */
+    asdu = test_CommandTracker_createResponse(CS101_COT_ACTIVATION_TERMINATION, false, 1, 100);
+    TEST_ASSERT_FALSE(CS101_CommandTracker_handleASDU(tracker, asdu));
+    CS101_ASDU_destroy(asdu);
 
-        CS101_ASDU_addInformationObject(newAsdu, io);
+    /* negative confirmation */
+    asdu = test_CommandTracker_createResponse(CS101_COT_ACTIVATION_CON, true, 1, 101);
+    TEST_ASSERT_TRUE(CS101_CommandTracker_handleASDU(tracker, asdu));
+    CS101_ASDU_destroy(asdu);
 
-        InformationObject_destroy(io);
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_NEGATIVE]);
+    TEST_ASSERT_EQUAL_INT(101, info.lastIoa);
 
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+    /* rejected command */
+    asdu = test_CommandTracker_createResponse(CS101_COT_UNKNOWN_IOA, true, 2, 100);
+    TEST_ASSERT_TRUE(CS101_CommandTracker_handleASDU(tracker, asdu));
+    CS101_ASDU_destroy(asdu);
 
-        if (i >= msgQueueCapacity)
-            TEST_ASSERT_EQUAL_INT(msgQueueCapacity, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
-        else
-            TEST_ASSERT_EQUAL_INT(i + 1, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_REJECTED]);
+    TEST_ASSERT_EQUAL_INT(0, CS101_CommandTracker_getNumberOfCommands(tracker));
+    TEST_ASSERT_FALSE(info.asduMissing);
 
-        CS101_ASDU_destroy(newAsdu);
-    }
+    /* timeout of the complete procedure */
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 1, 200, true, 100, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_IC_NA_1, 1, 0, true, 0, test_CommandTracker_commandHandler, &info));
 
-    CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
+    TEST_ASSERT_EQUAL_INT(0, CS101_CommandTracker_checkTimeouts(tracker));
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
+    Thread_sleep(250);
 
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+    TEST_ASSERT_EQUAL_INT(1, CS101_CommandTracker_checkTimeouts(tracker));
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_TIMEOUT]);
+    TEST_ASSERT_EQUAL_INT(200, info.lastIoa);
 
-    CS104_Connection_sendStartDT(con);
+    /* removed commands are not reported */
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 1, 300, false, 0, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_TRUE(CS101_CommandTracker_remove(tracker, C_SC_NA_1, 1, 300));
+    TEST_ASSERT_FALSE(CS101_CommandTracker_remove(tracker, C_SC_NA_1, 1, 300));
 
-    Thread_sleep(1000);
+    CS101_CommandTracker_cancelAll(tracker);
 
-    CS104_Connection_close(con);
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_CANCELED]);
+    TEST_ASSERT_EQUAL_INT(0, CS101_CommandTracker_getNumberOfCommands(tracker));
 
-    TEST_ASSERT_EQUAL_INT(msgQueueCapacity, info.asduHandlerCalled);
+    CS101_CommandTracker_destroy(tracker);
+}
 
-    /* outstanding I messages that are not confirmed */
-    TEST_ASSERT_EQUAL_INT(0, CS104_Slave_getNumberOfQueueEntries(slave, NULL));
+static bool
+test_CS104ConnectionCommandTracker_asduHandler(void* parameter, IMasterConnection connection, CS101_ASDU asdu)
+{
+    if (CS101_ASDU_getTypeID(asdu) == C_SC_NA_1) {
+        IMasterConnection_sendACT_CON(connection, asdu, false);
+        IMasterConnection_sendACT_TERM(connection, asdu);
 
-    CS104_Connection_destroy(con);
+        return true;
+    }
 
-    CS104_Slave_destroy(slave);
+    return false;
 }
 
 void
-test_CS104SlaveEventQueueOverflow3()
+test_CS104ConnectionCommandTracker(void)
 {
-    /**
-     * Trigger code to remove multiple messages at once from the buffer
-     */
-
-    CS104_Slave slave = CS104_Slave_create(2, 2);
+    CS104_Slave slave = CS104_Slave_create(100, 100);
 
-    CS104_Slave_setServerMode(slave, CS104_MODE_SINGLE_REDUNDANCY_GROUP);
     CS104_Slave_setLocalPort(slave, 20004);
+    CS104_Slave_setASDUHandler(slave, test_CS104ConnectionCommandTracker_asduHandler, NULL);
 
     CS104_Slave_start(slave);
 
-    CS101_AppLayerParameters alParams = CS104_Slave_getAppLayerParameters(slave);
-
-    struct stest_CS104SlaveEventQueue1 info;
-    info.asduHandlerCalled = 0;
-    info.spontCount = 0;
-    info.lastScaledValue = 0;
-
-    int16_t scaledValue = 0;
-
-    /* Fill queue with small messages */
-
-    int asduSize = 6 + 3 + 1;
-    int entrySize = sizeof(struct sTestMessageQueueEntryInfo) + asduSize;
-    int msgQueueCapacity = ((sizeof(struct sTestMessageQueueEntryInfo) + 256) * 2) / entrySize;
-
-    for (int i = 0; i < 35; i++) {
-
-        CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_SPONTANEOUS, 0, 1, false, false);
-
-        InformationObject io = (InformationObject) SinglePointInformation_create(NULL, 101, true, IEC60870_QUALITY_GOOD);
-
-        CS101_ASDU_addInformationObject(newAsdu, io);
-
-        InformationObject_destroy(io);
-
-        CS104_Slave_enqueueASDU(slave, newAsdu);
+    struct stest_CommandTracker info;
+    memset(&info, 0, sizeof(info));
 
-        CS101_ASDU_destroy(newAsdu);
-    }
+    CS101_CommandTracker tracker = CS101_CommandTracker_create(10);
 
     CS104_Connection con = CS104_Connection_create("127.0.0.1", 20004);
 
-    CS104_Connection_setASDUReceivedHandler(con, test_CS104SlaveEventQueue1_asduReceivedHandler, &info);
-
-    int count1 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+    CS104_Connection_setCommandTracker(con, tracker);
 
+    TEST_ASSERT_TRUE(CS104_Connection_connect(con));
 
+    CS104_Connection_sendStartDT(con);
 
-    /* add a single large messages */
-    CS101_ASDU newAsdu = CS101_ASDU_create(alParams, false, CS101_COT_PERIODIC, 0, 1, false, false);
+    Thread_sleep(100);
 
-    for (int i = 0; i < 50; i++) {
-          SinglePointInformation spi = SinglePointInformation_create(NULL, 110, false, IEC60870_QUALITY_GOOD);;
+    SingleCommand sc = SingleCommand_create(NULL, 5000, true, false, 0);
 
-          CS101_ASDU_addInformationObject(newAsdu, (InformationObject) spi);
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 1, 5000, true, 2000, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_TRUE(CS104_Connection_sendProcessCommandEx(con, CS101_COT_ACTIVATION, 1, (InformationObject) sc));
 
-          InformationObject_destroy((InformationObject) spi);
-    }
+    SingleCommand_destroy(sc);
 
-    CS104_Slave_enqueueASDU(slave, newAsdu);
+    /* the server does not support set point commands */
+    SetpointCommandNormalized spc = SetpointCommandNormalized_create(NULL, 6000, 0.5f, false, 0);
 
-    CS101_ASDU_destroy(newAsdu);
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SE_NA_1, 1, 6000, false, 2000, test_CommandTracker_commandHandler, &info));
+    TEST_ASSERT_TRUE(CS104_Connection_sendProcessCommandEx(con, CS101_COT_ACTIVATION, 1, (InformationObject) spc));
 
-    int count2 = CS104_Slave_getNumberOfQueueEntries(slave, NULL);
+    SetpointCommandNormalized_destroy(spc);
 
-    /* check that multiple buffer entries were removed */
-    TEST_ASSERT_TRUE(count2 + 1 < count1);
+    int i;
 
-    info.asduHandlerCalled = 0;
+    for (i = 0; i < 40; i++) {
+        if (CS101_CommandTracker_getNumberOfCommands(tracker) == 0)
+            break;
 
-    bool result = CS104_Connection_connect(con);
-    TEST_ASSERT_TRUE(result);
+        Thread_sleep(50);
+    }
 
-    CS104_Connection_sendStartDT(con);
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_CONFIRMED]);
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_TERMINATED]);
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_REJECTED]);
+    TEST_ASSERT_EQUAL_INT(0, info.events[CS101_COMMAND_EVENT_TIMEOUT]);
 
-    Thread_sleep(500);
+    /* outstanding commands are canceled when the connection is closed */
+    TEST_ASSERT_TRUE(CS101_CommandTracker_add(tracker, C_SC_NA_1, 1, 5001, false, 0, test_CommandTracker_commandHandler, &info));
 
     CS104_Connection_close(con);
 
-    TEST_ASSERT_EQUAL_INT(count2, info.asduHandlerCalled);
+    TEST_ASSERT_EQUAL_INT(1, info.events[CS101_COMMAND_EVENT_CANCELED]);
 
     CS104_Connection_destroy(con);
 
+    CS101_CommandTracker_destroy(tracker);
+
     CS104_Slave_destroy(slave);
 }
 
-
 void
 test_IpAddressHandling(void)
 {
@@ -6563,6 +9739,20 @@ main(int argc, char** argv)
     RUN_TEST(test_CP56Time2aConversionFunctions);
     RUN_TEST(test_StepPositionInformation);
     RUN_TEST(test_addMaxNumberOfIOsToASDU);
+    RUN_TEST(test_ASDUEncodeToSpan);
+    RUN_TEST(test_ASDUValidate);
+    RUN_TEST(test_APDUParser);
+    RUN_TEST(test_ProcessImage);
+    RUN_TEST(test_ProcessImagePointTypes);
+    RUN_TEST(test_ProcessImageCounterFreeze);
+    RUN_TEST(test_ProcessImageConcurrentUpdate);
+    RUN_TEST(test_ProcessImageHistory);
+    RUN_TEST(test_ProcessImageQualityFlags);
+    RUN_TEST(test_ChangeDetector);
+    RUN_TEST(test_ChangeDetectorQualityFlags);
+    RUN_TEST(test_TimerWheel);
+    RUN_TEST(test_CyclicScheduler);
+    RUN_TEST(test_ASDUTemplate);
     RUN_TEST(test_SingleEventType);
 
     RUN_TEST(test_SinglePointInformation);
@@ -6639,6 +9829,23 @@ main(int argc, char** argv)
     RUN_TEST(test_CS104SlaveEventQueueOverflow2);
     RUN_TEST(test_CS104SlaveEventQueueCheckCapacity);
     RUN_TEST(test_CS104SlaveEventQueueOverflow3);
+    RUN_TEST(test_CS104SlaveInterrogationFromProcessImage);
+    RUN_TEST(test_CS104SlaveReadFromProcessImage);
+    RUN_TEST(test_CS104SlaveCounterInterrogationFromProcessImage);
+    RUN_TEST(test_CS104SlaveHistoryReplay);
+    RUN_TEST(test_CS101Mirror);
+    RUN_TEST(test_CS104ConnectionMirror);
+    RUN_TEST(test_CS104ClientEngine);
+    RUN_TEST(test_CS104ReconnectManager);
+    RUN_TEST(test_CS104ConnectionThreadless);
+    RUN_TEST(test_CS104ConnectionSendQueue);
+    RUN_TEST(test_CS104ConnectionConcurrentSenders);
+    RUN_TEST(test_CS104ConnectionAdaptiveWindow);
+    RUN_TEST(test_CS104ConnectionBatchHandler);
+    RUN_TEST(test_CS104DecodePool);
+    RUN_TEST(test_CS104ReceiveBufferPool);
+    RUN_TEST(test_CS101CommandTracker);
+    RUN_TEST(test_CS104ConnectionCommandTracker);
 
     RUN_TEST(test_CS104_Connection_ConnectTimeout);
 